@@ -56,6 +56,10 @@
 #include <platform/KeyValueStoreManager.h>
 #endif // CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <app/PersistentEventLog.h>
+#endif
+
 #if defined(ENABLE_CHIP_SHELL)
 #include <CommissioneeShellCommands.h>
 #include <lib/shell/Engine.h> // nogncheck
@@ -391,6 +395,10 @@ int ChipLinuxAppInit(int argc, char * const argv[], OptionSet * customOptions,
     err = DeviceLayer::PlatformMgr().InitChipStack();
     SuccessOrExit(err);
 
+    // Run CASE certificate validation and signatures on background threads, in parallel for concurrent sessions.
+    err = DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask();
+    SuccessOrExit(err);
+
     // Init the commissionable data provider based on command line options
     // to handle custom verifiers, discriminators, etc.
     err = chip::examples::InitCommissionableDataProvider(gCommissionableDataProvider, LinuxDeviceOptions::GetInstance());
@@ -556,6 +564,22 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
 
     initParams.testEventTriggerDelegate = &sTestEventTriggerDelegate;
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    static chip::app::PersistentEventLog sPersistentEventLog;
+    if (LinuxDeviceOptions::GetInstance().eventLog != nullptr)
+    {
+        CHIP_ERROR err = sPersistentEventLog.Open(LinuxDeviceOptions::GetInstance().eventLog);
+        if (err == CHIP_NO_ERROR)
+        {
+            initParams.persistentEventLog = &sPersistentEventLog;
+        }
+        else
+        {
+            ChipLogError(NotSpecified, "Failed to open the persistent event log: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
     // We need to set DeviceInfoProvider before Server::Init to setup the storage of DeviceInfoProvider properly.
     DeviceLayer::SetDeviceInfoProvider(&gExampleDeviceInfoProvider);
 
@@ -614,6 +638,9 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     }
     gMainLoopImplementation = nullptr;
 
+    // Let background work that is still in flight finish before the stack it reports back to is torn down.
+    DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask();
+
     ApplicationShutdown();
 
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
@@ -90,7 +90,8 @@ enum
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     kDeviceOption_SubscriptionCapacity = 0x1024,
 #endif
-    kDeviceOption_WiFiSupports5g = 0x1025
+    kDeviceOption_WiFiSupports5g = 0x1025,
+    kDeviceOption_EventLog       = 0x1026
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -126,6 +127,7 @@ OptionDef sDeviceOptionDefs[] = {
     { "command", kArgumentRequired, kDeviceOption_Command },
     { "PICS", kArgumentRequired, kDeviceOption_PICS },
     { "KVS", kArgumentRequired, kDeviceOption_KVS },
+    { "event-log", kArgumentRequired, kDeviceOption_EventLog },
     { "interface-id", kArgumentRequired, kDeviceOption_InterfaceId },
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
     { "trace_file", kArgumentRequired, kDeviceOption_TraceFile },
@@ -238,6 +240,9 @@ const char * sDeviceOptionHelp =
     "  --KVS <filepath>\n"
     "       A file to store Key Value Store items.\n"
     "\n"
+    "  --event-log <filepath>\n"
+    "       A file to keep events in across restarts, if the persistent event log is enabled.\n"
+    "\n"
     "  --interface-id <interface>\n"
     "       A interface id to advertise on.\n"
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
@@ -465,6 +470,10 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         LinuxDeviceOptions::GetInstance().KVS = aValue;
         break;
 
+    case kDeviceOption_EventLog:
+        LinuxDeviceOptions::GetInstance().eventLog = aValue;
+        break;
+
     case kDeviceOption_InterfaceId:
         LinuxDeviceOptions::GetInstance().interfaceId =
             Inet::InterfaceId(static_cast<chip::Inet::InterfaceId::PlatformType>(atoi(aValue)));
@@ -70,6 +70,24 @@ bool CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Priv
     return false;
 }
 
+constexpr uint8_t kAllPrivileges = to_underlying(Privilege::kView) | to_underlying(Privilege::kProxyView) |
+    to_underlying(Privilege::kOperate) | to_underlying(Privilege::kManage) | to_underlying(Privilege::kAdminister);
+
+// Returns the privileges (as a bitmap of Privilege values) granted by an entry with the given privilege.
+uint8_t GetPrivilegesGrantedByEntryPrivilege(Privilege entryPrivilege)
+{
+    uint8_t privileges = 0;
+    for (auto privilege :
+         { Privilege::kView, Privilege::kProxyView, Privilege::kOperate, Privilege::kManage, Privilege::kAdminister })
+    {
+        if (CheckRequestPrivilegeAgainstEntryPrivilege(privilege, entryPrivilege))
+        {
+            privileges |= to_underlying(privilege);
+        }
+    }
+    return privileges;
+}
+
 constexpr bool IsValidCaseNodeId(NodeId aNodeId)
 {
     if (IsOperationalNodeId(aNodeId))
@@ -190,6 +208,7 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+        InvalidateDecisionCache();
     }
 
     return retval;
@@ -201,6 +220,7 @@ void AccessControl::Finish()
     ChipLogProgress(DataManagement, "AccessControl: finishing");
     mDelegate->Finish();
     mDelegate = nullptr;
+    InvalidateDecisionCache();
 }
 
 CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t * index,
@@ -218,6 +238,7 @@ CHIP_ERROR AccessControl::CreateEntry(const SubjectDescriptor * subjectDescripto
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
 
     size_t i = 0;
+    InvalidateDecisionCache();
     ReturnErrorOnFailure(mDelegate->CreateEntry(&i, entry, &fabric));
 
     if (index)
@@ -234,6 +255,7 @@ CHIP_ERROR AccessControl::UpdateEntry(const SubjectDescriptor * subjectDescripto
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
     ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
+    InvalidateDecisionCache();
     ReturnErrorOnFailure(mDelegate->UpdateEntry(index, entry, &fabric));
     NotifyEntryChanged(subjectDescriptor, fabric, index, &entry, EntryListener::ChangeType::kUpdated);
     return CHIP_NO_ERROR;
@@ -248,6 +270,7 @@ CHIP_ERROR AccessControl::DeleteEntry(const SubjectDescriptor * subjectDescripto
     {
         p = &entry;
     }
+    InvalidateDecisionCache();
     ReturnErrorOnFailure(mDelegate->DeleteEntry(index, &fabric));
     if (p && p->HasDefaultDelegate())
     {
@@ -355,119 +378,236 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+    uint8_t grantedPrivileges = 0;
+    bool found                = false;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    found = mDecisionCache.Find(subjectDescriptor, requestPath, grantedPrivileges);
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+    if (!found)
+    {
+        bool cacheable = false;
+        ReturnErrorOnFailure(GetGrantedPrivileges(subjectDescriptor, requestPath, requestPrivilege, grantedPrivileges, cacheable));
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+        if (cacheable)
+        {
+            mDecisionCache.Insert(subjectDescriptor, requestPath, grantedPrivileges);
+        }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    }
+
+    if ((grantedPrivileges & to_underlying(requestPrivilege)) == 0)
+    {
+        // No entry was found which passed all checks: access is denied.
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+        return CHIP_ERROR_ACCESS_DENIED;
+    }
+
+    // An entry passed all checks: access is allowed.
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+    ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControl::GetGrantedPrivileges(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                               Privilege requestPrivilege, uint8_t & grantedPrivileges, bool & cacheable)
+{
+    grantedPrivileges = 0;
+    cacheable         = true;
+
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
+    // Rather than stopping at the first entry granting the requested privilege, collect every privilege granted, so the
+    // result can be cached and reused for checks of other privileges.
     Entry entry;
-    while (iterator.Next(entry) == CHIP_NO_ERROR)
+    while (grantedPrivileges != kAllPrivileges && iterator.Next(entry) == CHIP_NO_ERROR)
     {
-        AuthMode authMode = AuthMode::kNone;
-        ReturnErrorOnFailure(entry.GetAuthMode(authMode));
-        // Operational PASE not supported for v1.0.
-        VerifyOrReturnError(authMode == AuthMode::kCase || authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
-        if (authMode != subjectDescriptor.authMode)
+        uint8_t entryPrivileges = 0;
+        bool matched            = false;
+        CHIP_ERROR err = MatchEntry(entry, subjectDescriptor, requestPath, grantedPrivileges, entryPrivileges, matched, cacheable);
+        if (err != CHIP_NO_ERROR)
         {
-            continue;
+            // Which privileges are granted is unknown, so don't cache. Fail the check only if checking the entries one at
+            // a time for the requested privilege would: i.e. the requested privilege isn't granted by an earlier entry,
+            // and this entry wasn't going to be skipped for not granting it.
+            cacheable = false;
+            if (grantedPrivileges & to_underlying(requestPrivilege))
+            {
+                break;
+            }
+            if (entryPrivileges != 0 && (entryPrivileges & to_underlying(requestPrivilege)) == 0)
+            {
+                continue;
+            }
+            return err;
         }
-
-        Privilege privilege = Privilege::kView;
-        ReturnErrorOnFailure(entry.GetPrivilege(privilege));
-        if (!CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, privilege))
+        if (matched)
         {
-            continue;
+            grantedPrivileges |= entryPrivileges;
         }
+    }
+
+    return CHIP_NO_ERROR;
+}
 
-        size_t subjectCount = 0;
-        ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
-        if (subjectCount > 0)
+CHIP_ERROR AccessControl::MatchEntry(const Entry & entry, const SubjectDescriptor & subjectDescriptor,
+                                     const RequestPath & requestPath, uint8_t alreadyGranted, uint8_t & entryPrivileges,
+                                     bool & matched, bool & cacheable)
+{
+    AuthMode authMode = AuthMode::kNone;
+    ReturnErrorOnFailure(entry.GetAuthMode(authMode));
+    // Operational PASE not supported for v1.0.
+    VerifyOrReturnError(authMode == AuthMode::kCase || authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+    if (authMode != subjectDescriptor.authMode)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    Privilege privilege = Privilege::kView;
+    ReturnErrorOnFailure(entry.GetPrivilege(privilege));
+    entryPrivileges = GetPrivilegesGrantedByEntryPrivilege(privilege);
+    if ((entryPrivileges & ~alreadyGranted) == 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    size_t subjectCount = 0;
+    ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+    if (subjectCount > 0)
+    {
+        bool subjectMatched = false;
+        for (size_t i = 0; i < subjectCount; ++i)
         {
-            bool subjectMatched = false;
-            for (size_t i = 0; i < subjectCount; ++i)
+            NodeId subject = kUndefinedNodeId;
+            ReturnErrorOnFailure(entry.GetSubject(i, subject));
+            if (IsOperationalNodeId(subject))
             {
-                NodeId subject = kUndefinedNodeId;
-                ReturnErrorOnFailure(entry.GetSubject(i, subject));
-                if (IsOperationalNodeId(subject))
-                {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
-                }
-                else if (IsCASEAuthTag(subject))
+                VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+                if (subject == subjectDescriptor.subject)
                 {
-                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
-                    if (subjectDescriptor.cats.CheckSubjectAgainstCATs(subject))
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
+                    subjectMatched = true;
+                    break;
                 }
-                else if (IsGroupId(subject))
+            }
+            else if (IsCASEAuthTag(subject))
+            {
+                VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+                if (subjectDescriptor.cats.CheckSubjectAgainstCATs(subject))
                 {
-                    VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
-                    if (subject == subjectDescriptor.subject)
-                    {
-                        subjectMatched = true;
-                        break;
-                    }
+                    subjectMatched = true;
+                    break;
                 }
-                else
+            }
+            else if (IsGroupId(subject))
+            {
+                VerifyOrReturnError(authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+                if (subject == subjectDescriptor.subject)
                 {
-                    // Operational PASE not supported for v1.0.
-                    return CHIP_ERROR_INCORRECT_STATE;
+                    subjectMatched = true;
+                    break;
                 }
             }
-            if (!subjectMatched)
+            else
             {
-                continue;
+                // Operational PASE not supported for v1.0.
+                return CHIP_ERROR_INCORRECT_STATE;
             }
         }
+        if (!subjectMatched)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
 
-        size_t targetCount = 0;
-        ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
-        if (targetCount > 0)
+    size_t targetCount = 0;
+    ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+    if (targetCount > 0)
+    {
+        bool targetMatched = false;
+        for (size_t i = 0; i < targetCount; ++i)
         {
-            bool targetMatched = false;
-            for (size_t i = 0; i < targetCount; ++i)
+            Entry::Target target;
+            ReturnErrorOnFailure(entry.GetTarget(i, target));
+            if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
             {
-                Entry::Target target;
-                ReturnErrorOnFailure(entry.GetTarget(i, target));
-                if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
-                {
-                    continue;
-                }
-                if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
-                {
-                    continue;
-                }
-                if (target.flags & Entry::Target::kDeviceType &&
-                    !mDeviceTypeResolver->IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
-                {
-                    continue;
-                }
-                targetMatched = true;
-                break;
+                continue;
             }
-            if (!targetMatched)
+            if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
             {
                 continue;
             }
+            if (target.flags & Entry::Target::kDeviceType)
+            {
+                // Which device types are on an endpoint can change without the entries changing.
+                cacheable = false;
+                if (!mDeviceTypeResolver->IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+                {
+                    continue;
+                }
+            }
+            targetMatched = true;
+            break;
         }
-        // Entry passed all checks: access is allowed.
+        if (!targetMatched)
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
 
-#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-        ChipLogProgress(DataManagement, "AccessControl: allowed");
-#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+    matched = true;
+    return CHIP_NO_ERROR;
+}
 
-        return CHIP_NO_ERROR;
-    }
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+size_t AccessControl::DecisionCache::SlotIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath)
+{
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash                  = ((static_cast<uint64_t>(requestPath.endpoint) << 32) | requestPath.cluster) * kMultiplier;
+    hash                           = (hash ^ subjectDescriptor.subject) * kMultiplier;
+    hash                           = (hash ^ subjectDescriptor.fabricIndex) * kMultiplier;
+    return static_cast<size_t>((hash >> 32) % CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE);
+}
+
+bool AccessControl::DecisionCache::Find(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                        uint8_t & grantedPrivileges) const
+{
+    const Slot & slot = mSlots[SlotIndex(subjectDescriptor, requestPath)];
+    // CATs are compared last, as the comparison is the most expensive and only relevant for CASE.
+    VerifyOrReturnValue(slot.inUse, false);
+    VerifyOrReturnValue(slot.requestPath.cluster == requestPath.cluster && slot.requestPath.endpoint == requestPath.endpoint,
+                        false);
+    VerifyOrReturnValue(slot.subjectDescriptor.fabricIndex == subjectDescriptor.fabricIndex &&
+                            slot.subjectDescriptor.authMode == subjectDescriptor.authMode &&
+                            slot.subjectDescriptor.subject == subjectDescriptor.subject,
+                        false);
+    VerifyOrReturnValue(subjectDescriptor.authMode != AuthMode::kCase || slot.subjectDescriptor.cats == subjectDescriptor.cats,
+                        false);
+    grantedPrivileges = slot.grantedPrivileges;
+    return true;
+}
 
-    // No entry was found which passed all checks: access is denied.
-    ChipLogProgress(DataManagement, "AccessControl: denied");
-    return CHIP_ERROR_ACCESS_DENIED;
+void AccessControl::DecisionCache::Insert(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                          uint8_t grantedPrivileges)
+{
+    Slot & slot            = mSlots[SlotIndex(subjectDescriptor, requestPath)];
+    slot.subjectDescriptor = subjectDescriptor;
+    slot.requestPath       = requestPath;
+    slot.grantedPrivileges = grantedPrivileges;
+    slot.inUse             = true;
+}
+
+void AccessControl::DecisionCache::Invalidate()
+{
+    for (auto & slot : mSlots)
+    {
+        slot.inUse = false;
+    }
 }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
 
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
 CHIP_ERROR AccessControl::Dump(const Entry & entry)
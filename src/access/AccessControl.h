@@ -497,6 +497,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateDecisionCache();
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +548,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateDecisionCache();
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +570,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateDecisionCache();
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,12 +652,71 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    /**
+     * Evaluate the entries of the subject's fabric, returning in grantedPrivileges the set of privileges (as a bitmap of
+     * Privilege values) they grant the subject on the request path.
+     *
+     * The requested privilege is only used to decide, like checking the entries one at a time would, whether an entry that
+     * can't be evaluated fails the check. cacheable is set to false if the result depends on anything but the entries (e.g.
+     * on which device types are on the endpoint) or on the requested privilege.
+     */
+    CHIP_ERROR GetGrantedPrivileges(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                    Privilege requestPrivilege, uint8_t & grantedPrivileges, bool & cacheable);
+
+    /**
+     * Evaluate a single entry. entryPrivileges is set (before anything that may fail after the auth mode is known) to the
+     * privileges the entry would grant, and matched to whether it grants them to the subject on the request path. Entries
+     * that would only grant privileges in alreadyGranted are not matched against the subject or request path.
+     */
+    CHIP_ERROR MatchEntry(const Entry & entry, const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                          uint8_t alreadyGranted, uint8_t & entryPrivileges, bool & matched, bool & cacheable);
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    /**
+     * Remembers the privileges granted to recently checked subjects on recently checked request paths, so that repeated
+     * checks (e.g. for every path of a wildcard subscription) don't evaluate the entries again.
+     *
+     * Slots are direct mapped by subject and request path. The whole cache is invalidated whenever entries change.
+     */
+    class DecisionCache
+    {
+    public:
+        bool Find(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, uint8_t & grantedPrivileges) const;
+        void Insert(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, uint8_t grantedPrivileges);
+        void Invalidate();
+
+    private:
+        struct Slot
+        {
+            SubjectDescriptor subjectDescriptor;
+            RequestPath requestPath;
+            uint8_t grantedPrivileges = 0;
+            bool inUse                = false;
+        };
+
+        static size_t SlotIndex(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath);
+
+        Slot mSlots[CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE];
+    };
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+    void InvalidateDecisionCache()
+    {
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+        mDecisionCache.Invalidate();
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    }
+
 private:
     Delegate * mDelegate = nullptr;
 
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    DecisionCache mDecisionCache;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
 };
 
 /**
@@ -1760,6 +1760,73 @@ void TestCheck(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void TestCheckAfterEntryChanges(nlTestSuite * inSuite, void * inContext)
+{
+    // Checks are repeated after each change, so that stale cached decisions (if any) would be caught.
+    constexpr SubjectDescriptor subjectDescriptor = { .fabricIndex = 1,
+                                                      .authMode    = AuthMode::kCase,
+                                                      .subject     = kOperationalNodeId1 };
+    constexpr RequestPath requestPath             = { .cluster = kOnOffCluster, .endpoint = 1 };
+
+    EntryData entryData = {
+        .fabricIndex = 1,
+        .privilege   = Privilege::kOperate,
+        .authMode    = AuthMode::kCase,
+        .subjects    = { kOperationalNodeId1 },
+        .targets     = { { .flags = Target::kCluster, .cluster = kOnOffCluster } },
+    };
+
+    NL_TEST_ASSERT(inSuite, ClearAccessControl(accessControl) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+
+    NL_TEST_ASSERT(inSuite, LoadAccessControl(accessControl, &entryData, 1) == CHIP_NO_ERROR);
+    for (int i = 0; i < 2; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kOperate) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage) == CHIP_ERROR_ACCESS_DENIED);
+        NL_TEST_ASSERT(inSuite,
+                       accessControl.Check(subjectDescriptor, { .cluster = kLevelControlCluster, .endpoint = 1 },
+                                           Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+    }
+
+    entryData.privilege = Privilege::kManage;
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.UpdateEntry(0, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kManage) == CHIP_NO_ERROR);
+
+    entryData.subjects[0] = kOperationalNodeId2;
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.UpdateEntry(nullptr, 1, 0, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+
+    entryData.subjects[0] = kOperationalNodeId1;
+    NL_TEST_ASSERT(inSuite, LoadAccessControl(accessControl, &entryData, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, accessControl.DeleteEntry(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+
+    // The same subject on another fabric gets nothing from the entries of this one.
+    NL_TEST_ASSERT(inSuite, LoadAccessControl(accessControl, &entryData, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   accessControl.Check({ .fabricIndex = 2, .authMode = AuthMode::kCase, .subject = kOperationalNodeId1 },
+                                       requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+
+    NL_TEST_ASSERT(inSuite, accessControl.DeleteAllEntriesForFabric(1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, requestPath, Privilege::kView) == CHIP_ERROR_ACCESS_DENIED);
+}
+
 void TestCreateReadEntry(nlTestSuite * inSuite, void * inContext)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -2235,6 +2302,7 @@ int TestAccessControl()
         NL_TEST_DEF("TestFabricFilteredReadEntry", TestFabricFilteredReadEntry),
         NL_TEST_DEF("TestFabricFilteredCreateEntry", TestFabricFilteredCreateEntry),
         NL_TEST_DEF("TestCheck", TestCheck),
+        NL_TEST_DEF("TestCheckAfterEntryChanges", TestCheckAfterEntryChanges),
         NL_TEST_SENTINEL()
     };
     // clang-format on
@@ -24,7 +24,6 @@
 #include "system/TLVPacketBufferBackingStore.h"
 #include <app/BufferedReadCallback.h>
 #include <app/InteractionModelEngine.h>
-#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace app {
@@ -46,93 +45,102 @@ void BufferedReadCallback::OnReportEnd()
     mCallback.OnReportEnd();
 }
 
-CHIP_ERROR BufferedReadCallback::GenerateListTLV(TLV::ScopedBufferTLVReader & aReader)
+namespace {
+
+//
+// The reconstituted list is an anonymous TLV array: the control octet that starts it, followed by the buffered
+// items, followed by an end of container marker.
+//
+constexpr uint8_t kListStartControlOctet =
+    static_cast<uint8_t>(TLV::TLVTagControl::Anonymous) | static_cast<uint8_t>(TLV::kTLVType_Array);
+constexpr uint8_t kListEndControlOctet = static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer);
+constexpr uint16_t kListEndSize        = sizeof(kListEndControlOctet);
+
+void AppendControlOctet(System::PacketBufferHandle & buffer, uint8_t controlOctet)
 {
-    TLV::TLVType outerType;
-    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    buffer->Start()[buffer->DataLength()] = controlOctet;
+    buffer->SetDataLength(static_cast<uint16_t>(buffer->DataLength() + sizeof(controlOctet)));
+}
 
+} // namespace
+
+CHIP_ERROR BufferedReadCallback::GenerateListTLV(System::ChainedPacketBufferTLVReader & aReader)
+{
     //
-    // To generate the final reconstituted list, we need to allocate a contiguous
-    // buffer than can hold the entirety of its contents. To do so, we need to figure out
-    // how big a buffer to allocate. This requires walking the buffered list items and computing their TLV sizes,
-    // summing them all up and adding a bit of slop to account for the TLV array the list elements will go into.
-    //
-    // The alternative was to use a PacketBufferTLVWriter backed by chained packet buffers to
-    // write out the list - this would have removed the need for this first pass. However,
-    // we cannot actually back a TLVReader with a chained buffer since that violates the ability
-    // for us to create readers off-of readers. Each reader would assume exclusive ownership of the chained
-    // buffer and mutate the state within TLVPacketBufferBackingStore, preventing shared use.
-    //
-    // To avoid that, a single contiguous buffer is the best likely approach for now.
+    // The list items were buffered into packet buffers that already hold the encoding of the list, each item within
+    // one buffer, so the list is delivered by chaining those buffers rather than copying them into a contiguous
+    // buffer. Space for the end of container marker is reserved in every buffer.
     //
-    uint32_t totalBufSize = 0;
-    for (const auto & packetBuffer : mBufferedList)
+    if (mBufferedList.empty())
     {
-        totalBufSize += packetBuffer->TotalLength();
+        ReturnErrorOnFailure(AllocateListBuffer());
     }
 
-    //
-    // Size of the start container and end container are just 1 byte each, but, let's just be safe.
-    //
-    totalBufSize += 4;
-
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    AppendControlOctet(mBufferedList.back(), kListEndControlOctet);
 
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
-    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerType));
-
-    for (auto & bufHandle : mBufferedList)
+    System::PacketBufferHandle list = std::move(mBufferedList.front());
+    for (size_t i = 1; i < mBufferedList.size(); i++)
     {
-        System::PacketBufferTLVReader reader;
+        list->AddToEnd(std::move(mBufferedList[i]));
+    }
+    mBufferedList.clear();
+
+    return aReader.Init(std::move(list));
+}
 
-        reader.Init(std::move(bufHandle));
+CHIP_ERROR BufferedReadCallback::AllocateListBuffer()
+{
+    //
+    // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
+    // data received over the wire, any single list item should always fit within that), and
+    // pack as many list items into it as fit.
+    //
+    System::PacketBufferHandle handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes, 0);
+    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
 
-        ReturnErrorOnFailure(reader.Next());
-        ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    if (mBufferedList.empty())
+    {
+        AppendControlOctet(handle, kListStartControlOctet);
     }
 
-    ReturnErrorOnFailure(writer.EndContainer(outerType));
+    mBufferedList.push_back(std::move(handle));
+    return CHIP_NO_ERROR;
+}
 
-    writer.Finalize(backingBuffer);
+CHIP_ERROR BufferedReadCallback::CopyListItem(System::PacketBufferHandle & buffer, TLV::TLVReader & reader)
+{
+    TLV::TLVWriter writer;
 
-    aReader.Init(std::move(backingBuffer), totalBufSize);
+    writer.Init(buffer->Start() + buffer->DataLength(), static_cast<uint32_t>(buffer->AvailableDataLength() - kListEndSize));
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    ReturnErrorOnFailure(writer.Finalize());
 
+    buffer->SetDataLength(static_cast<uint16_t>(buffer->DataLength() + writer.GetLengthWritten()));
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR BufferedReadCallback::BufferListItem(TLV::TLVReader & reader)
 {
-    System::PacketBufferTLVWriter writer;
-    System::PacketBufferHandle handle;
+    if (mBufferedList.empty())
+    {
+        ReturnErrorOnFailure(AllocateListBuffer());
+    }
 
     //
-    // We conservatively allocate a packet buffer as big as an IPv6 MTU (since we're buffering
-    // data received over the wire, which should always fit within that).
-    //
-    // We could have snapshotted the reader at its current position, advanced it past the current element
-    // and computed the delta in its read point to figure out the size of the element before allocating
-    // our target buffer. However, the reader's current position is already set past the control octet
-    // and the tag. Consequently, the computed size is always going to omit the sizes of these two parts of the
-    // TLV element. Since the tag can vary in size, for now, let's just do the safe thing. In the future, if this is a problem,
-    // we can improve this.
+    // CopyElement advances the reader past the item even if the copy fails, so keep a reader positioned
+    // at the item to retry with in a new buffer if it does not fit in the remaining space of the last one.
     //
-    handle = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
-    VerifyOrReturnError(!handle.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-    writer.Init(std::move(handle), false);
-
-    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
-    ReturnErrorOnFailure(writer.Finalize(&handle));
-
-    // Compact the buffer down to a more reasonably sized packet buffer
-    // if we can.
-    //
-    handle.RightSize();
+    TLV::TLVReader itemReader;
+    itemReader.Init(reader);
 
-    mBufferedList.push_back(std::move(handle));
+    CHIP_ERROR err = CopyListItem(mBufferedList.back(), reader);
+    if (err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL)
+    {
+        ReturnErrorOnFailure(AllocateListBuffer());
+        err = CopyListItem(mBufferedList.back(), itemReader);
+    }
 
-    return CHIP_NO_ERROR;
+    return err;
 }
 
 CHIP_ERROR BufferedReadCallback::BufferData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData)
@@ -202,7 +210,7 @@ CHIP_ERROR BufferedReadCallback::DispatchBufferedData(const ConcreteAttributePat
     }
 
     StatusIB statusIB;
-    TLV::ScopedBufferTLVReader reader;
+    System::ChainedPacketBufferTLVReader reader;
 
     ReturnErrorOnFailure(GenerateListTLV(reader));
 
@@ -46,7 +46,7 @@ private:
     /*
      * Generates the reconsistuted TLV array from the stored individual list elements
      */
-    CHIP_ERROR GenerateListTLV(TLV::ScopedBufferTLVReader & reader);
+    CHIP_ERROR GenerateListTLV(System::ChainedPacketBufferTLVReader & reader);
 
     /*
      * Dispatch any buffered list data if we need to. Buffered data will only be dispatched if:
@@ -121,14 +121,18 @@ private:
     }
 
     /*
-     * Given a reader positioned at a list element, allocate a packet buffer, copy the list item where
-     * the reader is positioned into that buffer and add it to our buffered list for tracking.
+     * Given a reader positioned at a list element, copy the list item where the reader is positioned into
+     * the last of our buffers, or into a newly allocated one if it does not fit there.
      *
      * This should be called in list index order starting from the lowest index that needs to be buffered.
      *
      */
     CHIP_ERROR BufferListItem(TLV::TLVReader & reader);
+    CHIP_ERROR CopyListItem(System::PacketBufferHandle & buffer, TLV::TLVReader & reader);
+    CHIP_ERROR AllocateListBuffer();
+
     ConcreteDataAttributePath mBufferedPath;
+    // The encoding of the buffered list, split across buffers such that no list item spans two of them.
     std::vector<System::PacketBufferHandle> mBufferedList;
     Callback & mCallback;
 };
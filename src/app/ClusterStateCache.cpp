@@ -19,7 +19,8 @@
 #include "system/SystemPacketBuffer.h"
 #include <app/ClusterStateCache.h>
 #include <app/InteractionModelEngine.h>
-#include <tuple>
+#include <algorithm>
+#include <string.h>
 
 namespace chip {
 namespace app {
@@ -49,18 +50,21 @@ size_t SizeOfStatusIB(const StatusIB & aStatus)
 
 } // anonymous namespace
 
-CHIP_ERROR ClusterStateCache::GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize)
+CHIP_ERROR ClusterStateCache::CopyElementToScratchBuffer(TLV::TLVReader * apData, size_t & aSize)
 {
-    Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
     TLV::TLVReader reader;
     reader.Init(*apData);
     size_t totalBufSize = reader.GetTotalLength();
-    backingBuffer.Calloc(totalBufSize);
-    VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), totalBufSize);
+    if (mScratchBuffer.AllocatedSize() < totalBufSize)
+    {
+        mScratchBuffer.Alloc(totalBufSize);
+        VerifyOrReturnError(mScratchBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+    TLV::TLVWriter writer;
+    writer.Init(mScratchBuffer.Get(), mScratchBuffer.AllocatedSize());
     ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), reader));
+    ReturnErrorOnFailure(writer.Finalize());
     aSize = writer.GetLengthWritten();
-    ReturnErrorOnFailure(writer.Finalize(backingBuffer));
     return CHIP_NO_ERROR;
 }
 
@@ -70,7 +74,7 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
     AttributeState state;
     bool endpointIsNew = false;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
+    if (mCache.Find(aPath.mEndpointId) == nullptr)
     {
         //
         // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
@@ -83,16 +87,14 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
     if (apData)
     {
         size_t elementSize = 0;
-        ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
+        ReturnErrorOnFailure(CopyElementToScratchBuffer(apData, elementSize));
 
         if (mCacheData)
         {
             Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
-            backingBuffer.Calloc(elementSize);
+            backingBuffer.Alloc(elementSize);
             VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
-            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
-            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), *apData));
-            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+            memcpy(backingBuffer.Get(), mScratchBuffer.Get(), elementSize);
 
             state.Set<AttributeData>(std::move(backingBuffer));
         }
@@ -155,7 +157,7 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
 
     if (mCacheData)
     {
-        mChangedAttributeSet.insert(aPath);
+        mChangedAttributes.push_back(aPath);
     }
 
     return CHIP_NO_ERROR;
@@ -211,7 +213,7 @@ CHIP_ERROR ClusterStateCache::UpdateEventCache(const EventHeader & aEventHeader,
 void ClusterStateCache::OnReportBegin()
 {
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    mChangedAttributeSet.clear();
+    mChangedAttributes.clear();
     mAddedEndpoints.clear();
     mCallback.OnReportBegin();
 }
@@ -235,21 +237,28 @@ void ClusterStateCache::OnReportEnd()
 {
     CommitPendingDataVersion();
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
-    std::set<std::tuple<EndpointId, ClusterId>> changedClusters;
+    mScratchBuffer.Free();
 
     //
-    // Add the EndpointId and ClusterId into a set so that we only
-    // convey unique combinations in the subsequent OnClusterChanged callback.
+    // Sort the changed paths and drop duplicates, so that each path is conveyed once and the paths of a cluster are
+    // adjacent, letting us convey each changed cluster once in the subsequent OnClusterChanged callback.
     //
-    for (auto & path : mChangedAttributeSet)
+    std::sort(mChangedAttributes.begin(), mChangedAttributes.end());
+    mChangedAttributes.erase(std::unique(mChangedAttributes.begin(), mChangedAttributes.end()), mChangedAttributes.end());
+
+    for (auto & path : mChangedAttributes)
     {
         mCallback.OnAttributeChanged(this, path);
-        changedClusters.insert(std::make_tuple(path.mEndpointId, path.mClusterId));
     }
 
-    for (auto & item : changedClusters)
+    for (size_t i = 0; i < mChangedAttributes.size(); i++)
     {
-        mCallback.OnClusterChanged(this, std::get<0>(item), std::get<1>(item));
+        const auto & path = mChangedAttributes[i];
+        if (i == 0 || path.mEndpointId != mChangedAttributes[i - 1].mEndpointId ||
+            path.mClusterId != mChangedAttributes[i - 1].mClusterId)
+        {
+            mCallback.OnClusterChanged(this, path.mEndpointId, path.mClusterId);
+        }
     }
 
     for (auto endpoint : mAddedEndpoints)
@@ -297,15 +306,15 @@ CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & read
 
 const ClusterStateCache::EndpointState * ClusterStateCache::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
 {
-    auto endpointIter = mCache.find(endpointId);
-    if (endpointIter == mCache.end())
+    auto endpointState = mCache.Find(endpointId);
+    if (endpointState == nullptr)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &endpointIter->second;
+    return endpointState;
 }
 
 const ClusterStateCache::ClusterState * ClusterStateCache::GetClusterState(EndpointId endpointId, ClusterId clusterId,
@@ -317,15 +326,15 @@ const ClusterStateCache::ClusterState * ClusterStateCache::GetClusterState(Endpo
         return nullptr;
     }
 
-    auto clusterState = endpointState->find(clusterId);
-    if (clusterState == endpointState->end())
+    auto clusterState = endpointState->Find(clusterId);
+    if (clusterState == nullptr)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &clusterState->second;
+    return clusterState;
 }
 
 const ClusterStateCache::AttributeState * ClusterStateCache::GetAttributeState(EndpointId endpointId, ClusterId clusterId,
@@ -337,15 +346,15 @@ const ClusterStateCache::AttributeState * ClusterStateCache::GetAttributeState(E
         return nullptr;
     }
 
-    auto attributeState = clusterState->mAttributes.find(attributeId);
-    if (attributeState == clusterState->mAttributes.end())
+    auto attributeState = clusterState->mAttributes.Find(attributeId);
+    if (attributeState == nullptr)
     {
         err = CHIP_ERROR_KEY_NOT_FOUND;
         return nullptr;
     }
 
     err = CHIP_NO_ERROR;
-    return &attributeState->second;
+    return attributeState;
 }
 
 const ClusterStateCache::EventData * ClusterStateCache::GetEventData(EventNumber eventNumber, CHIP_ERROR & err) const
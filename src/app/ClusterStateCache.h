@@ -27,7 +27,9 @@
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/Variant.h>
+#include <algorithm>
 #include <list>
 #include <map>
 #include <queue>
@@ -429,10 +431,10 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        auto endpointState = mCache.Find(endpointId);
+        if (endpointState != nullptr)
         {
-            for (auto & clusterIter : endpointIter->second)
+            for (auto & clusterIter : *endpointState)
             {
                 ReturnErrorOnFailure(func(clusterIter.first));
             }
@@ -526,6 +528,70 @@ public:
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
 private:
+    /*
+     * A map stored as a vector of (key, value) entries sorted by key.
+     *
+     * A node has few endpoints, an endpoint few clusters and a cluster few attributes, so a flat vector costs far less memory
+     * and is faster to search and walk than a node-based std::map. Reports list paths in increasing order, so new entries
+     * are usually appended at the end.
+     *
+     * Inserting an entry moves the entries after it, so pointers to values are only valid until the next insertion.
+     */
+    template <typename Key, typename Value>
+    class SortedVectorMap
+    {
+    public:
+        struct Entry
+        {
+            explicit Entry(Key key) : first(key) {}
+            Entry(Entry && other) noexcept : first(other.first), second(std::move(other.second)) {}
+            Entry & operator=(Entry && other) noexcept
+            {
+                first  = other.first;
+                second = std::move(other.second);
+                return *this;
+            }
+
+            Key first;
+            Value second;
+        };
+
+        typename std::vector<Entry>::const_iterator begin() const { return mEntries.begin(); }
+        typename std::vector<Entry>::const_iterator end() const { return mEntries.end(); }
+
+        const Value * Find(Key key) const
+        {
+            auto iter = LowerBound(key);
+            return (iter != mEntries.end() && iter->first == key) ? &iter->second : nullptr;
+        }
+
+        // Get the value for key, inserting a default-constructed one if there is none.
+        Value & operator[](Key key)
+        {
+            if (mEntries.empty() || mEntries.back().first < key)
+            {
+                mEntries.emplace_back(key);
+                return mEntries.back().second;
+            }
+
+            auto iter = mEntries.begin() + (LowerBound(key) - mEntries.cbegin());
+            if (iter->first != key)
+            {
+                iter = mEntries.emplace(iter, key);
+            }
+            return iter->second;
+        }
+
+    private:
+        typename std::vector<Entry>::const_iterator LowerBound(Key key) const
+        {
+            return std::lower_bound(mEntries.begin(), mEntries.end(), key,
+                                    [](const Entry & entry, Key aKey) { return entry.first < aKey; });
+        }
+
+        std::vector<Entry> mEntries;
+    };
+
     // An attribute state can be one of three things:
     // * If we got a path-specific error for the attribute, the corresponding
     //   status.
@@ -543,12 +609,12 @@ private:
     // and we must not be in the middle of receiving reports for that cluster.
     struct ClusterState
     {
-        std::map<AttributeId, AttributeState> mAttributes;
+        SortedVectorMap<AttributeId, AttributeState> mAttributes;
         Optional<DataVersion> mPendingDataVersion;
         Optional<DataVersion> mCommittedDataVersion;
     };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using EndpointState = SortedVectorMap<ClusterId, ClusterState>;
+    using NodeState     = SortedVectorMap<EndpointId, EndpointState>;
 
     struct Comparator
     {
@@ -659,11 +725,13 @@ private:
     // on the wire if not all filters can be applied.
     void GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const;
 
-    CHIP_ERROR GetElementTLVSize(TLV::TLVReader * apData, size_t & aSize);
+    // Copy the element apData is positioned on, with an anonymous tag, into mScratchBuffer and return its size.
+    CHIP_ERROR CopyElementToScratchBuffer(TLV::TLVReader * apData, size_t & aSize);
 
     Callback & mCallback;
     NodeState mCache;
-    std::set<ConcreteAttributePath> mChangedAttributeSet;
+    // Paths changed by the current report. May hold duplicates until sorted in OnReportEnd().
+    std::vector<ConcreteAttributePath> mChangedAttributes;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
 
@@ -673,6 +741,8 @@ private:
     BufferedReadCallback mBufferedReader;
     ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     const bool mCacheData                   = true;
+    // Reused for every attribute of a report, so that storing a value takes a single exactly-sized allocation.
+    Platform::ScopedMemoryBufferWithSize<uint8_t> mScratchBuffer;
 };
 
 };     // namespace app
@@ -152,6 +152,7 @@ struct EventLoadOutContext
     Timestamp mPreviousTime;
     Timestamp mCurrentTime;
     EventNumber mCurrentEventNumber                            = 0;
+    EventNumber mEndingEventNumber                             = UINT64_MAX;
     size_t mEventCount                                         = 0;
     const ObjectList<EventPathParams> * mpInterestedEventPaths = nullptr;
     bool mFirst                                                = true;
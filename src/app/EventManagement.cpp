@@ -19,9 +19,13 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <app/PersistentEventLog.h>
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
 #include <assert.h>
 #include <inttypes.h>
 #include <lib/core/TLVUtilities.h>
@@ -57,6 +61,45 @@ public:
     virtual ~CircularEventReader() = default;
 };
 
+/**
+ * @brief
+ *   A TLVBackingStore for reading a run of events of a CircularEventBuffer
+ *
+ * Unlike CircularEventReader, reading starts past the head of the buffer,
+ * and does not go on to the previous CircularEventBuffer.
+ */
+class CircularEventRunStore : public TLV::TLVBackingStore
+{
+public:
+    /**
+     * @param[in] aBuffer  The buffer to read.
+     * @param[in] aRun     The run of events of aBuffer to read.
+     */
+    CircularEventRunStore(CircularEventBuffer & aBuffer, const CircularEventBuffer::EventRun & aRun) :
+        mBuffer(aBuffer), mOffset(aRun.mOffset), mLength(aRun.mLength)
+    {}
+
+    CHIP_ERROR OnInit(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
+    CHIP_ERROR GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        return mBuffer.GetNextBuffer(aReader, aBufStart, aBufLen);
+    }
+    CHIP_ERROR OnInit(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & aWriter, uint8_t *& aBufStart, uint32_t & aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & aWriter, uint8_t * aBufStart, uint32_t aBufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    CircularEventBuffer & mBuffer;
+    uint32_t mOffset;
+    uint32_t mLength;
+};
+
 EventManagement & EventManagement::GetInstance()
 {
     return sInstance;
@@ -66,6 +109,8 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventNumber mEventNumber            = 0; // The event at the head of mpEventBuffer, to update the buffer indexes
+    ClusterId mClusterId                = 0;
 };
 
 /**
@@ -83,7 +128,7 @@ struct CopyAndAdjustDeltaTimeContext
 void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint32_t aNumBuffers,
                            CircularEventBuffer * apCircularEventBuffer, const LogStorageResources * const apLogStorageResources,
                            MonotonicallyIncreasingCounter<EventNumber> * apEventNumberCounter,
-                           System::Clock::Milliseconds64 aMonotonicStartupTime)
+                           System::Clock::Milliseconds64 aMonotonicStartupTime, PersistentEventLog * apPersistentEventLog)
 {
     CircularEventBuffer * current = nullptr;
     CircularEventBuffer * prev    = nullptr;
@@ -119,6 +164,22 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mpEventNumberCounter = apEventNumberCounter;
     mLastEventNumber     = mpEventNumberCounter->GetValue();
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    mpPersistentEventLog = apPersistentEventLog;
+    if (mpPersistentEventLog != nullptr && !mpPersistentEventLog->IsEmpty() &&
+        mpPersistentEventLog->GetLastEventNumber() >= mLastEventNumber)
+    {
+        // The event number counter went back, e.g. because its storage was reset: the persisted events would clash with
+        // the new ones.
+        ChipLogError(EventLogging, "Clearing the persistent event log, its events are newer than event 0x" ChipLogFormatX64,
+                     ChipLogValueX64(mLastEventNumber));
+        mpPersistentEventLog->Clear();
+    }
+#else
+    VerifyOrDo(apPersistentEventLog == nullptr,
+               ChipLogError(EventLogging, "The persistent event log requires CHIP_CONFIG_PERSISTENT_EVENT_LOG"));
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
     mpEventBuffer = apCircularEventBuffer;
     mState        = EventManagementStates::Idle;
     mBytesWritten = 0;
@@ -200,6 +261,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                eventBuffer->UnindexEvent(ctx.mEventNumber);
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -217,8 +282,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    CircularEventBuffer * nextBuffer = eventBuffer->GetNextCircularEventBuffer();
+                    const uint32_t nextOffset        = nextBuffer->GetTailOffset();
+                    err                              = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
+                    nextBuffer->IndexEvent(ctx.mEventNumber, ctx.mClusterId, nextOffset);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
                     err                                 = eventBuffer->EvictHead();
@@ -228,6 +296,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->UnindexEvent(ctx.mEventNumber);
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -341,11 +410,12 @@ void EventManagement::CreateEventManagement(Messaging::ExchangeManager * apExcha
                                             CircularEventBuffer * apCircularEventBuffer,
                                             const LogStorageResources * const apLogStorageResources,
                                             MonotonicallyIncreasingCounter<EventNumber> * apEventNumberCounter,
-                                            System::Clock::Milliseconds64 aMonotonicStartupTime)
+                                            System::Clock::Milliseconds64 aMonotonicStartupTime,
+                                            PersistentEventLog * apPersistentEventLog)
 {
 
     sInstance.Init(apExchangeManager, aNumBuffers, apCircularEventBuffer, apLogStorageResources, apEventNumberCounter,
-                   aMonotonicStartupTime);
+                   aMonotonicStartupTime, apPersistentEventLog);
 }
 
 /**
@@ -353,9 +423,10 @@ void EventManagement::CreateEventManagement(Messaging::ExchangeManager * apExcha
  */
 void EventManagement::DestroyEventManagement()
 {
-    sInstance.mState        = EventManagementStates::Shutdown;
-    sInstance.mpEventBuffer = nullptr;
-    sInstance.mpExchangeMgr = nullptr;
+    sInstance.mState               = EventManagementStates::Shutdown;
+    sInstance.mpEventBuffer        = nullptr;
+    sInstance.mpExchangeMgr        = nullptr;
+    sInstance.mpPersistentEventLog = nullptr;
 }
 
 CircularEventBuffer * EventManagement::GetPriorityBuffer(PriorityLevel aPriority) const
@@ -380,14 +451,17 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    // Events of the persistent event log may come from before a restart, with system timestamps that are not ordered, so
+    // only a non-negative delta can be used.
+    const bool useDelta = !(ctx->mpContext->mFirst) &&
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue);
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && useDelta)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && useDelta)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
@@ -424,6 +498,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     CircularTLVWriter writer;
     CHIP_ERROR err               = CHIP_NO_ERROR;
     uint32_t requestSize         = 0;
+    uint32_t eventOffset         = 0;
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
@@ -464,11 +539,22 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     // Ensure we have space in the in-memory logging queues
     err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
     SuccessOrExit(err);
+    eventOffset = mpEventBuffer->GetTailOffset();
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    if (mpPersistentEventLog != nullptr)
+    {
+        err = ConstructPersistentEvent(apDelegate, &opts, requestSize, writer);
+    }
+    else
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    {
+        err = ConstructEvent(&ctxt, apDelegate, &opts);
+    }
     SuccessOrExit(err);
 
     mBytesWritten += writer.GetLengthWritten();
+    mpEventBuffer->IndexEvent(mLastEventNumber, opts.mPath.mClusterId, eventOffset);
 
 exit:
     if (err != CHIP_NO_ERROR)
@@ -496,6 +582,30 @@ exit:
     return err;
 }
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+CHIP_ERROR EventManagement::ConstructPersistentEvent(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
+                                                     uint32_t aRequiredSpace, TLVWriter & aBufferWriter)
+{
+    MutableByteSpan space;
+    ReturnErrorOnFailure(mpPersistentEventLog->PrepareAppend(aRequiredSpace, space));
+
+    TLVWriter logWriter;
+    logWriter.Init(space);
+    EventLoadOutContext ctxt = EventLoadOutContext(logWriter, apOptions->mPriority, mLastEventNumber);
+    ctxt.mCurrentEventNumber = mLastEventNumber;
+    ReturnErrorOnFailure(ConstructEvent(&ctxt, apDelegate, apOptions));
+
+    // The circular buffer gets a copy of the event rather than calling the delegate once more.
+    TLVReader reader;
+    reader.Init(space.data(), logWriter.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(aBufferWriter.CopyElement(reader));
+    ReturnErrorOnFailure(aBufferWriter.Finalize());
+
+    return mpPersistentEventLog->CommitAppend(mLastEventNumber, logWriter.GetLengthWritten());
+}
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
 CHIP_ERROR EventManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * apContext)
 {
     TLVReader reader;
@@ -532,6 +642,11 @@ CHIP_ERROR EventManagement::CheckEventContext(EventLoadOutContext * eventLoadOut
         return CHIP_ERROR_UNEXPECTED_EVENT;
     }
 
+    if (eventLoadOutContext->mCurrentEventNumber >= eventLoadOutContext->mEndingEventNumber)
+    {
+        return CHIP_END_OF_TLV;
+    }
+
     if (event.mFabricIndex.HasValue() &&
         (event.mFabricIndex.Value() == kUndefinedFabricIndex ||
          eventLoadOutContext->mSubjectDescriptor.fabricIndex != event.mFabricIndex.Value()))
@@ -639,29 +754,107 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
     return err;
 }
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+CHIP_ERROR EventManagement::CopyPersistentEventsSince(EventLoadOutContext * apContext)
+{
+    // The events before the starting one are skipped without being read, as if they had all been read.
+    if (apContext->mStartingEventNumber > 0)
+    {
+        apContext->mCurrentEventNumber = std::max(apContext->mCurrentEventNumber, apContext->mStartingEventNumber - 1);
+    }
+
+    CHIP_ERROR err                        = CHIP_NO_ERROR;
+    PersistentEventLog::Iterator iterator = mpPersistentEventLog->IterateSince(apContext->mStartingEventNumber);
+    while (err == CHIP_NO_ERROR && iterator.Next())
+    {
+        TLVReader reader;
+        reader.Init(iterator.GetEvent());
+        err = reader.Next();
+        if (err == CHIP_NO_ERROR)
+        {
+            err = CopyEventsSince(reader, 0, apContext);
+        }
+    }
+    return err;
+}
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
+CHIP_ERROR EventManagement::CopyIndexedEventsSince(EventLoadOutContext * apContext)
+{
+    uint32_t clusterMask = 0;
+    for (auto * interestedPath = apContext->mpInterestedEventPaths; interestedPath != nullptr;
+         interestedPath        = interestedPath->mpNext)
+    {
+        const EventPathParams & path = interestedPath->mValue;
+        clusterMask |= path.HasWildcardClusterId() ? UINT32_MAX : CircularEventBuffer::GetClusterMask(path.mClusterId);
+    }
+
+    // Events are in event number order from the head of the most critical buffer to the tail of the least critical one,
+    // since they only move to the tail of the next buffer once they are evicted from the head of the previous one.
+    for (CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer                       = buffer->GetPreviousCircularEventBuffer())
+    {
+        CircularEventBuffer::EventRun run;
+        for (size_t runIndex = 0; buffer->GetEventRun(runIndex, run); runIndex++)
+        {
+            if (run.mLength == 0)
+            {
+                continue;
+            }
+            if (run.mLastEventNumber < apContext->mStartingEventNumber || (run.mClusterMask & clusterMask) == 0)
+            {
+                // Skip the run, as if all its events had been read.
+                apContext->mCurrentEventNumber = std::max(apContext->mCurrentEventNumber, run.mLastEventNumber);
+                continue;
+            }
+
+            CircularEventRunStore runStore(*buffer, run);
+            TLVReader reader;
+            ReturnErrorOnFailure(reader.Init(runStore, run.mLength));
+            CHIP_ERROR err = TLV::Utilities::Iterate(reader, CopyEventsSince, apContext, false /*recurse*/);
+            VerifyOrReturnError(err == CHIP_END_OF_TLV || err == CHIP_NO_ERROR, err);
+            VerifyOrReturnError(apContext->mCurrentEventNumber < apContext->mEndingEventNumber, CHIP_NO_ERROR);
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const ObjectList<EventPathParams> * apEventPathList,
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
 {
-    // TODO: Add particular set of event Paths in FetchEventsSince so that we can filter the interested paths
-    CHIP_ERROR err     = CHIP_NO_ERROR;
-    const bool recurse = false;
-    TLVReader reader;
-    CircularEventBufferWrapper bufWrapper;
+    CHIP_ERROR err = CHIP_NO_ERROR;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
-    SuccessOrExit(err);
-
-    err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    if (mpPersistentEventLog != nullptr)
+    {
+        // The persistent log drops its oldest events whatever their priority, while the buffers keep the more critical
+        // ones for longer: the events that the log no longer has are fetched from the buffers first.
+        context.mEndingEventNumber =
+            mpPersistentEventLog->IsEmpty() ? mLastEventNumber : mpPersistentEventLog->GetFirstEventNumber();
+        if (context.mStartingEventNumber < context.mEndingEventNumber)
+        {
+            err = CopyIndexedEventsSince(&context);
+        }
+        context.mEndingEventNumber = UINT64_MAX;
+        if (err == CHIP_NO_ERROR)
+        {
+            err = CopyPersistentEventsSince(&context);
+        }
+    }
+    else
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    {
+        err = CopyIndexedEventsSince(&context);
+    }
     if (err == CHIP_END_OF_TLV)
     {
         err = CHIP_NO_ERROR;
     }
 
-exit:
     if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
     {
         // We failed to fetch the current event because the buffer is too small, we will start from this one the next time.
@@ -703,7 +896,12 @@ CHIP_ERROR EventManagement::FabricRemovedCB(const TLV::TLVReader & aReader, size
                 // we cannot get the actual encoding size from current container beginning to the fabric index because of several
                 // optional parameters, so we are assuming minimal encoding is used and the fabric index is 1 byte.
                 uint8_t * dataPtr;
-                if (event.GetReadPoint() != readBuffer->GetQueue())
+                if (readBuffer == nullptr)
+                {
+                    // An event of the persistent event log, which is contiguous and writable.
+                    dataPtr = const_cast<uint8_t *>(event.GetReadPoint() - 1);
+                }
+                else if (event.GetReadPoint() != readBuffer->GetQueue())
                 {
                     dataPtr = readBuffer->GetQueue() + (event.GetReadPoint() - readBuffer->GetQueue() - 1);
                 }
@@ -732,6 +930,24 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     {
         err = CHIP_NO_ERROR;
     }
+
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    if (mpPersistentEventLog != nullptr)
+    {
+        PersistentEventLog::Iterator iterator = mpPersistentEventLog->IterateSince(0);
+        while (err == CHIP_NO_ERROR && iterator.Next())
+        {
+            TLVReader eventReader;
+            eventReader.Init(iterator.GetEvent());
+            err = eventReader.Next();
+            if (err == CHIP_NO_ERROR)
+            {
+                err = FabricRemovedCB(eventReader, 0, &aFabricIndex);
+                iterator.CommitEventChange();
+            }
+        }
+    }
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
     return err;
 }
 
@@ -828,6 +1044,8 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
+    ctx->mEventNumber                       = context.mEventNumber;
+    ctx->mClusterId                         = context.mClusterId;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
         ChipLogProgress(EventLogging,
@@ -854,9 +1072,85 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev           = apPrev;
+    mpNext           = apNext;
+    mPriority        = aPriorityLevel;
+    mIndexStart      = 0;
+    mIndexCount      = 0;
+    mHeadClusterMask = 0;
+    mLastEventNumber = 0;
+}
+
+void CircularEventBuffer::IndexEvent(EventNumber aEventNumber, ClusterId aClusterId, uint32_t aOffset)
+{
+    mLastEventNumber = aEventNumber;
+
+    // Entries are roughly evenly spread over the buffer, so that the ring of entries does not fill up before the events
+    // of the oldest entry are evicted.
+    if (mIndexCount > 0)
+    {
+        IndexEntry & lastEntry = mIndex[(mIndexStart + mIndexCount - 1) % kIndexSize];
+        if (GetOffsetFromHead(aOffset) - GetOffsetFromHead(lastEntry.mOffset) < GetTotalDataLength() / kIndexSize)
+        {
+            lastEntry.mClusterMask |= GetClusterMask(aClusterId);
+            return;
+        }
+    }
+
+    if (mIndexCount == kIndexSize)
+    {
+        // The run of the oldest entry becomes part of the run at the head of the buffer.
+        mHeadClusterMask |= mIndex[mIndexStart].mClusterMask;
+        mIndexStart = static_cast<uint8_t>((mIndexStart + 1) % kIndexSize);
+        mIndexCount--;
+    }
+
+    IndexEntry & entry = mIndex[(mIndexStart + mIndexCount) % kIndexSize];
+    entry.mEventNumber = aEventNumber;
+    entry.mOffset      = aOffset;
+    entry.mClusterMask = GetClusterMask(aClusterId);
+    mIndexCount++;
+}
+
+void CircularEventBuffer::UnindexEvent(EventNumber aEventNumber)
+{
+    // The rest of the run of an entry whose first event is evicted is now at the head of the buffer.
+    while (mIndexCount > 0 && mIndex[mIndexStart].mEventNumber <= aEventNumber)
+    {
+        mHeadClusterMask = mIndex[mIndexStart].mClusterMask;
+        mIndexStart      = static_cast<uint8_t>((mIndexStart + 1) % kIndexSize);
+        mIndexCount--;
+    }
+    if (DataLength() == 0)
+    {
+        mHeadClusterMask = 0;
+    }
+}
+
+bool CircularEventBuffer::GetEventRun(size_t aRunIndex, EventRun & aRun) const
+{
+    // The first run goes from the head of the buffer to the oldest entry, and each entry starts a run.
+    VerifyOrReturnValue(DataLength() > 0 && aRunIndex <= mIndexCount, false);
+
+    aRun.mOffset      = (aRunIndex == 0) ? 0 : GetOffsetFromHead(GetIndexEntry(aRunIndex - 1).mOffset);
+    aRun.mClusterMask = (aRunIndex == 0) ? mHeadClusterMask : GetIndexEntry(aRunIndex - 1).mClusterMask;
+    if (aRunIndex < mIndexCount)
+    {
+        aRun.mLength          = GetOffsetFromHead(GetIndexEntry(aRunIndex).mOffset) - aRun.mOffset;
+        aRun.mLastEventNumber = GetIndexEntry(aRunIndex).mEventNumber - 1;
+    }
+    else
+    {
+        aRun.mLength          = DataLength() - aRun.mOffset;
+        aRun.mLastEventNumber = mLastEventNumber;
+    }
+    return true;
+}
+
+uint32_t CircularEventBuffer::GetOffsetFromHead(uint32_t aOffset) const
+{
+    const uint32_t headOffset = static_cast<uint32_t>(QueueHead() - GetQueue());
+    return (aOffset + GetTotalDataLength() - headOffset) % GetTotalDataLength();
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -893,6 +1187,24 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
     }
 }
 
+CHIP_ERROR CircularEventRunStore::OnInit(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
+{
+    uint32_t offset = mOffset;
+    aBufStart       = nullptr;
+    ReturnErrorOnFailure(mBuffer.GetNextBuffer(aReader, aBufStart, aBufLen));
+    if (offset >= aBufLen)
+    {
+        // The run starts after the data wraps around the end of the buffer storage.
+        offset -= aBufLen;
+        aBufStart += aBufLen;
+        ReturnErrorOnFailure(mBuffer.GetNextBuffer(aReader, aBufStart, aBufLen));
+        VerifyOrReturnError(offset <= aBufLen, CHIP_ERROR_INTERNAL);
+    }
+    aBufStart += offset;
+    aBufLen = std::min(aBufLen - offset, mLength);
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -29,6 +29,7 @@
 #include "EventLoggingDelegate.h"
 #include "EventLoggingTypes.h"
 #include <access/SubjectDescriptor.h>
+#include <app/AppConfig.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/MessageDef/StatusIB.h>
 #include <app/ObjectList.h>
@@ -59,6 +60,12 @@
  * This means that LogStorageResources at a given priority level are reserved
  * for events of that priority level or higher priority.
  *
+ * When a PersistentEventLog is provided as well, every event is also appended
+ * to it, and events are fetched from it rather than from the buffers, so that
+ * they are still available after a restart.  The persistent log drops its
+ * oldest events when it is full, whatever their priority, so the events that
+ * it has dropped but the buffers still hold are fetched from the buffers.
+ *
  * As a simple example, assume there are only two priority levels, DEBUG and
  * CRITICAL, and two LogStorageResources with those priorities.  In that case,
  * old CRITICAL events will not start getting dropped until both buffers are
@@ -128,9 +135,78 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   A run of consecutive events of the buffer, as tracked by its index.
+     */
+    struct EventRun
+    {
+        uint32_t mOffset             = 0; ///< Offset of the first event of the run from the head of the buffer
+        uint32_t mLength             = 0; ///< Number of bytes of the events of the run
+        EventNumber mLastEventNumber = 0; ///< No event of the run has a greater event number
+        uint32_t mClusterMask        = 0; ///< Union of the GetClusterMask() of the events of the run
+    };
+
+    /**
+     * @brief
+     *   Record an event that was just written to the tail of the buffer in the index.
+     *
+     * @param[in] aEventNumber  The number of the event.
+     * @param[in] aClusterId    The cluster of the event.
+     * @param[in] aOffset       The offset of the event from the start of the buffer storage.
+     */
+    void IndexEvent(EventNumber aEventNumber, ClusterId aClusterId, uint32_t aOffset);
+
+    /**
+     * @brief
+     *   Update the index once the event aEventNumber was evicted from the head of the buffer.
+     */
+    void UnindexEvent(EventNumber aEventNumber);
+
+    /**
+     * @brief
+     *   Get the aRunIndex-th run of events of the buffer, starting from its head.
+     *
+     * The runs of a buffer hold its events in order, and the event numbers of the events
+     * of a run are greater than those of the events of the previous runs.
+     *
+     * @retval true/false whether the buffer has such a run
+     */
+    bool GetEventRun(size_t aRunIndex, EventRun & aRun) const;
+
+    /**
+     * @brief
+     *   The offset of the tail of the buffer, i.e. of the next event written, from the start of
+     *   the buffer storage.
+     */
+    uint32_t GetTailOffset() const { return static_cast<uint32_t>(QueueTail() - GetQueue()); }
+
+    /**
+     * @brief
+     *   A mask with the bit for aClusterId set, for EventRun::mClusterMask.
+     */
+    static constexpr uint32_t GetClusterMask(ClusterId aClusterId)
+    {
+        return static_cast<uint32_t>(1) << ((aClusterId ^ (aClusterId >> 16)) % 32);
+    }
+
     ~CircularEventBuffer() override = default;
 
 private:
+    struct IndexEntry
+    {
+        EventNumber mEventNumber = 0; ///< Number of the first event of the run that starts at this entry
+        uint32_t mOffset         = 0; ///< Offset of that event from the start of the buffer storage
+        uint32_t mClusterMask    = 0; ///< Clusters of the events of the run
+    };
+
+    static_assert(CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0 && CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE <= UINT8_MAX,
+                  "CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE must be between 1 and 255");
+    static constexpr uint8_t kIndexSize = CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE;
+
+    const IndexEntry & GetIndexEntry(size_t aEntryIndex) const { return mIndex[(mIndexStart + aEntryIndex) % kIndexSize]; }
+    uint32_t GetOffsetFromHead(uint32_t aOffset) const;
+
     CircularEventBuffer * mpPrev = nullptr; ///< A pointer CircularEventBuffer storing events less important events
     CircularEventBuffer * mpNext = nullptr; ///< A pointer CircularEventBuffer storing events more important events
 
@@ -139,10 +215,17 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    IndexEntry mIndex[kIndexSize];    ///< Ring of the entries of the index, oldest first
+    uint8_t mIndexStart          = 0; ///< Position of the oldest entry in mIndex
+    uint8_t mIndexCount          = 0; ///< Number of entries in mIndex
+    uint32_t mHeadClusterMask    = 0; ///< Clusters of the events between the head of the buffer and the oldest entry
+    EventNumber mLastEventNumber = 0; ///< Number of the last event written to the buffer
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
 class CircularEventReader;
+class PersistentEventLog;
 
 /**
  * @brief
@@ -224,11 +307,15 @@ public:
      *                                   time 0" for cases when we use
      *                                   system-time event timestamps.
      *
+     * @param[in] apPersistentEventLog   An open PersistentEventLog to also keep
+     *                                   events in, or nullptr.  Requires
+     *                                   CHIP_CONFIG_PERSISTENT_EVENT_LOG.
+     *
      */
     void Init(Messaging::ExchangeManager * apExchangeManager, uint32_t aNumBuffers, CircularEventBuffer * apCircularEventBuffer,
               const LogStorageResources * const apLogStorageResources,
               MonotonicallyIncreasingCounter<EventNumber> * apEventNumberCounter,
-              System::Clock::Milliseconds64 aMonotonicStartupTime);
+              System::Clock::Milliseconds64 aMonotonicStartupTime, PersistentEventLog * apPersistentEventLog = nullptr);
 
     static EventManagement & GetInstance();
 
@@ -256,13 +343,17 @@ public:
      *                                   time 0" for cases when we use
      *                                   system-time event timestamps.
      *
+     * @param[in] apPersistentEventLog   An open PersistentEventLog to also keep
+     *                                   events in, or nullptr.
+     *
      * @note This function must be called prior to the logging being used.
      */
     static void
     CreateEventManagement(Messaging::ExchangeManager * apExchangeManager, uint32_t aNumBuffers,
                           CircularEventBuffer * apCircularEventBuffer, const LogStorageResources * const apLogStorageResources,
                           MonotonicallyIncreasingCounter<EventNumber> * apEventNumberCounter,
-                          System::Clock::Milliseconds64 aMonotonicStartupTime = System::SystemClock().GetMonotonicMilliseconds64());
+                          System::Clock::Milliseconds64 aMonotonicStartupTime = System::SystemClock().GetMonotonicMilliseconds64(),
+                          PersistentEventLog * apPersistentEventLog = nullptr);
 
     static void DestroyEventManagement();
 
@@ -432,6 +523,30 @@ private:
     // Internal function to log event
     CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    /**
+     * @brief Write the event to the persistent event log, then copy it to the circular buffer.
+     *
+     * @param[in] apDelegate     The EventLoggingDelegate to serialize the event data
+     * @param[in] apOptions      EventOptions describing timestamp and other tags relevant to this event.
+     * @param[in] aRequiredSpace The size of the event, as computed by CalculateEventSize.
+     * @param[in] aBufferWriter  The writer of the lowest-priority circular buffer.
+     */
+    CHIP_ERROR ConstructPersistentEvent(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t aRequiredSpace,
+                                        TLV::TLVWriter & aBufferWriter);
+
+    /**
+     * @brief Internal API used to implement #FetchEventsSince from the persistent event log.
+     */
+    CHIP_ERROR CopyPersistentEventsSince(EventLoadOutContext * apContext);
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
+    /**
+     * @brief Internal API used to implement #FetchEventsSince from the circular buffers.  The indexes of the buffers are
+     * used to skip the runs of events before the starting event, and those of clusters that no interested path matches.
+     */
+    CHIP_ERROR CopyIndexedEventsSince(EventLoadOutContext * apContext);
+
     /**
      * @brief copy the event outright to next buffer with higher priority
      *
@@ -554,6 +669,9 @@ private:
     // The counter we're going to use for event numbers.
     MonotonicallyIncreasingCounter<EventNumber> * mpEventNumberCounter = nullptr;
 
+    // The log that events are also kept in across restarts, if any.
+    PersistentEventLog * mpPersistentEventLog = nullptr;
+
     EventNumber mLastEventNumber = 0; ///< Last event Number vended
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
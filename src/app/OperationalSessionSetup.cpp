@@ -540,7 +540,7 @@ OperationalSessionSetup::~OperationalSessionSetup()
     DequeueConnectionCallbacks(CHIP_ERROR_CANCELLED, ReleaseBehavior::DoNotRelease);
 }
 
-CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
+CHIP_ERROR OperationalSessionSetup::LookupPeerAddress(bool bypassCache)
 {
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     if (mRemainingAttempts > 0)
@@ -575,6 +575,7 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
     PeerId peerId(fabricInfo->GetCompressedFabricId(), mPeerId.GetNodeId());
 
     NodeLookupRequest request(peerId);
+    request.SetBypassCache(bypassCache);
 
     return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
 }
@@ -748,7 +749,8 @@ void OperationalSessionSetup::TrySetupAgain(System::Layer * systemLayer, void *
     auto * self = static_cast<OperationalSessionSetup *>(state);
 
     self->MoveToState(State::ResolvingAddress);
-    CHIP_ERROR err = self->LookupPeerAddress();
+    // Setting up a session with the previous address failed, and the peer may have moved to another one.
+    CHIP_ERROR err = self->LookupPeerAddress(/* bypassCache = */ true);
     if (err == CHIP_NO_ERROR)
     {
         return;
@@ -386,8 +386,11 @@ private:
 
     /**
      * Triggers a DNSSD lookup to find a usable peer address.
+     *
+     * With [bypassCache], the records of the peer cached by the DNSSD resolver
+     * are not used, e.g. because the address they resolved to did not work.
      */
-    CHIP_ERROR LookupPeerAddress();
+    CHIP_ERROR LookupPeerAddress(bool bypassCache = false);
 
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
@@ -0,0 +1,323 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/PersistentEventLog.h>
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CRC32.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace chip::Encoding;
+
+namespace chip {
+namespace app {
+
+bool PersistentEventLog::Iterator::Next()
+{
+    if (mOffset == mLog.mEnd)
+    {
+        return false;
+    }
+
+    const uint8_t * record = mLog.mpData + mOffset;
+    const uint32_t length  = LittleEndian::Get32(record);
+    mRecordOffset          = mOffset;
+    mEventNumber           = LittleEndian::Get64(record + 4);
+    mEvent                 = MutableByteSpan(mLog.mpData + mOffset + kRecordHeaderSize, length);
+    mOffset                = mLog.NextRecord(mOffset + RecordSize(length));
+    return true;
+}
+
+void PersistentEventLog::Iterator::CommitEventChange()
+{
+    uint8_t * record = mLog.mpData + mRecordOffset;
+    LittleEndian::Put32(record + 12, RecordCrc(record, LittleEndian::Get32(record)));
+}
+
+CHIP_ERROR PersistentEventLog::Open(const char * apPath, uint32_t aCapacity)
+{
+    aCapacity &= ~uint32_t(3);
+    VerifyOrReturnError(!IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apPath != nullptr && aCapacity > kRecordHeaderSize && aCapacity <= UINT32_MAX - kFileHeaderSize,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t mappingSize = kFileHeaderSize + static_cast<size_t>(aCapacity);
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    bool created             = false;
+    void * mapping           = MAP_FAILED;
+    struct stat fileStat;
+
+    int fd = open(apPath, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_POSIX(errno));
+
+    VerifyOrExit(fstat(fd, &fileStat) == 0, err = CHIP_ERROR_POSIX(errno));
+    if (static_cast<size_t>(fileStat.st_size) != mappingSize)
+    {
+        // A new file, or one of a different capacity: start over with a zero-filled one.
+        VerifyOrExit(ftruncate(fd, 0) == 0 && ftruncate(fd, static_cast<off_t>(mappingSize)) == 0,
+                     err = CHIP_ERROR_POSIX(errno));
+        created = true;
+    }
+
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(mapping != MAP_FAILED, err = CHIP_ERROR_POSIX(errno));
+
+    mpMapping    = static_cast<uint8_t *>(mapping);
+    mMappingSize = mappingSize;
+    mpData       = mpMapping + kFileHeaderSize;
+    mCapacity    = aCapacity;
+
+    if (created || !ReadFileHeader())
+    {
+        if (!created)
+        {
+            ChipLogError(EventLogging, "Persistent event log %s is not valid, clearing it", apPath);
+        }
+        mLastEventNumber = 0;
+        WriteFileHeader();
+    }
+    else
+    {
+        Recover();
+    }
+
+exit:
+    // The mapping stays valid once the file is closed.
+    close(fd);
+    return err;
+}
+
+void PersistentEventLog::Close()
+{
+    VerifyOrReturn(IsOpen());
+
+    msync(mpMapping, mMappingSize, MS_SYNC);
+    munmap(mpMapping, mMappingSize);
+    mpMapping        = nullptr;
+    mMappingSize     = 0;
+    mpData           = nullptr;
+    mCapacity        = 0;
+    mStart           = 0;
+    mEnd             = 0;
+    mAppendLength    = 0;
+    mLastEventNumber = 0;
+}
+
+EventNumber PersistentEventLog::GetFirstEventNumber() const
+{
+    return IsEmpty() ? 0 : LittleEndian::Get64(mpData + mStart + 4);
+}
+
+CHIP_ERROR PersistentEventLog::Clear()
+{
+    VerifyOrReturnError(IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+
+    SetOffsets(0, 0);
+    mAppendLength    = 0;
+    mLastEventNumber = 0;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentEventLog::PrepareAppend(size_t aRequiredLength, MutableByteSpan & aSpace)
+{
+    VerifyOrReturnError(IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+    // The log never fills up completely, as its start and end would then be the same, as for an empty log.
+    VerifyOrReturnError(aRequiredLength < mCapacity - kRecordHeaderSize - 3, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    const uint32_t size   = RecordSize(aRequiredLength);
+    uint32_t droppedCount = 0;
+    while (!FindSpace(size, mAppendOffset))
+    {
+        DropOldestEvent();
+        droppedCount++;
+    }
+    if (droppedCount > 0)
+    {
+        ChipLogDetail(EventLogging, "Dropped %" PRIu32 " events from the persistent event log", droppedCount);
+    }
+
+    mAppendLength = aRequiredLength;
+    aSpace        = MutableByteSpan(mpData + mAppendOffset + kRecordHeaderSize, aRequiredLength);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentEventLog::CommitAppend(EventNumber aEventNumber, size_t aLength)
+{
+    VerifyOrReturnError(IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aLength > 0 && aLength <= mAppendLength, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(IsEmpty() || aEventNumber > mLastEventNumber, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t * record = mpData + mAppendOffset;
+    LittleEndian::Put32(record, static_cast<uint32_t>(aLength));
+    LittleEndian::Put64(record + 4, aEventNumber);
+    LittleEndian::Put32(record + 12, RecordCrc(record, static_cast<uint32_t>(aLength)));
+
+    if (mAppendOffset != mEnd && mEnd < mCapacity)
+    {
+        // The record went to the start of the file, so readers of the records before it must go there too.
+        LittleEndian::Put32(mpData + mEnd, kWrapMarker);
+    }
+
+    // The record is complete, so it can now be made part of the log.
+    SetOffsets(mStart, mAppendOffset + RecordSize(aLength));
+    mAppendLength    = 0;
+    mLastEventNumber = aEventNumber;
+    return CHIP_NO_ERROR;
+}
+
+PersistentEventLog::Iterator PersistentEventLog::IterateSince(EventNumber aEventNumber)
+{
+    uint32_t offset = mStart;
+    while (offset != mEnd && LittleEndian::Get64(mpData + offset + 4) < aEventNumber)
+    {
+        offset = NextRecord(offset + RecordSize(LittleEndian::Get32(mpData + offset)));
+    }
+    return Iterator(*this, offset);
+}
+
+uint32_t PersistentEventLog::RecordCrc(const uint8_t * apRecord, uint32_t aLength)
+{
+    return Crc32(apRecord + kRecordHeaderSize, aLength, Crc32(apRecord, 12));
+}
+
+bool PersistentEventLog::ReadFileHeader()
+{
+    VerifyOrReturnValue(LittleEndian::Get32(mpMapping) == kMagic, false);
+    VerifyOrReturnValue(LittleEndian::Get32(mpMapping + 4) == kVersion, false);
+    VerifyOrReturnValue(LittleEndian::Get32(mpMapping + 8) == mCapacity, false);
+
+    const uint64_t offsets = LittleEndian::HostSwap64(__atomic_load_n(reinterpret_cast<uint64_t *>(mpMapping + kOffsetsOffset),
+                                                                      __ATOMIC_ACQUIRE));
+    mStart = static_cast<uint32_t>(offsets);
+    mEnd   = static_cast<uint32_t>(offsets >> 32);
+    return mStart < mCapacity && mEnd <= mCapacity && mStart % 4 == 0 && mEnd % 4 == 0;
+}
+
+void PersistentEventLog::WriteFileHeader()
+{
+    LittleEndian::Put32(mpMapping, kMagic);
+    LittleEndian::Put32(mpMapping + 4, kVersion);
+    LittleEndian::Put32(mpMapping + 8, mCapacity);
+    LittleEndian::Put32(mpMapping + 12, 0);
+    SetOffsets(0, 0);
+}
+
+void PersistentEventLog::SetOffsets(uint32_t aStart, uint32_t aEnd)
+{
+    // A single aligned store, so that the offsets cannot be seen half updated, and after the record writes before it.
+    const uint64_t offsets = LittleEndian::HostSwap64(static_cast<uint64_t>(aEnd) << 32 | aStart);
+    __atomic_store_n(reinterpret_cast<uint64_t *>(mpMapping + kOffsetsOffset), offsets, __ATOMIC_RELEASE);
+    mStart = aStart;
+    mEnd   = aEnd;
+}
+
+uint32_t PersistentEventLog::NextRecord(uint32_t aOffset) const
+{
+    if (aOffset != mEnd && (aOffset == mCapacity || LittleEndian::Get32(mpData + aOffset) == kWrapMarker))
+    {
+        return 0;
+    }
+    return aOffset;
+}
+
+bool PersistentEventLog::FindSpace(uint32_t aSize, uint32_t & aOffset) const
+{
+    if (IsEmpty())
+    {
+        aOffset = 0;
+        return true;
+    }
+    if (mStart < mEnd)
+    {
+        // The records do not wrap: there is space after them, and before them at the start of the file.
+        if (mCapacity - mEnd >= aSize)
+        {
+            aOffset = mEnd;
+            return true;
+        }
+        aOffset = 0;
+        return aSize < mStart;
+    }
+    aOffset = mEnd;
+    return mStart - mEnd > aSize;
+}
+
+void PersistentEventLog::Recover()
+{
+    uint32_t offset             = mStart;
+    EventNumber lastEventNumber = 0;
+
+    while (offset != mEnd)
+    {
+        const uint8_t * record        = mpData + offset;
+        const uint32_t available      = RegionEnd(offset) - offset;
+        const uint32_t length         = available >= kRecordHeaderSize ? LittleEndian::Get32(record) : 0;
+        const EventNumber eventNumber = length > 0 ? LittleEndian::Get64(record + 4) : 0;
+        if (length == 0 || length > available - kRecordHeaderSize ||
+            LittleEndian::Get32(record + 12) != RecordCrc(record, length) || (offset != mStart && eventNumber <= lastEventNumber))
+        {
+            break;
+        }
+        lastEventNumber = eventNumber;
+        offset          = NextRecord(offset + RecordSize(length));
+    }
+
+    if (offset != mEnd)
+    {
+        ChipLogError(EventLogging, "Dropping the incomplete events of the persistent event log from offset %" PRIu32, offset);
+        if (offset == mStart)
+        {
+            SetOffsets(0, 0);
+        }
+        else
+        {
+            SetOffsets(mStart, offset);
+        }
+    }
+    else if (IsEmpty() && mStart != 0)
+    {
+        SetOffsets(0, 0);
+    }
+    mLastEventNumber = lastEventNumber;
+}
+
+void PersistentEventLog::DropOldestEvent()
+{
+    const uint32_t start = NextRecord(mStart + RecordSize(LittleEndian::Get32(mpData + mStart)));
+    if (start == mEnd)
+    {
+        SetOffsets(0, 0);
+        mLastEventNumber = 0;
+    }
+    else
+    {
+        SetOffsets(start, mEnd);
+    }
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,188 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines PersistentEventLog, an append-only log of events in a memory-mapped file, which EventManagement
+ *      can keep its events in across restarts.
+ */
+
+#pragma once
+
+#include <app/EventLoggingTypes.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * An append-only log of events in a memory-mapped file.
+ *
+ * Each record of the log holds an event number, the TLV of the event, as EventManagement writes it to its circular
+ * buffers, and a CRC-32 of both. Records are appended in increasing event number order to a ring: a record that does
+ * not fit before the end of the file is written at its start, and when the log is full, the oldest records are dropped,
+ * whatever their priority, to make room. Records are never moved.
+ *
+ * Records are written in place through the mapping, and the offsets of the first and past-the-last records, which
+ * the file header holds in a single aligned 64-bit word, are only updated once a record is complete. The log therefore
+ * survives a restart or crash of the process. The file is not synced on every append, so after a power loss, the
+ * header may have been written back before some records were: Open() checks the records from the first one, and drops
+ * the first one whose CRC or event number is wrong along with all those after it.
+ */
+class PersistentEventLog
+{
+public:
+    /**
+     * Iterates the events of the log, oldest first. Appending to the log invalidates the iterator.
+     */
+    class Iterator
+    {
+    public:
+        /**
+         * Advance to the next event.
+         *
+         * @return false if there are no more events.
+         */
+        bool Next();
+
+        EventNumber GetEventNumber() const { return mEventNumber; }
+
+        /**
+         * The TLV of the current event. It may be modified in place, e.g. to clear its fabric index, but not resized;
+         * the change must then be committed with CommitEventChange().
+         */
+        MutableByteSpan GetEvent() const { return mEvent; }
+
+        /**
+         * Update the CRC of the current event after its TLV was modified in place.
+         */
+        void CommitEventChange();
+
+    private:
+        friend class PersistentEventLog;
+
+        Iterator(const PersistentEventLog & aLog, uint32_t aOffset) : mLog(aLog), mOffset(aOffset) {}
+
+        const PersistentEventLog & mLog;
+        uint32_t mOffset;
+        uint32_t mRecordOffset   = 0;
+        EventNumber mEventNumber = 0;
+        MutableByteSpan mEvent;
+    };
+
+    PersistentEventLog() = default;
+    ~PersistentEventLog() { Close(); }
+
+    PersistentEventLog(const PersistentEventLog &)             = delete;
+    PersistentEventLog & operator=(const PersistentEventLog &) = delete;
+
+    /**
+     * Open the log in the file at apPath, creating it if needed.
+     *
+     * A file that is not a log of aCapacity bytes, e.g. because the capacity was changed, is cleared.
+     *
+     * @param[in] apPath     The path of the file.
+     * @param[in] aCapacity  The number of bytes of records that the log holds, rounded down to a multiple of 4.
+     */
+    CHIP_ERROR Open(const char * apPath, uint32_t aCapacity = CHIP_DEVICE_CONFIG_PERSISTENT_EVENT_LOG_SIZE);
+
+    /**
+     * Write the log back to its file and unmap it.
+     */
+    void Close();
+
+    bool IsOpen() const { return mpMapping != nullptr; }
+    bool IsEmpty() const { return mStart == mEnd; }
+
+    /**
+     * The number of the oldest event of the log, or 0 if the log is empty.
+     */
+    EventNumber GetFirstEventNumber() const;
+
+    /**
+     * The number of the most recently appended event, or 0 if the log is empty.
+     */
+    EventNumber GetLastEventNumber() const { return mLastEventNumber; }
+
+    /**
+     * Drop all the events of the log.
+     */
+    CHIP_ERROR Clear();
+
+    /**
+     * Get the space to write the TLV of the next event in, dropping the oldest events if needed.
+     *
+     * @param[in]  aRequiredLength  The number of bytes the event needs.
+     * @param[out] aSpace           The space to write the event in, of aRequiredLength bytes.
+     *
+     * @retval CHIP_ERROR_BUFFER_TOO_SMALL if the event does not fit in the log even when it is empty.
+     */
+    CHIP_ERROR PrepareAppend(size_t aRequiredLength, MutableByteSpan & aSpace);
+
+    /**
+     * Append the event written to the space returned by the last PrepareAppend().
+     *
+     * @param[in] aEventNumber  The number of the event, which must be greater than that of the last event.
+     * @param[in] aLength       The number of bytes written.
+     */
+    CHIP_ERROR CommitAppend(EventNumber aEventNumber, size_t aLength);
+
+    /**
+     * Iterate the events with an event number of at least aEventNumber. The events before it are skipped without being
+     * parsed.
+     */
+    Iterator IterateSince(EventNumber aEventNumber);
+
+private:
+    static constexpr uint32_t kMagic            = 0x4C455043; // "CPEL"
+    static constexpr uint32_t kVersion          = 2;
+    static constexpr uint32_t kFileHeaderSize   = 24; // Magic, version, capacity, reserved and offsets of the records.
+    static constexpr uint32_t kOffsetsOffset    = 16; // Offset of the start (low half) and end (high half) of the records.
+    static constexpr uint32_t kRecordHeaderSize = 16; // TLV length, event number and CRC-32.
+    static constexpr uint32_t kWrapMarker       = UINT32_MAX; // TLV length that sends readers back to the start of the file.
+
+    static uint32_t RecordSize(size_t aLength) { return static_cast<uint32_t>((kRecordHeaderSize + aLength + 3) & ~size_t(3)); }
+    static uint32_t RecordCrc(const uint8_t * apRecord, uint32_t aLength);
+
+    bool ReadFileHeader();
+    void WriteFileHeader();
+    void SetOffsets(uint32_t aStart, uint32_t aEnd);
+    uint32_t NextRecord(uint32_t aOffset) const;
+    uint32_t RegionEnd(uint32_t aOffset) const { return (mEnd < mStart && aOffset >= mStart) ? mCapacity : mEnd; }
+    bool FindSpace(uint32_t aSize, uint32_t & aOffset) const;
+    void Recover();
+    void DropOldestEvent();
+
+    uint8_t * mpMapping          = nullptr;
+    size_t mMappingSize          = 0;
+    uint8_t * mpData             = nullptr;
+    uint32_t mCapacity           = 0;
+    uint32_t mStart              = 0;
+    uint32_t mEnd                = 0;
+    uint32_t mAppendOffset       = 0;
+    size_t mAppendLength         = 0;
+    EventNumber mLastEventNumber = 0;
+};
+
+} // namespace app
+} // namespace chip
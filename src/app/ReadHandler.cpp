@@ -109,6 +109,7 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
             return;
         }
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddInterestPaths(*this);
     for (size_t i = 0; i < resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths.AllocatedSize(); i++)
     {
         EventPathParams params = resumptionSessionEstablisher.mSubscriptionInfo.mEventPaths[i].GetParams();
@@ -158,6 +159,7 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RemoveInterestPaths(*this);
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -499,6 +501,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     if (CHIP_END_OF_TLV == err)
     {
         mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
+        mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().AddInterestPaths(*this);
         mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
         err                          = CHIP_NO_ERROR;
     }
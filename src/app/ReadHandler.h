@@ -56,6 +56,10 @@
 inline constexpr uint16_t kSubscriptionMaxIntervalPublisherLimit = 3600; // seconds (60 minutes)
 
 namespace chip {
+namespace benchmarks {
+class ReportingEngineBenchmark;
+} // namespace benchmarks
+
 namespace app {
 
 //
@@ -425,6 +429,7 @@ private:
     friend class TestReadInteraction;
     friend class chip::app::reporting::TestReportingEngine;
     friend class chip::app::reporting::TestReportScheduler;
+    friend class chip::benchmarks::ReportingEngineBenchmark;
 
     //
     // The engine needs to be able to Abort/Close a ReadHandler instance upon completion of work for a given read/subscribe
@@ -56,6 +56,7 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+    mInterestIndex.Clear();
 }
 
 bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
@@ -91,6 +92,75 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool a
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+bool Engine::EncodeSharedAttributeReport(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                         const ConcreteReadAttributePath & aPath)
+{
+    const Access::SubjectDescriptor subjectDescriptor = apReadHandler->GetSubjectDescriptor();
+    const ReportEncodingCache::Key key{ aPath, subjectDescriptor.fabricIndex, apReadHandler->IsFabricFiltered() };
+    DataVersion dataVersion = 0;
+    ByteSpan encodedReports;
+
+    if (mReportEncodingCache.Find(key, dataVersion, encodedReports) && IsClusterDataVersionEqual(aPath, dataVersion))
+    {
+        // The cached reports were read by a subject that was granted access, which says nothing about this one.
+        Access::RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+        Access::Privilege requestPrivilege = RequiredPrivilege::ForReadAttribute(aPath);
+        VerifyOrReturnValue(Access::GetAccessControl().Check(subjectDescriptor, requestPath, requestPrivilege) == CHIP_NO_ERROR,
+                            false);
+    }
+    else
+    {
+        MutableByteSpan freeSpace = mReportEncodingCache.GetFreeSpace();
+        VerifyOrReturnValue(!freeSpace.empty(), false);
+
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder sharedReportIBs;
+        writer.Init(freeSpace);
+        VerifyOrReturnValue(sharedReportIBs.Init(&writer) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(RetrieveClusterData(subjectDescriptor, key.mIsFabricFiltered, sharedReportIBs, aPath, nullptr) ==
+                                CHIP_NO_ERROR,
+                            false);
+        VerifyOrReturnValue(sharedReportIBs.EndOfAttributeReportIBs() == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(writer.Finalize() == CHIP_NO_ERROR, false);
+        encodedReports = ByteSpan(freeSpace.data(), writer.GetLengthWritten());
+
+        // Whatever was encoded is valid for this read handler, but only successfully read values (and not e.g. access denied
+        // statuses) are kept for the other read handlers.
+        (void) mReportEncodingCache.Insert(key, encodedReports.size());
+    }
+
+    TLV::TLVWriter backup;
+    aAttributeReportIBs.Checkpoint(backup);
+    if (ReportEncodingCache::CopyReports(encodedReports, aAttributeReportIBs) != CHIP_NO_ERROR)
+    {
+        // Most likely this report is full; let the caller retrieve the attribute again so that it can be chunked.
+        aAttributeReportIBs.Rollback(backup);
+        return false;
+    }
+    return true;
+}
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+bool Engine::ShouldShareAttributeReports()
+{
+    // Encodings are only shared between the read handlers that report in the same run. With a single one, encoding into the
+    // cache and copying out of it again only adds work.
+    VerifyOrReturnValue(mNumReportsInFlight + 2 <= CHIP_IM_MAX_REPORTS_IN_FLIGHT, false);
+
+    uint32_t numReportable = 0;
+    mpImEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        if (handler->ShouldReportUnscheduled() || mpImEngine->GetReportScheduler()->IsReportableNow(handler))
+        {
+            numReportable++;
+        }
+        return (numReportable < 2) ? Loop::Continue : Loop::Break;
+    });
+    return numReportable >= 2;
+}
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
 static bool IsOutOfWriterSpaceError(CHIP_ERROR err)
 {
     return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
@@ -193,6 +263,15 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeValueEncoder::AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+            // An attribute in the middle of being chunked has to continue from the saved state, so it can not be shared.
+            if (mShareAttributeReports && !encodeState.AllowPartialData() &&
+                EncodeSharedAttributeReport(apReadHandler, attributeReportIBs, pathForRetrieval))
+            {
+                apReadHandler->SetAttributeEncodeState(AttributeValueEncoder::AttributeEncodeState());
+                continue;
+            }
+#endif
             err = RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), attributeReportIBs,
                                       pathForRetrieval, &encodeState);
             if (err != CHIP_NO_ERROR)
@@ -643,6 +722,11 @@ void Engine::Run()
 {
     uint32_t numReadHandled = 0;
 
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    mReportEncodingCache.Clear();
+    mShareAttributeReports = ShouldShareAttributeReports();
+#endif
+
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = mpImEngine->mReadHandlers.Allocated();
@@ -671,6 +755,10 @@ void Engine::Run()
         mCurReadHandlerIdx++;
     }
 
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    mReportEncodingCache.Clear();
+#endif
+
     //
     // If our tracker has exceeded the bounds of the handler list, reset it back to 0.
     // This isn't strictly necessary, but does make it easier to debug issues in this code if they
@@ -836,30 +924,55 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
     return CHIP_NO_ERROR;
 }
 
+void Engine::AddInterestPaths(ReadHandler & aReadHandler)
+{
+    // On failure the index stops being used by SetDirty, so there is nothing more to do here.
+    (void) mInterestIndex.Add(&aReadHandler, aReadHandler.GetAttributePathList());
+}
+
+void Engine::RemoveInterestPaths(ReadHandler & aReadHandler)
+{
+    mInterestIndex.Remove(&aReadHandler, aReadHandler.GetAttributePathList());
+}
+
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
 {
     BumpDirtySetGeneration();
 
     bool intersectsInterestPath = false;
-    mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
+    auto markDirty              = [this, &aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
         // waiting for a response to the last message chunk for read interactions.
-        if (handler->CanStartReporting() || handler->IsAwaitingReportResponse())
+        //
+        // A handler may have several paths intersecting the dirty path; it only needs to be told once per generation.
+        if ((handler->CanStartReporting() || handler->IsAwaitingReportResponse()) && handler->mDirtyGeneration != mDirtyGeneration)
         {
+            handler->AttributePathIsDirty(aAttributePath);
+            intersectsInterestPath = true;
+        }
+    };
+
+    if (!aAttributePath.IsWildcardPath() && mInterestIndex.IsComplete())
+    {
+        mInterestIndex.ForEachInterestedHandler(aAttributePath.mEndpointId, aAttributePath.mClusterId, aAttributePath.mAttributeId,
+                                                markDirty);
+    }
+    else
+    {
+        mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &markDirty](ReadHandler * handler) {
             for (auto object = handler->GetAttributePathList(); object != nullptr; object = object->mpNext)
             {
                 if (object->mValue.Intersects(aAttributePath))
                 {
-                    handler->AttributePathIsDirty(aAttributePath);
-                    intersectsInterestPath = true;
+                    markDirty(handler);
                     break;
                 }
             }
-        }
 
-        return Loop::Continue;
-    });
+            return Loop::Continue;
+        });
+    }
 
     if (!intersectsInterestPath)
     {
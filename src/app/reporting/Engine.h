@@ -27,6 +27,8 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/InterestIndex.h>
+#include <app/reporting/ReportEncodingCache.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -38,6 +40,10 @@
 #include <system/TLVPacketBufferBackingStore.h>
 
 namespace chip {
+namespace benchmarks {
+class ReportingEngineBenchmark;
+} // namespace benchmarks
+
 namespace app {
 
 class InteractionModelEngine;
@@ -95,6 +101,17 @@ public:
      */
     CHIP_ERROR SetDirty(AttributePathParams & aAttributePathParams);
 
+    /**
+     * Make the attribute paths of the given read handler known to SetDirty(). Must be called once the handler's attribute path
+     * list is final, and balanced by RemoveInterestPaths() before that list is released.
+     */
+    void AddInterestPaths(ReadHandler & aReadHandler);
+
+    /**
+     * Forget the attribute paths of the given read handler. It is not an error if they were never added.
+     */
+    void RemoveInterestPaths(ReadHandler & aReadHandler);
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -148,6 +165,7 @@ private:
 
     friend class TestReportingEngine;
     friend class ::chip::app::TestReadInteraction;
+    friend class ::chip::benchmarks::ReportingEngineBenchmark;
 
     bool IsRunScheduled() const { return mRunScheduled; }
 
@@ -172,6 +190,23 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * Encode the attribute at aPath for apReadHandler by copying the encoding shared with the other read handlers reporting it
+     * in this run, reading and encoding the attribute into mReportEncodingCache first if needed.
+     *
+     * Returns false, with nothing written to aAttributeReportIBs, if the shared encoding can not be used. The caller is then
+     * expected to retrieve the attribute itself, which also takes care of chunking it.
+     */
+    bool EncodeSharedAttributeReport(ReadHandler * apReadHandler, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                     const ConcreteReadAttributePath & aPath);
+
+    /**
+     * Whether more than one read handler is going to report in the run that is starting, so that sharing encodings between them
+     * can pay off.
+     */
+    bool ShouldShareAttributeReports();
+#endif
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -281,6 +316,20 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    /**
+     * Index of the attribute paths of all read handlers, used by SetDirty() to find the handlers a change is relevant to.
+     */
+    InterestIndex mInterestIndex;
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    /**
+     * Encoded attribute reports shared between the read handlers reported on in a single Run(), cleared at the start and end of
+     * every run.
+     */
+    ReportEncodingCache mReportEncodingCache;
+    bool mShareAttributeReports = false;
+#endif
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/InterestIndex.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+size_t InterestIndex::BucketFor(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash                  = ((static_cast<uint64_t>(aClusterId) << 32) | aAttributeId) * kMultiplier;
+    hash                           = (hash ^ aEndpointId) * kMultiplier;
+    return static_cast<size_t>(hash >> 32) & (kBucketCount - 1);
+}
+
+CHIP_ERROR InterestIndex::Add(ReadHandler * apReadHandler, const ObjectList<AttributePathParams> * apPathList)
+{
+    for (auto path = apPathList; path != nullptr; path = path->mpNext)
+    {
+        Entry * entry = mEntryPool.CreateObject();
+        if (entry == nullptr)
+        {
+            ChipLogError(DataManagement, "Interest index is full, falling back to scanning all read handlers");
+            Remove(apReadHandler, apPathList);
+            mIsComplete = false;
+            return CHIP_ERROR_NO_MEMORY;
+        }
+
+        entry->mpReadHandler = apReadHandler;
+        entry->mpPath        = &path->mValue;
+
+        Entry *& bucket = mBuckets[BucketFor(path->mValue.mEndpointId, path->mValue.mClusterId, path->mValue.mAttributeId)];
+        entry->mpNext   = bucket;
+        bucket          = entry;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void InterestIndex::Remove(ReadHandler * apReadHandler, const ObjectList<AttributePathParams> * apPathList)
+{
+    for (auto path = apPathList; path != nullptr; path = path->mpNext)
+    {
+        Entry ** link = &mBuckets[BucketFor(path->mValue.mEndpointId, path->mValue.mClusterId, path->mValue.mAttributeId)];
+        while (*link != nullptr)
+        {
+            Entry * entry = *link;
+            if (entry->mpReadHandler == apReadHandler && entry->mpPath == &path->mValue)
+            {
+                *link = entry->mpNext;
+                mEntryPool.ReleaseObject(entry);
+                break;
+            }
+            link = &entry->mpNext;
+        }
+    }
+}
+
+void InterestIndex::Clear()
+{
+    for (auto & bucket : mBuckets)
+    {
+        bucket = nullptr;
+    }
+    mEntryPool.ReleaseAll();
+    mIsComplete = true;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the index the reporting engine uses to find the read handlers whose attribute
+ *      paths intersect a dirty attribute path.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ObjectList.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Pool.h>
+
+namespace chip {
+namespace app {
+
+class ReadHandler;
+
+namespace reporting {
+
+/*
+ *  @class InterestIndex
+ *
+ *  @brief Index from (endpoint, cluster, attribute) to the read handlers interested in that attribute.
+ *
+ *  Every attribute path of a registered read handler is hashed by its endpoint, cluster and attribute id, where a
+ *  wildcard component hashes as its wildcard value. The handlers interested in a concrete attribute can then be found
+ *  by probing the eight combinations of each component being either concrete or wildcard, instead of walking every
+ *  path of every read handler.
+ */
+class InterestIndex
+{
+public:
+    /**
+     * Add the given attribute paths of @a apReadHandler to the index.
+     *
+     * On failure nothing is added for the handler and the index is marked incomplete, see IsComplete().
+     */
+    CHIP_ERROR Add(ReadHandler * apReadHandler, const ObjectList<AttributePathParams> * apPathList);
+
+    /**
+     * Remove the given attribute paths of @a apReadHandler from the index. It is not an error for them not to be present.
+     */
+    void Remove(ReadHandler * apReadHandler, const ObjectList<AttributePathParams> * apPathList);
+
+    /**
+     * Remove everything from the index, and mark it complete again.
+     */
+    void Clear();
+
+    /**
+     * Whether every handler passed to Add() is present in the index. Once an Add() has failed, callers need to fall back to
+     * walking all read handlers until the index is cleared.
+     */
+    bool IsComplete() const { return mIsComplete; }
+
+    /**
+     * Call @a aFunction with each read handler that has an attribute path intersecting the concrete path
+     * (@a aEndpointId, @a aClusterId, @a aAttributeId). A handler is visited once per intersecting path, so may be
+     * visited more than once.
+     *
+     * @a aFunction must not add or remove paths.
+     */
+    template <typename Function>
+    void ForEachInterestedHandler(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId,
+                                  Function && aFunction) const
+    {
+        for (uint8_t wildcards = 0; wildcards < 8; wildcards++)
+        {
+            const EndpointId endpointId   = (wildcards & 0x1) ? kInvalidEndpointId : aEndpointId;
+            const ClusterId clusterId     = (wildcards & 0x2) ? kInvalidClusterId : aClusterId;
+            const AttributeId attributeId = (wildcards & 0x4) ? kInvalidAttributeId : aAttributeId;
+
+            const Entry * entry = mBuckets[BucketFor(endpointId, clusterId, attributeId)];
+            for (; entry != nullptr; entry = entry->mpNext)
+            {
+                if (entry->mpPath->mEndpointId == endpointId && entry->mpPath->mClusterId == clusterId &&
+                    entry->mpPath->mAttributeId == attributeId)
+                {
+                    aFunction(entry->mpReadHandler);
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        ReadHandler * mpReadHandler        = nullptr;
+        const AttributePathParams * mpPath = nullptr;
+        Entry * mpNext                     = nullptr;
+    };
+
+    static constexpr size_t kBucketCount = CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS;
+    static_assert((kBucketCount & (kBucketCount - 1)) == 0, "CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS must be a power of 2");
+
+    static size_t BucketFor(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId);
+
+    Entry * mBuckets[kBucketCount] = {};
+    // One entry per attribute path, so sized like the interaction model engine's attribute path pool.
+    ObjectPool<Entry, CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
+        mEntryPool;
+    bool mIsComplete = true;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
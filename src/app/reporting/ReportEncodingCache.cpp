@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/ReportEncodingCache.h>
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+#include <app/MessageDef/AttributeDataIB.h>
+#include <app/MessageDef/AttributeReportIB.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+bool ReportEncodingCache::Find(const Key & aKey, DataVersion & aDataVersion, ByteSpan & aEncodedReports) const
+{
+    // Walk backwards so that an entry re-encoded after a data version change shadows the stale one.
+    for (size_t i = mEntryCount; i > 0; i--)
+    {
+        const Entry & entry = mEntries[i - 1];
+        if (entry.mKey == aKey)
+        {
+            aDataVersion    = entry.mDataVersion;
+            aEncodedReports = ByteSpan(&mBuffer[entry.mOffset], entry.mLength);
+            return true;
+        }
+    }
+    return false;
+}
+
+MutableByteSpan ReportEncodingCache::GetFreeSpace()
+{
+    if (mEntryCount == kMaxEntries)
+    {
+        return MutableByteSpan();
+    }
+    return MutableByteSpan(&mBuffer[mBufferUsed], kBufferSize - mBufferUsed);
+}
+
+CHIP_ERROR ReportEncodingCache::Insert(const Key & aKey, size_t aLength)
+{
+    VerifyOrReturnError(mEntryCount < kMaxEntries, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(aLength <= kBufferSize - mBufferUsed, CHIP_ERROR_NO_MEMORY);
+
+    DataVersion dataVersion = 0;
+    ReturnErrorOnFailure(GetSingleDataVersion(ByteSpan(&mBuffer[mBufferUsed], aLength), dataVersion));
+
+    Entry & entry      = mEntries[mEntryCount++];
+    entry.mKey         = aKey;
+    entry.mDataVersion = dataVersion;
+    entry.mOffset      = static_cast<uint16_t>(mBufferUsed);
+    entry.mLength      = static_cast<uint16_t>(aLength);
+
+    mBufferUsed += aLength;
+    return CHIP_NO_ERROR;
+}
+
+void ReportEncodingCache::Clear()
+{
+    mEntryCount = 0;
+    mBufferUsed = 0;
+}
+
+CHIP_ERROR ReportEncodingCache::CopyReports(const ByteSpan & aEncodedReports, AttributeReportIBs::Builder & aAttributeReportIBs)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+    CHIP_ERROR err;
+
+    reader.Init(aEncodedReports);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(aAttributeReportIBs.GetWriter()->CopyElement(reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    return reader.ExitContainer(containerType);
+}
+
+CHIP_ERROR ReportEncodingCache::GetSingleDataVersion(const ByteSpan & aEncodedReports, DataVersion & aDataVersion)
+{
+    TLV::TLVReader reader;
+    AttributeReportIBs::Parser reportIBs;
+    bool hasDataVersion = false;
+    CHIP_ERROR err;
+
+    reader.Init(aEncodedReports);
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reportIBs.Init(reader));
+    reportIBs.GetReader(&reader);
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        AttributeReportIB::Parser reportIB;
+        AttributeDataIB::Parser dataIB;
+        DataVersion dataVersion = 0;
+
+        ReturnErrorOnFailure(reportIB.Init(reader));
+        VerifyOrReturnError(reportIB.GetAttributeData(&dataIB) == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(dataIB.GetDataVersion(&dataVersion) == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(!hasDataVersion || dataVersion == aDataVersion, CHIP_ERROR_INVALID_ARGUMENT);
+        aDataVersion   = dataVersion;
+        hasDataVersion = true;
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    VerifyOrReturnError(hasDataVersion, CHIP_ERROR_INVALID_ARGUMENT);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
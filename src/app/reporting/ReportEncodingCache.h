@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the cache the reporting engine uses to share the encoded AttributeReportIBs of an attribute
+ *      between the read handlers it generates reports for in a single run.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/*
+ *  @class ReportEncodingCache
+ *
+ *  @brief Cache of encoded AttributeReportIBs, keyed by attribute path, accessing fabric and fabric filtering.
+ *
+ *  Each entry holds the AttributeReportIB elements of one complete (unchunked) attribute value, along with the data version
+ *  they were encoded with. Only values that were successfully read with access granted are cached, so callers must check
+ *  that their own subject is granted access to the attribute, and that the data version is still current, before reusing an
+ *  entry.
+ *
+ *  Entries are never evicted individually: the cache is meant to be cleared at the start of each reporting engine run, and
+ *  simply stops accepting new entries when full.
+ */
+class ReportEncodingCache
+{
+public:
+    struct Key
+    {
+        ConcreteAttributePath mPath;
+        FabricIndex mAccessingFabricIndex = kUndefinedFabricIndex;
+        bool mIsFabricFiltered            = false;
+
+        bool operator==(const Key & aOther) const
+        {
+            return mPath == aOther.mPath && mAccessingFabricIndex == aOther.mAccessingFabricIndex &&
+                mIsFabricFiltered == aOther.mIsFabricFiltered;
+        }
+    };
+
+    /**
+     * Find the most recently inserted entry for @a aKey.
+     *
+     * @param[out] aDataVersion     The data version the entry was encoded with.
+     * @param[out] aEncodedReports  The encoded AttributeReportIBs array, suitable for CopyReports().
+     */
+    bool Find(const Key & aKey, DataVersion & aDataVersion, ByteSpan & aEncodedReports) const;
+
+    /**
+     * The buffer a new entry should be encoded into, as an anonymous AttributeReportIBs array, before calling Insert(). The
+     * buffer is empty if the cache is full.
+     */
+    MutableByteSpan GetFreeSpace();
+
+    /**
+     * Record the first @a aLength bytes of GetFreeSpace() as the encoding of @a aKey.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT if the encoding is not a non-empty list of AttributeDataIBs with a single data
+     *                                     version, e.g. because it holds an attribute status. Nothing is recorded.
+     * @retval CHIP_ERROR_NO_MEMORY        if the cache is full.
+     */
+    CHIP_ERROR Insert(const Key & aKey, size_t aLength);
+
+    /**
+     * Remove all entries.
+     */
+    void Clear();
+
+    /**
+     * Copy the AttributeReportIB elements of @a aEncodedReports into @a aAttributeReportIBs. On failure the caller is
+     * responsible for rolling back @a aAttributeReportIBs.
+     */
+    static CHIP_ERROR CopyReports(const ByteSpan & aEncodedReports, AttributeReportIBs::Builder & aAttributeReportIBs);
+
+private:
+    static constexpr size_t kBufferSize = CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE;
+    static constexpr size_t kMaxEntries = CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES;
+    static_assert(kBufferSize <= UINT16_MAX, "CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE must fit in 16 bits");
+    static_assert(kMaxEntries > 0, "CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES must not be 0");
+
+    struct Entry
+    {
+        Key mKey;
+        DataVersion mDataVersion = 0;
+        uint16_t mOffset         = 0;
+        uint16_t mLength         = 0;
+    };
+
+    static CHIP_ERROR GetSingleDataVersion(const ByteSpan & aEncodedReports, DataVersion & aDataVersion);
+
+    Entry mEntries[kMaxEntries];
+    size_t mEntryCount = 0;
+    size_t mBufferUsed = 0;
+    uint8_t mBuffer[kBufferSize];
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
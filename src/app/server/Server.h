@@ -25,6 +25,7 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/DefaultAttributePersistenceProvider.h>
+#include <app/EventManagement.h>
 #include <app/FailSafeContext.h>
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
@@ -154,6 +155,9 @@ struct ServerInitParams
     Credentials::OperationalCertificateStore * opCertStore = nullptr;
     // Required, if not provided, the Server::Init() WILL fail.
     app::reporting::ReportScheduler * reportScheduler = nullptr;
+    // Persistent event log: Optional. Keeps events across restarts when provided, if
+    // CHIP_CONFIG_PERSISTENT_EVENT_LOG is enabled. Must be opened before being provided.
+    app::PersistentEventLog * persistentEventLog = nullptr;
 };
 
 /**
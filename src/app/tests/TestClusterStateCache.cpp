@@ -32,6 +32,7 @@
 #include <lib/support/ScopedBuffer.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <algorithm>
 #include <nlunit-test.h>
 #include <string.h>
 #include <vector>
@@ -114,8 +115,7 @@ class ForwardedDataCallbackValidator final
 public:
     void SetExpectation(TLV::TLVReader & aData, EndpointId endpointId, AttributeInstruction::AttributeType attributeType)
     {
-        auto length = aData.GetRemainingLength();
-        std::vector<uint8_t> buffer(aData.GetReadPoint(), aData.GetReadPoint() + length);
+        auto buffer = CopyElement(aData);
         if (!mExpectedBuffers.empty() && endpointId == mLastEndpointId && attributeType == mLastAttributeType)
         {
             // For overriding test, the last buffered data is removed.
@@ -128,37 +128,35 @@ public:
 
     void SetExpectation() { mExpectedBuffers.clear(); }
 
-    void ValidateData(TLV::TLVReader & aData, bool isListOperation)
+    void ValidateData(TLV::TLVReader & aData)
     {
         NL_TEST_ASSERT(gSuite, !mExpectedBuffers.empty());
         if (!mExpectedBuffers.empty() > 0)
         {
             auto buffer = mExpectedBuffers.front();
             mExpectedBuffers.erase(mExpectedBuffers.begin());
-            uint32_t length = static_cast<uint32_t>(buffer.size());
-            if (isListOperation)
-            {
-                // List operation will attach end of container
-                NL_TEST_ASSERT(gSuite, length < aData.GetRemainingLength());
-            }
-            else
-            {
-                NL_TEST_ASSERT(gSuite, length == aData.GetRemainingLength());
-            }
-            if (length <= aData.GetRemainingLength() && length > 0)
-            {
-                NL_TEST_ASSERT(gSuite, memcmp(aData.GetReadPoint(), buffer.data(), length) == 0);
-                if (memcmp(aData.GetReadPoint(), buffer.data(), length) != 0)
-                {
-                    ChipLogProgress(DataManagement, "Failed");
-                }
-            }
+            NL_TEST_ASSERT(gSuite, CopyElement(aData) == buffer);
         }
     }
 
     void ValidateNoData() { NL_TEST_ASSERT(gSuite, mExpectedBuffers.empty()); }
 
 private:
+    // A list is forwarded in a chain of buffers once reassembled, so the element is copied out rather than compared in
+    // place. The copy is sized with the total length of the data, as the cache sizes its own copy.
+    static std::vector<uint8_t> CopyElement(TLV::TLVReader & aData)
+    {
+        TLV::TLVReader reader;
+        reader.Init(aData);
+        std::vector<uint8_t> buffer(reader.GetTotalLength());
+        TLV::TLVWriter writer;
+        writer.Init(buffer.data(), static_cast<uint32_t>(buffer.size()));
+        NL_TEST_ASSERT(gSuite, writer.CopyElement(TLV::AnonymousTag(), reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(gSuite, writer.Finalize() == CHIP_NO_ERROR);
+        buffer.resize(writer.GetLengthWritten());
+        return buffer;
+    }
+
     std::vector<std::vector<uint8_t>> mExpectedBuffers;
     EndpointId mLastEndpointId;
     AttributeInstruction::AttributeType mLastAttributeType;
@@ -295,7 +293,7 @@ private:
             NL_TEST_ASSERT(gSuite, apData != nullptr);
             if (apData)
             {
-                mDataCallbackValidator.ValidateData(*apData, aPath.IsListOperation());
+                mDataCallbackValidator.ValidateData(*apData);
             }
         }
         else
@@ -684,10 +682,205 @@ void TestCache(nlTestSuite * apSuite, void * apContext)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+/*
+ * This validates the cache when paths are not reported in increasing order, which inserts new endpoints, clusters and
+ * attributes in the middle of the cache's sorted storage, and when a path is reported again after other paths.
+ */
+void TestCacheOutOfOrderPaths(nlTestSuite * apSuite, void * apContext)
+{
+    ChipLogProgress(DataManagement, "E2:D1 E0:A2 E1:C3 E0:B4 --> E0:A2 E0:B4 E1:C3 E2:D1");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 2, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
+
+    ChipLogProgress(DataManagement, "E1:D1 E1:C2 E1:B3 E0:B4s E1:A5 --> E0:B4s E1:A5 E1:B3 E1:C2 E1:D1");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeD, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeC, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kStatus),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData) });
+
+    ChipLogProgress(DataManagement, "E3:A1 E1:A2 E3:A3 E2:B4 E1:A5 --> E1:A5 E2:B4 E3:A3");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeA, 3, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 3, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 2, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData) });
+
+    //
+    // A large value after small ones grows the buffer that values are encoded into, and later small values reuse it.
+    //
+    ChipLogProgress(DataManagement, "E0:A1 E0:D2 E1:A3 E1:B4 --> E0:A1 E0:D2 E1:A3 E1:B4");
+    RunAndValidateSequence({ AttributeInstruction(AttributeInstruction::kAttributeA, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeD, 0, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData),
+                             AttributeInstruction(AttributeInstruction::kAttributeB, 1, AttributeInstruction::kData) });
+}
+
+/*
+ * This validates the lookups and iteration of a cache filled out of order: missing endpoints, clusters and attributes
+ * are not found, and iteration visits each path once, in increasing order.
+ */
+void TestCacheLookup(nlTestSuite * apSuite, void * apContext)
+{
+    AttributeInstructionListType list = {
+        AttributeInstruction(AttributeInstruction::kAttributeB, 3, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeA, 1, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeA, 3, AttributeInstruction::kData),
+        AttributeInstruction(AttributeInstruction::kAttributeC, 0, AttributeInstruction::kStatus),
+    };
+
+    ForwardedDataCallbackValidator dataCallbackValidator;
+    CacheValidator client(list, dataCallbackValidator);
+    ClusterStateCache cache(client);
+    DataSeriesGenerator generator(&cache.GetBufferedCallback(), list);
+    generator.Generate(dataCallbackValidator);
+
+    using namespace Clusters::UnitTesting;
+
+    Attributes::Int16u::TypeInfo::DecodableType value = 0;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get<Attributes::Int16u::TypeInfo>(ConcreteAttributePath(3, Id, Attributes::Int16u::Id), value) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, value == list[2].mInstructionId);
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get<Attributes::Int16u::TypeInfo>(ConcreteAttributePath(2, Id, Attributes::Int16u::Id), value) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get<Attributes::Int16u::TypeInfo>(ConcreteAttributePath(4, Id, Attributes::Int16u::Id), value) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+
+    TLV::TLVReader reader;
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get(ConcreteAttributePath(1, Clusters::OnOff::Id, Attributes::Int16u::Id), reader) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite, cache.Get(ConcreteAttributePath(1, Id, Attributes::Int8u::Id), reader) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite,
+                   cache.Get(ConcreteAttributePath(0, Id, Attributes::StructAttr::Id), reader) ==
+                       CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+
+    size_t clusterCount = 0;
+    NL_TEST_ASSERT(apSuite, cache.ForEachCluster(2, [&clusterCount](ClusterId clusterId) {
+        clusterCount++;
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, clusterCount == 0);
+    NL_TEST_ASSERT(apSuite, cache.ForEachCluster(3, [&clusterCount](ClusterId clusterId) {
+        NL_TEST_ASSERT(gSuite, clusterId == Id);
+        clusterCount++;
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, clusterCount == 1);
+
+    std::vector<ConcreteAttributePath> paths;
+    NL_TEST_ASSERT(apSuite, cache.ForEachAttribute(Id, [&paths](const ConcreteAttributePath & path) {
+        paths.push_back(path);
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, paths.size() == list.size());
+    NL_TEST_ASSERT(apSuite, std::is_sorted(paths.begin(), paths.end()));
+    NL_TEST_ASSERT(apSuite, std::adjacent_find(paths.begin(), paths.end()) == paths.end());
+}
+
+/*
+ * A callback that checks the TLV data of the list attribute that the cache forwards. The cache, like the Java and Python
+ * bindings, sizes its copy of the value with the total length of that data.
+ */
+class ChunkedListValidator : public ClusterStateCache::Callback
+{
+public:
+    void OnDone(ReadClient *) override {}
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        NL_TEST_ASSERT(gSuite, aPath.mListOp == ConcreteDataAttributePath::ListOperation::ReplaceAll);
+        NL_TEST_ASSERT(gSuite, apData != nullptr);
+        VerifyOrReturn(apData != nullptr);
+
+        TLV::TLVReader reader;
+        reader.Init(*apData);
+        NL_TEST_ASSERT(gSuite, reader.Skip() == CHIP_NO_ERROR);
+        mListLength  = reader.GetLengthRead();
+        mTotalLength = reader.GetTotalLength();
+        mAttributeDataCount++;
+    }
+
+    size_t mAttributeDataCount = 0;
+    uint32_t mListLength       = 0;
+    uint32_t mTotalLength      = 0;
+};
+
+/*
+ * This validates the cache with a list attribute delivered in chunks, an empty list followed by one item per chunk, which
+ * BufferedReadCallback reassembles into a chain of packet buffers before the cache stores it.
+ */
+void TestCacheChunkedList(nlTestSuite * apSuite, void * apContext)
+{
+    using namespace Clusters::UnitTesting;
+
+    // Enough items to span several of the packet buffers that the list is reassembled into.
+    constexpr uint16_t kNumItems = 512;
+
+    ChunkedListValidator client;
+    ClusterStateCache cache(client);
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+
+    ConcreteDataAttributePath path(1, Id, Attributes::ListStructOctetString::Id);
+    path.mDataVersion.SetValue(1);
+
+    callback.OnReportBegin();
+    for (uint16_t i = 0; i <= kNumItems; i++)
+    {
+        System::PacketBufferTLVWriter writer;
+        writer.Init(System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize));
+        if (i == 0)
+        {
+            Attributes::ListStructOctetString::TypeInfo::Type value;
+            path.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
+            NL_TEST_ASSERT(apSuite, DataModel::Encode(writer, TLV::AnonymousTag(), value) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            Structs::TestListStructOctet::Type item;
+            item.member1 = i;
+            path.mListOp = ConcreteDataAttributePath::ListOperation::AppendItem;
+            NL_TEST_ASSERT(apSuite, DataModel::Encode(writer, TLV::AnonymousTag(), item) == CHIP_NO_ERROR);
+        }
+
+        System::PacketBufferHandle handle;
+        NL_TEST_ASSERT(apSuite, writer.Finalize(&handle) == CHIP_NO_ERROR);
+        System::PacketBufferTLVReader reader;
+        reader.Init(std::move(handle));
+        NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR);
+        callback.OnAttributeData(path, &reader, StatusIB());
+    }
+    callback.OnReportEnd();
+
+    // The whole list is forwarded once, and its data is all there is to read.
+    NL_TEST_ASSERT(apSuite, client.mAttributeDataCount == 1);
+    NL_TEST_ASSERT(apSuite, client.mListLength > System::PacketBuffer::kMaxSize);
+    NL_TEST_ASSERT(apSuite, client.mTotalLength == client.mListLength);
+
+    Attributes::ListStructOctetString::TypeInfo::DecodableType list;
+    NL_TEST_ASSERT(apSuite, cache.Get<Attributes::ListStructOctetString::TypeInfo>(path, list) == CHIP_NO_ERROR);
+    uint16_t expected = 1;
+    auto iter         = list.begin();
+    while (iter.Next())
+    {
+        NL_TEST_ASSERT(apSuite, iter.GetValue().member1 == expected);
+        expected++;
+    }
+    NL_TEST_ASSERT(apSuite, iter.GetStatus() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, expected == kNumItems + 1);
+}
+
 // clang-format off
 const nlTest sTests[] =
 {
     NL_TEST_DEF("TestCache", TestCache),
+    NL_TEST_DEF("TestCacheOutOfOrderPaths", TestCacheOutOfOrderPaths),
+    NL_TEST_DEF("TestCacheLookup", TestCacheLookup),
+    NL_TEST_DEF("TestCacheChunkedList", TestCacheChunkedList),
     NL_TEST_SENTINEL()
 };
 
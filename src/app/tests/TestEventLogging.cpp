@@ -28,6 +28,9 @@
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/ObjectList.h>
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <app/PersistentEventLog.h>
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
 #include <app/tests/AppTestContext.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
@@ -47,9 +50,13 @@
 
 #include <nlunit-test.h>
 
+#include <stdlib.h>
+#include <unistd.h>
+
 namespace {
 
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
+static const chip::ClusterId kQuietClusterId      = 0x00000023;
 static const uint32_t kLivenessChangeEvent        = 1;
 static const chip::EndpointId kTestEndpointId1    = 2;
 static const chip::EndpointId kTestEndpointId2    = 3;
@@ -66,24 +73,32 @@ public:
     // Performs setup for each individual test in the test suite
     CHIP_ERROR SetUp() override
     {
-        const chip::app::LogStorageResources logStorageResources[] = {
-            { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug },
-            { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info },
-            { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical },
-        };
-
         ReturnErrorOnFailure(chip::Test::AppContext::SetUp());
 
         CHIP_ERROR err = CHIP_NO_ERROR;
         VerifyOrExit((err = mEventCounter.Init(0)) == CHIP_NO_ERROR,
                      ChipLogError(AppServer, "Init EventCounter failed: %" CHIP_ERROR_FORMAT, err.Format()));
-        chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), ArraySize(logStorageResources),
-                                                          gCircularEventBuffer, logStorageResources, &mEventCounter);
+        CreateEventManagement(nullptr);
 
     exit:
         return err;
     }
 
+    // Creates the EventManagement with empty event buffers and the given persistent event log, which is null by default.
+    void CreateEventManagement(chip::app::PersistentEventLog * apPersistentEventLog)
+    {
+        const chip::app::LogStorageResources logStorageResources[] = {
+            { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug },
+            { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info },
+            { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical },
+        };
+
+        chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), ArraySize(logStorageResources),
+                                                          gCircularEventBuffer, logStorageResources, &mEventCounter,
+                                                          chip::System::SystemClock().GetMonotonicMilliseconds64(),
+                                                          apPersistentEventLog);
+    }
+
     // Performs teardown for each individual test in the test suite
     void TearDown() override
     {
@@ -311,9 +326,162 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+static void CheckFetchEventsSinceWithClusterFilter(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::EventNumber eid[6];
+    chip::app::EventOptions options;
+    options.mPriority = chip::app::PriorityLevel::Info;
+    TestEventGenerator testEventGenerator;
+
+    // Alternate between two clusters, so that the events of each are spread over the debug and info buffers.
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (size_t i = 0; i < ArraySize(eid); i++)
+    {
+        options.mPath = { kTestEndpointId1, (i % 2 == 0) ? kLivenessClusterId : kQuietClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        err = logMgmt.LogEvent(&testEventGenerator, options, eid[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    CheckLogState(apSuite, logMgmt, 6, chip::app::PriorityLevel::Info);
+
+    chip::app::ObjectList<chip::app::EventPathParams> livenessPath;
+    livenessPath.mValue.mEndpointId = kTestEndpointId1;
+    livenessPath.mValue.mClusterId  = kLivenessClusterId;
+
+    chip::app::ObjectList<chip::app::EventPathParams> quietPath;
+    quietPath.mValue.mEndpointId = kTestEndpointId1;
+    quietPath.mValue.mClusterId  = kQuietClusterId;
+
+    // Starting from the middle of the log, or from an event of the other cluster, only returns the later events.
+    CheckLogReadOut(apSuite, logMgmt, 0, 3, &livenessPath);
+    CheckLogReadOut(apSuite, logMgmt, eid[3], 1, &livenessPath);
+    CheckLogReadOut(apSuite, logMgmt, eid[2], 2, &quietPath);
+    CheckLogReadOut(apSuite, logMgmt, eid[5], 1, &quietPath);
+}
+
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+static void CheckLogEventWithPersistentLog(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    chip::EventNumber eid[6];
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Debug;
+    TestEventGenerator testEventGenerator;
+
+    char path[] = "/tmp/TestEventLogging-XXXXXX";
+    int fd      = mkstemp(path);
+    NL_TEST_ASSERT(apSuite, fd >= 0);
+    close(fd);
+
+    chip::app::PersistentEventLog persistentLog;
+    NL_TEST_ASSERT(apSuite, persistentLog.Open(path) == CHIP_NO_ERROR);
+
+    chip::app::EventManagement::DestroyEventManagement();
+    ctx.CreateEventManagement(&persistentLog);
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    for (size_t i = 0; i < ArraySize(eid); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        err = logMgmt.LogEvent(&testEventGenerator, options, eid[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    chip::app::ObjectList<chip::app::EventPathParams> paths;
+    paths.mValue.mEndpointId = kTestEndpointId1;
+    paths.mValue.mClusterId  = kLivenessClusterId;
+
+    // The debug buffer only holds the last 3 debug events, but all of them are fetched from the persistent log.
+    CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
+    CheckLogReadOut(apSuite, logMgmt, 0, 6, &paths);
+
+    // After a restart, the events are only in the persistent log.
+    chip::app::EventManagement::DestroyEventManagement();
+    ctx.CreateEventManagement(&persistentLog);
+    CheckLogState(apSuite, logMgmt, 0, chip::app::PriorityLevel::Debug);
+    CheckLogReadOut(apSuite, logMgmt, 0, 6, &paths);
+    CheckLogReadOut(apSuite, logMgmt, eid[3], 3, &paths);
+
+    chip::app::EventManagement::DestroyEventManagement();
+    ctx.CreateEventManagement(nullptr);
+    persistentLog.Close();
+    unlink(path);
+}
+
+static void CheckCriticalEventsDroppedByPersistentLog(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    chip::EventNumber criticalEid[2];
+    chip::EventNumber debugEid[6];
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    char path[] = "/tmp/TestEventLogging-XXXXXX";
+    int fd      = mkstemp(path);
+    NL_TEST_ASSERT(apSuite, fd >= 0);
+    close(fd);
+
+    // A log that only holds a few events, so that a burst of debug events drops the critical events from it.
+    chip::app::PersistentEventLog persistentLog;
+    NL_TEST_ASSERT(apSuite, persistentLog.Open(path, 200) == CHIP_NO_ERROR);
+
+    chip::app::EventManagement::DestroyEventManagement();
+    ctx.CreateEventManagement(&persistentLog);
+
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    options.mPath     = { kTestEndpointId1, kQuietClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Critical;
+    for (size_t i = 0; i < ArraySize(criticalEid); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        err = logMgmt.LogEvent(&testEventGenerator, options, criticalEid[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Debug;
+    for (size_t i = 0; i < ArraySize(debugEid); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        err = logMgmt.LogEvent(&testEventGenerator, options, debugEid[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    // The log dropped the critical events, but they are still fetched from the critical buffer.
+    const chip::EventNumber firstLoggedEid = persistentLog.GetFirstEventNumber();
+    NL_TEST_ASSERT(apSuite, firstLoggedEid > criticalEid[1] && firstLoggedEid <= debugEid[ArraySize(debugEid) - 1]);
+
+    chip::app::ObjectList<chip::app::EventPathParams> quietPath;
+    quietPath.mValue.mEndpointId = kTestEndpointId1;
+    quietPath.mValue.mClusterId  = kQuietClusterId;
+    CheckLogReadOut(apSuite, logMgmt, 0, 2, &quietPath);
+
+    // The events the log still holds are fetched from it.
+    chip::app::ObjectList<chip::app::EventPathParams> livenessPath;
+    livenessPath.mValue.mEndpointId = kTestEndpointId1;
+    livenessPath.mValue.mClusterId  = kLivenessClusterId;
+    CheckLogReadOut(apSuite, logMgmt, firstLoggedEid,
+                    static_cast<size_t>(debugEid[ArraySize(debugEid) - 1] - firstLoggedEid + 1), &livenessPath);
+
+    chip::app::EventManagement::DestroyEventManagement();
+    ctx.CreateEventManagement(nullptr);
+    persistentLog.Close();
+    unlink(path);
+}
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckFetchEventsSinceWithClusterFilter", CheckFetchEventsSinceWithClusterFilter),
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+    NL_TEST_DEF("CheckLogEventWithPersistentLog", CheckLogEventWithPersistentLog),
+    NL_TEST_DEF("CheckCriticalEventsDroppedByPersistentLog", CheckCriticalEventsDroppedByPersistentLog),
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
     NL_TEST_SENTINEL(),
 };
 
@@ -0,0 +1,282 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/PersistentEventLog.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint32_t kCapacity = 256;
+
+char sPath[] = "/tmp/TestPersistentEventLog-XXXXXX";
+
+// Appends an event whose TLV is an unsigned integer equal to its event number.
+CHIP_ERROR AppendEvent(PersistentEventLog & log, EventNumber eventNumber)
+{
+    MutableByteSpan space;
+    ReturnErrorOnFailure(log.PrepareAppend(16, space));
+
+    TLV::TLVWriter writer;
+    writer.Init(space);
+    ReturnErrorOnFailure(writer.Put(TLV::AnonymousTag(), eventNumber));
+    ReturnErrorOnFailure(writer.Finalize());
+    return log.CommitAppend(eventNumber, writer.GetLengthWritten());
+}
+
+// Checks that the log holds the events from firstEventNumber to lastEventNumber, skipping those before sinceEventNumber.
+void CheckEvents(nlTestSuite * inSuite, PersistentEventLog & log, EventNumber sinceEventNumber, EventNumber firstEventNumber,
+                 EventNumber lastEventNumber)
+{
+    PersistentEventLog::Iterator iterator = log.IterateSince(sinceEventNumber);
+    EventNumber expected                  = firstEventNumber;
+    while (iterator.Next())
+    {
+        NL_TEST_ASSERT(inSuite, iterator.GetEventNumber() == expected);
+
+        TLV::TLVReader reader;
+        uint64_t value = 0;
+        reader.Init(iterator.GetEvent());
+        NL_TEST_ASSERT(inSuite, reader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, reader.Get(value) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, value == expected);
+        expected++;
+    }
+    NL_TEST_ASSERT(inSuite, expected == lastEventNumber + 1);
+}
+
+void CheckAppendAndIterate(nlTestSuite * inSuite, void * inContext)
+{
+    PersistentEventLog log;
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.IsEmpty());
+
+    for (EventNumber eventNumber = 1; eventNumber <= 5; eventNumber++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendEvent(log, eventNumber) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == 5);
+    CheckEvents(inSuite, log, 0, 1, 5);
+    CheckEvents(inSuite, log, 3, 3, 5);
+    CheckEvents(inSuite, log, 6, 6, 5);
+
+    // Event numbers must increase.
+    NL_TEST_ASSERT(inSuite, AppendEvent(log, 5) == CHIP_ERROR_INVALID_ARGUMENT);
+    CheckEvents(inSuite, log, 0, 1, 5);
+
+    // An event larger than the log does not fit even once older events are dropped.
+    MutableByteSpan space;
+    NL_TEST_ASSERT(inSuite, log.PrepareAppend(kCapacity, space) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.IsEmpty());
+    CheckEvents(inSuite, log, 0, 1, 0);
+}
+
+void CheckReopen(nlTestSuite * inSuite, void * inContext)
+{
+    {
+        PersistentEventLog log;
+        NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+        for (EventNumber eventNumber = 10; eventNumber <= 13; eventNumber++)
+        {
+            NL_TEST_ASSERT(inSuite, AppendEvent(log, eventNumber) == CHIP_NO_ERROR);
+        }
+
+        // An event that was not committed is not part of the log.
+        MutableByteSpan space;
+        NL_TEST_ASSERT(inSuite, log.PrepareAppend(16, space) == CHIP_NO_ERROR);
+        memset(space.data(), 0xAA, 16);
+    }
+
+    PersistentEventLog log;
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == 13);
+    CheckEvents(inSuite, log, 0, 10, 13);
+    NL_TEST_ASSERT(inSuite, AppendEvent(log, 14) == CHIP_NO_ERROR);
+    CheckEvents(inSuite, log, 0, 10, 14);
+    log.Close();
+
+    // A different capacity starts over.
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity * 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.IsEmpty());
+}
+
+void CheckDropOldestEvents(nlTestSuite * inSuite, void * inContext)
+{
+    PersistentEventLog log;
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+
+    // Each event takes 16 bytes of record header and 2 bytes of TLV, padded to 20 bytes, so 11 or 12 fit, depending on
+    // where the records wrap around.
+    constexpr EventNumber kEventCount = 100;
+    for (EventNumber eventNumber = 1; eventNumber <= kEventCount; eventNumber++)
+    {
+        NL_TEST_ASSERT(inSuite, AppendEvent(log, eventNumber) == CHIP_NO_ERROR);
+    }
+
+    const EventNumber firstEventNumber = log.GetFirstEventNumber();
+    NL_TEST_ASSERT(inSuite, firstEventNumber > 1);
+    NL_TEST_ASSERT(inSuite, kEventCount - firstEventNumber + 1 >= kCapacity / 20 - 1);
+    NL_TEST_ASSERT(inSuite, kEventCount - firstEventNumber + 1 <= kCapacity / 20);
+    CheckEvents(inSuite, log, 0, firstEventNumber, kEventCount);
+    CheckEvents(inSuite, log, kEventCount - 1, kEventCount - 1, kEventCount);
+
+    // The records wrap around the end of the file, and are found there again once the log is reopened.
+    log.Close();
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetFirstEventNumber() == firstEventNumber);
+    NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == kEventCount);
+    CheckEvents(inSuite, log, 0, firstEventNumber, kEventCount);
+
+    // Fill the log up to less than a record from its end.
+    MutableByteSpan space;
+    NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.PrepareAppend(kCapacity - 24, space) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.CommitAppend(1, kCapacity - 24) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, AppendEvent(log, 2) == CHIP_NO_ERROR);
+    CheckEvents(inSuite, log, 0, 2, 2);
+    NL_TEST_ASSERT(inSuite, log.GetFirstEventNumber() == 2);
+}
+
+void CheckModifyEvent(nlTestSuite * inSuite, void * inContext)
+{
+    {
+        PersistentEventLog log;
+        NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+        for (EventNumber eventNumber = 1; eventNumber <= 3; eventNumber++)
+        {
+            NL_TEST_ASSERT(inSuite, AppendEvent(log, eventNumber) == CHIP_NO_ERROR);
+        }
+
+        // Changing the value of the second event in place, as FabricRemoved() does, keeps its record valid.
+        PersistentEventLog::Iterator iterator = log.IterateSince(2);
+        NL_TEST_ASSERT(inSuite, iterator.Next());
+        iterator.GetEvent().data()[1] = 7;
+        iterator.CommitEventChange();
+    }
+
+    PersistentEventLog log;
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == 3);
+    PersistentEventLog::Iterator iterator = log.IterateSince(2);
+    NL_TEST_ASSERT(inSuite, iterator.Next());
+    NL_TEST_ASSERT(inSuite, iterator.GetEventNumber() == 2);
+    NL_TEST_ASSERT(inSuite, iterator.GetEvent().data()[1] == 7);
+}
+
+// Returns the offset in the file of the last of the events appended by AppendEvent() to a log that does not wrap.
+off_t LastRecordOffset(nlTestSuite * inSuite, int fd)
+{
+    uint8_t offsets[8];
+    NL_TEST_ASSERT(inSuite, pread(fd, offsets, sizeof(offsets), 16) == sizeof(offsets));
+    return 24 + Encoding::LittleEndian::Get32(offsets + 4) - 20;
+}
+
+void CheckRecoverIncompleteEvents(nlTestSuite * inSuite, void * inContext)
+{
+    {
+        PersistentEventLog log;
+        NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, log.Clear() == CHIP_NO_ERROR);
+        for (EventNumber eventNumber = 1; eventNumber <= 4; eventNumber++)
+        {
+            NL_TEST_ASSERT(inSuite, AppendEvent(log, eventNumber) == CHIP_NO_ERROR);
+        }
+    }
+
+    // Tear the TLV of the last record, as if the header had been written back before it ahead of a power loss.
+    int fd = open(sPath, O_RDWR);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    uint8_t value = 0xAA;
+    NL_TEST_ASSERT(inSuite, pwrite(fd, &value, sizeof(value), LastRecordOffset(inSuite, fd) + 17) == sizeof(value));
+    close(fd);
+
+    {
+        PersistentEventLog log;
+        NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == 3);
+        CheckEvents(inSuite, log, 0, 1, 3);
+    }
+
+    // Tear the length of the last record.
+    fd = open(sPath, O_RDWR);
+    NL_TEST_ASSERT(inSuite, fd >= 0);
+    uint8_t field[4];
+    Encoding::LittleEndian::Put32(field, 0xFF);
+    NL_TEST_ASSERT(inSuite, pwrite(fd, field, sizeof(field), LastRecordOffset(inSuite, fd)) == sizeof(field));
+    close(fd);
+
+    PersistentEventLog log;
+    NL_TEST_ASSERT(inSuite, log.Open(sPath, kCapacity) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, log.GetLastEventNumber() == 2);
+    CheckEvents(inSuite, log, 0, 1, 2);
+    NL_TEST_ASSERT(inSuite, AppendEvent(log, 3) == CHIP_NO_ERROR);
+    CheckEvents(inSuite, log, 0, 1, 3);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("PersistentEventLog::AppendAndIterate", CheckAppendAndIterate),
+    NL_TEST_DEF("PersistentEventLog::Reopen", CheckReopen),
+    NL_TEST_DEF("PersistentEventLog::DropOldestEvents", CheckDropOldestEvents),
+    NL_TEST_DEF("PersistentEventLog::ModifyEvent", CheckModifyEvent),
+    NL_TEST_DEF("PersistentEventLog::RecoverIncompleteEvents", CheckRecoverIncompleteEvents),
+    NL_TEST_SENTINEL(),
+};
+
+int TestSetup(void * inContext)
+{
+    int fd = mkstemp(sPath);
+    VerifyOrReturnError(fd >= 0, FAILURE);
+    close(fd);
+    return SUCCESS;
+}
+
+int TestTearDown(void * inContext)
+{
+    unlink(sPath);
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestPersistentEventLog()
+{
+    nlTestSuite theSuite = { "PersistentEventLog", &sTests[0], TestSetup, TestTearDown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPersistentEventLog)
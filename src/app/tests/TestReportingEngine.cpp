@@ -25,6 +25,8 @@
 #include <app/ConcreteAttributePath.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
+#include <app/reporting/InterestIndex.h>
+#include <app/reporting/ReportEncodingCache.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
 #include <lib/core/CHIPCore.h>
@@ -57,6 +59,10 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestInterestIndex(nlTestSuite * apSuite, void * apContext);
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    static void TestReportEncodingCache(nlTestSuite * apSuite, void * apContext);
+#endif
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
@@ -330,6 +336,201 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestInterestIndex(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr EndpointId kOtherEndpointId = kTestEndpointId + 1;
+    constexpr ClusterId kOtherClusterId   = kTestClusterId + 1;
+
+    // The index never dereferences the handlers, so any distinct addresses will do.
+    uint8_t handlerStorage[3];
+    ReadHandler * handlerA = reinterpret_cast<ReadHandler *>(&handlerStorage[0]);
+    ReadHandler * handlerB = reinterpret_cast<ReadHandler *>(&handlerStorage[1]);
+    ReadHandler * handlerC = reinterpret_cast<ReadHandler *>(&handlerStorage[2]);
+
+    ObjectList<AttributePathParams> pathsA[1];
+    pathsA[0].mValue = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1);
+
+    ObjectList<AttributePathParams> pathsB[1];
+    pathsB[0].mValue = AttributePathParams(kTestClusterId, kInvalidAttributeId);
+
+    ObjectList<AttributePathParams> pathsC[3];
+    pathsC[0].mValue = AttributePathParams(kOtherEndpointId, kInvalidClusterId);
+    pathsC[1].mValue = AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    pathsC[2].mValue = AttributePathParams(kTestEndpointId, kOtherClusterId, kTestFieldId1);
+    pathsC[0].mpNext = &pathsC[1];
+    pathsC[1].mpNext = &pathsC[2];
+
+    InterestIndex index;
+    NL_TEST_ASSERT(apSuite, index.Add(handlerA, pathsA) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.Add(handlerB, pathsB) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.Add(handlerC, pathsC) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.IsComplete());
+
+    int visitsA = 0;
+    int visitsB = 0;
+    int visitsC = 0;
+    auto lookup = [&](EndpointId endpoint, ClusterId cluster, AttributeId attribute) {
+        visitsA = visitsB = visitsC = 0;
+        index.ForEachInterestedHandler(endpoint, cluster, attribute, [&](ReadHandler * handler) {
+            visitsA += (handler == handlerA) ? 1 : 0;
+            visitsB += (handler == handlerB) ? 1 : 0;
+            visitsC += (handler == handlerC) ? 1 : 0;
+        });
+    };
+
+    lookup(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 1 && visitsB == 1 && visitsC == 1);
+
+    lookup(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 1 && visitsC == 0);
+
+    lookup(kOtherEndpointId, kTestClusterId, kTestFieldId2);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 1 && visitsC == 1);
+
+    lookup(kTestEndpointId, kOtherClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 0 && visitsC == 1);
+
+    lookup(static_cast<EndpointId>(kTestEndpointId + 2), kOtherClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 0 && visitsC == 0);
+
+    index.Remove(handlerC, pathsC);
+    lookup(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 1 && visitsB == 1 && visitsC == 0);
+    lookup(kTestEndpointId, kOtherClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 0 && visitsC == 0);
+
+    // Removing paths that are not in the index is a no-op.
+    index.Remove(handlerC, pathsC);
+    index.Remove(handlerB, pathsA);
+    lookup(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 1 && visitsB == 1 && visitsC == 0);
+
+    index.Clear();
+    lookup(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    NL_TEST_ASSERT(apSuite, visitsA == 0 && visitsB == 0 && visitsC == 0);
+}
+
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+static CHIP_ERROR EncodeAttributeReport(const MutableByteSpan & aBuffer, const ReportEncodingCache::Key & aKey,
+                                        DataVersion aDataVersion, uint32_t aValue, size_t & aLength)
+{
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder builder;
+    writer.Init(aBuffer);
+    ReturnErrorOnFailure(builder.Init(&writer));
+    AttributeValueEncoder encoder(builder, aKey.mAccessingFabricIndex, aKey.mPath, aDataVersion, aKey.mIsFabricFiltered);
+    ReturnErrorOnFailure(encoder.Encode(aValue));
+    ReturnErrorOnFailure(builder.EndOfAttributeReportIBs());
+    ReturnErrorOnFailure(writer.Finalize());
+    aLength = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+void TestReportingEngine::TestReportEncodingCache(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    ReportEncodingCache cache;
+    const ReportEncodingCache::Key key{ ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId1), 1, true };
+    DataVersion dataVersion = 0;
+    ByteSpan encodedReports;
+    size_t length = 0;
+
+    NL_TEST_ASSERT(apSuite, !cache.Find(key, dataVersion, encodedReports));
+
+    err = EncodeAttributeReport(cache.GetFreeSpace(), key, 5, 42, length);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = cache.Insert(key, length);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, cache.Find(key, dataVersion, encodedReports));
+    NL_TEST_ASSERT(apSuite, dataVersion == 5);
+
+    // The accessing fabric and fabric filtering are part of the key.
+    ByteSpan otherReports;
+    ReportEncodingCache::Key otherKey = key;
+    otherKey.mAccessingFabricIndex    = 2;
+    NL_TEST_ASSERT(apSuite, !cache.Find(otherKey, dataVersion, otherReports));
+    otherKey                   = key;
+    otherKey.mIsFabricFiltered = false;
+    NL_TEST_ASSERT(apSuite, !cache.Find(otherKey, dataVersion, otherReports));
+
+    // Copying the cached reports produces the same bytes as encoding the attribute directly.
+    {
+        uint8_t expected[128];
+        size_t expectedLength = 0;
+        err                   = EncodeAttributeReport(MutableByteSpan(expected), key, 5, 42, expectedLength);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        uint8_t copied[128];
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        writer.Init(copied);
+        err = builder.Init(&writer);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = ReportEncodingCache::CopyReports(encodedReports, builder);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = builder.EndOfAttributeReportIBs();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = writer.Finalize();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, ByteSpan(copied, writer.GetLengthWritten()).data_equal(ByteSpan(expected, expectedLength)));
+
+        // Running out of space is reported to the caller.
+        uint8_t tooSmall[8];
+        writer.Init(tooSmall);
+        err = builder.Init(&writer);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = ReportEncodingCache::CopyReports(encodedReports, builder);
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY);
+    }
+
+    // A newer encoding of the same attribute shadows the older one.
+    err = EncodeAttributeReport(cache.GetFreeSpace(), key, 6, 43, length);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = cache.Insert(key, length);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Find(key, dataVersion, encodedReports));
+    NL_TEST_ASSERT(apSuite, dataVersion == 6);
+
+    // Attribute statuses are not cached.
+    {
+        const ReportEncodingCache::Key statusKey{ ConcreteAttributePath(kTestEndpointId, kTestClusterId, kTestFieldId2), 1,
+                                                  true };
+        MutableByteSpan freeSpace = cache.GetFreeSpace();
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        writer.Init(freeSpace);
+        err = builder.Init(&writer);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = builder.EncodeAttributeStatus(ConcreteReadAttributePath(statusKey.mPath),
+                                            StatusIB(Protocols::InteractionModel::Status::UnsupportedAccess));
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = builder.EndOfAttributeReportIBs();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = writer.Finalize();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = cache.Insert(statusKey, writer.GetLengthWritten());
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+        NL_TEST_ASSERT(apSuite, !cache.Find(statusKey, dataVersion, encodedReports));
+    }
+
+    cache.Clear();
+    NL_TEST_ASSERT(apSuite, !cache.Find(key, dataVersion, encodedReports));
+
+    // Once all entries are used, the cache stops accepting new ones.
+    for (AttributeId attributeId = 0; attributeId < CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES; attributeId++)
+    {
+        const ReportEncodingCache::Key entryKey{ ConcreteAttributePath(kTestEndpointId, kTestClusterId, attributeId), 1, true };
+        err = EncodeAttributeReport(cache.GetFreeSpace(), entryKey, 1, attributeId, length);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = cache.Insert(entryKey, length);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, cache.GetFreeSpace().empty());
+    NL_TEST_ASSERT(apSuite, cache.Insert(key, 0) == CHIP_ERROR_NO_MEMORY);
+}
+#endif // CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -341,6 +542,10 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestInterestIndex", chip::app::reporting::TestReportingEngine::TestInterestIndex),
+#if CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE > 0
+    NL_TEST_DEF("TestReportEncodingCache", chip::app::reporting::TestReportingEngine::TestReportEncodingCache),
+#endif
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -29,6 +29,8 @@
 #include <platform/LockTracker.h>
 #include <protocols/interaction_model/StatusCode.h>
 
+#include <algorithm>
+
 using chip::Protocols::InteractionModel::Status;
 
 // Attribute storage depends on knowing the current layout/setup of attributes
@@ -80,6 +82,10 @@ static uint8_t emberAfClusterCountByIndex(uint16_t endpointIndex, bool server);
 // enabled.
 static bool emberAfEndpointIsEnabled(chip::EndpointId endpoint);
 
+// Returns the index of the first endpoint with the given endpoint id, optionally
+// skipping disabled endpoints.
+static uint16_t findIndexFromEndpoint(chip::EndpointId endpoint, bool ignoreDisabledEndpoints);
+
 namespace {
 
 #if (!defined(ATTRIBUTE_SINGLETONS_SIZE)) || (ATTRIBUTE_SINGLETONS_SIZE == 0)
@@ -91,6 +97,61 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Indices into emAfEndpoints of all defined endpoints, sorted by endpoint id and
+// then by index, so that endpoints can be looked up by id with a binary search
+// instead of a scan over every endpoint.  An endpoint id can appear more than
+// once if a dynamic endpoint reuses the id of a fixed one.
+struct EndpointIndexEntry
+{
+    EndpointId endpoint;
+    uint16_t index;
+};
+EndpointIndexEntry endpointIndex[MAX_ENDPOINT_COUNT];
+uint16_t endpointIndexCount = 0;
+
+// Offset into attributeData of the attribute storage of each fixed endpoint,
+// followed by the total size of the fixed endpoints' storage.
+uint16_t fixedEndpointStorageOffsets[FIXED_ENDPOINT_COUNT + 1];
+
+bool operator<(const EndpointIndexEntry & a, const EndpointIndexEntry & b)
+{
+    return a.endpoint < b.endpoint || (a.endpoint == b.endpoint && a.index < b.index);
+}
+
+// Returns the first entry of endpointIndex for the given endpoint id; the
+// entries for that id follow it in increasing index order.
+const EndpointIndexEntry * firstEndpointIndexEntry(EndpointId endpoint)
+{
+    return std::lower_bound(endpointIndex, endpointIndex + endpointIndexCount, EndpointIndexEntry{ endpoint, 0 });
+}
+
+const EndpointIndexEntry * endEndpointIndexEntries()
+{
+    return endpointIndex + endpointIndexCount;
+}
+
+void addToEndpointIndex(uint16_t index)
+{
+    EndpointIndexEntry entry{ emAfEndpoints[index].endpoint, index };
+    EndpointIndexEntry * end = endpointIndex + endpointIndexCount;
+    EndpointIndexEntry * pos = std::lower_bound(endpointIndex, end, entry);
+    std::move_backward(pos, end, end + 1);
+    *pos = entry;
+    endpointIndexCount++;
+}
+
+void removeFromEndpointIndex(uint16_t index)
+{
+    EndpointIndexEntry entry{ emAfEndpoints[index].endpoint, index };
+    EndpointIndexEntry * end = endpointIndex + endpointIndexCount;
+    EndpointIndexEntry * pos = std::lower_bound(endpointIndex, end, entry);
+    if (pos != end && pos->endpoint == entry.endpoint && pos->index == index)
+    {
+        std::move(pos + 1, end, pos);
+        endpointIndexCount--;
+    }
+}
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -202,10 +263,13 @@ void emberAfEndpointConfigure()
 #endif // ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT > 0
 
     emberEndpointCount                = FIXED_ENDPOINT_COUNT;
+    endpointIndexCount                = 0;
+    fixedEndpointStorageOffsets[0]    = 0;
     DataVersion * currentDataVersions = fixedEndpointDataVersions;
     for (ep = 0; ep < FIXED_ENDPOINT_COUNT; ep++)
     {
         emAfEndpoints[ep].endpoint = fixedEndpoints[ep];
+        addToEndpointIndex(ep);
         emAfEndpoints[ep].deviceTypeList =
             Span<const EmberAfDeviceType>(&fixedDeviceTypeList[fixedDeviceTypeListOffsets[ep]], fixedDeviceTypeListLengths[ep]);
         emAfEndpoints[ep].endpointType = &generatedEmberAfEndpointTypes[fixedEmberAfEndpointTypes[ep]];
@@ -217,6 +281,9 @@ void emberAfEndpointConfigure()
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
         currentDataVersions += emberAfClusterCountByIndex(ep, /* server = */ true);
+
+        fixedEndpointStorageOffsets[ep + 1] =
+            static_cast<uint16_t>(fixedEndpointStorageOffsets[ep] + emAfEndpoints[ep].endpointType->endpointSize);
     }
 
 #if CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
@@ -245,12 +312,11 @@ uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
+    for (auto entry = firstEndpointIndexEntry(id); entry != endEndpointIndexEntries() && entry->endpoint == id; entry++)
     {
-        if (emAfEndpoints[index].endpoint == id)
+        if (entry->index >= FIXED_ENDPOINT_COUNT)
         {
-            return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
+            return static_cast<uint16_t>(entry->index - FIXED_ENDPOINT_COUNT);
         }
     }
     return kEmberInvalidEndpointIndex;
@@ -278,15 +344,17 @@ CHIP_ERROR emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberA
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (emberAfGetDynamicIndexFromEndpoint(id) != kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return CHIP_ERROR_ENDPOINT_EXISTS;
-        }
+        return CHIP_ERROR_ENDPOINT_EXISTS;
     }
 
-    emAfEndpoints[index].endpoint       = id;
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+    {
+        removeFromEndpointIndex(index);
+    }
+    emAfEndpoints[index].endpoint = id;
+    addToEndpointIndex(index);
     emAfEndpoints[index].deviceTypeList = deviceTypeList;
     emAfEndpoints[index].endpointType   = ep;
     emAfEndpoints[index].dataVersions   = dataVersionStorage.data();
@@ -317,13 +385,14 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
 {
     EndpointId ep = 0;
 
-    index = static_cast<uint8_t>(index + FIXED_ENDPOINT_COUNT);
+    index = static_cast<uint16_t>(index + FIXED_ENDPOINT_COUNT);
 
     if ((index < MAX_ENDPOINT_COUNT) && (emAfEndpoints[index].endpoint != kInvalidEndpointId) &&
         (emberAfEndpointIndexIsEnabled(index)))
     {
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
+        removeFromEndpointIndex(index);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -589,117 +658,103 @@ Status emAfReadOrWriteAttribute(const EmberAfAttributeSearchRecord * attRecord,
 {
     assertChipStackLockedByCurrentThread();
 
-    uint16_t attributeOffsetIndex = 0;
-
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t ep = findIndexFromEndpoint(attRecord->endpoint, true /* ignoreDisabledEndpoints */);
+    if (ep == kEmberInvalidEndpointIndex)
     {
-        // Is this a dynamic endpoint?
-        bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+        return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+    }
 
-        if (emAfEndpoints[ep].endpoint == attRecord->endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t clusterIndex;
-            if (!emberAfEndpointIndexIsEnabled(ep))
-            {
-                continue;
-            }
-            for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    // Is this a dynamic endpoint?
+    bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
+
+    // Dynamic endpoints are external and don't factor into storage size
+    uint16_t attributeOffsetIndex = isDynamicEndpoint ? 0 : fixedEndpointStorageOffsets[ep];
+
+    const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+    uint8_t clusterIndex;
+    for (clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+    {
+        const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+        if (emAfMatchCluster(cluster, attRecord))
+        { // Got the cluster
+            uint16_t attrIndex;
+            for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
             {
-                const EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
-                if (emAfMatchCluster(cluster, attRecord))
-                { // Got the cluster
-                    uint16_t attrIndex;
-                    for (attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+                const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                if (emAfMatchAttribute(cluster, am, attRecord))
+                { // Got the attribute
+                    // If passed metadata location is not null, populate
+                    if (metadata != nullptr)
                     {
-                        const EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
-                        if (emAfMatchAttribute(cluster, am, attRecord))
-                        { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != nullptr)
-                            {
-                                *metadata = am;
-                            }
+                        *metadata = am;
+                    }
 
+                    {
+                        uint8_t * attributeLocation = (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
+                                                                                           : attributeData + attributeOffsetIndex);
+                        uint8_t *src, *dst;
+                        if (write)
+                        {
+                            src = buffer;
+                            dst = attributeLocation;
+                            if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
                             {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == nullptr)
-                                    {
-                                        return Status::Success;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            am->attributeId))
-                                    {
-                                        return Status::UnsupportedAccess;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                          am, buffer)
-                                                  : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                         am, buffer, emberAfAttributeSize(am)));
-                                }
-
-                                // Internal storage is only supported for fixed endpoints
-                                if (!isDynamicEndpoint)
-                                {
-                                    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                }
-
-                                return Status::Failure;
+                                return Status::UnsupportedAccess;
                             }
                         }
                         else
-                        { // Not the attribute we are looking for
-                            // Increase the index if attribute is not externally stored
-                            if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                        {
+                            if (buffer == nullptr)
                             {
-                                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                                return Status::Success;
+                            }
+
+                            src = attributeLocation;
+                            dst = buffer;
+                            if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+                            {
+                                return Status::UnsupportedAccess;
                             }
                         }
-                    }
 
-                    // Attribute is not in the cluster.
-                    return Status::UnsupportedAttribute;
-                }
+                        // Is the attribute externally stored?
+                        if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+                        {
+                            return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
+                                                                                  am, buffer)
+                                          : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
+                                                                                 am, buffer, emberAfAttributeSize(am)));
+                        }
+
+                        // Internal storage is only supported for fixed endpoints
+                        if (!isDynamicEndpoint)
+                        {
+                            return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+                        }
 
-                // Not the cluster we are looking for
-                attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
+                        return Status::Failure;
+                    }
+                }
+                else
+                { // Not the attribute we are looking for
+                    // Increase the index if attribute is not externally stored
+                    if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                    {
+                        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emberAfAttributeSize(am));
+                    }
+                }
             }
 
-            // Cluster is not in the endpoint.
-            return Status::UnsupportedCluster;
+            // Attribute is not in the cluster.
+            return Status::UnsupportedAttribute;
         }
 
-        // Not the endpoint we are looking for
-        // Dynamic endpoints are external and don't factor into storage size
-        if (!isDynamicEndpoint)
-        {
-            attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + emAfEndpoints[ep].endpointType->endpointSize);
-        }
+        // Not the cluster we are looking for
+        attributeOffsetIndex = static_cast<uint16_t>(attributeOffsetIndex + cluster->clusterSize);
     }
-    return Status::UnsupportedEndpoint; // Sorry, endpoint was not found.
+
+    // Cluster is not in the endpoint.
+    return Status::UnsupportedCluster;
 }
 
 const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId)
@@ -743,18 +798,14 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    for (auto entry = firstEndpointIndexEntry(endpoint);
+         entry != endEndpointIndexEntries() && entry->endpoint == endpoint && entry->index < emberAfEndpointCount(); entry++)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
+        const EmberAfEndpointType * endpointType = emAfEndpoints[entry->index].endpointType;
+        uint8_t index                            = 0xFF;
+        if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
         {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
+            return index;
         }
     }
     return 0xFF;
@@ -846,20 +897,21 @@ const EmberAfCluster * emberAfFindClusterIncludingDisabledEndpoints(EndpointId e
     return nullptr;
 }
 
-static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
+uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     if (endpoint == kInvalidEndpointId)
     {
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    // Entries for the same endpoint id are sorted by index, so the first match
+    // is the one a scan of emAfEndpoints would find.
+    for (auto entry = firstEndpointIndexEntry(endpoint);
+         entry != endEndpointIndexEntries() && entry->endpoint == endpoint && entry->index < emberAfEndpointCount(); entry++)
     {
-        if (emAfEndpoints[epi].endpoint == endpoint &&
-            (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
+        if (!ignoreDisabledEndpoints || emAfEndpoints[entry->index].bitmask.Has(EmberAfEndpointOptions::isEnabled))
         {
-            return epi;
+            return entry->index;
         }
     }
     return kEmberInvalidEndpointIndex;
@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace chip {
+namespace benchmarks {
+
+namespace {
+
+const Registration * gFirstRegistration = nullptr;
+
+struct Result
+{
+    const char * name;
+    const char * error;
+    uint64_t iterations;
+    std::vector<double> samples; // sorted
+};
+
+double Median(const std::vector<double> & sorted)
+{
+    size_t middle = sorted.size() / 2;
+    return (sorted.size() % 2 != 0) ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+double Mean(const std::vector<double> & samples)
+{
+    double sum = 0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+    return sum / static_cast<double>(samples.size());
+}
+
+void WriteJsonString(FILE * file, const char * string)
+{
+    fputc('"', file);
+    for (; *string != '\0'; string++)
+    {
+        if (*string == '"' || *string == '\\')
+        {
+            fputc('\\', file);
+        }
+        fputc(*string, file);
+    }
+    fputc('"', file);
+}
+
+bool WriteJson(const char * path, const Options & options, const std::vector<Result> & results)
+{
+    FILE * file = (strcmp(path, "-") == 0) ? stdout : fopen(path, "w");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"context\": {\n");
+    fprintf(file, "    \"iterations\": %" PRIu64 ",\n", options.iterations);
+    fprintf(file, "    \"repetitions\": %" PRIu32 ",\n", options.repetitions);
+    fprintf(file, "    \"min_time_ns\": %lld\n", static_cast<long long>(options.minTime.count()));
+    fprintf(file, "  },\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result & result = results[i];
+        fprintf(file, "%s\n    {\n      \"name\": ", (i == 0) ? "" : ",");
+        WriteJsonString(file, result.name);
+        if (result.error != nullptr)
+        {
+            fprintf(file, ",\n      \"error\": ");
+            WriteJsonString(file, result.error);
+            fprintf(file, "\n    }");
+            continue;
+        }
+        fprintf(file, ",\n      \"iterations\": %" PRIu64 ",\n", result.iterations);
+        fprintf(file, "      \"repetitions\": %zu,\n", result.samples.size());
+        fprintf(file, "      \"ns_per_op\": { \"median\": %.2f, \"mean\": %.2f, \"min\": %.2f, \"max\": %.2f }\n    }",
+                Median(result.samples), Mean(result.samples), result.samples.front(), result.samples.back());
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    bool success = (ferror(file) == 0);
+    if (file != stdout)
+    {
+        success = (fclose(file) == 0) && success;
+    }
+    if (!success)
+    {
+        fprintf(stderr, "Failed to write %s\n", path);
+    }
+    return success;
+}
+
+} // namespace
+
+State::State(const Options & options) : mOptions(options)
+{
+    if (mOptions.iterations > 0)
+    {
+        mIterations  = mOptions.iterations;
+        mCalibrating = false;
+    }
+}
+
+void State::PauseTiming()
+{
+    if (mTiming)
+    {
+        mElapsed += Clock::now() - mResumedAt;
+        mTiming = false;
+    }
+}
+
+void State::ResumeTiming()
+{
+    if (!mTiming)
+    {
+        mTiming    = true;
+        mResumedAt = Clock::now();
+    }
+}
+
+void State::SkipWithError(const char * message)
+{
+    mError     = message;
+    mRemaining = 0;
+}
+
+void State::StartBatch(uint64_t iterations)
+{
+    mIterations = iterations;
+    // This call of KeepRunning() returns true, which is the first iteration of the batch.
+    mRemaining = iterations - 1;
+    mElapsed   = Clock::duration::zero();
+    mTiming    = false;
+    ResumeTiming();
+}
+
+bool State::NextBatch()
+{
+    PauseTiming();
+
+    if (!mStarted)
+    {
+        mStarted = true;
+        VerifyOrReturnValue(mError == nullptr, false);
+        StartBatch(mIterations);
+        return true;
+    }
+
+    VerifyOrReturnValue(mError == nullptr, false);
+
+    if (mCalibrating)
+    {
+        if (mElapsed < mOptions.minTime && mIterations < kMaxIterations)
+        {
+            // Aim a little past the minimum time, growing by at most 10x per batch so that a noisy short batch can't
+            // cause a very long one.
+            double estimate = static_cast<double>(mIterations) * 1.4 * static_cast<double>(mOptions.minTime.count()) /
+                static_cast<double>(std::max<Clock::rep>(mElapsed.count(), 1));
+            uint64_t next = std::min<uint64_t>(static_cast<uint64_t>(estimate), mIterations * 10);
+            StartBatch(std::min(std::max(next, mIterations + 1), kMaxIterations));
+            return true;
+        }
+        mCalibrating = false;
+        StartBatch(mIterations);
+        return true;
+    }
+
+    mSamples.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(mElapsed).count()) /
+                       static_cast<double>(mIterations));
+    VerifyOrReturnValue(mSamples.size() < mOptions.repetitions, false);
+    StartBatch(mIterations);
+    return true;
+}
+
+Registration::Registration(const char * name, BenchmarkFunction function) :
+    mName(name), mFunction(function), mNext(gFirstRegistration)
+{
+    gFirstRegistration = this;
+}
+
+const Registration * Registration::GetFirst()
+{
+    return gFirstRegistration;
+}
+
+bool RunBenchmarks(const Options & options, const char * filter, const char * jsonPath)
+{
+    // Registration order depends on link order, so sort by name to keep runs comparable.
+    std::vector<const Registration *> selected;
+    for (auto registration = Registration::GetFirst(); registration != nullptr; registration = registration->GetNext())
+    {
+        if (filter == nullptr || strstr(registration->GetName(), filter) != nullptr)
+        {
+            selected.push_back(registration);
+        }
+    }
+    std::sort(selected.begin(), selected.end(),
+              [](const Registration * a, const Registration * b) { return strcmp(a->GetName(), b->GetName()) < 0; });
+
+    bool success = true;
+    std::vector<Result> results;
+    for (auto registration : selected)
+    {
+        State state(options);
+        registration->GetFunction()(state);
+
+        Result result{ registration->GetName(), state.GetError(), state.GetIterations(), state.GetSamples() };
+        if (result.error == nullptr && result.samples.size() < options.repetitions)
+        {
+            result.error = "Benchmark returned before completing its repetitions";
+        }
+
+        // Human readable summary on stdout, unless stdout carries the JSON.
+        FILE * summary = (jsonPath != nullptr && strcmp(jsonPath, "-") == 0) ? stderr : stdout;
+        if (result.error != nullptr)
+        {
+            fprintf(summary, "%-48s FAILED: %s\n", result.name, result.error);
+            success = false;
+        }
+        else
+        {
+            std::sort(result.samples.begin(), result.samples.end());
+            fprintf(summary, "%-48s %12" PRIu64 " iterations %14.2f ns/op (min %.2f, max %.2f)\n", result.name,
+                    result.iterations, Median(result.samples), result.samples.front(), result.samples.back());
+        }
+        results.push_back(std::move(result));
+    }
+
+    if (jsonPath != nullptr)
+    {
+        success = WriteJson(jsonPath, options, results) && success;
+    }
+    return success;
+}
+
+} // namespace benchmarks
+} // namespace chip
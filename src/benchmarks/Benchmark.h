@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a minimal microbenchmark harness: a registry of benchmark functions, and the State object that
+ *      drives and times their measured loop.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace chip {
+namespace benchmarks {
+
+struct Options
+{
+    // Iterations per repetition. 0 calibrates the count so that a repetition takes at least minTime.
+    uint64_t iterations              = 0;
+    uint32_t repetitions             = 5;
+    std::chrono::nanoseconds minTime = std::chrono::milliseconds(100);
+};
+
+/**
+ * Drives the measured loop of a benchmark, which is written as
+ *
+ *     void BenchmarkSomething(State & state)
+ *     {
+ *         // Set up.
+ *         while (state.KeepRunning())
+ *         {
+ *             // The measured operation.
+ *         }
+ *         // Tear down.
+ *     }
+ *
+ * The loop first runs batches of growing size until one takes at least the minimum time, which also warms up caches and
+ * pools, and then runs one batch of that size per repetition. Setup and teardown therefore run once per benchmark, and
+ * the per-iteration cost of KeepRunning() is a decrement.
+ */
+class State
+{
+public:
+    explicit State(const Options & options);
+
+    bool KeepRunning()
+    {
+        if (mRemaining > 0)
+        {
+            mRemaining--;
+            return true;
+        }
+        return NextBatch();
+    }
+
+    /**
+     * Exclude the work between PauseTiming() and ResumeTiming() from the measurement, e.g. per-iteration setup. Each
+     * call reads the clock, so prefer preparing work in batches when the measured operation is short.
+     */
+    void PauseTiming();
+    void ResumeTiming();
+
+    /**
+     * Stop the benchmark and report it as failed with @a message, which must be a string literal. The measured loop
+     * exits at the next KeepRunning().
+     */
+    void SkipWithError(const char * message);
+
+    const char * GetError() const { return mError; }
+    uint64_t GetIterations() const { return mIterations; }
+
+    // Nanoseconds per iteration of each measured repetition.
+    const std::vector<double> & GetSamples() const { return mSamples; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint64_t kMaxIterations = 1000000000;
+
+    bool NextBatch();
+    void StartBatch(uint64_t iterations);
+
+    Options mOptions;
+    uint64_t mIterations = 1;
+    uint64_t mRemaining  = 0;
+    bool mStarted        = false;
+    bool mCalibrating    = true;
+    bool mTiming         = false;
+    Clock::time_point mResumedAt;
+    Clock::duration mElapsed{ 0 };
+    std::vector<double> mSamples;
+    const char * mError = nullptr;
+};
+
+/**
+ * Keep the compiler from optimizing away the computation of @a value, e.g. a decoded value that is otherwise unused.
+ */
+template <typename T>
+inline void DoNotOptimize(const T & value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+using BenchmarkFunction = void (*)(State & state);
+
+/**
+ * Registers a benchmark at static initialization time, see CHIP_BENCHMARK.
+ */
+class Registration
+{
+public:
+    Registration(const char * name, BenchmarkFunction function);
+
+    const char * GetName() const { return mName; }
+    BenchmarkFunction GetFunction() const { return mFunction; }
+    const Registration * GetNext() const { return mNext; }
+
+    static const Registration * GetFirst();
+
+private:
+    const char * mName;
+    BenchmarkFunction mFunction;
+    const Registration * mNext;
+};
+
+/**
+ * Run every registered benchmark whose name contains @a filter (all of them if null), printing a summary line for each
+ * to stdout and, if @a jsonPath is not null, writing the results as JSON to that file ("-" for stdout).
+ *
+ * @return true if every benchmark that ran succeeded and the results were written.
+ */
+bool RunBenchmarks(const Options & options, const char * filter, const char * jsonPath);
+
+} // namespace benchmarks
+} // namespace chip
+
+/**
+ * Register @a function, a void(State &), as the benchmark @a name. Names are "<Component>/<Operation>", and
+ * benchmarks run in name order.
+ */
+#define CHIP_BENCHMARK(name, function)                                                                                             \
+    static const ::chip::benchmarks::Registration sBenchmarkRegistration_##function(name, function)
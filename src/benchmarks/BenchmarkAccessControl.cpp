@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of AccessControl::Check against a full fabric of entries in the example delegate.
+ */
+
+#include "Benchmark.h"
+
+#include <access/AccessControl.h>
+#include <access/examples/ExampleAccessControlDelegate.h>
+#include <lib/support/CodeUtils.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Access;
+
+constexpr FabricIndex kFabricIndex   = 1;
+constexpr NodeId kSubjectNodeId      = 0x0123456789ABCDEF;
+constexpr NodeId kOtherNodeIds[]     = { 0x1111111111111111, 0x2222222222222222, 0x3333333333333333, 0x4444444444444444 };
+constexpr ClusterId kOnOffCluster    = 0x0000'0006;
+constexpr ClusterId kColorCluster    = 0x0000'0300;
+constexpr uint16_t kEndpointCycle    = 1024;
+constexpr NodeId kUnknownSubjectNode = 0x5555555555555555;
+
+class DeviceTypeResolver : public AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} gDeviceTypeResolver;
+
+AccessControl gAccessControl;
+
+CHIP_ERROR AddEntry(Privilege privilege, AuthMode authMode, const NodeId * subjects, size_t subjectCount,
+                    const AccessControl::Entry::Target * target)
+{
+    AccessControl::Entry entry;
+    ReturnErrorOnFailure(gAccessControl.PrepareEntry(entry));
+    ReturnErrorOnFailure(entry.SetFabricIndex(kFabricIndex));
+    ReturnErrorOnFailure(entry.SetPrivilege(privilege));
+    ReturnErrorOnFailure(entry.SetAuthMode(authMode));
+    for (size_t i = 0; i < subjectCount; i++)
+    {
+        ReturnErrorOnFailure(entry.AddSubject(nullptr, subjects[i]));
+    }
+    if (target != nullptr)
+    {
+        ReturnErrorOnFailure(entry.AddTarget(nullptr, *target));
+    }
+    return gAccessControl.CreateEntry(nullptr, entry);
+}
+
+// Fill the fabric with entries such that only the last one grants the subject access, so that an uncached check
+// evaluates all of them.
+CHIP_ERROR SetUpAccessControl()
+{
+    ReturnErrorOnFailure(gAccessControl.Init(Examples::GetAccessControlDelegate(), gDeviceTypeResolver));
+
+    // The example delegate keeps its entries across Finish(), so remove those of a previous benchmark.
+    while (gAccessControl.DeleteEntry(0) == CHIP_NO_ERROR)
+    {
+    }
+
+    AccessControl::Entry::Target colorTarget;
+    colorTarget.flags   = AccessControl::Entry::Target::kCluster;
+    colorTarget.cluster = kColorCluster;
+
+    AccessControl::Entry::Target onOffTarget;
+    onOffTarget.flags   = AccessControl::Entry::Target::kCluster;
+    onOffTarget.cluster = kOnOffCluster;
+
+    ReturnErrorOnFailure(AddEntry(Privilege::kAdminister, AuthMode::kCase, kOtherNodeIds, ArraySize(kOtherNodeIds), nullptr));
+    ReturnErrorOnFailure(AddEntry(Privilege::kOperate, AuthMode::kCase, &kSubjectNodeId, 1, &colorTarget));
+    ReturnErrorOnFailure(AddEntry(Privilege::kManage, AuthMode::kCase, kOtherNodeIds, ArraySize(kOtherNodeIds), &onOffTarget));
+    ReturnErrorOnFailure(AddEntry(Privilege::kOperate, AuthMode::kCase, &kSubjectNodeId, 1, &onOffTarget));
+    return CHIP_NO_ERROR;
+}
+
+SubjectDescriptor MakeSubjectDescriptor(NodeId subject)
+{
+    SubjectDescriptor subjectDescriptor;
+    subjectDescriptor.fabricIndex = kFabricIndex;
+    subjectDescriptor.authMode    = AuthMode::kCase;
+    subjectDescriptor.subject     = subject;
+    return subjectDescriptor;
+}
+
+template <typename PathForIteration>
+void BenchmarkCheck(benchmarks::State & state, NodeId subject, CHIP_ERROR expected, PathForIteration pathForIteration)
+{
+    CHIP_ERROR err = SetUpAccessControl();
+    if (err == CHIP_NO_ERROR)
+    {
+        const SubjectDescriptor subjectDescriptor = MakeSubjectDescriptor(subject);
+        uint32_t iteration                        = 0;
+        while (state.KeepRunning())
+        {
+            if (gAccessControl.Check(subjectDescriptor, pathForIteration(iteration++), Privilege::kView) != expected)
+            {
+                state.SkipWithError("Check returned an unexpected result");
+            }
+        }
+    }
+    else
+    {
+        state.SkipWithError("Setting up access control failed");
+    }
+    gAccessControl.Finish();
+}
+
+// A subscription or wildcard read checks the same subject and path repeatedly.
+void BenchmarkAccessControlCheckSamePath(benchmarks::State & state)
+{
+    BenchmarkCheck(state, kSubjectNodeId, CHIP_NO_ERROR,
+                   [](uint32_t iteration) { return RequestPath{ .cluster = kOnOffCluster, .endpoint = 1 }; });
+}
+CHIP_BENCHMARK("AccessControl/CheckSamePath", BenchmarkAccessControlCheckSamePath);
+
+// Cycle through more paths than any decision cache holds, so every check evaluates the entries.
+void BenchmarkAccessControlCheckDistinctPaths(benchmarks::State & state)
+{
+    BenchmarkCheck(state, kSubjectNodeId, CHIP_NO_ERROR, [](uint32_t iteration) {
+        return RequestPath{ .cluster = kOnOffCluster, .endpoint = static_cast<EndpointId>(iteration % kEndpointCycle) };
+    });
+}
+CHIP_BENCHMARK("AccessControl/CheckDistinctPaths", BenchmarkAccessControlCheckDistinctPaths);
+
+void BenchmarkAccessControlCheckDenied(benchmarks::State & state)
+{
+    BenchmarkCheck(state, kUnknownSubjectNode, CHIP_ERROR_ACCESS_DENIED, [](uint32_t iteration) {
+        return RequestPath{ .cluster = kOnOffCluster, .endpoint = static_cast<EndpointId>(iteration % kEndpointCycle) };
+    });
+}
+CHIP_BENCHMARK("AccessControl/CheckDenied", BenchmarkAccessControlCheckDenied);
+
+} // namespace
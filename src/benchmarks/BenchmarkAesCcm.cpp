@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the AES-CCM encryption and decryption of a message payload with a session key, with the one-shot
+ *      AES_CCM_encrypt()/AES_CCM_decrypt() functions that set up the cipher for every message, and with an
+ *      AesCcm128Cipher bound to the key as CryptoContext uses it. Payloads are a typical 100 byte message and a full
+ *      1232 byte IPv6 datagram payload.
+ */
+
+#include "Benchmark.h"
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Crypto;
+
+constexpr size_t kMaxPayloadLength = 1232;
+
+// The message header that a secure message authenticates.
+constexpr uint8_t kAad[]   = { 0x00, 0x34, 0x12, 0x00, 0x78, 0x56, 0x34, 0x12 };
+constexpr uint8_t kNonce[] = { 0x00, 0x78, 0x56, 0x34, 0x12, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static_assert(sizeof(kNonce) == kAES_CCM128_Nonce_Length, "Wrong nonce length");
+
+// The session key, and one message encrypted with it for the decryption benchmarks.
+class SessionKey
+{
+public:
+    ~SessionKey() { mKeystore.DestroyKey(mKey); }
+
+    CHIP_ERROR Init(size_t payloadLength)
+    {
+        Symmetric128BitsKeyByteArray keyMaterial;
+        memset(keyMaterial, 0x5a, sizeof(keyMaterial));
+        ReturnErrorOnFailure(mKeystore.CreateKey(keyMaterial, mKey));
+
+        mPayloadLength = payloadLength;
+        memset(mPlaintext, 0xa5, mPayloadLength);
+        return AES_CCM_encrypt(mPlaintext, mPayloadLength, kAad, sizeof(kAad), mKey, kNonce, sizeof(kNonce), mCiphertext, mTag,
+                               sizeof(mTag));
+    }
+
+    DefaultSessionKeystore mKeystore;
+    Aes128KeyHandle mKey;
+    size_t mPayloadLength = 0;
+    uint8_t mPlaintext[kMaxPayloadLength];
+    uint8_t mCiphertext[kMaxPayloadLength];
+    uint8_t mTag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+};
+
+// The one-shot functions, as used before ciphers were bound to session keys and still used for group keys.
+struct OneShot
+{
+    explicit OneShot(const Aes128KeyHandle & key) : mKey(key) {}
+
+    CHIP_ERROR Encrypt(const SessionKey & session, uint8_t * ciphertext, uint8_t * tag)
+    {
+        return AES_CCM_encrypt(session.mPlaintext, session.mPayloadLength, kAad, sizeof(kAad), mKey, kNonce, sizeof(kNonce),
+                               ciphertext, tag, CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES);
+    }
+
+    CHIP_ERROR Decrypt(const SessionKey & session, uint8_t * plaintext)
+    {
+        return AES_CCM_decrypt(session.mCiphertext, session.mPayloadLength, kAad, sizeof(kAad), session.mTag,
+                               sizeof(session.mTag), mKey, kNonce, sizeof(kNonce), plaintext);
+    }
+
+    const Aes128KeyHandle & mKey;
+};
+
+// An AesCcm128Cipher bound to the session key, as CryptoContext uses it for unicast sessions.
+struct BoundCipher
+{
+    explicit BoundCipher(const Aes128KeyHandle & key) { mCipher.Init(key); }
+
+    CHIP_ERROR Encrypt(const SessionKey & session, uint8_t * ciphertext, uint8_t * tag)
+    {
+        return mCipher.Encrypt(session.mPlaintext, session.mPayloadLength, kAad, sizeof(kAad), kNonce, sizeof(kNonce), ciphertext,
+                               tag, CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES);
+    }
+
+    CHIP_ERROR Decrypt(const SessionKey & session, uint8_t * plaintext)
+    {
+        return mCipher.Decrypt(session.mCiphertext, session.mPayloadLength, kAad, sizeof(kAad), session.mTag,
+                               sizeof(session.mTag), kNonce, sizeof(kNonce), plaintext);
+    }
+
+    AesCcm128Cipher mCipher;
+};
+
+template <class Cipher, size_t kPayloadLength>
+void Encrypt(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    {
+        SessionKey session;
+        if (session.Init(kPayloadLength) == CHIP_NO_ERROR)
+        {
+            Cipher cipher(session.mKey);
+            uint8_t ciphertext[kPayloadLength];
+            uint8_t tag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+            while (state.KeepRunning())
+            {
+                if (cipher.Encrypt(session, ciphertext, tag) != CHIP_NO_ERROR)
+                {
+                    state.SkipWithError("Encrypting the message failed");
+                    break;
+                }
+            }
+            benchmarks::DoNotOptimize(tag);
+        }
+        else
+        {
+            state.SkipWithError("Setting up the session key failed");
+        }
+    }
+    Platform::MemoryShutdown();
+}
+
+template <class Cipher, size_t kPayloadLength>
+void Decrypt(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    {
+        SessionKey session;
+        if (session.Init(kPayloadLength) == CHIP_NO_ERROR)
+        {
+            Cipher cipher(session.mKey);
+            uint8_t plaintext[kPayloadLength];
+            while (state.KeepRunning())
+            {
+                if (cipher.Decrypt(session, plaintext) != CHIP_NO_ERROR)
+                {
+                    state.SkipWithError("Decrypting the message failed");
+                    break;
+                }
+            }
+            benchmarks::DoNotOptimize(plaintext);
+        }
+        else
+        {
+            state.SkipWithError("Setting up the session key failed");
+        }
+    }
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkOneShotEncrypt100(benchmarks::State & state)
+{
+    Encrypt<OneShot, 100>(state);
+}
+CHIP_BENCHMARK("AesCcm/OneShotEncrypt100", BenchmarkOneShotEncrypt100);
+
+void BenchmarkCipherEncrypt100(benchmarks::State & state)
+{
+    Encrypt<BoundCipher, 100>(state);
+}
+CHIP_BENCHMARK("AesCcm/CipherEncrypt100", BenchmarkCipherEncrypt100);
+
+void BenchmarkOneShotDecrypt100(benchmarks::State & state)
+{
+    Decrypt<OneShot, 100>(state);
+}
+CHIP_BENCHMARK("AesCcm/OneShotDecrypt100", BenchmarkOneShotDecrypt100);
+
+void BenchmarkCipherDecrypt100(benchmarks::State & state)
+{
+    Decrypt<BoundCipher, 100>(state);
+}
+CHIP_BENCHMARK("AesCcm/CipherDecrypt100", BenchmarkCipherDecrypt100);
+
+void BenchmarkOneShotEncrypt1232(benchmarks::State & state)
+{
+    Encrypt<OneShot, kMaxPayloadLength>(state);
+}
+CHIP_BENCHMARK("AesCcm/OneShotEncrypt1232", BenchmarkOneShotEncrypt1232);
+
+void BenchmarkCipherEncrypt1232(benchmarks::State & state)
+{
+    Encrypt<BoundCipher, kMaxPayloadLength>(state);
+}
+CHIP_BENCHMARK("AesCcm/CipherEncrypt1232", BenchmarkCipherEncrypt1232);
+
+} // namespace
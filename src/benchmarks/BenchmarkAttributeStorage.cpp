@@ -0,0 +1,163 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the attribute-storage endpoint lookups that every read, write and report goes through, for a
+ *      bridge with 256 dynamic endpoints, and of adding and removing one of its dynamic endpoints.
+ */
+
+#include "Benchmark.h"
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/DataModelHandler.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <lib/support/CodeUtils.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr uint16_t kNumDynamicEndpoints = 256;
+
+// Above the ids of the fixed endpoints of the controller data model.
+constexpr EndpointId kFirstDynamicEndpointId = 1000;
+
+//clang-format off
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(bridgedClusterAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(0x00000001, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE(0x00000002, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE(0x00000003, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE(0x00000004, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(bridgedEndpointClusters)
+DECLARE_DYNAMIC_CLUSTER(Clusters::UnitTesting::Id, bridgedClusterAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(bridgedEndpoint, bridgedEndpointClusters);
+//clang-format on
+
+DataVersion gDataVersions[kNumDynamicEndpoints][ArraySize(bridgedEndpointClusters)];
+
+// Dynamic endpoint ids are not in slot order, as a bridge reusing slots for newly discovered devices ends up with.
+EndpointId DynamicEndpointId(uint16_t index)
+{
+    return static_cast<EndpointId>(kFirstDynamicEndpointId + (index * 7919u) % kNumDynamicEndpoints);
+}
+
+CHIP_ERROR SetDynamicEndpoint(uint16_t index)
+{
+    return emberAfSetDynamicEndpoint(index, DynamicEndpointId(index), &bridgedEndpoint, Span<DataVersion>(gDataVersions[index]));
+}
+
+// Runs [measure] with kNumDynamicEndpoints dynamic endpoints set.
+template <typename Measure>
+void WithDynamicEndpoints(benchmarks::State & state, Measure measure)
+{
+    VerifyOrReturn(CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT >= kNumDynamicEndpoints,
+                   state.SkipWithError("CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT is below 256"));
+
+    Test::AppContext ctx;
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (ctx.SetUp() == CHIP_NO_ERROR)
+    {
+        InitDataModelHandler();
+
+        uint16_t numSet = 0;
+        while (numSet < kNumDynamicEndpoints && SetDynamicEndpoint(numSet) == CHIP_NO_ERROR)
+        {
+            numSet++;
+        }
+
+        if (numSet == kNumDynamicEndpoints)
+        {
+            measure();
+        }
+        else
+        {
+            state.SkipWithError("Setting the dynamic endpoints failed");
+        }
+
+        for (uint16_t i = 0; i < numSet; i++)
+        {
+            emberAfClearDynamicEndpoint(i);
+        }
+        ctx.TearDown();
+    }
+    else
+    {
+        state.SkipWithError("Setting up the application context failed");
+    }
+    ctx.TearDownTestSuite();
+}
+
+// The lookup of an attribute's metadata, done for every attribute path of a read, write or report.
+void BenchmarkLocateAttribute(benchmarks::State & state)
+{
+    WithDynamicEndpoints(state, [&state]() {
+        uint16_t next = 0;
+        while (state.KeepRunning())
+        {
+            const EndpointId endpoint = DynamicEndpointId(next);
+            next                      = static_cast<uint16_t>((next + 97) % kNumDynamicEndpoints);
+            const EmberAfAttributeMetadata * metadata =
+                emberAfLocateAttributeMetadata(endpoint, Clusters::UnitTesting::Id, 0x00000004);
+            benchmarks::DoNotOptimize(metadata);
+        }
+    });
+}
+CHIP_BENCHMARK("AttributeStorage/LocateAttribute256", BenchmarkLocateAttribute);
+
+// The endpoint lookup behind emberAfContainsServer(), emberAfClusterIndex() and the other per-endpoint queries.
+void BenchmarkIndexFromEndpoint(benchmarks::State & state)
+{
+    WithDynamicEndpoints(state, [&state]() {
+        uint16_t next = 0;
+        while (state.KeepRunning())
+        {
+            const EndpointId endpoint = DynamicEndpointId(next);
+            next                      = static_cast<uint16_t>((next + 97) % kNumDynamicEndpoints);
+            uint16_t index            = emberAfIndexFromEndpoint(endpoint);
+            benchmarks::DoNotOptimize(index);
+        }
+    });
+}
+CHIP_BENCHMARK("AttributeStorage/IndexFromEndpoint256", BenchmarkIndexFromEndpoint);
+
+// A bridged device going away and coming back: its dynamic endpoint is cleared and set again.
+void BenchmarkSetAndClearDynamicEndpoint(benchmarks::State & state)
+{
+    WithDynamicEndpoints(state, [&state]() {
+        uint16_t next = 0;
+        while (state.KeepRunning())
+        {
+            emberAfClearDynamicEndpoint(next);
+            if (SetDynamicEndpoint(next) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Setting the dynamic endpoint again failed");
+                break;
+            }
+            next = static_cast<uint16_t>((next + 97) % kNumDynamicEndpoints);
+        }
+    });
+}
+CHIP_BENCHMARK("AttributeStorage/SetAndClearDynamicEndpoint256", BenchmarkSetAndClearDynamicEndpoint);
+
+} // namespace
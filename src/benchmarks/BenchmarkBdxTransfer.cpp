@@ -0,0 +1,350 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of BDX transfers over the TCP transport on the loopback interface, from a Sender that serves an image like
+ *      the OTA Provider app to a Receiver that downloads it like the OTA Requestor app: lock-step Receiver Drive transfers,
+ *      which is how OTA images are downloaded today, and Asynchronous transfers that keep several Blocks in flight. Each
+ *      operation is a transfer of a 1 MiB image, so 1e9 / (ns/op) is the transfer rate in MiB/s.
+ */
+
+#include "Benchmark.h"
+
+#include <inet/IPAddress.h>
+#include <inet/TCPEndPointImpl.h>
+#include <lib/support/BitFlags.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <protocols/bdx/BdxTransferSession.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+#include <transport/raw/PeerAddress.h>
+#include <transport/raw/TCP.h>
+
+#include <string.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::bdx;
+
+constexpr uint16_t kListenPort                         = CHIP_PORT;
+constexpr uint32_t kImageSize                          = 1024 * 1024;
+constexpr uint16_t kOtaBlockSize                       = 1024; // the block size of the OTA Provider and Requestor apps
+constexpr System::Clock::Timeout kBdxTimeout           = System::Clock::Seconds16(5);
+constexpr System::Clock::Milliseconds32 kTransferLimit = System::Clock::Milliseconds32(10000);
+constexpr uint16_t kExchangeId                         = 1;
+constexpr char kFileDesignator[]                       = "ota-image.bin";
+
+// A connection from the Receiver to the listening socket of the Sender, and the one it accepts.
+using LoopbackTCP = Transport::TCP<2, 4>;
+
+/**
+ * Runs both sides of a transfer over one TCP transport: the Receiver connects to the listening port of the transport, so
+ * the messages the Receiver gets come from that port and the ones the Sender gets come from the port of the connection.
+ */
+class LoopbackTransfer : public Transport::RawTransportDelegate
+{
+public:
+    LoopbackTransfer(Transport::TCPBase & tcp, const Inet::IPAddress & loopback, TransferControlFlags controlMode,
+                     uint16_t blockSize) :
+        mTCP(tcp),
+        mControlMode(controlMode), mBlockSize(blockSize)
+    {
+        mReceiver.mPeer        = Transport::PeerAddress::TCP(loopback, kListenPort);
+        mReceiver.mIsInitiator = true;
+        memset(mBlockData, 0x5a, sizeof(mBlockData));
+    }
+
+    CHIP_ERROR Start();
+    bool IsDone() const { return mDone || mError != CHIP_NO_ERROR; }
+    CHIP_ERROR GetResult() const;
+
+    void HandleMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msg) override;
+
+private:
+    struct Side
+    {
+        TransferSession mTransfer;
+        Transport::PeerAddress mPeer;
+        bool mIsInitiator       = false;
+        uint32_t mMessageCounter = 0;
+    };
+
+    void Pump(Side & side);
+    CHIP_ERROR HandleOutput(Side & side, TransferSession::OutputEvent & event);
+    CHIP_ERROR Send(Side & side, TransferSession::OutputEvent & event);
+    CHIP_ERROR PrepareNextBlock();
+
+    Transport::TCPBase & mTCP;
+    const TransferControlFlags mControlMode;
+    const uint16_t mBlockSize;
+
+    Side mSender;
+    Side mReceiver;
+    uint8_t mBlockData[kMaxLargePayloadBlockSize];
+    uint32_t mBytesSent     = 0;
+    uint32_t mBytesReceived = 0;
+    bool mDone              = false;
+    CHIP_ERROR mError       = CHIP_NO_ERROR;
+};
+
+CHIP_ERROR LoopbackTransfer::Start()
+{
+    mSender.mTransfer.Reset();
+    mReceiver.mTransfer.Reset();
+    mBytesSent     = 0;
+    mBytesReceived = 0;
+    mDone          = false;
+    mError         = CHIP_NO_ERROR;
+
+    // Like an OTA Requestor over TCP, propose Asynchronous mode along with Receiver Drive to fall back to.
+    const BitFlags<TransferControlFlags> controlOpts(mControlMode, TransferControlFlags::kReceiverDrive);
+    ReturnErrorOnFailure(mSender.mTransfer.WaitForTransfer(TransferRole::kSender, controlOpts, mBlockSize, kBdxTimeout));
+
+    TransferSession::TransferInitData initData;
+    initData.TransferCtlFlags = controlOpts;
+    initData.MaxBlockSize     = mBlockSize;
+    initData.FileDesignator   = reinterpret_cast<const uint8_t *>(kFileDesignator);
+    initData.FileDesLength    = static_cast<uint16_t>(strlen(kFileDesignator));
+    ReturnErrorOnFailure(mReceiver.mTransfer.StartTransfer(TransferRole::kReceiver, initData, kBdxTimeout));
+
+    Pump(mReceiver);
+    return mError;
+}
+
+CHIP_ERROR LoopbackTransfer::GetResult() const
+{
+    ReturnErrorOnFailure(mError);
+    VerifyOrReturnError(mDone, CHIP_ERROR_TIMEOUT);
+    return (mBytesReceived == kImageSize) ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL;
+}
+
+void LoopbackTransfer::HandleMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msg)
+{
+    VerifyOrReturn(mError == CHIP_NO_ERROR);
+
+    const bool toReceiver = (source.GetPort() == kListenPort);
+    Side & side           = toReceiver ? mReceiver : mSender;
+    if (!toReceiver)
+    {
+        side.mPeer = source;
+    }
+
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    mError = packetHeader.DecodeAndConsume(msg);
+    SuccessOrExit(mError);
+    mError = payloadHeader.DecodeAndConsume(msg);
+    SuccessOrExit(mError);
+    mError = side.mTransfer.HandleMessageReceived(payloadHeader, std::move(msg), System::SystemClock().GetMonotonicTimestamp());
+    SuccessOrExit(mError);
+
+    Pump(side);
+
+exit:
+    return;
+}
+
+void LoopbackTransfer::Pump(Side & side)
+{
+    while (mError == CHIP_NO_ERROR)
+    {
+        TransferSession::OutputEvent event;
+        side.mTransfer.PollOutput(event, System::SystemClock().GetMonotonicTimestamp());
+        if (event.EventType != TransferSession::OutputEventType::kNone)
+        {
+            mError = HandleOutput(side, event);
+        }
+        // The Sender sends a Block whenever its TransferSession allows it: when a Block is queried in Receiver Drive, and as
+        // long as fewer than TransferSession::kMaxBlocksInFlight are unacknowledged in Asynchronous mode.
+        else if (&side == &mSender && mSender.mTransfer.CanPrepareBlock())
+        {
+            mError = PrepareNextBlock();
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+CHIP_ERROR LoopbackTransfer::HandleOutput(Side & side, TransferSession::OutputEvent & event)
+{
+    switch (event.EventType)
+    {
+    case TransferSession::OutputEventType::kMsgToSend:
+        return Send(side, event);
+    case TransferSession::OutputEventType::kInitReceived: {
+        TransferSession::TransferAcceptData acceptData;
+        acceptData.ControlMode  = mControlMode;
+        acceptData.MaxBlockSize = side.mTransfer.GetTransferBlockSize();
+        acceptData.StartOffset  = 0;
+        acceptData.Length       = kImageSize;
+        return side.mTransfer.AcceptTransfer(acceptData);
+    }
+    case TransferSession::OutputEventType::kAcceptReceived:
+        return (mControlMode == TransferControlFlags::kReceiverDrive) ? side.mTransfer.PrepareBlockQuery() : CHIP_NO_ERROR;
+    case TransferSession::OutputEventType::kBlockReceived:
+        mBytesReceived += static_cast<uint32_t>(event.blockdata.Length);
+        if (event.blockdata.IsEof || mControlMode == TransferControlFlags::kAsync)
+        {
+            return side.mTransfer.PrepareBlockAck();
+        }
+        return side.mTransfer.PrepareBlockQuery();
+    case TransferSession::OutputEventType::kAckEOFReceived:
+        mDone = true;
+        return CHIP_NO_ERROR;
+    case TransferSession::OutputEventType::kStatusReceived:
+    case TransferSession::OutputEventType::kInternalError:
+    case TransferSession::OutputEventType::kTransferTimeout:
+        return CHIP_ERROR_INTERNAL;
+    default:
+        return CHIP_NO_ERROR;
+    }
+}
+
+CHIP_ERROR LoopbackTransfer::Send(Side & side, TransferSession::OutputEvent & event)
+{
+    PacketHeader packetHeader;
+    packetHeader.SetMessageCounter(side.mMessageCounter++);
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetMessageType(event.msgTypeData.ProtocolId, event.msgTypeData.MessageType)
+        .SetExchangeID(kExchangeId)
+        .SetInitiator(side.mIsInitiator);
+
+    ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(event.MsgData));
+    ReturnErrorOnFailure(packetHeader.EncodeBeforeData(event.MsgData));
+    return mTCP.SendMessage(side.mPeer, std::move(event.MsgData));
+}
+
+CHIP_ERROR LoopbackTransfer::PrepareNextBlock()
+{
+    const uint16_t blockSize = mSender.mTransfer.GetTransferBlockSize();
+    VerifyOrReturnError(blockSize <= sizeof(mBlockData), CHIP_ERROR_INTERNAL);
+
+    TransferSession::BlockData blockData;
+    blockData.Data   = mBlockData;
+    blockData.Length = std::min<uint32_t>(blockSize, kImageSize - mBytesSent);
+    blockData.IsEof  = (mBytesSent + blockData.Length == kImageSize);
+    ReturnErrorOnFailure(mSender.mTransfer.PrepareBlock(blockData));
+
+    mBytesSent += static_cast<uint32_t>(blockData.Length);
+    return CHIP_NO_ERROR;
+}
+
+void OnTransferLimit(System::Layer * systemLayer, void * appState) {}
+
+// Run the event loop until [done] returns true, or kTransferLimit passes if the transfer stalled.
+template <typename Predicate>
+void RunEventLoopUntil(System::LayerImpl & systemLayer, Predicate done)
+{
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+
+    // Keep WaitForEvents() from blocking for good if the transfer stalls.
+    VerifyOrReturn(systemLayer.StartTimer(kTransferLimit, OnTransferLimit, nullptr) == CHIP_NO_ERROR);
+    while (!done() && System::SystemClock().GetMonotonicTimestamp() - start < kTransferLimit)
+    {
+        systemLayer.PrepareEvents();
+        systemLayer.WaitForEvents();
+        systemLayer.HandleEvents();
+    }
+    systemLayer.CancelTimer(OnTransferLimit, nullptr);
+}
+
+void RunTransfers(benchmarks::State & state, System::LayerImpl & systemLayer, Inet::TCPEndPointManagerImpl & tcpEndPointManager,
+                  TransferControlFlags controlMode, uint16_t blockSize)
+{
+    Inet::IPAddress loopback;
+    VerifyOrReturn(Inet::IPAddress::FromString("::1", loopback), state.SkipWithError("Parsing the loopback address failed"));
+
+    LoopbackTCP tcp;
+    auto listenParams = Transport::TcpListenParameters(&tcpEndPointManager)
+                            .SetAddressType(Inet::IPAddressType::kIPv6)
+                            .SetListenPort(kListenPort);
+    VerifyOrReturn(tcp.Init(listenParams) == CHIP_NO_ERROR, state.SkipWithError("Listening on the TCP port failed"));
+
+    LoopbackTransfer transfer(tcp, loopback, controlMode, blockSize);
+    tcp.SetDelegate(&transfer);
+
+    while (state.KeepRunning())
+    {
+        if (transfer.Start() != CHIP_NO_ERROR)
+        {
+            state.SkipWithError("Starting the transfer failed");
+            break;
+        }
+        RunEventLoopUntil(systemLayer, [&transfer]() { return transfer.IsDone(); });
+        if (transfer.GetResult() != CHIP_NO_ERROR)
+        {
+            state.SkipWithError("The transfer failed");
+            break;
+        }
+    }
+
+    // Close the connection from the Receiver's side, so that it is the one left in TIME_WAIT rather than the listening
+    // port, which the next benchmark binds again.
+    tcp.Disconnect(Transport::PeerAddress::TCP(loopback, kListenPort));
+    RunEventLoopUntil(systemLayer, [&tcp]() { return !tcp.HasActiveConnections(); });
+    tcp.CloseActiveConnections();
+    tcp.Close();
+}
+
+template <TransferControlFlags kControlMode, uint16_t kBlockSize>
+void BenchmarkTransfer(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    System::LayerImpl systemLayer;
+    Inet::TCPEndPointManagerImpl tcpEndPointManager;
+    if (systemLayer.Init() == CHIP_NO_ERROR && tcpEndPointManager.Init(systemLayer) == CHIP_NO_ERROR)
+    {
+        RunTransfers(state, systemLayer, tcpEndPointManager, kControlMode, kBlockSize);
+        tcpEndPointManager.Shutdown();
+    }
+    else
+    {
+        state.SkipWithError("Initializing the system layer failed");
+    }
+    systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+}
+
+// How OTA images are downloaded today: one BlockQuery per Block, with Blocks that fit in an IPv6 MTU.
+void BenchmarkBdxReceiverDriveTransfer(benchmarks::State & state)
+{
+    BenchmarkTransfer<TransferControlFlags::kReceiverDrive, kOtaBlockSize>(state);
+}
+CHIP_BENCHMARK("BDX/ReceiverDriveTransfer", BenchmarkBdxReceiverDriveTransfer);
+
+void BenchmarkBdxReceiverDriveTransferLargeBlocks(benchmarks::State & state)
+{
+    BenchmarkTransfer<TransferControlFlags::kReceiverDrive, kMaxLargePayloadBlockSize>(state);
+}
+CHIP_BENCHMARK("BDX/ReceiverDriveTransferLargeBlocks", BenchmarkBdxReceiverDriveTransferLargeBlocks);
+
+void BenchmarkBdxAsyncTransfer(benchmarks::State & state)
+{
+    BenchmarkTransfer<TransferControlFlags::kAsync, kMaxLargePayloadBlockSize>(state);
+}
+CHIP_BENCHMARK("BDX/AsyncTransfer", BenchmarkBdxAsyncTransfer);
+
+} // namespace
@@ -0,0 +1,164 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmark of BufferedReadCallback reassembling a list attribute that a multi-chunk read delivered one item at a
+ *      time, and of decoding the reassembled list.
+ */
+
+#include "Benchmark.h"
+
+#include <app/BufferedReadCallback.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <cstring>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr size_t kListLength = 256;
+constexpr size_t kItemLength = 48;
+
+// Decodes every delivered list the way generated cluster objects do, reading each octet string in place.
+class ListDecoder : public ReadClient::Callback
+{
+public:
+    void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
+    {
+        mError = Decode(*apData);
+    }
+
+    void OnError(CHIP_ERROR aError) override { mError = aError; }
+    void OnDone(ReadClient * apReadClient) override {}
+
+    CHIP_ERROR mError  = CHIP_NO_ERROR;
+    uint64_t mChecksum = 0;
+
+private:
+    CHIP_ERROR Decode(TLV::TLVReader & reader)
+    {
+        TLV::TLVType list;
+        ReturnErrorOnFailure(reader.EnterContainer(list));
+        CHIP_ERROR err;
+        size_t itemsRead = 0;
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            TLV::TLVType item;
+            uint32_t index;
+            ByteSpan octets;
+            ReturnErrorOnFailure(reader.EnterContainer(item));
+            ReturnErrorOnFailure(reader.Next(TLV::ContextTag(0)));
+            ReturnErrorOnFailure(reader.Get(index));
+            ReturnErrorOnFailure(reader.Next(TLV::ContextTag(1)));
+            ReturnErrorOnFailure(reader.Get(octets));
+            ReturnErrorOnFailure(reader.ExitContainer(item));
+            mChecksum += index + octets.size();
+            itemsRead++;
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        VerifyOrReturnError(itemsRead == kListLength, CHIP_ERROR_INTERNAL);
+        return reader.ExitContainer(list);
+    }
+};
+
+CHIP_ERROR EncodeItem(uint8_t (&buffer)[kItemLength + 16], uint32_t index, uint32_t & length)
+{
+    uint8_t octets[kItemLength];
+    memset(octets, static_cast<uint8_t>(index), sizeof(octets));
+
+    TLV::TLVWriter writer;
+    TLV::TLVType item;
+    writer.Init(buffer);
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, item));
+    ReturnErrorOnFailure(writer.Put(TLV::ContextTag(0), index));
+    ReturnErrorOnFailure(writer.Put(TLV::ContextTag(1), ByteSpan(octets)));
+    ReturnErrorOnFailure(writer.EndContainer(item));
+    ReturnErrorOnFailure(writer.Finalize());
+    length = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+void RunReassembleList(benchmarks::State & state)
+{
+    // The empty list that starts a chunked list attribute, followed by the items appended to it.
+    uint8_t emptyList[4];
+    uint32_t emptyListLength = 0;
+    {
+        TLV::TLVWriter writer;
+        TLV::TLVType list;
+        writer.Init(emptyList);
+        VerifyOrReturn(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, list) == CHIP_NO_ERROR &&
+                           writer.EndContainer(list) == CHIP_NO_ERROR && writer.Finalize() == CHIP_NO_ERROR,
+                       state.SkipWithError("Encoding the list failed"));
+        emptyListLength = writer.GetLengthWritten();
+    }
+
+    static uint8_t sItems[kListLength][kItemLength + 16];
+    uint32_t itemLengths[kListLength];
+    for (uint32_t i = 0; i < kListLength; i++)
+    {
+        VerifyOrReturn(EncodeItem(sItems[i], i, itemLengths[i]) == CHIP_NO_ERROR, state.SkipWithError("Encoding an item failed"));
+    }
+
+    ListDecoder decoder;
+    BufferedReadCallback bufferedCallback(decoder);
+    ReadClient::Callback & callback = bufferedCallback;
+
+    ConcreteDataAttributePath path(1, 0xFFF1'FC05, 0x0000'0001);
+    while (state.KeepRunning())
+    {
+        callback.OnReportBegin();
+
+        TLV::TLVReader reader;
+        reader.Init(emptyList, emptyListLength);
+        VerifyOrReturn(reader.Next() == CHIP_NO_ERROR, state.SkipWithError("Reading the list failed"));
+        path.mListOp = ConcreteDataAttributePath::ListOperation::ReplaceAll;
+        callback.OnAttributeData(path, &reader, StatusIB());
+
+        path.mListOp = ConcreteDataAttributePath::ListOperation::AppendItem;
+        for (size_t i = 0; i < kListLength; i++)
+        {
+            reader.Init(sItems[i], itemLengths[i]);
+            VerifyOrReturn(reader.Next() == CHIP_NO_ERROR, state.SkipWithError("Reading an item failed"));
+            callback.OnAttributeData(path, &reader, StatusIB());
+        }
+
+        callback.OnReportEnd();
+    }
+
+    if (decoder.mError != CHIP_NO_ERROR)
+    {
+        state.SkipWithError("Decoding the reassembled list failed");
+    }
+    benchmarks::DoNotOptimize(decoder.mChecksum);
+}
+
+void BenchmarkBufferedReadCallbackReassembleList(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunReassembleList(state);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("BufferedReadCallback/ReassembleList", BenchmarkBufferedReadCallbackReassembleList);
+
+} // namespace
@@ -0,0 +1,365 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of CASE: a controller establishing sessions with a burst of simultaneous handshakes over the loopback
+ *      transport, with the certificate validation and signatures of both sides run on the CHIP task, and as background
+ *      work on the worker pool that POSIX platforms start, and the responder's handling of Sigma3 from an initiator
+ *      whose certificate chain it has validated before, with and without a verified certificate cache.
+ */
+
+#include "Benchmark.h"
+
+#include <credentials/FabricTable.h>
+#include <credentials/GroupDataProviderImpl.h>
+#include <credentials/PersistentStorageOpCertStore.h>
+#include <credentials/VerifiedCertificateCache.h>
+#include <credentials/tests/CHIPCert_test_vectors.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/tests/MessagingContext.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/CASESession.h>
+
+#include <string.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::Crypto;
+using namespace chip::Messaging;
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+// A controller (re)connecting to many nodes at once, e.g. after it restarts.
+constexpr size_t kConcurrentHandshakes = 16;
+#else
+// Each handshake holds an unauthenticated session on either side until it is done.
+constexpr size_t kConcurrentHandshakes = CHIP_CONFIG_UNAUTHENTICATED_CONNECTION_POOL_SIZE / 2;
+#endif
+
+// Sigma1, Sigma2 and Sigma3 stand-in for the transcript that is signed.
+constexpr uint8_t kTranscript[256] = { 0x15, 0x30, 0x01, 0x20 };
+
+/**
+ * One side of the handshakes: a fabric of the test certificates with an injected operational key, and its IPK.
+ */
+struct Node
+{
+    TestPersistentStorageDelegate storage;
+    PersistentStorageOpCertStore opCertStore;
+    DefaultSessionKeystore sessionKeystore;
+    GroupDataProviderImpl groupDataProvider;
+    FabricTable fabricTable;
+    FabricIndex fabricIndex = kUndefinedFabricIndex;
+    NodeId nodeId           = kUndefinedNodeId;
+
+    ~Node()
+    {
+        fabricTable.DeleteAllFabrics();
+        groupDataProvider.Finish();
+    }
+
+    CHIP_ERROR Init(TestCerts::TestCert cert, const ByteSpan & noc)
+    {
+        ReturnErrorOnFailure(opCertStore.Init(&storage));
+
+        FabricTable::InitParams initParams;
+        initParams.storage     = &storage;
+        initParams.opCertStore = &opCertStore;
+        ReturnErrorOnFailure(fabricTable.Init(initParams));
+
+        groupDataProvider.SetStorageDelegate(&storage);
+        groupDataProvider.SetSessionKeystore(&sessionKeystore);
+        ReturnErrorOnFailure(groupDataProvider.Init());
+
+        P256SerializedKeypair opKey;
+        ReturnErrorOnFailure(TestCerts::GetTestCertKeypair(cert, opKey));
+        ReturnErrorOnFailure(fabricTable.AddNewFabricForTest(TestCerts::sTestCert_Root01_Chip, TestCerts::sTestCert_ICA01_Chip,
+                                                             noc, ByteSpan(opKey.ConstBytes(), opKey.Length()), &fabricIndex));
+
+        const FabricInfo * fabricInfo = fabricTable.FindFabricWithIndex(fabricIndex);
+        VerifyOrReturnError(fabricInfo != nullptr, CHIP_ERROR_INTERNAL);
+        nodeId = fabricInfo->GetNodeId();
+        return SetIpk(*fabricInfo);
+    }
+
+    CHIP_ERROR SetIpk(const FabricInfo & fabricInfo)
+    {
+        GroupDataProvider::KeySet ipkKeySet(GroupDataProvider::kIdentityProtectionKeySetId,
+                                            GroupDataProvider::SecurityPolicy::kTrustFirst, 1);
+        ipkKeySet.epoch_keys[0].start_time = 0;
+        memset(ipkKeySet.epoch_keys[0].key, 0, sizeof(ipkKeySet.epoch_keys[0].key));
+
+        uint8_t compressedId[sizeof(uint64_t)];
+        MutableByteSpan compressedIdSpan(compressedId);
+        ReturnErrorOnFailure(fabricInfo.GetCompressedFabricIdBytes(compressedIdSpan));
+        return groupDataProvider.SetKeySet(fabricIndex, compressedIdSpan, ipkKeySet);
+    }
+};
+
+/**
+ * A burst of kConcurrentHandshakes handshakes, all started before any of them is serviced. Each Sigma1 is handed to
+ * the next responder, as several CASEServers of a node would take them.
+ */
+class HandshakeBurst : public UnsolicitedMessageHandler, public SessionEstablishmentDelegate
+{
+public:
+    CHIP_ERROR Start(Test::LoopbackMessagingContext & ctx, Node & initiator, Node & responder)
+    {
+        SessionManager & sessionManager = ctx.GetSecureSessionManager();
+        for (auto & session : mResponders)
+        {
+            session.SetGroupDataProvider(&responder.groupDataProvider);
+            ReturnErrorOnFailure(session.PrepareForSessionEstablishment(sessionManager, &responder.fabricTable, nullptr, nullptr,
+                                                                        this, ScopedNodeId(),
+                                                                        Optional<ReliableMessageProtocolConfig>::Missing()));
+        }
+
+        const ScopedNodeId peer(responder.nodeId, initiator.fabricIndex);
+        for (auto & session : mInitiators)
+        {
+            Optional<SessionHandle> unauthenticatedSession = sessionManager.CreateUnauthenticatedSession(
+                ctx.GetBobAddress(), GetLocalMRPConfig().ValueOr(GetDefaultMRPConfig()));
+            VerifyOrReturnError(unauthenticatedSession.HasValue(), CHIP_ERROR_NO_MEMORY);
+
+            ExchangeContext * exchange = ctx.GetExchangeManager().NewContext(unauthenticatedSession.Value(), &session);
+            VerifyOrReturnError(exchange != nullptr, CHIP_ERROR_NO_MEMORY);
+
+            session.SetGroupDataProvider(&initiator.groupDataProvider);
+            ReturnErrorOnFailure(session.EstablishSession(sessionManager, &initiator.fabricTable, peer, exchange, nullptr, nullptr,
+                                                          this, Optional<ReliableMessageProtocolConfig>::Missing()));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    // Both sides report to the burst, so it is done when each handshake has been reported twice.
+    bool Done() const { return mEstablished + mFailed == 2 * kConcurrentHandshakes; }
+    bool Succeeded() const { return mEstablished == 2 * kConcurrentHandshakes; }
+
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        VerifyOrReturnError(mNextResponder < kConcurrentHandshakes, CHIP_ERROR_NO_MEMORY);
+        return mResponders[mNextResponder++].OnUnsolicitedMessageReceived(payloadHeader, newDelegate);
+    }
+
+    void OnSessionEstablishmentError(CHIP_ERROR error) override { mFailed++; }
+    void OnSessionEstablished(const SessionHandle & session) override { mEstablished++; }
+
+private:
+    CASESession mInitiators[kConcurrentHandshakes];
+    CASESession mResponders[kConcurrentHandshakes];
+    size_t mNextResponder = 0;
+    size_t mEstablished   = 0;
+    size_t mFailed        = 0;
+};
+
+void ServiceEvents(Test::LoopbackMessagingContext & ctx)
+{
+    // Handling IO messages may schedule work, and scheduled work, including the completion of background work, may
+    // queue messages for sending.
+    ctx.DrainAndServiceIO();
+    DeviceLayer::PlatformMgr().ScheduleWork([](intptr_t) { DeviceLayer::PlatformMgr().StopEventLoopTask(); });
+    DeviceLayer::PlatformMgr().RunEventLoop();
+}
+
+// Runs [measure] with the CHIP stack up and an initiator and a responder node on the loopback transport.
+template <typename Measure>
+void WithNodes(benchmarks::State & state, Measure measure)
+{
+    Test::LoopbackMessagingContext ctx;
+    ctx.ConfigInitializeNodes(false);
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (DeviceLayer::PlatformMgr().InitChipStack() == CHIP_NO_ERROR)
+    {
+        DeviceLayer::SetSystemLayerForTesting(&ctx.GetSystemLayer());
+        if (ctx.SetUp() == CHIP_NO_ERROR)
+        {
+            Node * initiator = Platform::New<Node>();
+            Node * responder = Platform::New<Node>();
+            if (initiator->Init(TestCerts::TestCert::kNode01_02, TestCerts::sTestCert_Node01_02_Chip) == CHIP_NO_ERROR &&
+                responder->Init(TestCerts::TestCert::kNode01_01, TestCerts::sTestCert_Node01_01_Chip) == CHIP_NO_ERROR)
+            {
+                measure(ctx, *initiator, *responder);
+            }
+            else
+            {
+                state.SkipWithError("Setting up the fabrics failed");
+            }
+            Platform::Delete(responder);
+            Platform::Delete(initiator);
+            ctx.TearDown();
+        }
+        else
+        {
+            state.SkipWithError("Setting up the messaging context failed");
+        }
+        DeviceLayer::SetSystemLayerForTesting(nullptr);
+        DeviceLayer::PlatformMgr().Shutdown();
+    }
+    else
+    {
+        state.SkipWithError("Initializing the CHIP stack failed");
+    }
+    ctx.TearDownTestSuite();
+}
+
+// A burst of handshakes from Sigma1 to the established sessions on both sides. Setting up the sessions that take part
+// and expiring the established sessions is excluded.
+void RunHandshakeBursts(benchmarks::State & state, Test::LoopbackMessagingContext & ctx, Node & initiator, Node & responder)
+{
+    ExchangeManager & exchangeManager = ctx.GetExchangeManager();
+    SessionManager & sessionManager   = ctx.GetSecureSessionManager();
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        HandshakeBurst * burst = Platform::New<HandshakeBurst>();
+        CHIP_ERROR err = exchangeManager.RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                                  burst);
+        state.ResumeTiming();
+
+        if (err == CHIP_NO_ERROR)
+        {
+            err = burst->Start(ctx, initiator, responder);
+        }
+        while (err == CHIP_NO_ERROR && !burst->Done())
+        {
+            ServiceEvents(ctx);
+        }
+
+        state.PauseTiming();
+        const bool succeeded = (err == CHIP_NO_ERROR) && burst->Succeeded();
+        exchangeManager.UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+        Platform::Delete(burst);
+        sessionManager.ExpireAllSessions(ScopedNodeId(responder.nodeId, initiator.fabricIndex));
+        sessionManager.ExpireAllSessions(ScopedNodeId(initiator.nodeId, responder.fabricIndex));
+        ctx.DrainAndServiceIO();
+        state.ResumeTiming();
+
+        if (!succeeded)
+        {
+            state.SkipWithError("A handshake failed");
+            break;
+        }
+    }
+}
+
+void BenchmarkCASESessionConcurrentHandshakesOnChipTask(benchmarks::State & state)
+{
+    WithNodes(state, [&state](Test::LoopbackMessagingContext & ctx, Node & initiator, Node & responder) {
+        RunHandshakeBursts(state, ctx, initiator, responder);
+    });
+}
+CHIP_BENCHMARK("CASESession/ConcurrentHandshakesOnChipTask", BenchmarkCASESessionConcurrentHandshakesOnChipTask);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+void BenchmarkCASESessionConcurrentHandshakesOnWorkerPool(benchmarks::State & state)
+{
+    WithNodes(state, [&state](Test::LoopbackMessagingContext & ctx, Node & initiator, Node & responder) {
+        VerifyOrReturn(DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR,
+                       state.SkipWithError("Starting the background workers failed"));
+        RunHandshakeBursts(state, ctx, initiator, responder);
+        DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask();
+    });
+}
+CHIP_BENCHMARK("CASESession/ConcurrentHandshakesOnWorkerPool", BenchmarkCASESessionConcurrentHandshakesOnWorkerPool);
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
+/**
+ * The initiator's part of Sigma3: its NOC and ICAC, and its signature of the transcript with its operational key.
+ */
+struct Sigma3
+{
+    ByteSpan initiatorNOC  = TestCerts::sTestCert_Node01_01_Chip;
+    ByteSpan initiatorICAC = TestCerts::sTestCert_ICA01_Chip;
+    ByteSpan fabricRCAC    = TestCerts::sTestCert_Root01_Chip;
+    P256ECDSASignature signature;
+
+    CHIP_ERROR Init()
+    {
+        P256SerializedKeypair serializedKeypair;
+        P256Keypair keypair;
+        ReturnErrorOnFailure(TestCerts::GetTestCertKeypair(TestCerts::TestCert::kNode01_01, serializedKeypair));
+        ReturnErrorOnFailure(keypair.Deserialize(serializedKeypair));
+        return keypair.ECDSA_sign_msg(kTranscript, sizeof(kTranscript), signature);
+    }
+
+    // What CASESession::HandleSigma3b() does: validate the initiator's certificate chain, then its signature.
+    CHIP_ERROR Verify(ValidationContext & context) const
+    {
+        CompressedFabricId compressedFabricId;
+        FabricId fabricId;
+        NodeId nodeId;
+        P256PublicKey initiatorPublicKey;
+        ReturnErrorOnFailure(FabricTable::VerifyCredentials(initiatorNOC, initiatorICAC, fabricRCAC, context, compressedFabricId,
+                                                            fabricId, nodeId, initiatorPublicKey));
+        return initiatorPublicKey.ECDSA_validate_msg_signature(kTranscript, sizeof(kTranscript), signature);
+    }
+};
+
+void RunResponderSigma3(benchmarks::State & state, VerifiedCertificateCache * cache)
+{
+    Sigma3 sigma3;
+    VerifyOrReturn(sigma3.Init() == CHIP_NO_ERROR, state.SkipWithError("Signing the transcript failed"));
+
+    ValidationContext context;
+    context.Reset();
+    context.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    context.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    context.mVerifiedCertCache = cache;
+
+    while (state.KeepRunning())
+    {
+        if (sigma3.Verify(context) != CHIP_NO_ERROR)
+        {
+            state.SkipWithError("Verifying Sigma3 failed");
+            break;
+        }
+    }
+}
+
+void BenchmarkCASESessionResponderSigma3(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunResponderSigma3(state, nullptr);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("CASESession/ResponderSigma3", BenchmarkCASESessionResponderSigma3);
+
+void BenchmarkCASESessionResponderSigma3Cached(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    VerifiedCertificateCache cache;
+    if (cache.Init() == CHIP_NO_ERROR)
+    {
+        RunResponderSigma3(state, &cache);
+    }
+    else
+    {
+        state.SkipWithError("Initializing the cache failed");
+    }
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("CASESession/ResponderSigma3Cached", BenchmarkCASESessionResponderSigma3Cached);
+
+} // namespace
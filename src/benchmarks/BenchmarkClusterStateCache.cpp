@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of a controller's ClusterStateCache for one node: storing the priming report of a wildcard
+ *      subscription, storing a report that changes a few attributes, and looking up a cached attribute.
+ */
+
+#include "Benchmark.h"
+
+#include <app/ClusterStateCache.h>
+#include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+// A node with a few endpoints, each with a handful of clusters of a dozen or so attributes.
+constexpr size_t kNumEndpoints            = 8;
+constexpr size_t kNumClustersPerEndpoint  = 8;
+constexpr size_t kNumAttributesPerCluster = 16;
+constexpr size_t kNumAttributes           = kNumEndpoints * kNumClustersPerEndpoint * kNumAttributesPerCluster;
+
+// Attributes changed by a report after the priming one, e.g. a few measurements.
+constexpr size_t kNumChangedAttributes = 4;
+
+class NullCallback : public ClusterStateCache::Callback
+{
+public:
+    void OnDone(ReadClient * apReadClient) override {}
+};
+
+ConcreteDataAttributePath AttributePath(size_t index, DataVersion dataVersion)
+{
+    const auto attribute = static_cast<AttributeId>(index % kNumAttributesPerCluster);
+    const auto cluster   = static_cast<ClusterId>(0x0000'0100 + (index / kNumAttributesPerCluster) % kNumClustersPerEndpoint);
+    const auto endpoint  = static_cast<EndpointId>(index / (kNumAttributesPerCluster * kNumClustersPerEndpoint));
+
+    ConcreteDataAttributePath path(endpoint, cluster, attribute);
+    path.mDataVersion.SetValue(dataVersion);
+    return path;
+}
+
+// A 32-bit attribute value, encoded as the anonymous element a report carries.
+class EncodedValue
+{
+public:
+    CHIP_ERROR Encode(uint32_t value)
+    {
+        TLV::TLVWriter writer;
+        writer.Init(mBuffer);
+        ReturnErrorOnFailure(writer.Put(TLV::AnonymousTag(), value));
+        ReturnErrorOnFailure(writer.Finalize());
+        mLength = writer.GetLengthWritten();
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR Read(TLV::TLVReader & reader) const
+    {
+        reader.Init(mBuffer, mLength);
+        return reader.Next();
+    }
+
+private:
+    uint8_t mBuffer[8];
+    uint32_t mLength = 0;
+};
+
+// Delivers a report of the attributes at [indices] to [cache], in the order given.
+CHIP_ERROR DeliverReport(ClusterStateCache & cache, const EncodedValue & value, const size_t * indices, size_t count,
+                         DataVersion dataVersion)
+{
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    callback.OnReportBegin();
+    for (size_t i = 0; i < count; i++)
+    {
+        TLV::TLVReader reader;
+        ReturnErrorOnFailure(value.Read(reader));
+        callback.OnAttributeData(AttributePath(indices[i], dataVersion), &reader, StatusIB());
+    }
+    callback.OnReportEnd();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PrimeCache(ClusterStateCache & cache, const EncodedValue & value)
+{
+    static size_t sIndices[kNumAttributes];
+    for (size_t i = 0; i < kNumAttributes; i++)
+    {
+        sIndices[i] = i;
+    }
+    return DeliverReport(cache, value, sIndices, kNumAttributes, 1);
+}
+
+// Runs [measure] with a cache primed with every attribute of the node.
+template <typename Measure>
+void WithPrimedCache(benchmarks::State & state, Measure measure)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    {
+        EncodedValue value;
+        NullCallback callback;
+        ClusterStateCache cache(callback);
+        if (value.Encode(0x1234'5678) == CHIP_NO_ERROR && PrimeCache(cache, value) == CHIP_NO_ERROR)
+        {
+            measure(cache, value);
+        }
+        else
+        {
+            state.SkipWithError("Priming the cache failed");
+        }
+    }
+    Platform::MemoryShutdown();
+}
+
+// The priming report of a wildcard subscription, stored in a new cache. Destroying the cache is excluded.
+void BenchmarkClusterStateCachePrime(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    EncodedValue value;
+    NullCallback callback;
+    if (value.Encode(0x1234'5678) == CHIP_NO_ERROR)
+    {
+        while (state.KeepRunning())
+        {
+            ClusterStateCache * cache = Platform::New<ClusterStateCache>(callback);
+            CHIP_ERROR err            = PrimeCache(*cache, value);
+            state.PauseTiming();
+            Platform::Delete(cache);
+            state.ResumeTiming();
+            if (err != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Priming the cache failed");
+                break;
+            }
+        }
+    }
+    else
+    {
+        state.SkipWithError("Encoding the value failed");
+    }
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("ClusterStateCache/Prime1024", BenchmarkClusterStateCachePrime);
+
+// A subscription report changing a few attributes of different clusters of a primed cache.
+void BenchmarkClusterStateCacheUpdate(benchmarks::State & state)
+{
+    WithPrimedCache(state, [&state](ClusterStateCache & cache, const EncodedValue & value) {
+        size_t indices[kNumChangedAttributes];
+        size_t next             = 0;
+        DataVersion dataVersion = 1;
+        while (state.KeepRunning())
+        {
+            for (auto & index : indices)
+            {
+                index = next;
+                next  = (next + 97) % kNumAttributes;
+            }
+            if (DeliverReport(cache, value, indices, kNumChangedAttributes, ++dataVersion) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Delivering the report failed");
+                break;
+            }
+        }
+    });
+}
+CHIP_BENCHMARK("ClusterStateCache/Update4Of1024", BenchmarkClusterStateCacheUpdate);
+
+// The lookup of one cached attribute, as every read of the cache by the application makes.
+void BenchmarkClusterStateCacheGet(benchmarks::State & state)
+{
+    WithPrimedCache(state, [&state](ClusterStateCache & cache, const EncodedValue & value) {
+        size_t next = 0;
+        while (state.KeepRunning())
+        {
+            TLV::TLVReader reader;
+            const ConcreteDataAttributePath path = AttributePath(next, 1);
+            next                                 = (next + 97) % kNumAttributes;
+            if (cache.Get(path, reader) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Getting the attribute failed");
+                break;
+            }
+            benchmarks::DoNotOptimize(reader);
+        }
+    });
+}
+CHIP_BENCHMARK("ClusterStateCache/Get1024", BenchmarkClusterStateCacheGet);
+
+} // namespace
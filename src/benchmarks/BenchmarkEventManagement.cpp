@@ -0,0 +1,239 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of EventManagement: LogEvent for a small event, with the events kept in memory only and, where it is
+ *      enabled, also in a PersistentEventLog, and FetchEventsSince from deep event buffers, for a subscriber that only
+ *      needs the last few events and for one of a cluster that only logged an event at boot.
+ */
+
+#include "Benchmark.h"
+
+#include <access/AccessControl.h>
+#include <access/examples/PermissiveAccessControlDelegate.h>
+#include <app/EventManagement.h>
+#include <app/MessageDef/EventDataIB.h>
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <app/PersistentEventLog.h>
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <lib/support/CHIPCounter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+#include <stdlib.h>
+#include <unistd.h>
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr EndpointId kEndpointId        = 1;
+constexpr ClusterId kBootClusterId      = 0x0028; // Basic Information, which logs StartUp at boot
+constexpr ClusterId kSwitchClusterId    = 0x003B; // Switch, which logs an event on every press
+constexpr EventId kEventId              = 0;
+constexpr size_t kSwitchEventCount      = 2000;
+constexpr EventNumber kRecentEventCount = 4;
+
+// Deep buffers, as on a bridge.
+uint8_t sDebugEventBuffer[8192];
+uint8_t sInfoEventBuffer[8192];
+uint8_t sCritEventBuffer[8192];
+CircularEventBuffer sCircularEventBuffer[3];
+
+class StateChangeEvent : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLV::TLVType dataContainerType;
+        ReturnErrorOnFailure(aWriter.StartContainer(TLV::ContextTag(to_underlying(EventDataIB::Tag::kData)),
+                                                    TLV::kTLVType_Structure, dataContainerType));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(0), mState));
+        return aWriter.EndContainer(dataContainerType);
+    }
+
+    uint32_t mState = 0;
+};
+
+class DeviceTypeResolver : public Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+} gDeviceTypeResolver;
+
+Access::AccessControl gAccessControl;
+
+void CreateEventManagement(MonotonicallyIncreasingCounter<EventNumber> & aEventCounter, PersistentEventLog * apPersistentEventLog)
+{
+    const LogStorageResources logStorageResources[] = {
+        { &sDebugEventBuffer[0], sizeof(sDebugEventBuffer), PriorityLevel::Debug },
+        { &sInfoEventBuffer[0], sizeof(sInfoEventBuffer), PriorityLevel::Info },
+        { &sCritEventBuffer[0], sizeof(sCritEventBuffer), PriorityLevel::Critical },
+    };
+    EventManagement::CreateEventManagement(nullptr, ArraySize(logStorageResources), sCircularEventBuffer, logStorageResources,
+                                           &aEventCounter, System::SystemClock().GetMonotonicMilliseconds64(),
+                                           apPersistentEventLog);
+}
+
+CHIP_ERROR LogEvent(ClusterId aClusterId, PriorityLevel aPriority, StateChangeEvent & aEvent)
+{
+    EventOptions options;
+    options.mPath     = { kEndpointId, aClusterId, kEventId };
+    options.mPriority = aPriority;
+    EventNumber eventNumber;
+    aEvent.mState++;
+    return EventManagement::GetInstance().LogEvent(&aEvent, options, eventNumber);
+}
+
+void RunLogEvent(benchmarks::State & state, PersistentEventLog * apPersistentEventLog)
+{
+    MonotonicallyIncreasingCounter<EventNumber> eventCounter;
+    VerifyOrReturn(eventCounter.Init(0) == CHIP_NO_ERROR, state.SkipWithError("Initializing the event counter failed"));
+    CreateEventManagement(eventCounter, apPersistentEventLog);
+
+    StateChangeEvent event;
+    while (state.KeepRunning())
+    {
+        if (LogEvent(kSwitchClusterId, PriorityLevel::Info, event) != CHIP_NO_ERROR)
+        {
+            state.SkipWithError("Logging the event failed");
+            break;
+        }
+    }
+
+    EventManagement::DestroyEventManagement();
+}
+
+// A StartUp event, then enough switch events to fill the debug and info buffers.
+CHIP_ERROR LogBootAndSwitchEvents()
+{
+    StateChangeEvent event;
+    ReturnErrorOnFailure(LogEvent(kBootClusterId, PriorityLevel::Critical, event));
+    for (size_t i = 0; i < kSwitchEventCount; i++)
+    {
+        ReturnErrorOnFailure(LogEvent(kSwitchClusterId, PriorityLevel::Info, event));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void RunFetchEventsSince(benchmarks::State & state, ClusterId aClusterId, EventNumber aEventMin)
+{
+    ObjectList<EventPathParams> path;
+    path.mValue.mEndpointId = kEndpointId;
+    path.mValue.mClusterId  = aClusterId;
+
+    Access::SubjectDescriptor subjectDescriptor;
+    subjectDescriptor.fabricIndex = 1;
+    subjectDescriptor.authMode    = Access::AuthMode::kCase;
+
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    uint8_t buffer[1024];
+    while (state.KeepRunning())
+    {
+        TLV::TLVWriter writer;
+        writer.Init(buffer);
+        EventNumber eventMin = aEventMin;
+        size_t eventCount    = 0;
+        CHIP_ERROR err       = eventManagement.FetchEventsSince(writer, &path, eventMin, eventCount, subjectDescriptor);
+        if (err != CHIP_NO_ERROR || eventCount == 0)
+        {
+            state.SkipWithError("Fetching the events failed");
+            break;
+        }
+    }
+}
+
+void RunFetchEventsSinceWithEvents(benchmarks::State & state, ClusterId aClusterId, bool aRecentOnly)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    Access::SetAccessControl(gAccessControl);
+    MonotonicallyIncreasingCounter<EventNumber> eventCounter;
+    if (gAccessControl.Init(Access::Examples::GetPermissiveAccessControlDelegate(), gDeviceTypeResolver) == CHIP_NO_ERROR &&
+        eventCounter.Init(0) == CHIP_NO_ERROR)
+    {
+        CreateEventManagement(eventCounter, nullptr);
+        if (LogBootAndSwitchEvents() == CHIP_NO_ERROR)
+        {
+            const EventNumber lastEventNumber = EventManagement::GetInstance().GetLastEventNumber();
+            RunFetchEventsSince(state, aClusterId, aRecentOnly ? lastEventNumber - kRecentEventCount : 0);
+        }
+        else
+        {
+            state.SkipWithError("Logging the events failed");
+        }
+        EventManagement::DestroyEventManagement();
+        gAccessControl.Finish();
+    }
+    else
+    {
+        state.SkipWithError("Initializing access control failed");
+    }
+    Access::ResetAccessControlToDefault();
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkEventManagementLogEvent(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunLogEvent(state, nullptr);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("EventManagement/LogEvent", BenchmarkEventManagementLogEvent);
+
+#if CHIP_CONFIG_PERSISTENT_EVENT_LOG
+void BenchmarkEventManagementLogEventPersistent(benchmarks::State & state)
+{
+    char path[] = "/tmp/BenchmarkEventManagement-XXXXXX";
+    int fd      = mkstemp(path);
+    VerifyOrReturn(fd >= 0, state.SkipWithError("Creating the event log file failed"));
+    close(fd);
+
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    PersistentEventLog persistentEventLog;
+    if (persistentEventLog.Open(path) == CHIP_NO_ERROR)
+    {
+        RunLogEvent(state, &persistentEventLog);
+        persistentEventLog.Close();
+    }
+    else
+    {
+        state.SkipWithError("Opening the event log failed");
+    }
+    Platform::MemoryShutdown();
+    unlink(path);
+}
+CHIP_BENCHMARK("EventManagement/LogEventPersistent", BenchmarkEventManagementLogEventPersistent);
+#endif // CHIP_CONFIG_PERSISTENT_EVENT_LOG
+
+void BenchmarkEventManagementFetchEventsSinceRecent(benchmarks::State & state)
+{
+    RunFetchEventsSinceWithEvents(state, kSwitchClusterId, true);
+}
+CHIP_BENCHMARK("EventManagement/FetchEventsSinceRecent", BenchmarkEventManagementFetchEventsSinceRecent);
+
+void BenchmarkEventManagementFetchEventsSinceQuietCluster(benchmarks::State & state)
+{
+    RunFetchEventsSinceWithEvents(state, kBootClusterId, false);
+}
+CHIP_BENCHMARK("EventManagement/FetchEventsSinceQuietCluster", BenchmarkEventManagementFetchEventsSinceQuietCluster);
+
+} // namespace
@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of ExchangeManager dispatching decrypted messages: to one of many open exchanges, and to an
+ *      unsolicited message handler in a full handler table.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/tests/MessagingContext.h>
+#include <transport/SessionMessageDelegate.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+
+// A controller talking to many devices at once; without heap pools, as many exchanges as the pool holds.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+constexpr size_t kOpenExchanges = 256;
+#else
+constexpr size_t kOpenExchanges = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS;
+#endif
+
+constexpr uint8_t kMsgType = 1;
+
+class CountingDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && payload) override
+    {
+        mReceived++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint64_t mReceived = 0;
+};
+
+PacketHeader MakePacketHeader(const SessionHandle & session)
+{
+    PacketHeader packetHeader;
+    packetHeader.SetSessionId(session->AsSecureSession()->GetLocalSessionId());
+    return packetHeader;
+}
+
+// Deliver responses round-robin to exchanges this node initiated, as its peers answer them.
+void RunDispatchToOpenExchange(benchmarks::State & state, Test::LoopbackMessagingContext & ctx)
+{
+    System::PacketBufferHandle payload = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    VerifyOrReturn(!payload.IsNull(), state.SkipWithError("Allocating the payload failed"));
+
+    CountingDelegate delegate;
+    ExchangeContext * exchanges[kOpenExchanges];
+    size_t opened = 0;
+    for (; opened < kOpenExchanges; opened++)
+    {
+        exchanges[opened] = ctx.NewExchangeToBob(&delegate);
+        if (exchanges[opened] == nullptr)
+        {
+            state.SkipWithError("Allocating an exchange failed");
+            break;
+        }
+    }
+
+    if (opened == kOpenExchanges)
+    {
+        SessionMessageDelegate & exchangeManager = ctx.GetExchangeManager();
+        const SessionHandle session              = ctx.GetSessionAliceToBob();
+        PacketHeader packetHeader                = MakePacketHeader(session);
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::BDX::Id, kMsgType).SetInitiator(false);
+
+        uint32_t messageCounter = 0;
+        size_t next             = 0;
+        while (state.KeepRunning())
+        {
+            packetHeader.SetMessageCounter(messageCounter++);
+            payloadHeader.SetExchangeID(exchanges[next]->GetExchangeId());
+            next = (next + 1) % kOpenExchanges;
+            exchangeManager.OnMessageReceived(packetHeader, payloadHeader, session,
+                                              SessionMessageDelegate::DuplicateMessage::No, payload.Retain());
+        }
+
+        if (delegate.mReceived != messageCounter && state.GetError() == nullptr)
+        {
+            state.SkipWithError("Not every message reached its exchange");
+        }
+    }
+
+    for (size_t i = 0; i < opened; i++)
+    {
+        exchanges[i]->Close();
+    }
+}
+
+// Deliver requests whose handler is registered for a specific message type, along with as many other handlers as
+// the table has room for.
+void RunDispatchUnsolicited(benchmarks::State & state, Test::LoopbackMessagingContext & ctx)
+{
+    System::PacketBufferHandle payload = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    VerifyOrReturn(!payload.IsNull(), state.SkipWithError("Allocating the payload failed"));
+
+    CountingDelegate delegate;
+    ExchangeManager & exchangeManager = ctx.GetExchangeManager();
+
+    uint8_t registered = 0;
+    for (uint8_t msgType = kMsgType; msgType < UINT8_MAX; msgType++)
+    {
+        if (exchangeManager.RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, msgType, &delegate) != CHIP_NO_ERROR)
+        {
+            break;
+        }
+        registered++;
+    }
+
+    if (registered > 0)
+    {
+        const SessionHandle session = ctx.GetSessionBobToAlice();
+        PacketHeader packetHeader   = MakePacketHeader(session);
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::BDX::Id, static_cast<uint8_t>(kMsgType + registered - 1)).SetInitiator(true);
+
+        // Each request opens an exchange, which closes once the delegate has handled the request.
+        uint32_t messageCounter = 0;
+        uint16_t exchangeId     = 0;
+        while (state.KeepRunning())
+        {
+            packetHeader.SetMessageCounter(messageCounter++);
+            payloadHeader.SetExchangeID(exchangeId++);
+            static_cast<SessionMessageDelegate &>(exchangeManager)
+                .OnMessageReceived(packetHeader, payloadHeader, session, SessionMessageDelegate::DuplicateMessage::No,
+                                   payload.Retain());
+        }
+
+        if (delegate.mReceived != messageCounter && state.GetError() == nullptr)
+        {
+            state.SkipWithError("Not every message reached its handler");
+        }
+    }
+    else
+    {
+        state.SkipWithError("Registering a handler failed");
+    }
+
+    for (uint8_t i = 0; i < registered; i++)
+    {
+        exchangeManager.UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, static_cast<uint8_t>(kMsgType + i));
+    }
+}
+
+template <void (*Run)(benchmarks::State &, Test::LoopbackMessagingContext &)>
+void BenchmarkWithMessagingContext(benchmarks::State & state)
+{
+    Test::LoopbackMessagingContext ctx;
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (ctx.SetUp() == CHIP_NO_ERROR)
+    {
+        Run(state, ctx);
+        ctx.DrainAndServiceIO();
+        ctx.TearDown();
+    }
+    else
+    {
+        state.SkipWithError("Setting up the messaging context failed");
+    }
+    ctx.TearDownTestSuite();
+}
+
+void BenchmarkExchangeManagerDispatchToOpenExchange(benchmarks::State & state)
+{
+    BenchmarkWithMessagingContext<RunDispatchToOpenExchange>(state);
+}
+CHIP_BENCHMARK("ExchangeManager/DispatchToOpenExchange", BenchmarkExchangeManagerDispatchToOpenExchange);
+
+void BenchmarkExchangeManagerDispatchUnsolicited(benchmarks::State & state)
+{
+    BenchmarkWithMessagingContext<RunDispatchUnsolicited>(state);
+}
+CHIP_BENCHMARK("ExchangeManager/DispatchUnsolicited", BenchmarkExchangeManagerDispatchUnsolicited);
+
+} // namespace
@@ -0,0 +1,263 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the Linux KVS backends, the INI file (ChipLinuxStorage) and the append-only log
+ *      (ChipLinuxStorageLog), each written the way KeyValueStoreManagerImpl writes it: a single write to a store that
+ *      already holds the values of a commissioned device, and the sequence of writes a device makes when it is
+ *      commissioned onto its first fabric.
+ *
+ *      The storage files are created in $TMPDIR, or /tmp, so results depend on that file system.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+struct StorageWrite
+{
+    StorageKeyName key;
+    size_t size; // Not written, but deleted, if 0.
+};
+
+// The KVS writes of a device commissioned onto its first fabric, with typical value sizes.
+const StorageWrite kCommissioningWrites[] = {
+    { DefaultStorageKeyAllocator::FailSafeCommitMarkerKey(), 2 },
+    { DefaultStorageKeyAllocator::FabricRCAC(1), 400 },
+    { DefaultStorageKeyAllocator::FabricICAC(1), 400 },
+    { DefaultStorageKeyAllocator::FabricNOC(1), 400 },
+    { DefaultStorageKeyAllocator::FabricOpKey(1), 140 },
+    { DefaultStorageKeyAllocator::FabricMetadata(1), 40 },
+    { DefaultStorageKeyAllocator::FabricIndexInfo(), 20 },
+    { DefaultStorageKeyAllocator::GroupFabricList(), 12 },
+    { DefaultStorageKeyAllocator::FabricGroups(1), 24 },
+    { DefaultStorageKeyAllocator::FabricKeyset(1, 0), 130 },
+    { DefaultStorageKeyAllocator::GroupDataCounter(), 4 },
+    { DefaultStorageKeyAllocator::GroupControlCounter(), 4 },
+    { DefaultStorageKeyAllocator::AccessControlAclEntry(1, 0), 60 },
+    { DefaultStorageKeyAllocator::LastKnownGoodTimeKey(), 8 },
+    { DefaultStorageKeyAllocator::FailSafeCommitMarkerKey(), 0 },
+    { DefaultStorageKeyAllocator::FabricSession(1, 0x1122334455667788), 100 },
+    { DefaultStorageKeyAllocator::SessionResumption("ABCDEFGHIJKLMNOPQRSTUV=="), 40 },
+    { DefaultStorageKeyAllocator::SessionResumptionIndex(), 30 },
+};
+
+// The INI backend as KeyValueStoreManagerImpl uses it: every write is committed by rewriting the file.
+class IniStore
+{
+public:
+    CHIP_ERROR Init(const char * path) { return mStorage.Init(path); }
+
+    CHIP_ERROR Put(const char * key, const uint8_t * value, size_t size)
+    {
+        ReturnErrorOnFailure(mStorage.WriteValueBin(key, value, size));
+        return mStorage.Commit();
+    }
+
+    CHIP_ERROR Delete(const char * key)
+    {
+        ReturnErrorOnFailure(mStorage.ClearValue(key));
+        return mStorage.Commit();
+    }
+
+private:
+    ChipLinuxStorage mStorage;
+};
+
+// The log backend with the default commit window of 0: every write is synced before returning.
+class LogStore
+{
+public:
+    CHIP_ERROR Init(const char * path) { return mStorage.Init(path, System::Clock::Milliseconds32(0)); }
+    CHIP_ERROR Put(const char * key, const uint8_t * value, size_t size) { return mStorage.Put(key, value, size); }
+    CHIP_ERROR Delete(const char * key) { return mStorage.Delete(key); }
+
+private:
+    ChipLinuxStorageLog mStorage;
+};
+
+// A directory for the storage files, removed with its contents when done.
+class TemporaryDirectory
+{
+public:
+    ~TemporaryDirectory()
+    {
+        VerifyOrReturn(!mPath.empty());
+        if (DIR * dir = opendir(mPath.c_str()))
+        {
+            while (struct dirent * entry = readdir(dir))
+            {
+                if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                {
+                    unlink((mPath + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(mPath.c_str());
+    }
+
+    bool Create()
+    {
+        const char * tmpdir = getenv("TMPDIR");
+        std::string path    = std::string((tmpdir != nullptr) ? tmpdir : "/tmp") + "/chip_kvs_benchmark-XXXXXX";
+        VerifyOrReturnValue(mkdtemp(&path[0]) != nullptr, false);
+        mPath = path;
+        return true;
+    }
+
+    std::string FilePath(unsigned index) const { return mPath + "/kvs" + std::to_string(index); }
+
+private:
+    std::string mPath;
+};
+
+template <class Store>
+CHIP_ERROR WriteCommissioningValues(Store & store)
+{
+    uint8_t value[512] = {};
+    for (const StorageWrite & write : kCommissioningWrites)
+    {
+        if (write.size > 0)
+        {
+            ReturnErrorOnFailure(store.Put(write.key.KeyName(), value, write.size));
+        }
+        else
+        {
+            ReturnErrorOnFailure(store.Delete(write.key.KeyName()));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+// One 4 byte counter update, as for the message counters and the event number, in a store holding the values of a
+// commissioned device.
+template <class Store>
+void PutCounter(benchmarks::State & state)
+{
+    TemporaryDirectory directory;
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    if (directory.Create())
+    {
+        Store * store = Platform::New<Store>();
+        if (store->Init(directory.FilePath(0).c_str()) == CHIP_NO_ERROR && WriteCommissioningValues(*store) == CHIP_NO_ERROR)
+        {
+            uint32_t counter         = 0;
+            const StorageKeyName key = DefaultStorageKeyAllocator::GroupDataCounter();
+            while (state.KeepRunning())
+            {
+                counter++;
+                if (store->Put(key.KeyName(), reinterpret_cast<const uint8_t *>(&counter), sizeof(counter)) != CHIP_NO_ERROR)
+                {
+                    state.SkipWithError("Writing the counter failed");
+                    break;
+                }
+            }
+        }
+        else
+        {
+            state.SkipWithError("Initializing the store failed");
+        }
+        Platform::Delete(store);
+    }
+    else
+    {
+        state.SkipWithError("Creating the storage directory failed");
+    }
+    Platform::MemoryShutdown();
+}
+
+// The writes of commissioning, each time to a new store. Creating the store is excluded.
+template <class Store>
+void Commission(benchmarks::State & state)
+{
+    TemporaryDirectory directory;
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    if (directory.Create())
+    {
+        unsigned index = 0;
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            Store * store  = Platform::New<Store>();
+            CHIP_ERROR err = store->Init(directory.FilePath(index++).c_str());
+            state.ResumeTiming();
+
+            if (err == CHIP_NO_ERROR)
+            {
+                err = WriteCommissioningValues(*store);
+            }
+
+            state.PauseTiming();
+            Platform::Delete(store);
+            state.ResumeTiming();
+            if (err != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Writing the commissioning values failed");
+                break;
+            }
+        }
+    }
+    else
+    {
+        state.SkipWithError("Creating the storage directory failed");
+    }
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkIniPutCounter(benchmarks::State & state)
+{
+    PutCounter<IniStore>(state);
+}
+CHIP_BENCHMARK("LinuxKVS/IniPutCounter", BenchmarkIniPutCounter);
+
+void BenchmarkLogPutCounter(benchmarks::State & state)
+{
+    PutCounter<LogStore>(state);
+}
+CHIP_BENCHMARK("LinuxKVS/LogPutCounter", BenchmarkLogPutCounter);
+
+void BenchmarkIniCommission(benchmarks::State & state)
+{
+    Commission<IniStore>(state);
+}
+CHIP_BENCHMARK("LinuxKVS/IniCommission", BenchmarkIniCommission);
+
+void BenchmarkLogCommission(benchmarks::State & state)
+{
+    Commission<LogStore>(state);
+}
+CHIP_BENCHMARK("LinuxKVS/LogCommission", BenchmarkLogCommission);
+
+} // namespace
@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of decoding the packet and payload headers of received messages.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CodeUtils.h>
+#include <protocols/interaction_model/Constants.h>
+#include <transport/raw/MessageHeader.h>
+
+namespace {
+
+using namespace chip;
+
+template <typename Header>
+void BenchmarkDecode(benchmarks::State & state, const Header & header)
+{
+    uint8_t buffer[64];
+    uint16_t length = 0;
+    VerifyOrReturn(header.Encode(buffer, &length) == CHIP_NO_ERROR, state.SkipWithError("Encoding failed"));
+
+    while (state.KeepRunning())
+    {
+        Header decoded;
+        uint16_t decodedLength = 0;
+        VerifyOrReturn(decoded.Decode(buffer, length, &decodedLength) == CHIP_NO_ERROR, state.SkipWithError("Decoding failed"));
+        benchmarks::DoNotOptimize(decoded);
+    }
+}
+
+// The header of a message on a secure unicast session: a session id and counter, and no node ids.
+void BenchmarkPacketHeaderDecodeSecureUnicast(benchmarks::State & state)
+{
+    PacketHeader header;
+    header.SetSessionId(0x1234).SetMessageCounter(0x01020304).SetSessionType(Header::SessionType::kUnicastSession);
+    BenchmarkDecode(state, header);
+}
+CHIP_BENCHMARK("PacketHeader/DecodeSecureUnicast", BenchmarkPacketHeaderDecodeSecureUnicast);
+
+// The header of an unsecured session establishment message, which carries a source node id.
+void BenchmarkPacketHeaderDecodeWithNodeIds(benchmarks::State & state)
+{
+    PacketHeader header;
+    header.SetMessageCounter(0x01020304).SetSourceNodeId(0x0123456789ABCDEF).SetDestinationNodeId(0xFEDCBA9876543210);
+    BenchmarkDecode(state, header);
+}
+CHIP_BENCHMARK("PacketHeader/DecodeWithNodeIds", BenchmarkPacketHeaderDecodeWithNodeIds);
+
+void BenchmarkPayloadHeaderDecode(benchmarks::State & state)
+{
+    PayloadHeader header;
+    header.SetMessageType(Protocols::InteractionModel::MsgType::ReportData)
+        .SetExchangeID(0x4321)
+        .SetInitiator(true)
+        .SetNeedsAck(true)
+        .SetAckMessageCounter(0x05060708);
+    BenchmarkDecode(state, header);
+}
+CHIP_BENCHMARK("PayloadHeader/Decode", BenchmarkPayloadHeaderDecode);
+
+} // namespace
@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of PacketBufferHandle::New and freeing for the mix of buffer sizes that a busy node allocates: standalone
+ *      acknowledgments, reports, mDNS responses and full-size receive buffers.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System;
+
+// Payload sizes, in the proportions they are allocated in.
+constexpr size_t kMixedSizes[] = {
+    0,   0,   0, 0,         // Standalone acknowledgments
+    120, 120,               // Status responses and small commands
+    600, 600,               // Reports
+    900,                    // mDNS responses
+    PacketBuffer::kMaxSize, // Receive buffers
+};
+constexpr size_t kNumMixedSizes = sizeof(kMixedSizes) / sizeof(kMixedSizes[0]);
+
+// Buffers in flight at once, e.g. queued for sending or awaiting acknowledgment.
+constexpr size_t kBuffersInFlight = 32;
+
+void RunNewAndFree(benchmarks::State & state, const size_t * sizes, size_t numSizes)
+{
+    PacketBufferHandle buffers[kBuffersInFlight];
+    size_t next = 0;
+    while (state.KeepRunning())
+    {
+        for (auto & buffer : buffers)
+        {
+            buffer = PacketBufferHandle::New(sizes[next]);
+            next   = (next + 1) % numSizes;
+            if (buffer.IsNull())
+            {
+                state.SkipWithError("Allocating a buffer failed");
+                return;
+            }
+        }
+        for (auto & buffer : buffers)
+        {
+            buffer = nullptr;
+        }
+    }
+}
+
+void BenchmarkPacketBufferNewAndFreeAcks(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunNewAndFree(state, kMixedSizes, 1);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("PacketBuffer/NewAndFreeAcks", BenchmarkPacketBufferNewAndFreeAcks);
+
+void BenchmarkPacketBufferNewAndFreeMixedSizes(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunNewAndFree(state, kMixedSizes, kNumMixedSizes);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("PacketBuffer/NewAndFreeMixedSizes", BenchmarkPacketBufferNewAndFreeMixedSizes);
+
+} // namespace
@@ -0,0 +1,124 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmark of ReliableMessageMgr::StartTimer, which runs whenever a message is sent or acknowledged, while many
+ *      exchanges wait for the acknowledgment of their message.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/echo/Echo.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+
+// A controller with a message in flight to many devices at once; without heap pools, as many as the pool holds.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+constexpr size_t kPendingExchanges = 256;
+#else
+constexpr size_t kPendingExchanges = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS;
+#endif
+
+class NullDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && payload) override
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+void RunStartTimer(benchmarks::State & state, Test::LoopbackMessagingContext & ctx)
+{
+    // Drop every message, and retransmit long after the benchmark is done, so that every exchange stays pending.
+    auto & loopback             = ctx.GetLoopback();
+    loopback.mNumMessagesToDrop = UINT32_MAX;
+    ctx.GetSessionAliceToBob()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(60'000), // idle retransmission interval
+        System::Clock::Timestamp(60'000), // active retransmission interval
+    }));
+
+    NullDelegate delegate;
+    ExchangeContext * exchanges[kPendingExchanges];
+    size_t opened = 0;
+    for (; opened < kPendingExchanges; opened++)
+    {
+        exchanges[opened] = ctx.NewExchangeToBob(&delegate);
+        if (exchanges[opened] == nullptr)
+        {
+            state.SkipWithError("Allocating an exchange failed");
+            break;
+        }
+        System::PacketBufferHandle payload = MessagePacketBuffer::New(0);
+        if (payload.IsNull() ||
+            exchanges[opened]->SendMessage(Protocols::Echo::MsgType::EchoRequest, std::move(payload),
+                                           SendMessageFlags::kExpectResponse) != CHIP_NO_ERROR)
+        {
+            exchanges[opened++]->Abort();
+            state.SkipWithError("Sending a message failed");
+            break;
+        }
+    }
+
+    if (opened == kPendingExchanges)
+    {
+        ReliableMessageMgr * reliableMessageMgr = ctx.GetExchangeManager().GetReliableMessageMgr();
+        while (state.KeepRunning())
+        {
+            reliableMessageMgr->StartTimer();
+        }
+    }
+
+    for (size_t i = 0; i < opened; i++)
+    {
+        exchanges[i]->Abort();
+    }
+    loopback.mNumMessagesToDrop = 0;
+}
+
+void BenchmarkReliableMessageMgrStartTimer(benchmarks::State & state)
+{
+    Test::LoopbackMessagingContext ctx;
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (ctx.SetUp() == CHIP_NO_ERROR)
+    {
+        RunStartTimer(state, ctx);
+        ctx.DrainAndServiceIO();
+        ctx.TearDown();
+    }
+    else
+    {
+        state.SkipWithError("Setting up the messaging context failed");
+    }
+    ctx.TearDownTestSuite();
+}
+CHIP_BENCHMARK("ReliableMessageMgr/StartTimer", BenchmarkReliableMessageMgrStartTimer);
+
+} // namespace
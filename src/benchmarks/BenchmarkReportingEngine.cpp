@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmark of reporting::Engine::BuildAndSendSingleReportData for a wildcard read served by the mock attribute
+ *      storage, and the data model functions the interaction model needs to link against that storage.
+ */
+
+#include "Benchmark.h"
+
+#include <app/InteractionModelEngine.h>
+#include <app/MessageDef/ReadRequestMessage.h>
+#include <app/ReadHandler.h>
+#include <app/reporting/Engine.h>
+#include <app/reporting/tests/MockReportScheduler.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/endpoint-config-api.h>
+#include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+namespace chip {
+namespace app {
+
+Protocols::InteractionModel::Status ServerClusterCommandExists(const ConcreteCommandPath & aCommandPath)
+{
+    return Protocols::InteractionModel::Status::UnsupportedCommand;
+}
+
+void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, chip::TLV::TLVReader & aReader,
+                                  CommandHandler * apCommandObj)
+{}
+
+CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
+                                 const ConcreteReadAttributePath & aPath, AttributeReportIBs::Builder & aAttributeReports,
+                                 AttributeValueEncoder::AttributeEncodeState * apEncoderState)
+{
+    return Test::ReadSingleMockClusterData(aSubjectDescriptor.fabricIndex, aPath, aAttributeReports, apEncoderState);
+}
+
+bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
+{
+    return emberAfContainsAttribute(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+}
+
+CHIP_ERROR WriteSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, const ConcreteDataAttributePath & aPath,
+                                  TLV::TLVReader & aReader, WriteHandler * apWriteHandler)
+{
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+bool IsClusterDataVersionEqual(const ConcreteClusterPath & aConcreteClusterPath, DataVersion aRequiredVersion)
+{
+    return aRequiredVersion == Test::GetVersion();
+}
+
+bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint)
+{
+    return false;
+}
+
+const EmberAfAttributeMetadata * GetAttributeMetadata(const ConcreteAttributePath & aPath)
+{
+    return nullptr;
+}
+
+Protocols::InteractionModel::Status CheckEventSupportStatus(const ConcreteEventPath & aPath)
+{
+    return Protocols::InteractionModel::Status::UnsupportedEvent;
+}
+
+} // namespace app
+
+namespace benchmarks {
+
+class ReportingEngineBenchmark
+{
+public:
+    static void BuildAndSendSingleReportData(State & state);
+
+private:
+    class NullExchangeDelegate : public Messaging::ExchangeDelegate
+    {
+        CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                     System::PacketBufferHandle && payload) override
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
+    };
+
+    class NullManagementCallback : public app::ReadHandler::ManagementCallback
+    {
+    public:
+        void OnDone(app::ReadHandler & apHandler) override {}
+        app::ReadHandler::ApplicationCallback * GetAppCallback() override { return nullptr; }
+        app::InteractionModelEngine * GetInteractionModelEngine() override { return app::InteractionModelEngine::GetInstance(); }
+    };
+
+    static CHIP_ERROR BuildReadRequest(System::PacketBufferHandle & request);
+    static void Run(State & state, Test::AppContext & ctx);
+};
+
+// Read every attribute of a cluster that the mock storage has on all three endpoints.
+CHIP_ERROR ReportingEngineBenchmark::BuildReadRequest(System::PacketBufferHandle & request)
+{
+    System::PacketBufferTLVWriter writer;
+    writer.Init(System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize));
+
+    app::ReadRequestMessage::Builder requestBuilder;
+    ReturnErrorOnFailure(requestBuilder.Init(&writer));
+    app::AttributePathIBs::Builder & pathsBuilder = requestBuilder.CreateAttributeRequests();
+    ReturnErrorOnFailure(requestBuilder.GetError());
+    app::AttributePathIB::Builder & pathBuilder = pathsBuilder.CreatePath();
+    ReturnErrorOnFailure(pathsBuilder.GetError());
+    ReturnErrorOnFailure(pathBuilder.Cluster(Test::MockClusterId(1)).EndOfAttributePathIB());
+    ReturnErrorOnFailure(pathsBuilder.EndOfAttributePathIBs());
+    ReturnErrorOnFailure(requestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage());
+    return writer.Finalize(&request);
+}
+
+void ReportingEngineBenchmark::Run(State & state, Test::AppContext & ctx)
+{
+    System::PacketBufferHandle request;
+    VerifyOrReturn(BuildReadRequest(request) == CHIP_NO_ERROR, state.SkipWithError("Building the read request failed"));
+
+    app::reporting::Engine & engine = app::InteractionModelEngine::GetInstance()->GetReportingEngine();
+    NullExchangeDelegate exchangeDelegate;
+    NullManagementCallback managementCallback;
+
+    // Creating the handler and draining the report are excluded, so the measurement is the encoding of the report from
+    // the attribute storage and sending it, including its encryption.
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        {
+            Messaging::ExchangeContext * exchange = ctx.NewExchangeToAlice(&exchangeDelegate);
+            if (exchange == nullptr)
+            {
+                state.SkipWithError("Allocating an exchange failed");
+                break;
+            }
+            app::ReadHandler readHandler(managementCallback, exchange, app::ReadHandler::InteractionType::Read,
+                                         app::reporting::GetDefaultReportScheduler());
+            readHandler.OnInitialRequest(request.CloneData());
+
+            state.ResumeTiming();
+            CHIP_ERROR err = engine.BuildAndSendSingleReportData(&readHandler);
+            state.PauseTiming();
+
+            ctx.DrainAndServiceIO();
+            if (err != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Building the report failed");
+            }
+        }
+        state.ResumeTiming();
+    }
+}
+
+void ReportingEngineBenchmark::BuildAndSendSingleReportData(State & state)
+{
+    Test::AppContext ctx;
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (ctx.SetUp() == CHIP_NO_ERROR)
+    {
+        Run(state, ctx);
+        ctx.TearDown();
+    }
+    else
+    {
+        state.SkipWithError("Setting up the application context failed");
+    }
+    ctx.TearDownTestSuite();
+}
+
+} // namespace benchmarks
+} // namespace chip
+
+namespace {
+
+void BenchmarkReportingEngineBuildAndSendSingleReportData(chip::benchmarks::State & state)
+{
+    chip::benchmarks::ReportingEngineBenchmark::BuildAndSendSingleReportData(state);
+}
+CHIP_BENCHMARK("ReportingEngine/BuildAndSendSingleReportData", BenchmarkReportingEngineBuildAndSendSingleReportData);
+
+} // namespace
@@ -0,0 +1,158 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the minimal mDNS ResponseSender answering a controller's unicast query for the operational instance
+ *      of a bridge that is on many fabrics, building the reply for every query and, where it is enabled, sending the
+ *      reply kept from the first query. Replies are checked by a CheckOnlyServer.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/dnssd/minimal_mdns/ResponseSender.h>
+#include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
+#include <lib/dnssd/minimal_mdns/responders/Ptr.h>
+#include <lib/dnssd/minimal_mdns/responders/Srv.h>
+#include <lib/dnssd/minimal_mdns/responders/Txt.h>
+#include <lib/dnssd/minimal_mdns/tests/CheckOnlyServer.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+namespace {
+
+using namespace chip;
+using namespace mdns::Minimal;
+
+constexpr size_t kFabricCount   = 16;
+constexpr uint16_t kMatterPort  = 5540;
+constexpr uint16_t kMdnsPort    = 5353;
+constexpr uint64_t kBaseNodeId  = 0x0123456789ABCDEF;
+const char * kTxtEntries[]      = { "SII=5000", "SAI=300", "SAT=4000", "T=0" };
+const QNamePart kServiceParts[] = { "_matter", "_tcp", "local" };
+const QNamePart kHostParts[]    = { "AABBCCDDEEFF", "local" };
+
+/// The records a node advertises for one of its fabrics, as set up by the minimal mDNS advertiser.
+struct OperationalInstance
+{
+    explicit OperationalInstance(size_t fabricIndex) : instanceName(BuildInstanceName(instanceNameStorage, fabricIndex))
+    {
+        queryResponder.AddResponder(&ptrResponder).SetReportAdditional(instanceName).SetReportInServiceListing(true);
+        queryResponder.AddResponder(&srvResponder).SetReportAdditional(FullQName(kHostParts));
+        queryResponder.AddResponder(&txtResponder).SetReportAdditional(FullQName(kHostParts));
+    }
+
+    static FullQName BuildInstanceName(uint8_t (&storage)[128], size_t fabricIndex)
+    {
+        char label[2 * 16 + 2];
+        snprintf(label, sizeof(label), "%016" PRIX64 "-%016" PRIX64, static_cast<uint64_t>(fabricIndex + 1),
+                 kBaseNodeId + fabricIndex);
+        return FlatAllocatedQName::Build(storage, label, "_matter", "_tcp", "local");
+    }
+
+    uint8_t instanceNameStorage[128];
+    FullQName instanceName;
+
+    SrvResourceRecord srvRecord = SrvResourceRecord(instanceName, FullQName(kHostParts), kMatterPort);
+    TxtResourceRecord txtRecord = TxtResourceRecord(instanceName, kTxtEntries);
+    PtrResponder ptrResponder   = PtrResponder(FullQName(kServiceParts), instanceName);
+    SrvResponder srvResponder   = SrvResponder(srvRecord);
+    TxtResponder txtResponder   = TxtResponder(txtRecord);
+    QueryResponder<6> queryResponder;
+};
+
+void RunRespond(benchmarks::State & state, bool keepReplies)
+{
+    nlTestSuite checkSuite = { "ResponseSender", nullptr, nullptr, nullptr };
+    test::CheckOnlyServer server(&checkSuite);
+    ResponseSender responseSender(&server);
+
+    std::vector<std::unique_ptr<OperationalInstance>> instances;
+    for (size_t i = 0; i < kFabricCount; i++)
+    {
+        instances.push_back(std::make_unique<OperationalInstance>(i));
+        VerifyOrReturn(responseSender.AddQueryResponder(&instances.back()->queryResponder) == CHIP_NO_ERROR,
+                       state.SkipWithError("Adding a query responder failed"));
+    }
+
+    // A query for the SRV and TXT records of the instance that was advertised last, asking for a unicast reply.
+    OperationalInstance & queried = *instances.back();
+    uint8_t queryStorage[128];
+    Encoding::BigEndian::BufferWriter queryWriter(queryStorage, sizeof(queryStorage));
+    RecordWriter recordWriter(&queryWriter);
+    recordWriter.WriteQName(queried.instanceName);
+    VerifyOrReturn(queryWriter.Fit(), state.SkipWithError("Writing the query failed"));
+    const QueryData query(QType::ANY, QClass::IN, true /* unicast */, queryStorage,
+                          BytesRange(queryStorage, queryStorage + queryWriter.Needed()));
+
+    Inet::IPPacketInfo packetInfo;
+    packetInfo.Clear();
+    Inet::IPAddress::FromString("fe80::1", packetInfo.SrcAddress);
+    packetInfo.SrcPort = kMdnsPort;
+
+    uint16_t messageId = 0;
+    while (state.KeepRunning())
+    {
+        if (!keepReplies)
+        {
+            responseSender.ClearResponseCache();
+        }
+
+        server.Reset();
+        server.AddExpectedRecord(&queried.srvRecord);
+        server.AddExpectedRecord(&queried.txtRecord);
+        if (responseSender.Respond(++messageId, query, &packetInfo, ResponseConfiguration()) != CHIP_NO_ERROR ||
+            !server.GetHeaderFound())
+        {
+            state.SkipWithError("Replying to the query failed");
+            break;
+        }
+    }
+
+    if (checkSuite.failedAssertions != 0)
+    {
+        state.SkipWithError("The reply did not have the expected records");
+    }
+}
+
+void BenchmarkResponseSenderRespond(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunRespond(state, false);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("ResponseSender/Respond", BenchmarkResponseSenderRespond);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+void BenchmarkResponseSenderRespondKept(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    RunRespond(state, true);
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("ResponseSender/RespondKept", BenchmarkResponseSenderRespondKept);
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+} // namespace
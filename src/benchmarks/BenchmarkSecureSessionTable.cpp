@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the SecureSessionTable with every session of the pool in use: the lookup of a session by local
+ *      session ID that every received secure message makes, and the allocation of a session with a free ID, as for
+ *      every PASE and CASE handshake.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <transport/SecureSessionTable.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+constexpr size_t kNumSessions = CHIP_CONFIG_SECURE_SESSION_POOL_SIZE;
+
+// Fills [sessionTable] with [count] pending sessions held by [sessions], and returns how many were created.
+size_t FillTable(SecureSessionTable & sessionTable, Optional<SessionHandle> * sessions, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        sessions[i] = sessionTable.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+        VerifyOrReturnValue(sessions[i].HasValue(), i);
+    }
+    return count;
+}
+
+// Runs [measure] with a SecureSessionTable holding [count] sessions.
+template <typename Measure>
+void WithSessions(benchmarks::State & state, size_t count, Measure measure)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    {
+        SecureSessionTable sessionTable;
+        sessionTable.Init();
+
+        Optional<SessionHandle> * sessions = new Optional<SessionHandle>[kNumSessions];
+        if (FillTable(sessionTable, sessions, count) == count)
+        {
+            measure(sessionTable, sessions);
+        }
+        else
+        {
+            state.SkipWithError("Creating the sessions failed");
+        }
+
+        // Dropping the last reference to a pending session releases it to the table.
+        delete[] sessions;
+    }
+    Platform::MemoryShutdown();
+}
+
+// The session lookup of every received secure message, in a full table.
+void BenchmarkFindByLocalKey(benchmarks::State & state)
+{
+    WithSessions(state, kNumSessions, [&state](SecureSessionTable & sessionTable, Optional<SessionHandle> * sessions) {
+        size_t next = 0;
+        while (state.KeepRunning())
+        {
+            const uint16_t sessionId        = sessions[next].Value()->AsSecureSession()->GetLocalSessionId();
+            next                            = (next + 7919) % kNumSessions;
+            Optional<SessionHandle> session = sessionTable.FindSecureSessionByLocalKey(sessionId);
+            benchmarks::DoNotOptimize(session);
+        }
+    });
+}
+CHIP_BENCHMARK("SecureSessionTable/FindByLocalKeyFull", BenchmarkFindByLocalKey);
+
+// A session ID that belongs to no session, as for a message of a session the peer still holds after a reboot.
+void BenchmarkFindUnknownLocalKey(benchmarks::State & state)
+{
+    WithSessions(state, kNumSessions, [&state](SecureSessionTable & sessionTable, Optional<SessionHandle> * sessions) {
+        const uint16_t sessionId = static_cast<uint16_t>(sessions[0].Value()->AsSecureSession()->GetLocalSessionId() - 1);
+        while (state.KeepRunning())
+        {
+            Optional<SessionHandle> session = sessionTable.FindSecureSessionByLocalKey(sessionId);
+            benchmarks::DoNotOptimize(session);
+        }
+    });
+}
+CHIP_BENCHMARK("SecureSessionTable/FindUnknownLocalKeyFull", BenchmarkFindUnknownLocalKey);
+
+// A session is allocated in the last free slot of the table and released again, as a handshake that fails does.
+void BenchmarkCreateAndRelease(benchmarks::State & state)
+{
+    WithSessions(state, kNumSessions - 1, [&state](SecureSessionTable & sessionTable, Optional<SessionHandle> * sessions) {
+        while (state.KeepRunning())
+        {
+            Optional<SessionHandle> session = sessionTable.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+            if (!session.HasValue())
+            {
+                state.SkipWithError("Creating the session failed");
+                break;
+            }
+        }
+    });
+}
+CHIP_BENCHMARK("SecureSessionTable/CreateAndReleaseFull", BenchmarkCreateAndRelease);
+
+} // namespace
@@ -0,0 +1,179 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmark of SessionManager::OnMessageReceived for messages on a secure unicast session: header decoding,
+ *      session lookup, decryption, counter verification and dispatch to a new exchange. It is measured with the
+ *      sessions of the messaging context only, and with a session pool's worth of other sessions, as on a controller with
+ *      sessions to many nodes.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CodeUtils.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeDelegate.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/echo/Echo.h>
+#include <transport/SessionManager.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+
+constexpr size_t kPayloadLength = 64;
+// Messages are encrypted in batches with timing paused, so that the clock is only read once per batch.
+constexpr size_t kBatchSize = 64;
+// Above the session IDs of the messaging context.
+constexpr uint16_t kFirstOtherSessionId = 1000;
+
+class CountingHandler : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && payload) override
+    {
+        mReceived++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint64_t mReceived = 0;
+};
+
+CHIP_ERROR PrepareEchoRequest(Test::LoopbackMessagingContext & ctx, uint16_t exchangeId, EncryptedPacketBufferHandle & message)
+{
+    static const uint8_t kPayload[kPayloadLength] = {};
+
+    System::PacketBufferHandle buffer = MessagePacketBuffer::NewWithData(kPayload, sizeof(kPayload));
+    VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetMessageType(Protocols::Echo::MsgType::EchoRequest).SetExchangeID(exchangeId).SetInitiator(true);
+    return ctx.GetSecureSessionManager().PrepareMessage(ctx.GetSessionBobToAlice(), payloadHeader, std::move(buffer), message);
+}
+
+CHIP_ERROR PrepareBatch(Test::LoopbackMessagingContext & ctx, uint16_t & exchangeId,
+                        EncryptedPacketBufferHandle (&batch)[kBatchSize])
+{
+    for (auto & message : batch)
+    {
+        ReturnErrorOnFailure(PrepareEchoRequest(ctx, exchangeId++, message));
+    }
+    return CHIP_NO_ERROR;
+}
+
+void RunOnMessageReceived(benchmarks::State & state, Test::LoopbackMessagingContext & ctx)
+{
+    CountingHandler handler;
+    ExchangeManager & exchangeManager = ctx.GetExchangeManager();
+    VerifyOrReturn(exchangeManager.RegisterUnsolicitedMessageHandlerForType(Protocols::Echo::MsgType::EchoRequest, &handler) ==
+                       CHIP_NO_ERROR,
+                   state.SkipWithError("Registering the handler failed"));
+
+    EncryptedPacketBufferHandle batch[kBatchSize];
+    size_t next         = kBatchSize;
+    uint16_t exchangeId = 0;
+    uint64_t delivered  = 0;
+    while (state.KeepRunning())
+    {
+        if (next == kBatchSize)
+        {
+            state.PauseTiming();
+            if (PrepareBatch(ctx, exchangeId, batch) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Preparing a message failed");
+                break;
+            }
+            next = 0;
+            state.ResumeTiming();
+        }
+
+        // The receive path decrypts in place, so it gets the only reference to the prepared buffer.
+        System::PacketBufferHandle message = batch[next].CastToWritable();
+        batch[next++]                      = EncryptedPacketBufferHandle();
+        ctx.GetSecureSessionManager().OnMessageReceived(ctx.GetBobAddress(), std::move(message));
+        delivered++;
+    }
+
+    ctx.DrainAndServiceIO();
+    if (handler.mReceived != delivered && state.GetError() == nullptr)
+    {
+        state.SkipWithError("Not every message was dispatched");
+    }
+    exchangeManager.UnregisterUnsolicitedMessageHandlerForType(Protocols::Echo::MsgType::EchoRequest);
+}
+
+// Adds CHIP_CONFIG_SECURE_SESSION_POOL_SIZE CASE sessions to other nodes of Bob's fabric, or as many as the session
+// pool has room for.
+void FillSessionTable(Test::LoopbackMessagingContext & ctx, SessionHolder (&holders)[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE])
+{
+    const NodeId localNodeId = ctx.GetBobFabric()->GetNodeId();
+    for (uint16_t i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i++)
+    {
+        const uint16_t sessionId = static_cast<uint16_t>(kFirstOtherSessionId + i);
+        CHIP_ERROR err           = ctx.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+            holders[i], sessionId, sessionId, localNodeId, localNodeId + 1 + i, ctx.GetBobFabricIndex(), ctx.GetAliceAddress(),
+            CryptoContext::SessionRole::kInitiator);
+        VerifyOrReturn(err == CHIP_NO_ERROR);
+    }
+}
+
+void OnMessageReceived(benchmarks::State & state, bool fullSessionTable)
+{
+    Test::LoopbackMessagingContext ctx;
+    VerifyOrReturn(ctx.SetUpTestSuite() == CHIP_NO_ERROR, state.SkipWithError("Setting up the test suite failed"));
+    if (ctx.SetUp() == CHIP_NO_ERROR)
+    {
+        SessionHolder otherSessions[CHIP_CONFIG_SECURE_SESSION_POOL_SIZE];
+        if (fullSessionTable)
+        {
+            FillSessionTable(ctx, otherSessions);
+        }
+        RunOnMessageReceived(state, ctx);
+        ctx.TearDown();
+    }
+    else
+    {
+        state.SkipWithError("Setting up the messaging context failed");
+    }
+    ctx.TearDownTestSuite();
+}
+
+void BenchmarkSessionManagerOnMessageReceived(benchmarks::State & state)
+{
+    OnMessageReceived(state, false);
+}
+CHIP_BENCHMARK("SessionManager/OnMessageReceived", BenchmarkSessionManagerOnMessageReceived);
+
+void BenchmarkSessionManagerOnMessageReceivedFullTable(benchmarks::State & state)
+{
+    OnMessageReceived(state, true);
+}
+CHIP_BENCHMARK("SessionManager/OnMessageReceivedFullTable", BenchmarkSessionManagerOnMessageReceivedFullTable);
+
+} // namespace
@@ -0,0 +1,207 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of a controller's session resumption storage during a reconnect storm: after a restart, the
+ *      controller resumes a session with each of its nodes, looking up the stored resumption state and saving the new
+ *      one. SimpleSessionResumptionStorage is measured with as many nodes as it can hold, and
+ *      CachedSessionResumptionStorage with as many and with a full table, writing every save through or writing the
+ *      storm's pages back together.
+ */
+
+#include "Benchmark.h"
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <system/SystemLayerImpl.h>
+
+namespace {
+
+using namespace chip;
+
+constexpr FabricIndex kFabricIndex = 1;
+constexpr NodeId kFirstNodeId      = 0x1000;
+constexpr size_t kSimpleNodeCount  = CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE;
+constexpr size_t kMaxNodeCount     = CachedSessionResumptionStorage::kCacheSize;
+
+struct Resumption
+{
+    SessionResumptionStorage::ResumptionIdStorage resumptionId;
+    Crypto::P256ECDHDerivedSecret sharedSecret;
+    CATValues peerCATs;
+};
+
+// The resumption state that the handshakes of a storm save, alternating so that every save replaces the stored state.
+Resumption sResumptions[2][kMaxNodeCount];
+
+CHIP_ERROR InitResumptions()
+{
+    for (auto & storm : sResumptions)
+    {
+        for (auto & resumption : storm)
+        {
+            resumption.sharedSecret.SetLength(resumption.sharedSecret.Capacity());
+            ReturnErrorOnFailure(Crypto::DRBG_get_bytes(resumption.resumptionId.data(), resumption.resumptionId.size()));
+            ReturnErrorOnFailure(Crypto::DRBG_get_bytes(resumption.sharedSecret.Bytes(), resumption.sharedSecret.Length()));
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PopulateStorage(SessionResumptionStorage & sessionStorage, size_t nodeCount)
+{
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        const Resumption & resumption = sResumptions[1][i];
+        ReturnErrorOnFailure(sessionStorage.Save(ScopedNodeId(kFirstNodeId + i, kFabricIndex), resumption.resumptionId,
+                                                 resumption.sharedSecret, resumption.peerCATs));
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Each node is looked up by the initiator, then by the resumption ID the responder echoes, and the resumed session's
+// new state is saved.
+CHIP_ERROR RunStorm(SessionResumptionStorage & sessionStorage, size_t nodeCount, uint64_t stormIndex)
+{
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        const ScopedNodeId node(kFirstNodeId + i, kFabricIndex);
+        SessionResumptionStorage::ResumptionIdStorage resumptionId;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        ReturnErrorOnFailure(sessionStorage.FindByScopedNodeId(node, resumptionId, sharedSecret, peerCATs));
+
+        ScopedNodeId foundNode;
+        ReturnErrorOnFailure(sessionStorage.FindByResumptionId(resumptionId, foundNode, sharedSecret, peerCATs));
+        VerifyOrReturnError(foundNode == node, CHIP_ERROR_INTERNAL);
+
+        const Resumption & resumption = sResumptions[stormIndex % 2][i];
+        ReturnErrorOnFailure(sessionStorage.Save(node, resumption.resumptionId, resumption.sharedSecret, resumption.peerCATs));
+    }
+    return CHIP_NO_ERROR;
+}
+
+// A controller restart with the storage that the controller factory used before the cache.
+void BenchmarkSessionResumptionReconnectStormSimple(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    TestPersistentStorageDelegate storage;
+    SimpleSessionResumptionStorage populator;
+    if (InitResumptions() == CHIP_NO_ERROR && populator.Init(&storage) == CHIP_NO_ERROR &&
+        PopulateStorage(populator, kSimpleNodeCount) == CHIP_NO_ERROR)
+    {
+        uint64_t stormIndex = 0;
+        while (state.KeepRunning())
+        {
+            SimpleSessionResumptionStorage sessionStorage;
+            if (sessionStorage.Init(&storage) != CHIP_NO_ERROR ||
+                RunStorm(sessionStorage, kSimpleNodeCount, stormIndex++) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("The reconnect storm failed");
+                break;
+            }
+        }
+    }
+    else
+    {
+        state.SkipWithError("Populating storage failed");
+    }
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("SessionResumption/ReconnectStormSimple", BenchmarkSessionResumptionReconnectStormSimple);
+
+// A controller restart with the cache, which loads every page in Init(). With a write-back delay, the write-back
+// timer does not fire here, so the storm's pages are written at the end, as the timer would do once the storm is over.
+CHIP_ERROR RunCachedStorm(PersistentStorageDelegate & storage, System::Layer & systemLayer, System::Clock::Timeout writeBackDelay,
+                          size_t nodeCount, uint64_t stormIndex)
+{
+    CachedSessionResumptionStorage * sessionStorage = Platform::New<CachedSessionResumptionStorage>();
+    VerifyOrReturnError(sessionStorage != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    CHIP_ERROR err = sessionStorage->Init(&storage, &systemLayer, writeBackDelay);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = RunStorm(*sessionStorage, nodeCount, stormIndex);
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = sessionStorage->Flush();
+    }
+    sessionStorage->Shutdown();
+    Platform::Delete(sessionStorage);
+    return err;
+}
+
+template <size_t kNodeCount, uint32_t kWriteBackDelayMs>
+void ReconnectStormCached(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    {
+        TestPersistentStorageDelegate storage;
+        System::LayerImpl systemLayer;
+        CachedSessionResumptionStorage * populator = Platform::New<CachedSessionResumptionStorage>();
+        const bool populated = populator != nullptr && InitResumptions() == CHIP_NO_ERROR &&
+            populator->Init(&storage) == CHIP_NO_ERROR && PopulateStorage(*populator, kNodeCount) == CHIP_NO_ERROR;
+        Platform::Delete(populator);
+
+        if (populated && systemLayer.Init() == CHIP_NO_ERROR)
+        {
+            uint64_t stormIndex = 0;
+            while (state.KeepRunning())
+            {
+                if (RunCachedStorm(storage, systemLayer, System::Clock::Milliseconds32(kWriteBackDelayMs), kNodeCount,
+                                   stormIndex++) != CHIP_NO_ERROR)
+                {
+                    state.SkipWithError("The reconnect storm failed");
+                    break;
+                }
+            }
+            systemLayer.Shutdown();
+        }
+        else
+        {
+            state.SkipWithError("Populating storage failed");
+        }
+    }
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkSessionResumptionReconnectStormCached(benchmarks::State & state)
+{
+    ReconnectStormCached<kSimpleNodeCount, 0>(state);
+}
+CHIP_BENCHMARK("SessionResumption/ReconnectStormCached", BenchmarkSessionResumptionReconnectStormCached);
+
+void BenchmarkSessionResumptionReconnectStormCachedFull(benchmarks::State & state)
+{
+    ReconnectStormCached<kMaxNodeCount, 0>(state);
+}
+CHIP_BENCHMARK("SessionResumption/ReconnectStormCachedFull", BenchmarkSessionResumptionReconnectStormCachedFull);
+
+void BenchmarkSessionResumptionReconnectStormCachedFullWriteBack(benchmarks::State & state)
+{
+    ReconnectStormCached<kMaxNodeCount, 1000>(state);
+}
+CHIP_BENCHMARK("SessionResumption/ReconnectStormCachedFullWriteBack", BenchmarkSessionResumptionReconnectStormCachedFullWriteBack);
+
+} // namespace
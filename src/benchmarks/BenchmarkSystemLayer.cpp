@@ -0,0 +1,236 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of the configured socket based System::Layer event loop: dispatching a readable socket among many
+ *      idle watched ones, as in a bridge or controller with hundreds of open connections, and restarting one of many
+ *      pending timers, as MRP retransmissions and subscription liveness timers do.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemTimer.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+
+constexpr size_t kNumPendingTimers = 1000;
+
+struct WatchedPipe
+{
+    int readFd                     = -1;
+    int writeFd                    = -1;
+    System::SocketWatchToken token = 0;
+    bool watched                   = false;
+};
+
+void OnReadable(System::SocketEvents events, intptr_t data)
+{
+    char buf[16];
+    while (read(static_cast<int>(data), buf, sizeof(buf)) > 0)
+    {
+    }
+}
+
+// Raise the soft limit on open descriptors to at least [count], if the hard limit allows it.
+bool EnsureDescriptorLimit(rlim_t count)
+{
+    struct rlimit limit;
+    VerifyOrReturnValue(getrlimit(RLIMIT_NOFILE, &limit) == 0, false);
+    VerifyOrReturnValue(limit.rlim_cur < count, true);
+    VerifyOrReturnValue(limit.rlim_max == RLIM_INFINITY || limit.rlim_max >= count, false);
+    limit.rlim_cur = count;
+    return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+}
+
+CHIP_ERROR OpenAndWatch(System::LayerImpl & systemLayer, WatchedPipe & pipe)
+{
+    int fds[2];
+    VerifyOrReturnError(::pipe(fds) == 0, CHIP_ERROR_POSIX(errno));
+    pipe.readFd  = fds[0];
+    pipe.writeFd = fds[1];
+    VerifyOrReturnError(fcntl(pipe.readFd, F_SETFL, O_NONBLOCK) == 0, CHIP_ERROR_POSIX(errno));
+
+    ReturnErrorOnFailure(systemLayer.StartWatchingSocket(pipe.readFd, &pipe.token));
+    pipe.watched = true;
+    ReturnErrorOnFailure(systemLayer.SetCallback(pipe.token, OnReadable, pipe.readFd));
+    return systemLayer.RequestCallbackOnPendingRead(pipe.token);
+}
+
+void Close(System::LayerImpl & systemLayer, WatchedPipe & pipe)
+{
+    if (pipe.watched)
+    {
+        systemLayer.StopWatchingSocket(&pipe.token);
+    }
+    if (pipe.readFd >= 0)
+    {
+        close(pipe.readFd);
+        close(pipe.writeFd);
+    }
+    pipe = WatchedPipe();
+}
+
+void RunSocketWakeup(benchmarks::State & state, System::LayerImpl & systemLayer, WatchedPipe * pipes, size_t numWatched)
+{
+    VerifyOrReturn(EnsureDescriptorLimit(2 * numWatched + 64),
+                   state.SkipWithError("RLIMIT_NOFILE does not allow watching that many sockets"));
+    for (size_t i = 0; i < numWatched; i++)
+    {
+        VerifyOrReturn(OpenAndWatch(systemLayer, pipes[i]) == CHIP_NO_ERROR, state.SkipWithError("Watching the sockets failed"));
+    }
+
+    size_t next = 0;
+    while (state.KeepRunning())
+    {
+        // Stride through the sockets so that consecutive wakeups are for sockets far apart in the watch table.
+        WatchedPipe & pipe = pipes[next];
+        next               = (next + 7919) % numWatched;
+        if (write(pipe.writeFd, "x", 1) != 1)
+        {
+            state.SkipWithError("Writing to the pipe failed");
+            break;
+        }
+        systemLayer.PrepareEvents();
+        systemLayer.WaitForEvents();
+        systemLayer.HandleEvents();
+    }
+}
+
+// One socket becomes readable while the other watched sockets are idle, and one event loop turn dispatches it.
+template <size_t kNumWatched>
+void BenchmarkSocketWakeup(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    System::LayerImpl systemLayer;
+    if (systemLayer.Init() == CHIP_NO_ERROR)
+    {
+        WatchedPipe * pipes = new WatchedPipe[kNumWatched];
+        RunSocketWakeup(state, systemLayer, pipes, kNumWatched);
+        for (size_t i = 0; i < kNumWatched; i++)
+        {
+            Close(systemLayer, pipes[i]);
+        }
+        delete[] pipes;
+    }
+    else
+    {
+        state.SkipWithError("Initializing the system layer failed");
+    }
+    systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkSystemLayerSocketWakeup16(benchmarks::State & state)
+{
+    BenchmarkSocketWakeup<16>(state);
+}
+CHIP_BENCHMARK("SystemLayer/SocketWakeup16", BenchmarkSystemLayerSocketWakeup16);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+// The Select event loop can not watch this many sockets: its watch table is sized by the endpoint pools, and select()
+// is limited to descriptors below FD_SETSIZE.
+void BenchmarkSystemLayerSocketWakeup1000(benchmarks::State & state)
+{
+    BenchmarkSocketWakeup<1000>(state);
+}
+CHIP_BENCHMARK("SystemLayer/SocketWakeup1000", BenchmarkSystemLayerSocketWakeup1000);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+void OnTimer(System::Layer * systemLayer, void * appState) {}
+
+// Timers with the given [appState]s that expire in 1 to 65 seconds, as a pseudo-random function of [i] and [round].
+System::TimerList::Node * NewTimer(System::Layer & systemLayer, void * appState, size_t i, unsigned round)
+{
+    const uint32_t hash                  = static_cast<uint32_t>((i + 1) * 2654435761u) ^ (round * 40503u);
+    const System::Clock::Timestamp delay = System::Clock::Milliseconds64(1000 + (hash % 64000));
+    return Platform::New<System::TimerList::Node>(systemLayer, delay, OnTimer, appState);
+}
+
+// One of kNumPendingTimers pending timers is cancelled (found by callback and application state, as by
+// Layer::CancelTimer()) and started again with another expiry.
+template <class Queue>
+void RestartTimer(benchmarks::State & state)
+{
+    using Node = System::TimerList::Node;
+
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    System::LayerImpl systemLayer;
+    if (systemLayer.Init() == CHIP_NO_ERROR)
+    {
+        // Two timers per application state, so that a restart only swaps timers and allocates nothing.
+        uint8_t appStates[kNumPendingTimers];
+        Node * spare[kNumPendingTimers];
+        Queue queue;
+        for (size_t i = 0; i < kNumPendingTimers; i++)
+        {
+            queue.Add(NewTimer(systemLayer, &appStates[i], i, 0));
+            spare[i] = NewTimer(systemLayer, &appStates[i], i, 1);
+        }
+
+        size_t next = 0;
+        while (state.KeepRunning())
+        {
+            Node * cancelled = queue.Remove(OnTimer, &appStates[next]);
+            queue.Add(spare[next]);
+            spare[next] = cancelled;
+            next        = (next + 7919) % kNumPendingTimers;
+        }
+
+        for (size_t i = 0; i < kNumPendingTimers; i++)
+        {
+            Platform::Delete(spare[i]);
+        }
+        while (Node * timer = queue.PopEarliest())
+        {
+            Platform::Delete(timer);
+        }
+    }
+    else
+    {
+        state.SkipWithError("Initializing the system layer failed");
+    }
+    systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+}
+
+void BenchmarkTimerListRestart(benchmarks::State & state)
+{
+    RestartTimer<System::TimerList>(state);
+}
+CHIP_BENCHMARK("SystemLayer/TimerListRestart1000", BenchmarkTimerListRestart);
+
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+void BenchmarkTimerWheelRestart(benchmarks::State & state)
+{
+    RestartTimer<System::TimerWheel>(state);
+}
+CHIP_BENCHMARK("SystemLayer/TimerWheelRestart1000", BenchmarkTimerWheelRestart);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+} // namespace
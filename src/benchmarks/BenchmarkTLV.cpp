@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of TLVWriter and TLVReader on a structure shaped like the attribute data of a report: a list of
+ *      records of paths, versions and mixed scalar, string and octet string values.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::TLV;
+
+constexpr size_t kRecordCount = 8;
+constexpr uint8_t kOctets[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+constexpr char kLabel[]       = "kitchen-ceiling-light";
+
+CHIP_ERROR EncodeRecords(TLVWriter & writer)
+{
+    TLVType outer;
+    TLVType list;
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outer));
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(1), kTLVType_Array, list));
+    for (size_t i = 0; i < kRecordCount; i++)
+    {
+        TLVType record;
+        ReturnErrorOnFailure(writer.StartContainer(AnonymousTag(), kTLVType_Structure, record));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint16_t>(1 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(1), static_cast<uint32_t>(0x0006 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint32_t>(0x4000 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(3), static_cast<uint32_t>(0x12345678 + i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(4), (i % 2) == 0));
+        ReturnErrorOnFailure(writer.Put(ContextTag(5), static_cast<int64_t>(-1000000007) * static_cast<int64_t>(i)));
+        ReturnErrorOnFailure(writer.PutString(ContextTag(6), kLabel));
+        ReturnErrorOnFailure(writer.Put(ContextTag(7), ByteSpan(kOctets)));
+        ReturnErrorOnFailure(writer.EndContainer(record));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(list));
+    ReturnErrorOnFailure(writer.Put(ContextTag(2), static_cast<uint8_t>(kRecordCount)));
+    ReturnErrorOnFailure(writer.EndContainer(outer));
+    return writer.Finalize();
+}
+
+// Decode every element with the getter for its type, as generated cluster object decoding would.
+CHIP_ERROR DecodeRecords(TLVReader & reader, uint64_t & checksum)
+{
+    TLVType outer;
+    TLVType list;
+    ReturnErrorOnFailure(reader.Next(kTLVType_Structure, AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(outer));
+    ReturnErrorOnFailure(reader.Next(kTLVType_Array, ContextTag(1)));
+    ReturnErrorOnFailure(reader.EnterContainer(list));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        TLVType record;
+        ReturnErrorOnFailure(reader.EnterContainer(record));
+        while ((err = reader.Next()) == CHIP_NO_ERROR)
+        {
+            switch (TagNumFromTag(reader.GetTag()))
+            {
+            case 4: {
+                bool value;
+                ReturnErrorOnFailure(reader.Get(value));
+                checksum += value ? 1 : 0;
+                break;
+            }
+            case 5: {
+                int64_t value;
+                ReturnErrorOnFailure(reader.Get(value));
+                checksum += static_cast<uint64_t>(value);
+                break;
+            }
+            case 6: {
+                CharSpan value;
+                ReturnErrorOnFailure(reader.Get(value));
+                checksum += value.size();
+                break;
+            }
+            case 7: {
+                ByteSpan value;
+                ReturnErrorOnFailure(reader.Get(value));
+                checksum += value.size();
+                break;
+            }
+            default: {
+                uint32_t value;
+                ReturnErrorOnFailure(reader.Get(value));
+                checksum += value;
+                break;
+            }
+            }
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(reader.ExitContainer(record));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(reader.ExitContainer(list));
+    ReturnErrorOnFailure(reader.ExitContainer(outer));
+    return CHIP_NO_ERROR;
+}
+
+void BenchmarkTLVWriterEncode(benchmarks::State & state)
+{
+    uint8_t buffer[1024];
+    while (state.KeepRunning())
+    {
+        TLVWriter writer;
+        writer.Init(buffer);
+        VerifyOrReturn(EncodeRecords(writer) == CHIP_NO_ERROR, state.SkipWithError("Encoding failed"));
+        benchmarks::DoNotOptimize(buffer);
+    }
+}
+CHIP_BENCHMARK("TLVWriter/EncodeReport", BenchmarkTLVWriterEncode);
+
+void BenchmarkTLVReaderDecode(benchmarks::State & state)
+{
+    uint8_t buffer[1024];
+    TLVWriter writer;
+    writer.Init(buffer);
+    VerifyOrReturn(EncodeRecords(writer) == CHIP_NO_ERROR, state.SkipWithError("Encoding failed"));
+    const uint32_t length = writer.GetLengthWritten();
+
+    while (state.KeepRunning())
+    {
+        TLVReader reader;
+        reader.Init(buffer, length);
+        uint64_t checksum = 0;
+        VerifyOrReturn(DecodeRecords(reader, checksum) == CHIP_NO_ERROR, state.SkipWithError("Decoding failed"));
+        benchmarks::DoNotOptimize(checksum);
+    }
+}
+CHIP_BENCHMARK("TLVReader/DecodeReport", BenchmarkTLVReaderDecode);
+
+} // namespace
@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Benchmarks of UDPEndPoint over the loopback interface: a burst of small datagrams is sent from one endpoint to
+ *      another and the system layer event loop is run until all of them are received, which is how report bursts and
+ *      group command fan-out reach the stack. Each operation is one datagram, so 1e9 / (ns/op) is the packet rate.
+ */
+
+#include "Benchmark.h"
+
+#include <inet/IPAddress.h>
+#include <inet/UDPEndPointImpl.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayerImpl.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Inet;
+
+constexpr size_t kBurstSize                         = 32; // datagrams sent before running the event loop
+constexpr uint16_t kPayloadLength                   = 64; // about the size of a standalone acknowledgement
+constexpr System::Clock::Milliseconds32 kBurstLimit = System::Clock::Milliseconds32(1000);
+
+void OnMessageReceived(UDPEndPoint * endPoint, System::PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    ++*static_cast<size_t *>(endPoint->mAppState);
+}
+
+void OnReceiveError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo) {}
+
+void OnBurstLimit(System::Layer * systemLayer, void * appState) {}
+
+CHIP_ERROR SendBurst(UDPEndPoint & sender, const IPAddress & address, uint16_t port, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kPayloadLength);
+        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+        memset(buffer->Start(), static_cast<int>(i), kPayloadLength);
+        buffer->SetDataLength(kPayloadLength);
+        ReturnErrorOnFailure(sender.SendTo(address, port, std::move(buffer)));
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Run the event loop until [received] reaches [expected], or kBurstLimit passes if datagrams were lost.
+CHIP_ERROR RunEventLoopUntil(System::LayerImpl & systemLayer, const size_t & received, size_t expected)
+{
+    const System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+
+    // Keep WaitForEvents() from blocking for good if a datagram is lost.
+    ReturnErrorOnFailure(systemLayer.StartTimer(kBurstLimit, OnBurstLimit, nullptr));
+    while (received < expected && System::SystemClock().GetMonotonicTimestamp() - start < kBurstLimit)
+    {
+        systemLayer.PrepareEvents();
+        systemLayer.WaitForEvents();
+        systemLayer.HandleEvents();
+    }
+    systemLayer.CancelTimer(OnBurstLimit, nullptr);
+    return (received < expected) ? CHIP_ERROR_TIMEOUT : CHIP_NO_ERROR;
+}
+
+void RunLoopback(benchmarks::State & state, System::LayerImpl & systemLayer, UDPEndPointManagerImpl & udpEndPointManager)
+{
+    IPAddress loopback;
+    VerifyOrReturn(IPAddress::FromString("::1", loopback), state.SkipWithError("Parsing the loopback address failed"));
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    size_t received        = 0;
+    if (udpEndPointManager.NewEndPoint(&receiver) != CHIP_NO_ERROR || udpEndPointManager.NewEndPoint(&sender) != CHIP_NO_ERROR ||
+        receiver->Bind(IPAddressType::kIPv6, loopback, 0) != CHIP_NO_ERROR ||
+        receiver->Listen(OnMessageReceived, OnReceiveError, &received) != CHIP_NO_ERROR ||
+        sender->Bind(IPAddressType::kIPv6, loopback, 0) != CHIP_NO_ERROR)
+    {
+        state.SkipWithError("Setting up the UDP endpoints failed");
+    }
+    else
+    {
+        const uint16_t port = receiver->GetBoundPort();
+        size_t datagram     = 0;
+        while (state.KeepRunning())
+        {
+            // Iterations are datagrams: every kBurstSize of them, send a burst and run the event loop until it is
+            // received, so that the time of a burst is spread over its datagrams.
+            if ((datagram++ % kBurstSize) != 0)
+            {
+                continue;
+            }
+            const size_t expected = received + kBurstSize;
+            if (SendBurst(*sender, loopback, port, kBurstSize) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Sending the datagrams failed");
+                break;
+            }
+            if (RunEventLoopUntil(systemLayer, received, expected) != CHIP_NO_ERROR)
+            {
+                state.SkipWithError("Receiving the datagrams failed");
+                break;
+            }
+        }
+    }
+
+    if (sender != nullptr)
+    {
+        sender->Free();
+    }
+    if (receiver != nullptr)
+    {
+        receiver->Free();
+    }
+}
+
+void BenchmarkUDPEndPointLoopback(benchmarks::State & state)
+{
+    VerifyOrReturn(Platform::MemoryInit() == CHIP_NO_ERROR, state.SkipWithError("Initializing memory failed"));
+    System::LayerImpl systemLayer;
+    UDPEndPointManagerImpl udpEndPointManager;
+    if (systemLayer.Init() == CHIP_NO_ERROR && udpEndPointManager.Init(systemLayer) == CHIP_NO_ERROR)
+    {
+        RunLoopback(state, systemLayer, udpEndPointManager);
+        udpEndPointManager.Shutdown();
+    }
+    else
+    {
+        state.SkipWithError("Initializing the system layer failed");
+    }
+    systemLayer.Shutdown();
+    Platform::MemoryShutdown();
+}
+CHIP_BENCHMARK("UDPEndPoint/Loopback", BenchmarkUDPEndPointLoopback);
+
+} // namespace
@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements chip_benchmarks, which runs the microbenchmarks of the core data paths registered with
+ *      CHIP_BENCHMARK. Everything runs in-process over loopback transports, so results only depend on the host.
+ */
+
+#include "Benchmark.h"
+
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+void PrintUsage(const char * program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "\n"
+            "  --filter=<substring>   Only run benchmarks whose name contains <substring>\n"
+            "  --list                 List the benchmarks and exit\n"
+            "  --json=<path>          Also write the results as JSON to <path>, or to stdout if <path> is -\n"
+            "  --repetitions=<n>      Measure each benchmark <n> times (default 5)\n"
+            "  --iterations=<n>       Run <n> iterations per repetition instead of calibrating the count\n"
+            "  --min-time-ms=<n>      Calibrate repetitions to take at least <n> ms (default 100)\n"
+            "  --verbose              Keep CHIP logging at its default level\n",
+            program);
+}
+
+bool ParseUnsigned(const char * value, uint64_t & result)
+{
+    char * end = nullptr;
+    result     = strtoull(value, &end, 10);
+    return *value != '\0' && *end == '\0';
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    chip::benchmarks::Options options;
+    const char * filter   = nullptr;
+    const char * jsonPath = nullptr;
+    bool list             = false;
+    bool verbose          = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char * arg = argv[i];
+        uint64_t value   = 0;
+
+        if (strncmp(arg, "--filter=", 9) == 0)
+        {
+            filter = arg + 9;
+        }
+        else if (strcmp(arg, "--list") == 0)
+        {
+            list = true;
+        }
+        else if (strncmp(arg, "--json=", 7) == 0 && arg[7] != '\0')
+        {
+            jsonPath = arg + 7;
+        }
+        else if (strncmp(arg, "--repetitions=", 14) == 0 && ParseUnsigned(arg + 14, value) && value > 0 && value <= UINT32_MAX)
+        {
+            options.repetitions = static_cast<uint32_t>(value);
+        }
+        else if (strncmp(arg, "--iterations=", 13) == 0 && ParseUnsigned(arg + 13, value) && value > 0)
+        {
+            options.iterations = value;
+        }
+        else if (strncmp(arg, "--min-time-ms=", 14) == 0 && ParseUnsigned(arg + 14, value))
+        {
+            options.minTime = std::chrono::milliseconds(value);
+        }
+        else if (strcmp(arg, "--verbose") == 0)
+        {
+            verbose = true;
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return (strcmp(arg, "--help") == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (list)
+    {
+        for (auto registration = chip::benchmarks::Registration::GetFirst(); registration != nullptr;
+             registration      = registration->GetNext())
+        {
+            if (filter == nullptr || strstr(registration->GetName(), filter) != nullptr)
+            {
+                printf("%s\n", registration->GetName());
+            }
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (!verbose)
+    {
+        // Per-message progress and detail logs would otherwise dominate the measured paths.
+        chip::Logging::SetLogFilter(chip::Logging::kLogCategory_Error);
+    }
+
+    return chip::benchmarks::RunBenchmarks(options, filter, jsonPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
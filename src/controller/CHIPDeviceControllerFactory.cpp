@@ -38,7 +38,7 @@
 
 #include <app/server/Dnssd.h>
 #include <protocols/secure_channel/CASEServer.h>
-#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
 
 using namespace chip::Inet;
 using namespace chip::System;
@@ -118,6 +118,17 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
 #if CONFIG_DEVICE_LAYER
     ReturnErrorOnFailure(DeviceLayer::PlatformMgr().InitChipStack());
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT > 1
+    // Run CASE certificate validation and signatures on the background workers, so that the handshakes
+    // of many concurrent sessions (e.g. to every device of a fabric at startup) proceed in parallel.
+    // An application that started the workers itself keeps ownership of them.
+    {
+        CHIP_ERROR err = DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask();
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_INCORRECT_STATE, err);
+        stateParams.stopBackgroundEventLoopOnShutdown = (err == CHIP_NO_ERROR);
+    }
+#endif
+
     stateParams.systemLayer        = &DeviceLayer::SystemLayer();
     stateParams.udpEndPointManager = DeviceLayer::UDPEndPointManager();
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -201,8 +212,8 @@ CHIP_ERROR DeviceControllerFactory::InitSystemState(FactoryInitParams params)
     SessionResumptionStorage * sessionResumptionStorage;
     if (params.sessionResumptionStorage == nullptr)
     {
-        auto ownedSessionResumptionStorage = chip::Platform::MakeUnique<SimpleSessionResumptionStorage>();
-        ReturnErrorOnFailure(ownedSessionResumptionStorage->Init(params.fabricIndependentStorage));
+        auto ownedSessionResumptionStorage = chip::Platform::MakeUnique<CachedSessionResumptionStorage>();
+        ReturnErrorOnFailure(ownedSessionResumptionStorage->Init(params.fabricIndependentStorage, stateParams.systemLayer));
         stateParams.ownedSessionResumptionStorage    = std::move(ownedSessionResumptionStorage);
         stateParams.externalSessionResumptionStorage = nullptr;
         sessionResumptionStorage                     = stateParams.ownedSessionResumptionStorage.get();
@@ -421,6 +432,14 @@ void DeviceControllerSystemState::Shutdown()
 
     ChipLogDetail(Controller, "Shutting down the System State, this will teardown the CHIP Stack");
 
+#if CONFIG_DEVICE_LAYER
+    if (mStopBackgroundEventLoopOnShutdown)
+    {
+        // Let background work that is still in flight finish before the sessions it reports back to are torn down.
+        DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask();
+    }
+#endif
+
     if (mTempFabricTable && mEnableServerInteractions)
     {
         // The DnssdServer is holding a reference to our temp fabric table,
@@ -499,6 +518,12 @@ void DeviceControllerSystemState::Shutdown()
         mSessionMgr->Shutdown();
     }
 
+    // Write back the session resumption state that is only cached so far, while the system layer is still up.
+    if (mOwnedSessionResumptionStorage)
+    {
+        mOwnedSessionResumptionStorage->Shutdown();
+    }
+
     mSystemLayer        = nullptr;
     mUDPEndPointManager = nullptr;
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
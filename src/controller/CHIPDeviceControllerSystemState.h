@@ -39,7 +39,7 @@
 #include <protocols/bdx/BdxTransferServer.h>
 #include <protocols/secure_channel/CASEServer.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
-#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
 #include <protocols/secure_channel/UnsolicitedStatusHandler.h>
 
 #include <transport/TransportMgr.h>
@@ -97,7 +97,7 @@ struct DeviceControllerSystemStateParams
     // NOTE: Exactly one of externalSessionResumptionStorage (externally provided,
     // externally owned) or ownedSessionResumptionStorage (managed by the system
     // state) must be non-null.
-    Platform::UniquePtr<SimpleSessionResumptionStorage> ownedSessionResumptionStorage;
+    Platform::UniquePtr<CachedSessionResumptionStorage> ownedSessionResumptionStorage;
     Credentials::CertificateValidityPolicy * certificateValidityPolicy            = nullptr;
     SessionManager * sessionMgr                                                   = nullptr;
     Protocols::SecureChannel::UnsolicitedStatusHandler * unsolicitedStatusHandler = nullptr;
@@ -111,6 +111,10 @@ struct DeviceControllerSystemStateParams
     FabricTable::Delegate * fabricTableDelegate                                   = nullptr;
     chip::app::reporting::ReportScheduler::TimerDelegate * timerDelegate          = nullptr;
     chip::app::reporting::ReportScheduler * reportScheduler                       = nullptr;
+
+    // Set if DeviceControllerFactory started the background event loop, which
+    // DeviceControllerSystemState::Shutdown then stops.
+    bool stopBackgroundEventLoopOnShutdown = false;
 };
 
 // A representation of the internal state maintained by the DeviceControllerFactory.
@@ -144,7 +148,8 @@ public:
         mCASEClientPool(params.caseClientPool), mGroupDataProvider(params.groupDataProvider), mTimerDelegate(params.timerDelegate),
         mReportScheduler(params.reportScheduler), mSessionKeystore(params.sessionKeystore),
         mFabricTableDelegate(params.fabricTableDelegate),
-        mOwnedSessionResumptionStorage(std::move(params.ownedSessionResumptionStorage))
+        mOwnedSessionResumptionStorage(std::move(params.ownedSessionResumptionStorage)),
+        mStopBackgroundEventLoopOnShutdown(params.stopBackgroundEventLoopOnShutdown)
     {
         if (mOwnedSessionResumptionStorage)
         {
@@ -245,7 +250,7 @@ private:
     Crypto::SessionKeystore * mSessionKeystore                                     = nullptr;
     FabricTable::Delegate * mFabricTableDelegate                                   = nullptr;
     SessionResumptionStorage * mSessionResumptionStorage                           = nullptr;
-    Platform::UniquePtr<SimpleSessionResumptionStorage> mOwnedSessionResumptionStorage;
+    Platform::UniquePtr<CachedSessionResumptionStorage> mOwnedSessionResumptionStorage;
 
     // If mTempFabricTable is not null, it was created during
     // DeviceControllerFactory::InitSystemState and needs to be
@@ -258,6 +263,8 @@ private:
 
     bool mEnableServerInteractions = false;
 
+    bool mStopBackgroundEventLoopOnShutdown = false;
+
     void Shutdown();
 };
 
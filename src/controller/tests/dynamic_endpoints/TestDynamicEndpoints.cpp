@@ -0,0 +1,195 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Tests of the endpoint lookups of attribute-storage with every dynamic endpoint slot in use, which is more than
+ *      255 slots in the data model this test links, and while dynamic endpoints are added and removed in random order.
+ */
+
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/tests/AppTestContext.h>
+#include <app/util/DataModelHandler.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+using TestContext = chip::Test::AppContext;
+
+constexpr uint16_t kNumDynamicEndpoints = CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT;
+
+// Above the ids of the fixed endpoints of the controller data model.
+constexpr EndpointId kFirstDynamicEndpointId = 1000;
+constexpr AttributeId kTestAttribute         = 1;
+constexpr AttributeId kMissingAttribute      = 2;
+
+//clang-format off
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(testClusterAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(kTestAttribute, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(testEndpointClusters)
+DECLARE_DYNAMIC_CLUSTER(Clusters::UnitTesting::Id, testClusterAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(testEndpoint, testEndpointClusters);
+//clang-format on
+
+DataVersion gDataVersions[kNumDynamicEndpoints][ArraySize(testEndpointClusters)];
+
+// The endpoint id that slot [index] gets the [generation]th time it is set: ids are not in slot order, and a slot gets
+// a different id each time it is reused.
+EndpointId DynamicEndpointId(uint16_t index, uint32_t generation)
+{
+    return static_cast<EndpointId>(kFirstDynamicEndpointId + (index * 7919u) % kNumDynamicEndpoints +
+                                   generation * kNumDynamicEndpoints);
+}
+
+CHIP_ERROR SetDynamicEndpoint(uint16_t index, EndpointId id)
+{
+    return emberAfSetDynamicEndpoint(index, id, &testEndpoint, Span<DataVersion>(gDataVersions[index]));
+}
+
+void CheckSetEndpoint(nlTestSuite * apSuite, uint16_t index, EndpointId id)
+{
+    const uint16_t endpointIndex = static_cast<uint16_t>(emberAfFixedEndpointCount() + index);
+
+    NL_TEST_ASSERT(apSuite, emberAfGetDynamicIndexFromEndpoint(id) == index);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(id) == endpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfEndpointFromIndex(endpointIndex) == id);
+    NL_TEST_ASSERT(apSuite, emberAfEndpointIndexIsEnabled(endpointIndex));
+    NL_TEST_ASSERT(apSuite, emberAfClusterIndex(id, Clusters::UnitTesting::Id, CLUSTER_MASK_SERVER) == 0);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(id, Clusters::UnitTesting::Id, kTestAttribute) != nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(id, Clusters::UnitTesting::Id, kMissingAttribute) == nullptr);
+}
+
+void CheckClearedEndpoint(nlTestSuite * apSuite, EndpointId id)
+{
+    NL_TEST_ASSERT(apSuite, emberAfGetDynamicIndexFromEndpoint(id) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(id) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfClusterIndex(id, Clusters::UnitTesting::Id, CLUSTER_MASK_SERVER) == UINT8_MAX);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(id, Clusters::UnitTesting::Id, kTestAttribute) == nullptr);
+}
+
+void TestAllDynamicEndpoints(nlTestSuite * apSuite, void * apContext)
+{
+    InitDataModelHandler();
+
+    for (uint16_t i = 0; i < kNumDynamicEndpoints; i++)
+    {
+        NL_TEST_ASSERT(apSuite, SetDynamicEndpoint(i, DynamicEndpointId(i, 0)) == CHIP_NO_ERROR);
+    }
+
+    // There is no free slot left, and an id can only be used once.
+    NL_TEST_ASSERT(apSuite, SetDynamicEndpoint(kNumDynamicEndpoints, DynamicEndpointId(kNumDynamicEndpoints, 0)) ==
+                       CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(apSuite, SetDynamicEndpoint(0, DynamicEndpointId(kNumDynamicEndpoints - 1, 0)) == CHIP_ERROR_ENDPOINT_EXISTS);
+
+    for (uint16_t i = 0; i < kNumDynamicEndpoints; i++)
+    {
+        CheckSetEndpoint(apSuite, i, DynamicEndpointId(i, 0));
+    }
+
+    for (uint16_t i = 0; i < kNumDynamicEndpoints; i++)
+    {
+        NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(i) == DynamicEndpointId(i, 0));
+        CheckClearedEndpoint(apSuite, DynamicEndpointId(i, 0));
+    }
+}
+
+void TestDynamicEndpointChurn(nlTestSuite * apSuite, void * apContext)
+{
+    InitDataModelHandler();
+
+    uint32_t generations[kNumDynamicEndpoints] = {};
+    bool isSet[kNumDynamicEndpoints]           = {};
+    uint32_t random                            = 1;
+
+    for (uint32_t step = 0; step < 4u * kNumDynamicEndpoints; step++)
+    {
+        random               = random * 1103515245u + 12345u;
+        const uint16_t index = static_cast<uint16_t>((random >> 16) % kNumDynamicEndpoints);
+        const EndpointId id  = DynamicEndpointId(index, generations[index]);
+
+        if (isSet[index])
+        {
+            NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(index) == id);
+            CheckClearedEndpoint(apSuite, id);
+            generations[index]++;
+        }
+        else
+        {
+            NL_TEST_ASSERT(apSuite, SetDynamicEndpoint(index, id) == CHIP_NO_ERROR);
+            CheckSetEndpoint(apSuite, index, id);
+        }
+        isSet[index] = !isSet[index];
+
+        // Every other endpoint must still be found where it was.
+        if (step % kNumDynamicEndpoints == 0)
+        {
+            for (uint16_t i = 0; i < kNumDynamicEndpoints; i++)
+            {
+                if (isSet[i])
+                {
+                    CheckSetEndpoint(apSuite, i, DynamicEndpointId(i, generations[i]));
+                }
+            }
+        }
+    }
+
+    for (uint16_t i = 0; i < kNumDynamicEndpoints; i++)
+    {
+        if (isSet[i])
+        {
+            CheckSetEndpoint(apSuite, i, DynamicEndpointId(i, generations[i]));
+            NL_TEST_ASSERT(apSuite, emberAfClearDynamicEndpoint(i) == DynamicEndpointId(i, generations[i]));
+        }
+    }
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestAllDynamicEndpoints", TestAllDynamicEndpoints),
+    NL_TEST_DEF("TestDynamicEndpointChurn", TestDynamicEndpointChurn),
+    NL_TEST_SENTINEL(),
+};
+
+nlTestSuite sSuite = {
+    "TestDynamicEndpoints",
+    &sTests[0],
+    TestContext::nlTestSetUpTestSuite,
+    TestContext::nlTestTearDownTestSuite,
+    TestContext::nlTestSetUp,
+    TestContext::nlTestTearDown,
+};
+
+} // namespace
+
+int TestDynamicEndpoints()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDynamicEndpoints)
@@ -33,6 +33,7 @@
 
 #include <credentials/CHIPCert_Internal.h>
 #include <credentials/CHIPCertificateSet.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <lib/asn1/ASN1.h>
 #include <lib/asn1/ASN1Macros.h>
 #include <lib/core/CHIPCore.h>
@@ -414,8 +415,16 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
     }
 
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
-    // succeeds, the current certificate is valid.
-    err = VerifyCertSignature(*cert, *caCert);
+    // succeeds, the current certificate is valid. The signatures of CA certificates are looked up in the verified
+    // certificate cache, if there is one, as the same ones are met again and again; leaf certificates are always verified.
+    if (depth > 0 && context.mVerifiedCertCache != nullptr)
+    {
+        err = context.mVerifiedCertCache->VerifyCertSignature(*cert, *caCert);
+    }
+    else
+    {
+        err = VerifyCertSignature(*cert, *caCert);
+    }
     SuccessOrExit(err);
 
 exit:
@@ -503,9 +512,10 @@ bool ChipCertificateData::IsEqual(const ChipCertificateData & other) const
 
 void ValidationContext::Reset()
 {
-    mEffectiveTime  = EffectiveTime{};
-    mTrustAnchor    = nullptr;
-    mValidityPolicy = nullptr;
+    mEffectiveTime     = EffectiveTime{};
+    mTrustAnchor       = nullptr;
+    mValidityPolicy    = nullptr;
+    mVerifiedCertCache = nullptr;
     mRequiredKeyUsages.ClearAll();
     mRequiredKeyPurposes.ClearAll();
     mRequiredCertType = CertType::kNotSpecified;
@@ -53,6 +53,8 @@ struct LastKnownGoodChipEpochTime : chip::System::Clock::Seconds32
 
 using EffectiveTime = Variant<CurrentChipEpochTime, LastKnownGoodChipEpochTime>;
 
+class VerifiedCertificateCache;
+
 /**
  *  @struct ValidationContext
  *
@@ -75,6 +77,9 @@ struct ValidationContext
     CertificateValidityPolicy * mValidityPolicy =
         nullptr; /**< Optional application policy to apply for certificate validity period evaluation. */
 
+    VerifiedCertificateCache * mVerifiedCertCache =
+        nullptr; /**< Optional cache of verified CA certificate signatures, which are then not verified again. */
+
     void Reset();
 
     template <typename T>
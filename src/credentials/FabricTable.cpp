@@ -354,6 +354,10 @@ CHIP_ERROR FabricTable::VerifyCredentials(FabricIndex fabricIndex, const ByteSpa
     uint8_t rootCertBuf[kMaxCHIPCertLength];
     MutableByteSpan rootCertSpan{ rootCertBuf };
     ReturnErrorOnFailure(FetchRootCert(fabricIndex, rootCertSpan));
+    if (context.mVerifiedCertCache == nullptr)
+    {
+        context.mVerifiedCertCache = &mVerifiedCertCache;
+    }
     return VerifyCredentials(noc, icac, rootCertSpan, context, outCompressedFabricId, outFabricId, outNodeId, outNocPubkey,
                              outRootPublicKey);
 }
@@ -994,6 +998,9 @@ CHIP_ERROR FabricTable::Delete(FabricIndex fabricIndex)
     // Since fabricIsInitialized was true, fabric is not null.
     fabricInfo->Reset();
 
+    // The signatures of the fabric's ICACs are not needed anymore.
+    mVerifiedCertCache.Clear();
+
     if (!mNextAvailableFabricIndex.HasValue())
     {
         // We must have been in a situation where CHIP_CONFIG_MAX_FABRICS is 254
@@ -1079,6 +1086,8 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     // this condition and can act appropriately.
     mLastKnownGoodTime.Init(mStorage);
 
+    ReturnErrorOnFailure(mVerifiedCertCache.Init());
+
     uint8_t buf[IndexInfoTLVMaxSize()];
     uint16_t size  = sizeof(buf);
     CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::FabricIndexInfo().KeyName(), buf, size);
@@ -1158,6 +1167,7 @@ void FabricTable::Shutdown()
         // direct lookups fail.
         fabricInfo.Reset();
     }
+    mVerifiedCertCache.Clear();
 
     mStorage = nullptr;
 }
@@ -1520,6 +1530,14 @@ CHIP_ERROR FabricTable::SignWithOpKeypair(FabricIndex fabricIndex, ByteSpan mess
     return CHIP_ERROR_KEY_NOT_FOUND;
 }
 
+CHIP_ERROR FabricTable::ExportInjectedOpKeypairForFabric(FabricIndex fabricIndex, P256SerializedKeypair & outKeypair) const
+{
+    const FabricInfo * fabricInfo = FindFabricWithIndex(fabricIndex);
+    VerifyOrReturnError(fabricInfo != nullptr && fabricInfo->HasOperationalKey(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    return fabricInfo->mOperationalKey->Serialize(outKeypair);
+}
+
 bool FabricTable::HasPendingOperationalKey(bool & outIsPendingKeyForUpdateNoc) const
 {
     // We can only manage commissionable pending fail-safe state if we have a keystore
@@ -29,6 +29,7 @@
 #include <credentials/CertificateValidityPolicy.h>
 #include <credentials/LastKnownGoodTime.h>
 #include <credentials/OperationalCertificateStore.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <crypto/OperationalKeystore.h>
 #include <lib/core/CHIPEncoding.h>
@@ -675,6 +676,22 @@ public:
      */
     CHIP_ERROR SignWithOpKeypair(FabricIndex fabricIndex, ByteSpan message, Crypto::P256ECDSASignature & outSignature) const;
 
+    /**
+     * @brief Copy a given fabric's manually injected operational keypair (see `FabricInfo::SetOperationalKeypair`),
+     *        so that CASE can sign with the copy off the Matter thread, where the fabric table must not be used.
+     *
+     * Keys held by the OperationalKeystore are not copied: the keystore signs in the background itself
+     * if it supports it.
+     *
+     * @param fabricIndex - Fabric index whose operational key to copy
+     * @param outKeypair - Serialized keypair to receive the copy
+     *
+     * @retval CHIP_NO_ERROR on success
+     * @retval CHIP_ERROR_KEY_NOT_FOUND if the fabric has no injected operational keypair
+     * @retval other CHIP_ERROR value if the keypair cannot be serialized (e.g. it is held by a secure element)
+     */
+    CHIP_ERROR ExportInjectedOpKeypairForFabric(FabricIndex fabricIndex, Crypto::P256SerializedKeypair & outKeypair) const;
+
     /**
      * @brief Create an ephemeral keypair for use in session establishment.
      *
@@ -944,7 +961,8 @@ public:
      */
     void RevertPendingOpCertsExceptRoot();
 
-    // Verifies credentials, using the root certificate of the provided fabric index.
+    // Verifies credentials, using the root certificate of the provided fabric index. Unless the context
+    // has its own, the signatures of CA certificates are looked up in GetVerifiedCertificateCache().
     CHIP_ERROR VerifyCredentials(FabricIndex fabricIndex, const ByteSpan & noc, const ByteSpan & icac,
                                  Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                  FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
@@ -955,6 +973,11 @@ public:
                                         Credentials::ValidationContext & context, CompressedFabricId & outCompressedFabricId,
                                         FabricId & outFabricId, NodeId & outNodeId, Crypto::P256PublicKey & outNocPubkey,
                                         Crypto::P256PublicKey * outRootPublicKey = nullptr);
+
+    // Cache of the CA certificate signatures verified for this table's fabrics. Contexts for the static
+    // VerifyCredentials() can point to it, which is safe from any thread.
+    Credentials::VerifiedCertificateCache & GetVerifiedCertificateCache() const { return mVerifiedCertCache; }
+
     /**
      * @brief Enables FabricInfo instances to collide and reference the same logical fabric (i.e Root Public Key + FabricId).
      *
@@ -1181,6 +1204,9 @@ private:
 
     LastKnownGoodTime mLastKnownGoodTime;
 
+    // Mutable as verifying credentials, which is const, fills it.
+    mutable Credentials::VerifiedCertificateCache mVerifiedCertCache;
+
     // We may not have an mNextAvailableFabricIndex if our table is as large as
     // it can go and is full.
     Optional<FabricIndex> mNextAvailableFabricIndex;
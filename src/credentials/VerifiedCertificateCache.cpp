@@ -0,0 +1,123 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "VerifiedCertificateCache.h"
+
+#include <lib/support/CodeUtils.h>
+
+#include <mutex>
+#include <string.h>
+
+namespace chip {
+namespace Credentials {
+
+CHIP_ERROR VerifiedCertificateCache::Init()
+{
+    ReturnErrorOnFailure(System::Mutex::Init(mLock));
+    Clear();
+    return CHIP_NO_ERROR;
+}
+
+void VerifiedCertificateCache::Clear()
+{
+    std::lock_guard<System::Mutex> lock(mLock);
+
+    for (auto & entry : mEntries)
+    {
+        entry.lastUsed = 0;
+    }
+    mUseCounter = 0;
+}
+
+CHIP_ERROR VerifiedCertificateCache::VerifyCertSignature(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    Digest digest;
+    ReturnErrorOnFailure(ComputeDigest(cert, signer, digest));
+
+    {
+        std::lock_guard<System::Mutex> lock(mLock);
+        if (Find(digest))
+        {
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    ReturnErrorOnFailure(Credentials::VerifyCertSignature(cert, signer));
+
+    std::lock_guard<System::Mutex> lock(mLock);
+    Add(digest);
+    return CHIP_NO_ERROR;
+}
+
+bool VerifiedCertificateCache::Contains(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    Digest digest;
+    VerifyOrReturnValue(ComputeDigest(cert, signer, digest) == CHIP_NO_ERROR, false);
+
+    std::lock_guard<System::Mutex> lock(mLock);
+    return Find(digest);
+}
+
+CHIP_ERROR VerifiedCertificateCache::ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer,
+                                                   Digest & digest)
+{
+    VerifyOrReturnError(cert.mCertFlags.Has(CertFlags::kTBSHashPresent), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Crypto::Hash_SHA256_stream hash;
+    ReturnErrorOnFailure(hash.Begin());
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mTBSHash)));
+    ReturnErrorOnFailure(hash.AddData(cert.mSignature));
+    ReturnErrorOnFailure(hash.AddData(signer.mPublicKey));
+
+    MutableByteSpan digestSpan(digest);
+    return hash.Finish(digestSpan);
+}
+
+bool VerifiedCertificateCache::Find(const Digest & digest)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.lastUsed != 0 && memcmp(entry.digest, digest, sizeof(Digest)) == 0)
+        {
+            entry.lastUsed = ++mUseCounter;
+            return true;
+        }
+    }
+    return false;
+}
+
+void VerifiedCertificateCache::Add(const Digest & digest)
+{
+    // Another validation may have added the same signature while it was verified unlocked.
+    VerifyOrReturn(!Find(digest));
+
+    // Replace the entry that was used the longest time ago, which is an unused one if there are any.
+    Entry * oldest = &mEntries[0];
+    for (auto & entry : mEntries)
+    {
+        if (entry.lastUsed < oldest->lastUsed)
+        {
+            oldest = &entry;
+        }
+    }
+
+    memcpy(oldest->digest, digest, sizeof(Digest));
+    oldest->lastUsed = ++mUseCounter;
+}
+
+} // namespace Credentials
+} // namespace chip
@@ -0,0 +1,84 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemMutex.h>
+
+namespace chip {
+namespace Credentials {
+
+/**
+ * Remembers the signatures of CA certificates that were verified during certificate
+ * chain validation, so that validating the chain of a peer seen before only has to
+ * verify the signature of its leaf certificate.
+ *
+ * An entry is the SHA-256 digest of the TBS hash and signature of a certificate and
+ * the public key of its signer, so it only ever stands for the one verification that
+ * succeeded. The other checks of the certificates (usage, time validity, policy and
+ * chaining) are not cached and run on every validation.
+ *
+ * Validation may run on a background thread (see CASESession), so the cache is
+ * guarded by a mutex, which is not held while a signature is verified.
+ */
+class VerifiedCertificateCache
+{
+public:
+    static constexpr size_t kCacheSize = CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE;
+
+    static_assert(kCacheSize > 0, "The verified certificate cache needs at least one entry");
+
+    CHIP_ERROR Init();
+
+    /// Forget all verified signatures.
+    void Clear();
+
+    /// Verify the signature of [cert] with the public key of [signer], unless
+    /// that signature was verified before. [cert] must have its TBS hash.
+    CHIP_ERROR VerifyCertSignature(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+    /// Check if the signature of [cert] with the public key of [signer] was verified before.
+    bool Contains(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+private:
+    using Digest = uint8_t[Crypto::kSHA256_Hash_Length];
+
+    struct Entry
+    {
+        Digest digest;
+        uint32_t lastUsed = 0; // 0 for an unused entry
+    };
+
+    static CHIP_ERROR ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer, Digest & digest);
+
+    bool Find(const Digest & digest);
+    void Add(const Digest & digest);
+
+    System::Mutex mLock;
+    Entry mEntries[kCacheSize];
+    uint32_t mUseCounter = 0;
+};
+
+} // namespace Credentials
+} // namespace chip
@@ -25,6 +25,7 @@
  */
 
 #include <credentials/CHIPCert.h>
+#include <credentials/VerifiedCertificateCache.h>
 #include <credentials/examples/LastKnownGoodTimeCertificateValidityPolicyExample.h>
 #include <credentials/examples/StrictCertificateValidityPolicyExample.h>
 #include <crypto/CHIPCryptoPAL.h>
@@ -1336,6 +1337,64 @@ static void TestChipCert_LoadDuplicateCerts(nlTestSuite * inSuite, void * inCont
     NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 3);
 }
 
+static void TestChipCert_VerifiedCertCache(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    VerifiedCertificateCache cache;
+    StrictCertificateValidityPolicyExample strictPolicy;
+
+    err = cache.Init();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = certSet.Init(kStandardCertsCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = LoadTestCertSet01(certSet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    const ChipCertificateData & rootCert = certSet.GetCertSet()[0];
+    const ChipCertificateData & icaCert  = certSet.GetCertSet()[1];
+    const ChipCertificateData & nodeCert = certSet.GetCertSet()[2];
+
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    validContext.mVerifiedCertCache = &cache;
+
+    // Validating the chain keeps the signature of the ICAC, but not the one of the leaf.
+    err = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Contains(icaCert, rootCert));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(nodeCert, icaCert));
+
+    err = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The validity policy still applies to a chain whose ICAC signature is kept.
+    validContext.mValidityPolicy = &strictPolicy;
+    err                          = certSet.ValidateCert(certSet.GetLastCert(), validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_CERT_EXPIRED);
+    validContext.mValidityPolicy = nullptr;
+
+    // A kept signature does not stand for another signature of the same certificate, or another signer.
+    uint8_t signatureBuf[kP256_ECDSA_Signature_Length_Raw];
+    memcpy(signatureBuf, icaCert.mSignature.data(), sizeof(signatureBuf));
+    signatureBuf[sizeof(signatureBuf) - 1] ^= 0x01;
+    ChipCertificateData tamperedIcaCert = icaCert;
+    tamperedIcaCert.mSignature          = P256ECDSASignatureSpan(signatureBuf);
+    NL_TEST_ASSERT(inSuite, !cache.Contains(tamperedIcaCert, rootCert));
+    NL_TEST_ASSERT(inSuite, cache.VerifyCertSignature(tamperedIcaCert, rootCert) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !cache.Contains(tamperedIcaCert, rootCert));
+
+    NL_TEST_ASSERT(inSuite, !cache.Contains(icaCert, nodeCert));
+    NL_TEST_ASSERT(inSuite, cache.VerifyCertSignature(icaCert, nodeCert) != CHIP_NO_ERROR);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, !cache.Contains(icaCert, rootCert));
+}
+
 static void TestChipCert_GenerateRootCert(nlTestSuite * inSuite, void * inContext)
 {
     // Generate a new keypair for cert signing
@@ -2252,6 +2311,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate ID", TestChipCert_CertId),
     NL_TEST_DEF("Test CHIP Certificate Decoding Options", TestChipCert_DecodingOptions),
     NL_TEST_DEF("Test Loading Duplicate Certificates", TestChipCert_LoadDuplicateCerts),
+    NL_TEST_DEF("Test Verified Certificate Cache", TestChipCert_VerifiedCertCache),
     NL_TEST_DEF("Test CHIP Generate Root Certificate", TestChipCert_GenerateRootCert),
     NL_TEST_DEF("Test CHIP Generate Root Certificate with Fabric", TestChipCert_GenerateRootFabCert),
     NL_TEST_DEF("Test CHIP Generate ICA Certificate", TestChipCert_GenerateICACert),
@@ -2430,6 +2430,37 @@ void TestFetchCATs(nlTestSuite * inSuite, void * inContext)
     // TODO(#20335): Add test cases for NOCs that actually embed CATs
 }
 
+void TestExportInjectedOpKeypair(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate testStorage;
+    ScopedFabricTable fabricTableHolder;
+    NL_TEST_ASSERT(inSuite, fabricTableHolder.Init(&testStorage) == CHIP_NO_ERROR);
+    FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+    NL_TEST_ASSERT(inSuite, LoadTestFabric_Node01_01(inSuite, fabricTable, /* doCommit = */ true) == CHIP_NO_ERROR);
+
+    // The copy of the injected key signs like the fabric does.
+    {
+        Crypto::P256SerializedKeypair serializedKeypair;
+        NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.ExportInjectedOpKeypairForFabric(1, serializedKeypair));
+
+        Crypto::P256Keypair keypair;
+        NL_TEST_ASSERT_SUCCESS(inSuite, keypair.Deserialize(serializedKeypair));
+        const ByteSpan publicKey{ keypair.Pubkey().ConstBytes(), keypair.Pubkey().Length() };
+        NL_TEST_ASSERT(inSuite, publicKey.data_equal(TestCerts::sTestCert_Node01_01_PublicKey));
+
+        uint8_t message[] = { 'm', 's', 'g' };
+        Crypto::P256ECDSASignature sig;
+        NL_TEST_ASSERT_SUCCESS(inSuite, keypair.ECDSA_sign_msg(message, sizeof(message), sig));
+        NL_TEST_ASSERT_SUCCESS(inSuite, keypair.Pubkey().ECDSA_validate_msg_signature(message, sizeof(message), sig));
+    }
+
+    // No fabric, no key.
+    {
+        Crypto::P256SerializedKeypair serializedKeypair;
+        NL_TEST_ASSERT(inSuite, fabricTable.ExportInjectedOpKeypairForFabric(2, serializedKeypair) == CHIP_ERROR_KEY_NOT_FOUND);
+    }
+}
+
 // Validate that adding the same fabric twice fails (same root, same FabricId)
 void TestAddNocRootCollision(nlTestSuite * inSuite, void * inContext)
 {
@@ -3019,6 +3050,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Test compressed fabric ID is properly generated", TestCompressedFabricId),
     NL_TEST_DEF("Test fabric lookup by <root public key, fabric ID>", TestFabricLookup),
     NL_TEST_DEF("Test Fetching CATs", TestFetchCATs),
+    NL_TEST_DEF("Test exporting an injected operational keypair", TestExportInjectedOpKeypair),
     NL_TEST_DEF("Test AddNOC root collision", TestAddNocRootCollision),
     NL_TEST_DEF("Test invalid chaining in AddNOC and UpdateNOC", TestInvalidChaining),
     NL_TEST_DEF("Test ephemeral keys allocation", TestEphemeralKeys),
@@ -785,6 +785,60 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief AES-CCM cipher bound to one key, for encrypting or decrypting many messages under that key.
+ *
+ * AES_CCM_encrypt() and AES_CCM_decrypt() set up the cipher for the key on every call. On backends where that setup has a
+ * significant cost (allocating cipher state and expanding the key), an AesCcm128Cipher does it once, on first use, and
+ * keeps the result until Release(). On other backends it simply forwards to the one-shot functions.
+ *
+ * The key handle passed to Init() must remain valid, and hold the same key, until Release() is called or the cipher is
+ * destroyed.
+ */
+class AesCcm128Cipher
+{
+public:
+    AesCcm128Cipher() = default;
+    ~AesCcm128Cipher() { Release(); }
+
+    AesCcm128Cipher(const AesCcm128Cipher &)             = delete;
+    AesCcm128Cipher & operator=(const AesCcm128Cipher &) = delete;
+
+    /**
+     * @brief Bind the cipher to a key, releasing any previous binding.
+     */
+    void Init(const Aes128KeyHandle & key);
+
+    /**
+     * @brief Release the cipher state and the binding to the key.
+     */
+    void Release();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Same as AES_CCM_encrypt(), using the key passed to Init().
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if not initialized, otherwise as AES_CCM_encrypt()
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Same as AES_CCM_decrypt(), using the key passed to Init().
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if not initialized, otherwise as AES_CCM_decrypt()
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length, uint8_t * plaintext);
+
+private:
+    const Aes128KeyHandle * mKey = nullptr;
+    // Backend-specific cipher state for each direction, if the backend keeps any.
+    void * mEncryptContext = nullptr;
+    void * mDecryptContext = nullptr;
+};
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
@@ -146,19 +146,37 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
-CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
-                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
-                           uint8_t * tag, size_t tag_length)
+#if CHIP_CRYPTO_BORINGSSL
+using AesCcmContext = EVP_AEAD_CTX;
+#else
+using AesCcmContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+static void FreeAesCcmContext(AesCcmContext * context)
+{
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(context);
+#else
+    EVP_CIPHER_CTX_free(context);
+#endif // CHIP_CRYPTO_BORINGSSL
+}
+
+// Keeps the context of a successful operation in *reusableContext, if not null, instead of freeing it. A context passed in
+// *reusableContext already has the key set up, so that step is skipped. Contexts are not reused across directions, as
+// OpenSSL does not support switching a CCM context between encryption and decryption.
+static CHIP_ERROR AesCcmEncrypt(AesCcmContext ** reusableContext, const uint8_t * plaintext, size_t plaintext_length,
+                                const uint8_t * aad, size_t aad_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                                size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length)
 {
+    AesCcmContext * context = nullptr;
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
     size_t written_tag_len = 0;
     const EVP_AEAD * aead  = nullptr;
 #else
-    EVP_CIPHER_CTX * context = nullptr;
     int bytesWritten         = 0;
     size_t ciphertext_length = 0;
     const EVP_CIPHER * type  = nullptr;
+    const uint8_t * keyBytes = nullptr;
 #endif
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -202,10 +220,18 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 #if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+    if (reusableContext != nullptr && *reusableContext != nullptr)
+    {
+        context = *reusableContext;
+    }
+    else
+    {
+        aead = EVP_aead_aes_128_ccm_matter();
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        context =
+            EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    }
 
     result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
                                        plaintext_length, nullptr, 0, aad, aad_length);
@@ -213,14 +239,23 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
     VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
 #else
 
-    type = EVP_aes_128_ccm();
+    if (reusableContext != nullptr && *reusableContext != nullptr)
+    {
+        context = *reusableContext;
+    }
+    else
+    {
+        type = EVP_aes_128_ccm();
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        context = EVP_CIPHER_CTX_new();
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in cipher
+        result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        keyBytes = key.As<Symmetric128BitsKeyByteArray>();
+    }
 
     // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
     result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
@@ -230,9 +265,9 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
     result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
+    // Pass in key (unless already set up) + nonce
     static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    result = EVP_EncryptInit_ex(context, nullptr, nullptr, keyBytes, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in plain text length
@@ -268,31 +303,34 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (reusableContext != nullptr && error == CHIP_NO_ERROR)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-        context = nullptr;
+        *reusableContext = context;
+    }
+    else if (context != nullptr)
+    {
+        // A failed operation may leave the context in an unknown state, so it is not reused.
+        FreeAesCcmContext(context);
+        if (reusableContext != nullptr)
+        {
+            *reusableContext = nullptr;
+        }
     }
 
     return error;
 }
 
-CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
-                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
-                           size_t nonce_length, uint8_t * plaintext)
+static CHIP_ERROR AesCcmDecrypt(AesCcmContext ** reusableContext, const uint8_t * ciphertext, size_t ciphertext_length,
+                                const uint8_t * aad, size_t aad_length, const uint8_t * tag, size_t tag_length,
+                                const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * plaintext)
 {
+    AesCcmContext * context = nullptr;
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
-    const EVP_AEAD * aead  = nullptr;
+    const EVP_AEAD * aead = nullptr;
 #else
-
-    EVP_CIPHER_CTX * context = nullptr;
     int bytesOutput          = 0;
     const EVP_CIPHER * type  = nullptr;
+    const uint8_t * keyBytes = nullptr;
 #endif // CHIP_CRYPTO_BORINGSSL
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -334,23 +372,40 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
     VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
 
 #if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
+    if (reusableContext != nullptr && *reusableContext != nullptr)
+    {
+        context = *reusableContext;
+    }
+    else
+    {
+        aead = EVP_aead_aes_128_ccm_matter();
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        context =
+            EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    }
 
     result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
                                       aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 #else
-    type = EVP_aes_128_ccm();
+    if (reusableContext != nullptr && *reusableContext != nullptr)
+    {
+        context = *reusableContext;
+    }
+    else
+    {
+        type = EVP_aes_128_ccm();
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        context = EVP_CIPHER_CTX_new();
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in cipher
+        result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        keyBytes = key.As<Symmetric128BitsKeyByteArray>();
+    }
 
     // Pass in nonce length
     VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
@@ -365,9 +420,9 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                                               const_cast<void *>(static_cast<const void *>(tag)));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
+    // Pass in key (unless already set up) + nonce
     static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    result = EVP_DecryptInit_ex(context, nullptr, nullptr, keyBytes, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in cipher text length
@@ -397,17 +452,83 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (reusableContext != nullptr && error == CHIP_NO_ERROR)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
+        *reusableContext = context;
+    }
+    else if (context != nullptr)
+    {
+        // A failed operation may leave the context in an unknown state, so it is not reused.
+        FreeAesCcmContext(context);
+        if (reusableContext != nullptr)
+        {
+            *reusableContext = nullptr;
+        }
+    }
 
-        context = nullptr;
+    return error;
+}
+
+CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
+                           uint8_t * tag, size_t tag_length)
+{
+    return AesCcmEncrypt(nullptr, plaintext, plaintext_length, aad, aad_length, key, nonce, nonce_length, ciphertext, tag,
+                         tag_length);
+}
+
+CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                           size_t nonce_length, uint8_t * plaintext)
+{
+    return AesCcmDecrypt(nullptr, ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, key, nonce, nonce_length,
+                         plaintext);
+}
+
+void AesCcm128Cipher::Init(const Aes128KeyHandle & key)
+{
+    Release();
+    mKey = &key;
+}
+
+void AesCcm128Cipher::Release()
+{
+    if (mEncryptContext != nullptr)
+    {
+        FreeAesCcmContext(static_cast<AesCcmContext *>(mEncryptContext));
+        mEncryptContext = nullptr;
+    }
+    if (mDecryptContext != nullptr)
+    {
+        FreeAesCcmContext(static_cast<AesCcmContext *>(mDecryptContext));
+        mDecryptContext = nullptr;
     }
+    mKey = nullptr;
+}
+
+CHIP_ERROR AesCcm128Cipher::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                    size_t tag_length)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    AesCcmContext * context = static_cast<AesCcmContext *>(mEncryptContext);
+    CHIP_ERROR error        = AesCcmEncrypt(&context, plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length,
+                                            ciphertext, tag, tag_length);
+    mEncryptContext         = context;
+    return error;
+}
+
+CHIP_ERROR AesCcm128Cipher::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                    uint8_t * plaintext)
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
+    AesCcmContext * context = static_cast<AesCcmContext *>(mDecryptContext);
+    CHIP_ERROR error        = AesCcmDecrypt(&context, ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey,
+                                            nonce, nonce_length, plaintext);
+    mDecryptContext         = context;
     return error;
 }
 
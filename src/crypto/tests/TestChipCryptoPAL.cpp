@@ -376,6 +376,67 @@ static void TestAES_CCM_128DecryptTestVectors(nlTestSuite * inSuite, void * inCo
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128CipherTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    HeapChecker heapChecker(inSuite);
+    int numOfTestsRan = 0;
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        if (vector->pt_len == 0 || vector->result != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        numOfTestsRan++;
+
+        chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+        out_ct.Alloc(vector->ct_len);
+        NL_TEST_ASSERT(inSuite, out_ct);
+        chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+        out_tag.Alloc(vector->tag_len);
+        NL_TEST_ASSERT(inSuite, out_tag);
+        chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+        out_pt.Alloc(vector->pt_len);
+        NL_TEST_ASSERT(inSuite, out_pt);
+
+        TestAesKey key(inSuite, vector->key, vector->key_len);
+        AesCcm128Cipher cipher;
+        NL_TEST_ASSERT(inSuite,
+                       cipher.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce, vector->nonce_len,
+                                      out_ct.Get(), out_tag.Get(), vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+        cipher.Init(key.key);
+
+        // Run each operation more than once, so that later runs reuse the cipher state set up by the first.
+        for (int i = 0; i < 2; i++)
+        {
+            CHIP_ERROR err = cipher.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce,
+                                            vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), vector->ct, vector->ct_len) == 0);
+            NL_TEST_ASSERT(inSuite, memcmp(out_tag.Get(), vector->tag, vector->tag_len) == 0);
+
+            err = cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                 vector->nonce, vector->nonce_len, out_pt.Get());
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(out_pt.Get(), vector->pt, vector->pt_len) == 0);
+        }
+
+        // A failed decryption must not affect later operations.
+        memcpy(out_tag.Get(), vector->tag, vector->tag_len);
+        out_tag[0] ^= 0x01;
+        NL_TEST_ASSERT(inSuite,
+                       cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag.Get(), vector->tag_len,
+                                      vector->nonce, vector->nonce_len, out_pt.Get()) != CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       cipher.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                      vector->nonce, vector->nonce_len, out_pt.Get()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(out_pt.Get(), vector->pt, vector->pt_len) == 0);
+
+        cipher.Release();
+        NL_TEST_ASSERT(inSuite, !cipher.IsInitialized());
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
 static void TestAES_CCM_128EncryptInvalidNonceLen(nlTestSuite * inSuite, void * inContext)
 {
     HeapChecker heapChecker(inSuite);
@@ -3016,6 +3077,7 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test encrypting AES-CCM-128 test vectors", TestAES_CCM_128EncryptTestVectors),
     NL_TEST_DEF("Test decrypting AES-CCM-128 test vectors", TestAES_CCM_128DecryptTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 test vectors with a reused cipher", TestAES_CCM_128CipherTestVectors),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid nonce", TestAES_CCM_128EncryptInvalidNonceLen),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid tag", TestAES_CCM_128EncryptInvalidTagLen),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid nonce", TestAES_CCM_128DecryptInvalidNonceLen),
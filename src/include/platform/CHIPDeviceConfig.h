@@ -136,6 +136,17 @@
 #define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT
+ *
+ * The number of threads that process background events, on platforms that run them on a pool of
+ * threads (POSIX). Background work, such as CASE certificate validation and signatures, then runs
+ * in parallel for concurrent sessions.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT
+#define CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT 1
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ICD_SLOW_POLL_INTERVAL
  *
@@ -1315,6 +1326,20 @@ static_assert(CHIP_DEVICE_CONFIG_BLE_EXT_ADVERTISING_INTERVAL_MIN < CHIP_DEVICE_
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 0
 #endif
 
+/**
+ * @def CHIP_DEVICE_CONFIG_PERSISTENT_EVENT_LOG_SIZE
+ *
+ * @brief
+ *   The default size, in bytes, of the records of a PersistentEventLog, the
+ *   memory-mapped file that events are kept in across restarts when
+ *   CHIP_CONFIG_PERSISTENT_EVENT_LOG is enabled.  The oldest events are
+ *   dropped, whatever their priority, once it is full; those that the
+ *   EventManagement buffers still hold are then fetched from the buffers.
+ */
+#ifndef CHIP_DEVICE_CONFIG_PERSISTENT_EVENT_LOG_SIZE
+#define CHIP_DEVICE_CONFIG_PERSISTENT_EVENT_LOG_SIZE (64 * 1024)
+#endif
+
 // -------------------- Software Update Manager Configuration --------------------
 
 /**
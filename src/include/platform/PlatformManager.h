@@ -234,6 +234,10 @@ public:
     /**
      * Generally this function has the same semantics as StartEventLoopTask
      * except it applies to background processing.
+     *
+     * On POSIX platforms, this starts CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT
+     * threads that process background events concurrently; until it is called,
+     * background events are processed on the CHIP task.
      */
     CHIP_ERROR StartBackgroundEventLoopTask();
 
@@ -25,6 +25,9 @@
 #pragma once
 
 #include <platform/DeviceSafeQueue.h>
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+#include <platform/DeviceWorkerPool.h>
+#endif
 #include <platform/internal/GenericPlatformManagerImpl.h>
 
 #include <fcntl.h>
@@ -93,6 +96,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -111,6 +121,12 @@ private:
     DeviceSafeQueue mChipEventQueue;
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background work (e.g. CASE crypto) runs on a pool of threads, in parallel with the CHIP task and with each other.
+    DeviceWorkerPool mBackgroundWorkers;
+    static void DispatchBackgroundEvent(const ChipDeviceEvent & event, void * context);
+#endif
 #endif
     void ProcessDeviceEvents();
 };
@@ -257,6 +257,69 @@ void * GenericPlatformManagerImpl_POSIX<ImplClass>::EventLoopTaskMain(void * arg
     return nullptr;
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    if (!(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Until the application starts the background workers, background work runs on the CHIP task as before.
+    CHIP_ERROR err = mBackgroundWorkers.Post(*event);
+    if (err == CHIP_ERROR_INCORRECT_STATE)
+    {
+        return _PostEvent(event);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to post event to CHIP background event queue: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+    return err;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    // Accept background events with no threads of our own, and process them on the calling thread until
+    // StopBackgroundEventLoopTask().
+    CHIP_ERROR err = mBackgroundWorkers.Start(0, CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE, DispatchBackgroundEvent, Impl());
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Error trying to run the background event loop: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    mBackgroundWorkers.RunWorker();
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    ReturnErrorOnFailure(mBackgroundWorkers.Start(CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT,
+                                                  CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE, DispatchBackgroundEvent, Impl()));
+    ChipLogDetail(DeviceLayer, "CHIP background workers running: %u",
+                  static_cast<unsigned>(CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT));
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    // Work that was already queued still runs, so that it can release what it holds (see DeviceWorkerPool::Stop).
+    mBackgroundWorkers.Stop();
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::DispatchBackgroundEvent(const ChipDeviceEvent & event, void * context)
+{
+    static_cast<ImplClass *>(context)->DispatchEvent(&event);
+}
+
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 #endif // !CHIP_SYSTEM_CONFIG_USE_LIBEV
 
 template <class ImplClass>
@@ -394,6 +457,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    mBackgroundWorkers.Stop();
+#endif
+
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
 #endif
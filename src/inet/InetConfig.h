@@ -272,6 +272,51 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    The number of datagrams a socket-based UDP endpoint receives with a
+ *    single recvmmsg() call.
+ *
+ *  @details
+ *    When this is 0, a single datagram is received with recvmsg() each time
+ *    the socket is readable. Otherwise, each time the socket is readable, up
+ *    to this many datagrams are received with one recvmmsg() call and handed
+ *    to the endpoint's OnMessageReceived in turn. A listening endpoint keeps
+ *    the receive buffers that were not filled for the next call.
+ *
+ *    This is also the size of the send queue enabled by
+ *    #INET_CONFIG_UDP_SOCKET_SEND_QUEUE.
+ *
+ *    Requires recvmmsg() and sendmmsg(), which Linux provides.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 0
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+ *
+ *  @brief
+ *    Queue the datagrams sent by a socket-based UDP endpoint and send them
+ *    with a single sendmmsg() call once the current pass of the event loop
+ *    is done.
+ *
+ *  @details
+ *    With the queue, SendMsg() only returns the errors found before the
+ *    datagram is queued; errors from the socket are logged instead. A queue
+ *    that fills up is sent right away. When the socket buffer is full, the
+ *    queue is kept until the socket is writable again, and SendMsg() fails
+ *    with EAGAIN while the queue is full. Closing the endpoint sends what is
+ *    queued if the socket buffer has room for it, and drops the rest.
+ *
+ *    Requires #INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE to be set.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+#define INET_CONFIG_UDP_SOCKET_SEND_QUEUE 0
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
@@ -167,6 +167,64 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 }
 #endif // INET_CONFIG_ENABLE_IPV4
 
+// Fill in the source of a received datagram from [peerSockAddr], and its interface and destination address from the
+// IP_PKTINFO/IPV6_PKTINFO control message of [msgHeader].
+CHIP_ERROR GetReceivedPacketInfo(struct msghdr & msgHeader, const SockAddr & peerSockAddr, IPPacketInfo & packetInfo)
+{
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 } // anonymous namespace
 
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
@@ -278,6 +336,24 @@ CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
     return layer->RequestCallbackOnPendingRead(mWatch);
 }
 
+// static
+void UDPEndPointImplSockets::SetMessageHeader(OutgoingMessage & message, struct iovec & msgIOV, struct msghdr & msgHeader)
+{
+    msgIOV.iov_base = message.buffer->Start();
+    msgIOV.iov_len  = message.buffer->DataLength();
+
+    memset(&msgHeader, 0, sizeof(msgHeader));
+    msgHeader.msg_name    = &message.peerSockAddr;
+    msgHeader.msg_namelen = message.peerSockAddrLength;
+    msgHeader.msg_iov     = &msgIOV;
+    msgHeader.msg_iovlen  = 1;
+    if (message.controlDataLength > 0)
+    {
+        msgHeader.msg_control    = message.controlData;
+        msgHeader.msg_controllen = message.controlDataLength;
+    }
+}
+
 CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
 {
     // Ensure packet buffer is not null
@@ -293,24 +369,39 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
+    OutgoingMessage message;
+    ReturnErrorOnFailure(PrepareMessage(aPktInfo, message));
+    message.buffer = std::move(msg);
+
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+    return QueueMessage(std::move(message));
+#else  // !INET_CONFIG_UDP_SOCKET_SEND_QUEUE
     struct iovec msgIOV;
-    msgIOV.iov_base = msg->Start();
-    msgIOV.iov_len  = msg->DataLength();
+    struct msghdr msgHeader;
+    SetMessageHeader(message, msgIOV, msgHeader);
 
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-    uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
-#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    // Send IP packet.
+    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
+    if (lenSent == -1)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+    if (lenSent != message.buffer->DataLength())
+    {
+        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+    }
+    return CHIP_NO_ERROR;
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+}
 
-    struct msghdr msgHeader;
-    memset(&msgHeader, 0, sizeof(msgHeader));
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+CHIP_ERROR UDPEndPointImplSockets::PrepareMessage(const IPPacketInfo * aPktInfo, OutgoingMessage & message)
+{
+    memset(message.controlData, 0, sizeof(message.controlData));
+    message.controlDataLength = 0;
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    SockAddr peerSockAddr;
+    SockAddr & peerSockAddr = message.peerSockAddr;
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
-    msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
     {
         peerSockAddr.in6.sin6_family     = AF_INET6;
@@ -319,7 +410,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
         InterfaceId::PlatformType intfId = aPktInfo->Interface.GetPlatformInterface();
         VerifyOrReturnError(CanCastTo<decltype(peerSockAddr.in6.sin6_scope_id)>(intfId), CHIP_ERROR_INCORRECT_STATE);
         peerSockAddr.in6.sin6_scope_id = static_cast<decltype(peerSockAddr.in6.sin6_scope_id)>(intfId);
-        msgHeader.msg_namelen          = sizeof(sockaddr_in6);
+        message.peerSockAddrLength     = sizeof(sockaddr_in6);
     }
 #if INET_CONFIG_ENABLE_IPV4
     else
@@ -327,7 +418,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
         peerSockAddr.in.sin_family = AF_INET;
         peerSockAddr.in.sin_port   = htons(aPktInfo->DestPort);
         peerSockAddr.in.sin_addr   = aPktInfo->DestAddress.ToIPv4();
-        msgHeader.msg_namelen      = sizeof(sockaddr_in);
+        message.peerSockAddrLength = sizeof(sockaddr_in);
     }
 #endif // INET_CONFIG_ENABLE_IPV4
 
@@ -351,8 +442,10 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     if (intf.IsPresent() || aPktInfo->SrcAddress.Type() != IPAddressType::kAny)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        struct msghdr msgHeader;
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_control    = message.controlData;
+        msgHeader.msg_controllen = sizeof(message.controlData);
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -375,7 +468,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
             pktInfo->ipi_ifindex  = static_cast<decltype(pktInfo->ipi_ifindex)>(intfId);
             pktInfo->ipi_spec_dst = aPktInfo->SrcAddress.ToIPv4();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+            message.controlDataLength = CMSG_SPACE(sizeof(in_pktinfo));
 #else  // !defined(IP_PKTINFO)
             return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
 #endif // !defined(IP_PKTINFO)
@@ -398,7 +491,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
             pktInfo->ipi6_ifindex = static_cast<decltype(pktInfo->ipi6_ifindex)>(intfId);
             pktInfo->ipi6_addr    = aPktInfo->SrcAddress.ToIPv6();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+            message.controlDataLength = CMSG_SPACE(sizeof(in6_pktinfo));
 #else  // !defined(IPV6_PKTINFO)
             return CHIP_ERROR_UNSUPPORTED_CHIP_FEATURE;
 #endif // !defined(IPV6_PKTINFO)
@@ -410,21 +503,132 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     }
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
-    // Send IP packet.
-    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
-    if (lenSent == -1)
+    return CHIP_NO_ERROR;
+}
+
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+CHIP_ERROR UDPEndPointImplSockets::QueueMessage(OutgoingMessage && message)
+{
+    // The queue only stays full while the socket buffer is: fail as sendmsg() would on a full socket buffer.
+    VerifyOrReturnError(mSendQueueLength < kBatchSize, CHIP_ERROR_POSIX(EAGAIN));
+
+    // The queue is sent once the current pass of the event loop is done, so that the datagrams sent while handling
+    // its events go out with a single sendmmsg() call. Without a scheduled flush, send right away.
+    if (!mSendQueueFlushScheduled)
     {
-        return CHIP_ERROR_POSIX(errno);
+        mSendQueueFlushScheduled = (GetSystemLayer().ScheduleWork(HandleSendQueueFlush, this) == CHIP_NO_ERROR);
     }
-    if (lenSent != msg->DataLength())
+
+    mSendQueue[mSendQueueLength++] = std::move(message);
+    if (!mSendQueueFlushScheduled || mSendQueueLength == kBatchSize)
     {
-        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+        FlushSendQueue();
     }
     return CHIP_NO_ERROR;
 }
 
+void UDPEndPointImplSockets::FlushSendQueue()
+{
+    VerifyOrReturn(mSendQueueLength > 0 && !mSendQueueBlocked);
+
+    struct mmsghdr msgHeaders[kBatchSize];
+    struct iovec msgIOVs[kBatchSize];
+    for (size_t i = 0; i < mSendQueueLength; i++)
+    {
+        SetMessageHeader(mSendQueue[i], msgIOVs[i], msgHeaders[i].msg_hdr);
+        msgHeaders[i].msg_len = 0;
+    }
+
+    // sendmmsg() stops at the first datagram that fails. As SendMsg() has already returned for it, log the error,
+    // drop the datagram and carry on with the rest. A full socket buffer is no fault of the datagram: the rest of the
+    // queue is kept and sent once the socket is writable again, without blocking the event loop meanwhile.
+    size_t sent = 0;
+    while (sent < mSendQueueLength)
+    {
+        const int count =
+            sendmmsg(mSocket, &msgHeaders[sent], static_cast<unsigned int>(mSendQueueLength - sent), MSG_DONTWAIT);
+        if (count > 0)
+        {
+            sent += static_cast<size_t>(count);
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            CHIP_ERROR err = WaitForWritableSocket();
+            if (err == CHIP_NO_ERROR)
+            {
+                break;
+            }
+            ChipLogError(Inet, "Dropped %u queued UDP messages: %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(mSendQueueLength - sent), err.Format());
+            sent = mSendQueueLength;
+        }
+        else if (errno != EINTR)
+        {
+            ChipLogError(Inet, "Failed to send a queued UDP message: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            sent++;
+        }
+    }
+
+    // Release the datagrams that were sent or dropped, and move those that are kept to the front of the queue.
+    VerifyOrReturn(sent > 0);
+    for (size_t i = 0; i < sent; i++)
+    {
+        mSendQueue[i].buffer = nullptr;
+    }
+    for (size_t i = sent; i < mSendQueueLength; i++)
+    {
+        mSendQueue[i - sent] = std::move(mSendQueue[i]);
+    }
+    mSendQueueLength -= sent;
+}
+
+CHIP_ERROR UDPEndPointImplSockets::WaitForWritableSocket()
+{
+    auto * layer = static_cast<System::LayerSockets *>(&GetSystemLayer());
+    ReturnErrorOnFailure(layer->SetCallback(mWatch, HandlePendingIO, reinterpret_cast<intptr_t>(this)));
+    ReturnErrorOnFailure(layer->RequestCallbackOnPendingWrite(mWatch));
+    mSendQueueBlocked = true;
+    return CHIP_NO_ERROR;
+}
+
+// static
+void UDPEndPointImplSockets::HandleSendQueueFlush(System::Layer * systemLayer, void * appState)
+{
+    auto * endPoint                    = static_cast<UDPEndPointImplSockets *>(appState);
+    endPoint->mSendQueueFlushScheduled = false;
+    endPoint->FlushSendQueue();
+}
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+
 void UDPEndPointImplSockets::CloseImpl()
 {
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+    // Datagrams sent before closing still go out if the socket buffer has room for them.
+    FlushSendQueue();
+    if (mSendQueueLength > 0)
+    {
+        ChipLogError(Inet, "Dropped %u queued UDP messages on close", static_cast<unsigned>(mSendQueueLength));
+        for (size_t i = 0; i < mSendQueueLength; i++)
+        {
+            mSendQueue[i].buffer = nullptr;
+        }
+        mSendQueueLength = 0;
+    }
+    mSendQueueBlocked = false;
+    if (mSendQueueFlushScheduled)
+    {
+        GetSystemLayer().CancelTimer(HandleSendQueueFlush, this);
+        mSendQueueFlushScheduled = false;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    for (auto & buffer : mReceiveBuffers)
+    {
+        buffer = nullptr;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
     if (mSocket != kInvalidSocketFd)
     {
         static_cast<System::LayerSockets *>(&GetSystemLayer())->StopWatchingSocket(&mWatch);
@@ -570,11 +774,23 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events, intptr
 
 void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
 {
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+    if (mSendQueueBlocked && events.Has(System::SocketEventFlags::kWrite))
+    {
+        mSendQueueBlocked = false;
+        static_cast<System::LayerSockets *>(&GetSystemLayer())->ClearCallbackOnPendingWrite(mWatch);
+        FlushSendQueue();
+    }
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+
     if (mState != State::kListening || OnMessageReceived == nullptr || !events.Has(System::SocketEventFlags::kRead))
     {
         return;
     }
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    ReceiveBatch();
+#else  // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE == 0
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -619,62 +835,7 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetReceivedPacketInfo(msgHeader, lPeerSockAddr, lPacketInfo);
         }
     }
     else
@@ -694,7 +855,102 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
             OnReceiveError(this, lStatus, nullptr);
         }
     }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+}
+
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+void UDPEndPointImplSockets::ReceiveBatch()
+{
+    struct mmsghdr msgHeaders[kBatchSize];
+    struct iovec msgIOVs[kBatchSize];
+    SockAddr peerSockAddrs[kBatchSize];
+    alignas(struct cmsghdr) uint8_t controlData[kBatchSize][kPktInfoControlDataSize];
+
+    // Receive into as many buffers as can be allocated, up to a batch.
+    unsigned int bufferCount = 0;
+    for (; bufferCount < kBatchSize; bufferCount++)
+    {
+        System::PacketBufferHandle & buffer = mReceiveBuffers[bufferCount];
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
+            }
+        }
+
+        msgIOVs[bufferCount].iov_base = buffer->Start();
+        msgIOVs[bufferCount].iov_len  = buffer->AvailableDataLength();
+
+        struct msghdr & msgHeader = msgHeaders[bufferCount].msg_hdr;
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_name              = &peerSockAddrs[bufferCount];
+        msgHeader.msg_namelen           = sizeof(peerSockAddrs[bufferCount]);
+        msgHeader.msg_iov               = &msgIOVs[bufferCount];
+        msgHeader.msg_iovlen            = 1;
+        msgHeader.msg_control           = controlData[bufferCount];
+        msgHeader.msg_controllen        = sizeof(controlData[bufferCount]);
+        msgHeaders[bufferCount].msg_len = 0;
+    }
+
+    if (bufferCount == 0)
+    {
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
+    }
+
+    const int count = recvmmsg(mSocket, msgHeaders, bufferCount, MSG_DONTWAIT, nullptr);
+    if (count < 0)
+    {
+        const CHIP_ERROR status = CHIP_ERROR_POSIX(errno);
+        if (OnReceiveError != nullptr && status != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, status, nullptr);
+        }
+        return;
+    }
+
+    // The callbacks may close or free the endpoint, so keep it until the whole batch is handled, and stop handing
+    // out messages once it no longer listens.
+    Retain();
+    for (int i = 0; i < count && mState == State::kListening && OnMessageReceived != nullptr; i++)
+    {
+        struct msghdr & msgHeader = msgHeaders[i].msg_hdr;
+
+        IPPacketInfo packetInfo;
+        packetInfo.Clear();
+        packetInfo.DestPort  = mBoundPort;
+        packetInfo.Interface = mBoundIntfId;
+
+        CHIP_ERROR status = CHIP_NO_ERROR;
+        if ((msgHeader.msg_flags & MSG_TRUNC) != 0)
+        {
+            status = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            status = GetReceivedPacketInfo(msgHeader, peerSockAddrs[i], packetInfo);
+        }
+
+        if (status == CHIP_NO_ERROR)
+        {
+            System::PacketBufferHandle buffer = std::move(mReceiveBuffers[i]);
+            buffer->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            buffer.RightSize();
+            OnMessageReceived(this, std::move(buffer), &packetInfo);
+        }
+        else if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, status, nullptr);
+        }
+    }
+    Release();
 }
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
 
 #ifdef IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
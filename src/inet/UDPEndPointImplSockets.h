@@ -26,6 +26,10 @@
 #include <inet/EndPointStateSockets.h>
 #include <inet/UDPEndPoint.h>
 
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE && INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE == 0
+#error "INET_CONFIG_UDP_SOCKET_SEND_QUEUE requires INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0"
+#endif
+
 namespace chip {
 namespace Inet {
 
@@ -54,13 +58,49 @@ private:
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
     void CloseImpl() override;
 
+    // Room for one IP_PKTINFO or IPV6_PKTINFO control message.
+    static constexpr size_t kPktInfoControlDataSize = 64;
+
+    // A datagram with its destination, ready to be handed to sendmsg() or sendmmsg().
+    struct OutgoingMessage
+    {
+        System::PacketBufferHandle buffer;
+        SockAddr peerSockAddr;
+        socklen_t peerSockAddrLength;
+        socklen_t controlDataLength; // 0 if there is no control message
+        alignas(struct cmsghdr) uint8_t controlData[kPktInfoControlDataSize];
+    };
+
     CHIP_ERROR GetSocket(IPAddressType addressType);
+    CHIP_ERROR PrepareMessage(const IPPacketInfo * aPktInfo, OutgoingMessage & message);
+    static void SetMessageHeader(OutgoingMessage & message, struct iovec & msgIOV, struct msghdr & msgHeader);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+    static constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+
+    void ReceiveBatch();
+
+    // Receive buffers that were not filled are kept for the next batch.
+    System::PacketBufferHandle mReceiveBuffers[kBatchSize];
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 0
+
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+    CHIP_ERROR QueueMessage(OutgoingMessage && message);
+    void FlushSendQueue();
+    CHIP_ERROR WaitForWritableSocket();
+    static void HandleSendQueueFlush(System::Layer * systemLayer, void * appState);
+
+    OutgoingMessage mSendQueue[kBatchSize];
+    size_t mSendQueueLength       = 0;
+    bool mSendQueueFlushScheduled = false; // a HandleSendQueueFlush() call is scheduled
+    bool mSendQueueBlocked        = false; // the socket buffer is full, the queue is sent once the socket is writable
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     using MulticastGroupHandler = CHIP_ERROR (*)(InterfaceId, const IPAddress &);
@@ -46,6 +46,12 @@
 
 #include <system/SystemError.h>
 
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 #include <nlunit-test.h>
 
 #include "TestInetCommon.h"
@@ -239,6 +245,161 @@ static void TestInetInterface(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !addrIterator.HasBroadcastAddress());
 }
 
+constexpr size_t kUDPBurstLength = 40;
+
+struct UDPBurstState
+{
+    uint8_t received[kUDPBurstLength] = {};
+    size_t receivedCount              = 0;
+    bool freeOnReceive                = false;
+};
+
+void HandleUDPBurstMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * burst = static_cast<UDPBurstState *>(endPoint->mAppState);
+    if (burst->receivedCount < kUDPBurstLength && msg->DataLength() > 0)
+    {
+        burst->received[burst->receivedCount] = msg->Start()[0];
+    }
+    burst->receivedCount++;
+    if (burst->freeOnReceive)
+    {
+        endPoint->Free();
+    }
+}
+
+static void TestInetUDPBurst(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress loopback;
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    UDPBurstState burst;
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&receiver) == CHIP_NO_ERROR);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&sender) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, receiver->Bind(IPAddressType::kIPv6, loopback, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, receiver->Listen(HandleUDPBurstMessage, nullptr, &burst) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sender->Bind(IPAddressType::kIPv6, loopback, 0) == CHIP_NO_ERROR);
+
+    // More datagrams than fit in a receive batch all arrive, in order.
+    for (uint8_t i = 0; i < kUDPBurstLength; i++)
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiver->GetBoundPort(), std::move(buffer)) == CHIP_NO_ERROR);
+    }
+    for (int pass = 0; pass < 100 && burst.receivedCount < kUDPBurstLength; pass++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, burst.receivedCount == kUDPBurstLength);
+    for (uint8_t i = 0; i < kUDPBurstLength; i++)
+    {
+        NL_TEST_ASSERT(inSuite, burst.received[i] == i);
+    }
+
+    // An endpoint freed by its receive handler is not handed the datagrams that arrived with the first one.
+    burst.receivedCount = 0;
+    burst.freeOnReceive = true;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiver->GetBoundPort(), std::move(buffer)) == CHIP_NO_ERROR);
+    }
+    for (int pass = 0; pass < 10; pass++)
+    {
+        ServiceEvents(10);
+    }
+    NL_TEST_ASSERT(inSuite, burst.receivedCount == 1);
+
+    sender->Free();
+
+    // The later tests check the high water mark of the endpoints they allocate.
+    SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(System::Stats::kInetLayer_NumUDPEps);
+}
+
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+// Receives the datagrams waiting on [fd] without blocking, and returns how many there were.
+size_t ReceivePendingDatagrams(int fd, uint8_t * received, size_t maxCount)
+{
+    size_t count = 0;
+    uint8_t datagram;
+    while (count < maxCount && recv(fd, &datagram, sizeof(datagram), MSG_DONTWAIT) == sizeof(datagram))
+    {
+        received[count++] = datagram;
+    }
+    return count;
+}
+
+static void TestInetUDPSendQueue(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+
+    // A plain socket receives the datagrams, so that they can be read without servicing the event loop.
+    const int receiverFd = socket(AF_INET6, SOCK_DGRAM, 0);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, receiverFd >= 0);
+    struct sockaddr_in6 receiverAddr = {};
+    socklen_t receiverAddrLength     = sizeof(receiverAddr);
+    receiverAddr.sin6_family         = AF_INET6;
+    receiverAddr.sin6_addr           = in6addr_loopback;
+    NL_TEST_ASSERT(inSuite, bind(receiverFd, reinterpret_cast<struct sockaddr *>(&receiverAddr), receiverAddrLength) == 0);
+    NL_TEST_ASSERT(inSuite,
+                   getsockname(receiverFd, reinterpret_cast<struct sockaddr *>(&receiverAddr), &receiverAddrLength) == 0);
+    const uint16_t receiverPort = ntohs(receiverAddr.sin6_port);
+
+    IPAddress loopback;
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("::1", loopback));
+    UDPEndPoint * sender = nullptr;
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&sender) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sender->Bind(IPAddressType::kIPv6, loopback, 0) == CHIP_NO_ERROR);
+
+    uint8_t received[kBatchSize + 1];
+
+    // Datagrams sent while handling events are queued, and sent once the current pass of the event loop is done.
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiverPort, std::move(buffer)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, ReceivePendingDatagrams(receiverFd, received, sizeof(received)) == 0);
+    ServiceEvents(10);
+    NL_TEST_ASSERT(inSuite, ReceivePendingDatagrams(receiverFd, received, sizeof(received)) == 3);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, received[i] == i);
+    }
+
+    // A queue that fills up is sent right away.
+    for (uint8_t i = 0; i < kBatchSize; i++)
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiverPort, std::move(buffer)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, ReceivePendingDatagrams(receiverFd, received, sizeof(received)) == kBatchSize);
+    for (uint8_t i = 0; i < kBatchSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, received[i] == i);
+    }
+
+    // Closing the endpoint sends what is queued.
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        PacketBufferHandle buffer = PacketBufferHandle::NewWithData(&i, sizeof(i));
+        NL_TEST_ASSERT(inSuite, sender->SendTo(loopback, receiverPort, std::move(buffer)) == CHIP_NO_ERROR);
+    }
+    sender->Free();
+    NL_TEST_ASSERT(inSuite, ReceivePendingDatagrams(receiverFd, received, sizeof(received)) == 2);
+
+    // The flush scheduled for the datagrams sent before closing was cancelled.
+    ServiceEvents(10);
+
+    close(receiverFd);
+
+    // The later tests check the high water mark of the endpoints they allocate.
+    SYSTEM_STATS_RESET_HIGH_WATER_MARK_FOR_TESTING(System::Stats::kInetLayer_NumUDPEps);
+}
+#endif // INET_CONFIG_UDP_SOCKET_SEND_QUEUE && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
 {
     CHIP_ERROR err;
@@ -451,6 +612,10 @@ static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
 static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPre),
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPBurst", TestInetUDPBurst),
+#if INET_CONFIG_UDP_SOCKET_SEND_QUEUE && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPSendQueue", TestInetUDPSendQueue),
+#endif
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
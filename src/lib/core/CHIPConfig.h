@@ -254,6 +254,26 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets the exchange manager uses to find the open
+ *    exchange a received message belongs to.  Each bucket costs one
+ *    pointer; a lookup walks the exchanges that share a bucket.
+ *
+ *    With heap-allocated pools the number of exchanges is not bounded by
+ *    CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, so more buckets are used.
+ *
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS 64
+#else
+#define CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_MCSP_RECEIVE_TABLE_SIZE
  *
@@ -854,6 +874,9 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
  *      * #CHIP_IM_MAX_REPORTS_IN_FLIGHT
  *      * #CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *      * #CHIP_IM_SERVER_MAX_NUM_DIRTY_SET
+ *      * #CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
+ *      * #CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE
+ *      * #CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES
  *      * #CHIP_IM_MAX_NUM_WRITE_HANDLER
  *      * #CHIP_IM_MAX_NUM_WRITE_CLIENT
  *      * #CHIP_IM_MAX_NUM_TIMED_HANDLER
@@ -931,6 +954,36 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets used by the reporting engine to find the read handlers interested in a dirty
+ *        attribute path. Must be a power of 2.
+ */
+#ifndef CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_SERVER_INTEREST_INDEX_BUCKETS 32
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE
+ *
+ * @brief Defines the size, in bytes, of the buffer the reporting engine uses to share encoded attribute reports between read
+ *        handlers that report the same attribute in a single run. Set to 0 to disable sharing.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE
+#define CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES
+ *
+ * @brief Defines the maximum number of attributes whose encoded reports the reporting engine shares in a single run.
+ *        Only used when CHIP_IM_SERVER_REPORT_ENCODING_CACHE_SIZE is not 0.
+ */
+#ifndef CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES
+#define CHIP_IM_SERVER_REPORT_ENCODING_CACHE_ENTRIES 32
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1116,6 +1169,18 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * Defines the number of (subject, request path) pairs for which access
+ * control remembers the granted privileges, so that repeated checks don't
+ * evaluate the access control entries again. The cache is invalidated
+ * whenever the entries change. Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 0
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1216,6 +1281,46 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE (3 * CHIP_CONFIG_MAX_FABRICS)
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_CONTROLLER_CACHE_SIZE
+ *
+ * @brief
+ *   Maximum number of nodes whose CASE session resumption state a controller keeps in
+ *   CachedSessionResumptionStorage. Unlike CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE, this
+ *   is not tied to the number of fabrics, since a controller resumes sessions with every
+ *   node it commissioned. The state is held in memory and persisted in pages of 16 nodes.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_CONTROLLER_CACHE_SIZE
+#define CHIP_CONFIG_CASE_SESSION_RESUME_CONTROLLER_CACHE_SIZE 1024
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BACK_DELAY_MS
+ *
+ * @brief
+ *   How long CachedSessionResumptionStorage may keep newly saved session resumption state
+ *   in memory only, so that the pages changed by many handshakes in quick succession (e.g. a
+ *   controller reconnecting to its nodes) are written to storage together. A restart before
+ *   then loses that state, which costs the affected sessions a full CASE handshake.
+ *   0, the default, writes every save through to storage.
+ */
+#ifndef CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BACK_DELAY_MS
+#define CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BACK_DELAY_MS 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+ *
+ * @brief
+ *   Number of verified CA certificate signatures the FabricTable remembers, so that CASE
+ *   with a peer whose certificate chain was validated before only verifies the signature of
+ *   the peer's NOC instead of the ICAC's too. The default fits one ICAC per fabric. Each
+ *   entry takes 36 bytes.
+ */
+#ifndef CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE
+#define CHIP_CONFIG_VERIFIED_CERT_CACHE_SIZE CHIP_CONFIG_MAX_FABRICS
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -1236,6 +1341,23 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of entries of the index of each event logging buffer.
+ *
+ * Each entry records the event number and offset of an event of the
+ * buffer, roughly every 1/CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE of the
+ * buffer, along with the clusters of the events up to the next entry.
+ * Fetching events starts from the entry closest to the first event
+ * needed, and skips the runs of events of clusters that the reader is
+ * not interested in.  Each entry takes 16 bytes.
+ *
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 8
+#endif /* CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1359,6 +1481,32 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Determines the number of DNS-SD records (PTR, SRV, TXT and AAAA) the minmdns
+ *        resolver caches until their TTL runs out. Resolves of nodes whose records are
+ *        all cached are answered without a query, and browse queries list the cached
+ *        instances as known answers. Each entry takes about 220 bytes, and an operational
+ *        node needs 3 to 4 of them, so this is only worth enabling on controllers, which
+ *        should size it for the nodes they resolve. 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+ *
+ * @brief Determines the number of unicast replies the minmdns advertiser keeps, as sent,
+ *        to send again to repeated queries for a few seconds, or until the advertised
+ *        services change. Each kept reply holds a packet buffer of up to 512 bytes. A
+ *        value of 0 disables keeping replies.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1758,6 +1906,26 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS 5
 #endif // CHIP_CONFIG_MAX_BDX_LOG_TRANSFERS
 
+/**
+ *  @def CHIP_CONFIG_BDX_MAX_BLOCKS_IN_FLIGHT
+ *
+ *  @brief
+ *    Maximum number of Blocks that the sender of an asynchronous BDX transfer sends
+ *    before it waits for a BlockAck.
+ *
+ *    Asynchronous transfers need a transport that delivers messages reliably and in
+ *    order, such as TCP, so this does not apply to transfers over MRP.
+ *
+ *    Blocks over TCP are still bounded by the capacity of a single packet buffer
+ *    (bdx::kMaxLargePayloadBlockSize, about 1.5 kB), as there are no large-payload
+ *    buffers for TCP yet. The window only hides the round-trip time between Blocks;
+ *    transfers of tens of MB still take one message per 1.5 kB of data.
+ *
+ */
+#ifndef CHIP_CONFIG_BDX_MAX_BLOCKS_IN_FLIGHT
+#define CHIP_CONFIG_BDX_MAX_BLOCKS_IN_FLIGHT 8
+#endif // CHIP_CONFIG_BDX_MAX_BLOCKS_IN_FLIGHT
+
 /**
  * @}
  */
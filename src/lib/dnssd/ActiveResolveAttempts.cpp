@@ -97,6 +97,19 @@ bool ActiveResolveAttempts::HasBrowseFor(chip::Dnssd::DiscoveryType type) const
     return false;
 }
 
+bool ActiveResolveAttempts::IsPending(const ScheduledAttempt & attempt) const
+{
+    for (auto & item : mRetryQueue)
+    {
+        if (item.attempt.Matches(attempt))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void ActiveResolveAttempts::CompleteIpResolution(SerializedQNameIterator targetHostName)
 {
     for (auto & item : mRetryQueue)
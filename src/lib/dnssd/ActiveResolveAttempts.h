@@ -291,6 +291,10 @@ public:
     /// Check if a browse operation is active for the given discovery type
     bool HasBrowseFor(chip::Dnssd::DiscoveryType type) const;
 
+    /// Check if an attempt matching the given one is still pending, i.e. it
+    /// was neither completed nor timed out.
+    bool IsPending(const ScheduledAttempt & attempt) const;
+
 private:
     struct RetryEntry
     {
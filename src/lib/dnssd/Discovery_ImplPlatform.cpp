@@ -641,6 +641,11 @@ CHIP_ERROR DiscoveryImplPlatform::ResolveNodeId(const PeerId & peerId)
     return ChipDnssdResolve(&service, Inet::InterfaceId::Null(), HandleNodeIdResolve, this);
 }
 
+void DiscoveryImplPlatform::ForgetCachedNode(const PeerId & peerId)
+{
+    // Caching is left to the platform DNS-SD implementation, which confirms the records it has when asked to resolve.
+}
+
 void DiscoveryImplPlatform::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
     char name[Common::kInstanceNameMaxLength + 1];
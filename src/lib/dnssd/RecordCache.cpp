@@ -0,0 +1,334 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "RecordCache.h"
+
+#include <lib/core/CHIPEncoding.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+
+using namespace chip;
+
+namespace mdns {
+namespace Minimal {
+namespace {
+
+/// Writes [name] without any compression pointers, so that it can be read
+/// outside of the packet it was received in.
+bool WriteUncompressedQName(Encoding::BigEndian::BufferWriter & out, SerializedQNameIterator name)
+{
+    while (name.Next())
+    {
+        const size_t length = strlen(name.Value());
+        out.Put8(static_cast<uint8_t>(length));
+        out.Put(name.Value(), length);
+    }
+    out.Put8(0);
+    return name.IsValid();
+}
+
+/// FNV-1a over the lowercased labels of a name, each followed by a separator.
+constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+constexpr uint32_t kFnvPrime       = 16777619u;
+
+uint32_t HashLabel(uint32_t hash, const char * label)
+{
+    for (; *label != '\0'; label++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(tolower(static_cast<unsigned char>(*label)))) * kFnvPrime;
+    }
+    return (hash ^ '.') * kFnvPrime;
+}
+
+/// How long records flushed by a record with the cache-flush bit are kept (RFC 6762 section 10.2).
+constexpr System::Clock::Seconds32 kCacheFlushDelay(1);
+
+} // namespace
+
+uint32_t RecordCache::HashName(const FullQName & name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    for (size_t i = 0; i < name.nameCount; i++)
+    {
+        hash = HashLabel(hash, name.names[i]);
+    }
+    return hash;
+}
+
+uint32_t RecordCache::HashName(SerializedQNameIterator name)
+{
+    uint32_t hash = kFnvOffsetBasis;
+    while (name.Next())
+    {
+        hash = HashLabel(hash, name.Value());
+    }
+    return hash;
+}
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+void RecordCache::Clear()
+{
+    memset(mBuckets, 0, sizeof(mBuckets));
+    mFreeEntries = nullptr;
+    for (auto & entry : mEntries)
+    {
+        FreeEntry(entry);
+    }
+}
+
+bool RecordCache::Add(Inet::InterfaceId interface, const ResourceData & data, const BytesRange & packet)
+{
+    Entry received;
+    VerifyOrReturnValue(Serialize(data, packet, received), false);
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+    received.interfaceId               = interface;
+    received.expiryTime                = now + System::Clock::Seconds32(static_cast<uint32_t>(data.GetTtlSeconds()));
+    received.nameHash                  = HashName(data.GetName());
+
+    // The other records of the name and type that the sender has are all in this packet or the ones sent with it
+    // (RFC 6762 section 10.2), so any record it does not send again is stale.
+    const bool cacheFlush = (static_cast<uint16_t>(data.GetClass()) & kQClassResponseFlushBit) != 0;
+
+    // Look for the record to replace in the bucket of its name, and free the expired entries found on the way. With the
+    // cache-flush bit, the whole bucket is walked to flush the other records of the name and type.
+    Entry * entryToUse = nullptr;
+    Entry * entry      = mBuckets[received.nameHash % kBucketCount];
+    while (entry != nullptr && (entryToUse == nullptr || cacheFlush))
+    {
+        Entry * next = entry->next;
+        if (entry->expiryTime <= now)
+        {
+            UnlinkEntry(*entry);
+            FreeEntry(*entry);
+        }
+        else if (entry->nameHash == received.nameHash)
+        {
+            if (entryToUse == nullptr && entry->Matches(received))
+            {
+                entryToUse = entry;
+            }
+            else if (cacheFlush && entry->IsFlushedBy(received, now))
+            {
+                // Not dropped right away, as the sender may still be sending the rest of its records.
+                entry->expiryTime = std::min(entry->expiryTime, now + kCacheFlushDelay);
+            }
+        }
+        entry = next;
+    }
+
+    if (data.GetTtlSeconds() == 0)
+    {
+        // A 'goodbye' record: the record is no longer valid.
+        if (entryToUse != nullptr)
+        {
+            UnlinkEntry(*entryToUse);
+            FreeEntry(*entryToUse);
+        }
+        return true;
+    }
+
+    if (entryToUse == nullptr)
+    {
+        entryToUse  = &AllocateEntry(now);
+        *entryToUse = received;
+        LinkEntry(*entryToUse);
+        return true;
+    }
+
+    // The record keeps its place in the bucket, which has the same name hash.
+    Entry * const linkedNext = entryToUse->next;
+    *entryToUse              = received;
+    entryToUse->next         = linkedNext;
+    return true;
+}
+
+RecordCache::Entry & RecordCache::AllocateEntry(System::Clock::Timestamp now)
+{
+    Entry * entryToUse = mFreeEntries;
+    if (entryToUse != nullptr)
+    {
+        mFreeEntries = entryToUse->next;
+        return *entryToUse;
+    }
+
+    // Drop an expired record, or else the record closest to expiring. Only expiry times are compared, so this does
+    // not parse any entry.
+    entryToUse = &mEntries[0];
+    for (auto & entry : mEntries)
+    {
+        if (entry.expiryTime <= now)
+        {
+            entryToUse = &entry;
+            break;
+        }
+        if (entry.expiryTime < entryToUse->expiryTime)
+        {
+            entryToUse = &entry;
+        }
+    }
+    UnlinkEntry(*entryToUse);
+    return *entryToUse;
+}
+
+void RecordCache::LinkEntry(Entry & entry)
+{
+    Entry *& bucket = mBuckets[entry.nameHash % kBucketCount];
+    entry.next      = bucket;
+    bucket          = &entry;
+}
+
+void RecordCache::UnlinkEntry(Entry & entry)
+{
+    Entry ** link = &mBuckets[entry.nameHash % kBucketCount];
+    while (*link != &entry)
+    {
+        link = &(*link)->next;
+    }
+    *link = entry.next;
+}
+
+void RecordCache::FreeEntry(Entry & entry)
+{
+    entry.length = 0;
+    entry.next   = mFreeEntries;
+    mFreeEntries = &entry;
+}
+
+#else // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+void RecordCache::Clear() {}
+
+bool RecordCache::Add(Inet::InterfaceId interface, const ResourceData & data, const BytesRange & packet)
+{
+    return false;
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+bool RecordCache::Serialize(const ResourceData & data, const BytesRange & packet, Entry & entry)
+{
+    Encoding::BigEndian::BufferWriter out(entry.data, sizeof(entry.data));
+
+    VerifyOrReturnValue(WriteUncompressedQName(out, data.GetName()), false);
+
+    // The cache-flush bit only has a meaning for the packet the record was received in.
+    out.Put16(static_cast<uint16_t>(data.GetType()))
+        .Put16(static_cast<uint16_t>(static_cast<uint16_t>(data.GetClass()) & ~kQClassResponseFlushBit))
+        .Put32(static_cast<uint32_t>(data.GetTtlSeconds()));
+
+    const size_t dataLengthOffset = out.Needed();
+    out.Put16(0); // replaced once the data is written
+
+    switch (data.GetType())
+    {
+    case QType::PTR: {
+        SerializedQNameIterator target;
+        VerifyOrReturnValue(ParsePtrRecord(data.GetData(), packet, &target), false);
+        VerifyOrReturnValue(WriteUncompressedQName(out, target), false);
+        break;
+    }
+    case QType::SRV: {
+        SrvRecord srv;
+        VerifyOrReturnValue(srv.Parse(data.GetData(), packet), false);
+        out.Put16(srv.GetPriority()).Put16(srv.GetWeight()).Put16(srv.GetPort());
+        VerifyOrReturnValue(WriteUncompressedQName(out, srv.GetName()), false);
+        break;
+    }
+    case QType::TXT:
+    case QType::AAAA:
+        out.Put(data.GetData().Start(), data.GetData().Size());
+        break;
+    default:
+        return false;
+    }
+
+    VerifyOrReturnValue(out.Fit(), false);
+    Encoding::BigEndian::Put16(entry.data + dataLengthOffset, static_cast<uint16_t>(out.Needed() - dataLengthOffset - 2));
+    entry.length = static_cast<uint16_t>(out.Needed());
+    return true;
+}
+
+bool RecordCache::Entry::Parse(Record & record) const
+{
+    VerifyOrReturnValue(length != 0, false);
+
+    record.interfaceId    = interfaceId;
+    record.range          = BytesRange(data, data + length);
+    const uint8_t * start = data;
+    return record.data.Parse(record.range, &start);
+}
+
+bool RecordCache::Entry::Get(System::Clock::Timestamp now, Record & record) const
+{
+    VerifyOrReturnValue(expiryTime > now && Parse(record), false);
+
+    record.remainingTtlSeconds = std::chrono::duration_cast<System::Clock::Seconds32>(expiryTime - now).count();
+    return true;
+}
+
+bool RecordCache::Entry::Matches(const Entry & other) const
+{
+    Record record;
+    Record otherRecord;
+    VerifyOrReturnValue(Parse(record) && other.Parse(otherRecord), false);
+    VerifyOrReturnValue(record.data.GetType() == otherRecord.data.GetType(), false);
+    VerifyOrReturnValue(record.data.GetName() == otherRecord.data.GetName(), false);
+
+    switch (record.data.GetType())
+    {
+    case QType::SRV:
+    case QType::TXT:
+        // A service instance has a single SRV and TXT record, so a new one replaces the cached one.
+        return true;
+    case QType::AAAA:
+        // Link-local addresses are only meaningful on the interface they were received on.
+        VerifyOrReturnValue(interfaceId == other.interfaceId, false);
+        break;
+    default:
+        break;
+    }
+
+    // Names within the data are uncompressed, so the data can be compared as is.
+    const BytesRange & recordData      = record.data.GetData();
+    const BytesRange & otherRecordData = otherRecord.data.GetData();
+    return (recordData.Size() == otherRecordData.Size()) &&
+        (memcmp(recordData.Start(), otherRecordData.Start(), recordData.Size()) == 0);
+}
+
+bool RecordCache::Entry::IsFlushedBy(const Entry & other, System::Clock::Timestamp now) const
+{
+    Record record;
+    Record otherRecord;
+    VerifyOrReturnValue(Parse(record) && other.Parse(otherRecord), false);
+    VerifyOrReturnValue(record.data.GetType() == otherRecord.data.GetType(), false);
+    VerifyOrReturnValue(record.data.GetName() == otherRecord.data.GetName(), false);
+    VerifyOrReturnValue(interfaceId == other.interfaceId, false);
+
+    // Records received within the last second may be from the same response as [other] (RFC 6762 section 10.2).
+    const System::Clock::Timestamp receivedTime = expiryTime - System::Clock::Seconds32(record.data.GetTtlSeconds());
+    return receivedTime + kCacheFlushDelay <= now;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,197 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <system/SystemClock.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Caches PTR, SRV, TXT and AAAA records received by the resolver until their
+/// TTL runs out, so that resolves can be answered without a query and queries
+/// can list the answers that are already known (RFC 6762 section 7.1).
+///
+/// Records are kept in a fixed number of entries. Each entry holds a single
+/// record, with its names uncompressed, so that it can be handed out as a
+/// ResourceData that is valid on its own. Entries are chained in buckets by a
+/// hash of their record name, so that finding the records of a name does not
+/// go through the whole cache.
+///
+/// With a CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE of 0, nothing is cached.
+class RecordCache
+{
+public:
+    static constexpr size_t kCacheSize = CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE;
+
+    // Enough for the records of an operational node: its SRV, TXT and AAAA
+    // records are all around 100 bytes. Larger records are not cached.
+    static constexpr size_t kMaxRecordSize = 192;
+
+    /// A record found in the cache.
+    ///
+    /// VALIDITY: references the cache entry, so only valid until the cache is
+    ///           next modified.
+    struct Record
+    {
+        chip::Inet::InterfaceId interfaceId;
+        ResourceData data;            // as received, with the TTL it was received with
+        BytesRange range;             // valid data for the names within `data`
+        uint32_t remainingTtlSeconds; // seconds until the record expires
+    };
+
+    RecordCache(chip::System::Clock::ClockBase * clock) : mClock(clock) { Clear(); }
+
+    /// Drop all cached records.
+    void Clear();
+
+    /// Cache a record received over [interface] within [packet].
+    ///
+    /// A record with the same name, type and (except for SRV and TXT records,
+    /// of which a name has a single one) data is replaced. A TTL of 0 removes
+    /// the record instead. When the cache is full, the record closest to
+    /// expiring is dropped.
+    ///
+    /// A record with the cache-flush bit set makes the other records of its
+    /// name, type and interface that were received more than a second earlier
+    /// expire a second later (RFC 6762 section 10.2).
+    ///
+    /// Returns false if the record was not cached: it is not of a cached type,
+    /// cannot be parsed or is larger than kMaxRecordSize.
+    bool Add(chip::Inet::InterfaceId interface, const ResourceData & data, const BytesRange & packet);
+
+    /// Call `callback(const Record &)` for each record of the given name and
+    /// type that has not expired. The callback must not modify the cache.
+    ///
+    /// [name] may be a FullQName or a SerializedQNameIterator.
+    template <typename Name, typename Callback>
+    void ForEach(const Name & name, QType type, Callback && callback) const
+    {
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+        const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+        const uint32_t nameHash                  = HashName(name);
+
+        for (const Entry * entry = mBuckets[nameHash % kBucketCount]; entry != nullptr; entry = entry->next)
+        {
+            Record record;
+            if ((entry->nameHash != nameHash) || !entry->Get(now, record) || (record.data.GetType() != type) ||
+                (record.data.GetName() != name))
+            {
+                continue;
+            }
+            callback(record);
+        }
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    }
+
+    /// Drop the records of the given name and type.
+    ///
+    /// [name] may be a FullQName or a SerializedQNameIterator. The latter may
+    /// point into a cached record of another name or type.
+    template <typename Name>
+    void Remove(const Name & name, QType type)
+    {
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+        const uint32_t nameHash = HashName(name);
+
+        Entry * entry = mBuckets[nameHash % kBucketCount];
+        while (entry != nullptr)
+        {
+            Entry * next = entry->next;
+            Record record;
+            if ((entry->nameHash == nameHash) && entry->Parse(record) && (record.data.GetType() == type) &&
+                (record.data.GetName() == name))
+            {
+                UnlinkEntry(*entry);
+                FreeEntry(*entry);
+            }
+            entry = next;
+        }
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    }
+
+    /// Check if a record of the given name and type has not expired.
+    template <typename Name>
+    bool Contains(const Name & name, QType type) const
+    {
+        bool found = false;
+        ForEach(name, type, [&found](const Record &) { found = true; });
+        return found;
+    }
+
+private:
+    static constexpr size_t kBucketCount = kCacheSize;
+
+    struct Entry
+    {
+        chip::Inet::InterfaceId interfaceId;
+        chip::System::Clock::Timestamp expiryTime;
+        Entry * next      = nullptr; // next entry of the same bucket, or of the free list
+        uint32_t nameHash = 0;       // HashName() of the record name
+        uint16_t length   = 0;       // 0 for an unused entry
+        uint8_t data[kMaxRecordSize];
+
+        /// Parse the entry into [record], whether it has expired or not.
+        bool Parse(Record & record) const;
+
+        /// Parse the entry into [record] if it is in use and not expired at [now].
+        bool Get(chip::System::Clock::Timestamp now, Record & record) const;
+
+        /// Check if the entry holds the record that [other] would replace.
+        bool Matches(const Entry & other) const;
+
+        /// Check if [other], received at [now] with the cache-flush bit, flushes
+        /// the record of the entry.
+        bool IsFlushedBy(const Entry & other, chip::System::Clock::Timestamp now) const;
+    };
+
+    /// Serialize [data] with its names uncompressed into [entry].
+    static bool Serialize(const ResourceData & data, const BytesRange & packet, Entry & entry);
+
+    /// A hash of [name] that does not depend on the case of its labels, as names
+    /// are compared case-insensitively.
+    static uint32_t HashName(const FullQName & name);
+    static uint32_t HashName(SerializedQNameIterator name);
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    /// Take an entry off the free list, or else the first expired entry or the
+    /// one closest to expiring off its bucket.
+    Entry & AllocateEntry(chip::System::Clock::Timestamp now);
+
+    void LinkEntry(Entry & entry);
+    void UnlinkEntry(Entry & entry);
+    void FreeEntry(Entry & entry);
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+    chip::System::Clock::ClockBase * mClock;
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    Entry mEntries[kCacheSize];
+    Entry * mBuckets[kBucketCount] = {};
+    Entry * mFreeEntries           = nullptr;
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+};
+
+} // namespace Minimal
+} // namespace mdns
@@ -151,6 +151,15 @@ public:
      */
     virtual CHIP_ERROR ResolveNodeId(const PeerId & peerId) = 0;
 
+    /**
+     * Drops whatever the implementation has cached about the given operational
+     * node, so that the next ResolveNodeId for it queries the network.
+     *
+     * Used when the node could not be reached at the address it resolved to,
+     * as it may have moved to another one.
+     */
+    virtual void ForgetCachedNode(const PeerId & peerId) = 0;
+
     /*
      * Notify the resolver that one of the consumers that called ResolveNodeId
      * successfully no longer needs the resolution result (e.g. because it got
@@ -23,6 +23,7 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/RecordCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
@@ -47,6 +48,27 @@ constexpr uint16_t kMdnsPort        = 5353;
 
 using namespace mdns::Minimal;
 
+// Records of these services are cached, as are the AAAA records of their hosts.
+constexpr QNamePart kOperationalSuffix[]    = { kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+constexpr QNamePart kCommissionableSuffix[] = { kCommissionableServiceName, kCommissionProtocol, kLocalDomain };
+constexpr QNamePart kCommissionerSuffix[]   = { kCommissionerServiceName, kCommissionProtocol, kLocalDomain };
+
+/// Checks if the given name is a Matter service, or an instance or subtype of
+/// one, e.g. `_matterc._udp.local`, `<instance>._matterc._udp.local` or
+/// `_L1234._sub._matterc._udp.local`.
+bool IsMatterServiceName(SerializedQNameIterator name)
+{
+    do
+    {
+        if ((name == kOperationalSuffix) || (name == kCommissionableSuffix) || (name == kCommissionerSuffix))
+        {
+            return true;
+        }
+    } while (name.Next());
+
+    return false;
+}
+
 /// Handles processing of minmdns packet data.
 ///
 /// Can process multiple incremental resolves based on SRV data and allows
@@ -55,7 +77,9 @@ using namespace mdns::Minimal;
 class PacketParser : private ParserDelegate
 {
 public:
-    PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves) {}
+    PacketParser(ActiveResolveAttempts & activeResolves, RecordCache & recordCache) :
+        mActiveResolves(activeResolves), mRecordCache(recordCache)
+    {}
 
     /// Goes through the given SRV records within a response packet
     /// and sets up data resolution
@@ -67,6 +91,11 @@ public:
     /// Must be called AFTER ParseSrvRecords has been called.
     void ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRange & packet);
 
+    /// Feeds the cached records of the given name and type through the
+    /// resolvers, as if they had just been received.
+    template <typename Name>
+    void ParseCachedRecords(const Name & name, QType type);
+
     IncrementalResolver * ResolverBegin() { return mResolvers; }
     IncrementalResolver * ResolverEnd() { return mResolvers + kMinMdnsNumParallelResolvers; }
 
@@ -87,6 +116,11 @@ private:
     /// Forwards the resource to all active resolvers.
     void ParseResource(const ResourceData & data);
 
+    /// Checks if a received record is one to cache: the PTR, SRV and TXT
+    /// records of Matter services and the AAAA records of the hosts being
+    /// resolved.
+    bool IsCacheable(const ResourceData & data) const;
+
     enum class RecordParsingState
     {
         kIdle,
@@ -104,6 +138,7 @@ private:
 
     // resolvers kept between parse steps
     ActiveResolveAttempts & mActiveResolves;
+    RecordCache & mRecordCache;
     IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
 };
 
@@ -151,6 +186,10 @@ void PacketParser::OnResource(ResourceType type, const ResourceData & data)
             // SRV packets logged during 'SrvInitialization' phase
             mdns::Minimal::Logging::LogReceivedResource(data);
         }
+        if (IsCacheable(data))
+        {
+            mRecordCache.Add(mInterfaceId, data, mPacketRange);
+        }
         ParseResource(data);
         break;
     case RecordParsingState::kIdle:
@@ -190,6 +229,32 @@ void PacketParser::ParseResource(const ResourceData & data)
     }
 }
 
+bool PacketParser::IsCacheable(const ResourceData & data) const
+{
+    switch (data.GetType())
+    {
+    case QType::PTR:
+    case QType::SRV:
+    case QType::TXT:
+        return IsMatterServiceName(data.GetName());
+    case QType::AAAA:
+        if (data.GetTtlSeconds() == 0)
+        {
+            return true; // removes the address if it is cached
+        }
+        for (auto & resolver : mResolvers)
+        {
+            if (resolver.IsActive() && (resolver.GetTargetHostName() == data.GetName()))
+            {
+                return true;
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
 void PacketParser::ParseSRVResource(const ResourceData & data)
 {
     SrvRecord srv;
@@ -266,10 +331,33 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
     mParsingState = RecordParsingState::kIdle;
 }
 
+template <typename Name>
+void PacketParser::ParseCachedRecords(const Name & name, QType type)
+{
+    mParsingState = (type == QType::SRV) ? RecordParsingState::kSrvInitialization : RecordParsingState::kRecordParsing;
+
+    mRecordCache.ForEach(name, type, [this](const RecordCache::Record & record) {
+        mInterfaceId = record.interfaceId;
+        mPacketRange = record.range;
+        if (record.data.GetType() == QType::SRV)
+        {
+            ParseSRVResource(record.data);
+        }
+        else
+        {
+            ParseResource(record.data);
+        }
+    });
+
+    mParsingState = RecordParsingState::kIdle;
+}
+
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() :
+        mActiveResolves(&chip::System::SystemClock()), mRecordCache(&chip::System::SystemClock()),
+        mPacketParser(mActiveResolves, mRecordCache)
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -284,6 +372,7 @@ public:
     void Shutdown() override;
     void SetOperationalDelegate(OperationalResolveDelegate * delegate) override { mOperationalDelegate = delegate; }
     CHIP_ERROR ResolveNodeId(const PeerId & peerId) override;
+    void ForgetCachedNode(const PeerId & peerId) override;
     void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) override;
     CHIP_ERROR DiscoverCommissionableNodes(DiscoveryFilter filter, DiscoveryContext & context) override;
     CHIP_ERROR DiscoverCommissioners(DiscoveryFilter filter, DiscoveryContext & context) override;
@@ -295,6 +384,7 @@ private:
     DiscoveryContext * mDiscoveryContext              = nullptr;
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
+    RecordCache mRecordCache;
     PacketParser mPacketParser;
 
     void SetDiscoveryContext(DiscoveryContext * context);
@@ -303,9 +393,35 @@ private:
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+    /// Send the queries of the given attempts that are (or are not) first sends
+    /// in a single packet, followed by their known answers.
+    CHIP_ERROR SendQueries(const ActiveResolveAttempts::ScheduledAttempt * attempts, size_t attemptCount, bool firstSend);
+
+    /// Answer the given attempt from the record cache, as far as possible.
+    ///
+    /// Returns true if the attempt was completed, so no query is needed.
+    bool AnswerFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt);
+
+    /// Check if the SRV and TXT records of a service instance and the AAAA
+    /// records of its host are all cached.
+    template <typename Name>
+    bool IsResolvableFromCache(const Name & instanceName);
+
+    /// Resolve a service instance from the record cache if its records are
+    /// all cached, as if they had just been received.
+    template <typename Name>
+    void ResolveFromCache(const Name & instanceName);
+
+    /// Append the cached answers to the given attempt to a query, so that
+    /// responders leave them out.
+    void AddKnownAnswers(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
+
     /// Prepare a query for the given schedule attempt
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
+    /// Build the name that the given browse attempt queries
+    CHIP_ERROR BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data, mdns::Minimal::FullQName & qname);
+
     /// Prepare a query for specific resolve types
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data, bool firstSend);
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data, bool firstSend);
@@ -371,6 +487,13 @@ void MinMdnsResolver::AdvancePendingResolverStates()
 
         IncrementalResolver::RequiredInformationFlags missing = resolver->GetMissingRequiredInformation();
 
+        if (missing.Has(IncrementalResolver::RequiredInformationBitFlags::kIpAddress))
+        {
+            // The host may already be known, e.g. from another of its services.
+            mPacketParser.ParseCachedRecords(resolver->GetTargetHostName(), QType::AAAA);
+            missing = resolver->GetMissingRequiredInformation();
+        }
+
         if (missing.Has(IncrementalResolver::RequiredInformationBitFlags::kIpAddress))
         {
             ScheduleIpAddressResolve(resolver->GetTargetHostName());
@@ -502,13 +625,12 @@ bool MinMdnsResolver::IsInitialized()
 void MinMdnsResolver::Shutdown()
 {
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
+    mRecordCache.Clear();
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
-                                       bool firstSend)
+CHIP_ERROR MinMdnsResolver::BuildBrowseQName(const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                             mdns::Minimal::FullQName & qname)
 {
-    mdns::Minimal::FullQName qname;
-
     switch (data.type)
     {
     case DiscoveryType::kOperational:
@@ -549,6 +671,14 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     }
 
     ReturnErrorCodeIf(!qname.nameCount, CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+                                       bool firstSend)
+{
+    mdns::Minimal::FullQName qname;
+    ReturnErrorOnFailure(BuildBrowseQName(data, qname));
 
     mdns::Minimal::Query query(qname);
     query
@@ -629,7 +759,12 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
 
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
-    while (true)
+    // Attempts that are due are sent together: first sends, which ask for unicast
+    // replies, in one packet and retries in another.
+    ActiveResolveAttempts::ScheduledAttempt attempts[ActiveResolveAttempts::kRetryQueueSize];
+    size_t attemptCount = 0;
+
+    while (attemptCount < ArraySize(attempts))
     {
         Optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
 
@@ -638,27 +773,144 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+        if (AnswerFromCache(resolve.Value()))
+        {
+            continue;
+        }
+
+        attempts[attemptCount++] = resolve.Value();
+    }
 
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
+    ReturnErrorOnFailure(SendQueries(attempts, attemptCount, /* firstSend = */ true));
+    ReturnErrorOnFailure(SendQueries(attempts, attemptCount, /* firstSend = */ false));
 
-        ReturnErrorOnFailure(BuildQuery(builder, resolve.Value()));
+    ExpireIncrementalResolvers();
 
-        if (resolve.Value().firstSend)
+    return ScheduleRetries();
+}
+
+CHIP_ERROR MinMdnsResolver::SendQueries(const ActiveResolveAttempts::ScheduledAttempt * attempts, size_t attemptCount,
+                                        bool firstSend)
+{
+    QueryBuilder builder;
+    bool hasQueries = false;
+
+    for (size_t i = 0; i < attemptCount; i++)
+    {
+        if (attempts[i].firstSend != firstSend)
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
+            continue;
         }
-        else
+
+        if (!hasQueries)
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
+            System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+            ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+            builder.Reset(std::move(buffer));
+            builder.Header().SetMessageId(0);
+            hasQueries = true;
         }
+
+        ReturnErrorOnFailure(BuildQuery(builder, attempts[i]));
     }
 
-    ExpireIncrementalResolvers();
+    VerifyOrReturnError(hasQueries, CHIP_NO_ERROR);
 
-    return ScheduleRetries();
+    // Known answers follow all of the queries.
+    for (size_t i = 0; i < attemptCount; i++)
+    {
+        if (attempts[i].firstSend == firstSend)
+        {
+            AddKnownAnswers(builder, attempts[i]);
+        }
+    }
+
+    if (firstSend)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort);
+    }
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
+bool MinMdnsResolver::AnswerFromCache(const ActiveResolveAttempts::ScheduledAttempt & attempt)
+{
+    if (attempt.IsResolve())
+    {
+        char nameBuffer[kMaxOperationalServiceNameSize] = "";
+        VerifyOrReturnValue(MakeInstanceName(nameBuffer, sizeof(nameBuffer), attempt.ResolveData().peerId) == CHIP_NO_ERROR,
+                            false);
+
+        const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+        ResolveFromCache(FullQName(instanceQName));
+    }
+    else if (attempt.IsBrowse() && attempt.firstSend)
+    {
+        // Report the instances that are already known, which responders leave out
+        // of their replies as they are listed as known answers.
+        mdns::Minimal::FullQName qname;
+        VerifyOrReturnValue(BuildBrowseQName(attempt.BrowseData(), qname) == CHIP_NO_ERROR, false);
+
+        mRecordCache.ForEach(qname, QType::PTR, [this](const RecordCache::Record & record) {
+            SerializedQNameIterator instanceName;
+            if (ParsePtrRecord(record.data.GetData(), record.range, &instanceName))
+            {
+                ResolveFromCache(instanceName);
+            }
+        });
+    }
+
+    return !mActiveResolves.IsPending(attempt);
+}
+
+template <typename Name>
+bool MinMdnsResolver::IsResolvableFromCache(const Name & instanceName)
+{
+    bool resolvable = false;
+
+    mRecordCache.ForEach(instanceName, QType::SRV, [this, &instanceName, &resolvable](const RecordCache::Record & record) {
+        SrvRecord srv;
+        resolvable = srv.Parse(record.data.GetData(), record.range) && mRecordCache.Contains(srv.GetName(), QType::AAAA) &&
+            mRecordCache.Contains(instanceName, QType::TXT);
+    });
+
+    return resolvable;
+}
+
+template <typename Name>
+void MinMdnsResolver::ResolveFromCache(const Name & instanceName)
+{
+    // Anything missing needs a query, which gets all of the records again.
+    VerifyOrReturn(IsResolvableFromCache(instanceName));
+
+    mPacketParser.ParseCachedRecords(instanceName, QType::SRV);
+    mPacketParser.ParseCachedRecords(instanceName, QType::TXT);
+
+    // Takes the AAAA records from the cache as well.
+    AdvancePendingResolverStates();
+}
+
+void MinMdnsResolver::AddKnownAnswers(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt)
+{
+    // Resolves are only queried when some of their records are not cached, and
+    // then need all of them, so only browses have known answers.
+    VerifyOrReturn(attempt.IsBrowse());
+
+    mdns::Minimal::FullQName qname;
+    VerifyOrReturn(BuildBrowseQName(attempt.BrowseData(), qname) == CHIP_NO_ERROR);
+
+    mRecordCache.ForEach(qname, QType::PTR, [this, &builder](const RecordCache::Record & record) {
+        // RFC 6762 section 7.1: only list answers with more than half of their TTL left. Instances
+        // that are not fully cached are left out, so that their records are all sent again.
+        SerializedQNameIterator instanceName;
+        if ((record.remainingTtlSeconds > record.data.GetTtlSeconds() / 2) &&
+            ParsePtrRecord(record.data.GetData(), record.range, &instanceName) && IsResolvableFromCache(instanceName))
+        {
+            // Answers that do not fit are just not suppressed.
+            builder.AddAnswer(record.data, record.remainingTtlSeconds);
+        }
+    });
 }
 
 void MinMdnsResolver::ExpireIncrementalResolvers()
@@ -717,14 +969,47 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 {
     mActiveResolves.MarkPending(filter, type);
 
-    return SendAllPendingQueries();
+    // The query is sent once the retry timer fires right away, together with
+    // those of any other browse or resolve started before then.
+    return ScheduleRetries();
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
     mActiveResolves.MarkPending(peerId);
 
-    return SendAllPendingQueries();
+    // The query is sent once the retry timer fires right away, together with
+    // those of any other browse or resolve started before then.
+    return ScheduleRetries();
+}
+
+void MinMdnsResolver::ForgetCachedNode(const PeerId & peerId)
+{
+    char nameBuffer[kMaxOperationalServiceNameSize] = "";
+    VerifyOrReturn(MakeInstanceName(nameBuffer, sizeof(nameBuffer), peerId) == CHIP_NO_ERROR);
+
+    const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    const FullQName instanceName(instanceQName);
+
+    // The addresses of the host are the records most likely to be stale. Its name points into the cached SRV record, so
+    // that record is only removed after them.
+    SerializedQNameIterator hostName;
+    bool hasHostName = false;
+    mRecordCache.ForEach(instanceName, QType::SRV, [&](const RecordCache::Record & record) {
+        SrvRecord srv;
+        if (srv.Parse(record.data.GetData(), record.range))
+        {
+            hostName    = srv.GetName();
+            hasHostName = true;
+        }
+    });
+    if (hasHostName)
+    {
+        mRecordCache.Remove(hostName, QType::AAAA);
+    }
+
+    mRecordCache.Remove(instanceName, QType::SRV);
+    mRecordCache.Remove(instanceName, QType::TXT);
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
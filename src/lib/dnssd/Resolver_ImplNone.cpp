@@ -36,6 +36,7 @@ public:
         ChipLogError(Discovery, "Failed to resolve node ID: dnssd resolving not available");
         return CHIP_ERROR_NOT_IMPLEMENTED;
     }
+    void ForgetCachedNode(const PeerId & peerId) override {}
     void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) override
     {
         ChipLogError(Discovery, "Failed to stop resolving node ID: dnssd resolving not available");
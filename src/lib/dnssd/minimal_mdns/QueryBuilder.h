@@ -19,6 +19,7 @@
 
 #include <system/SystemPacketBuffer.h>
 
+#include <lib/dnssd/minimal_mdns/Parser.h>
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
 
@@ -81,6 +82,40 @@ public:
         return *this;
     }
 
+    /// Append a known answer (RFC 6762 section 7.1), so that responders do not
+    /// send it again, with the given TTL. Known answers follow all of the queries.
+    ///
+    /// The record data is copied as is, so any names within it must not be
+    /// compressed.
+    ///
+    /// Returns false, leaving the packet unchanged, if the answer does not fit.
+    bool AddAnswer(const ResourceData & record, uint32_t ttlSeconds)
+    {
+        if (!mQueryBuildOk)
+        {
+            return false;
+        }
+
+        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
+        RecordWriter writer(&out);
+
+        writer.WriteQName(record.GetName())
+            .Put16(static_cast<uint16_t>(record.GetType()))
+            .Put16(static_cast<uint16_t>(record.GetClass()))
+            .Put32(ttlSeconds)
+            .Put16(static_cast<uint16_t>(record.GetData().Size()))
+            .Put(record.GetData());
+
+        if (!writer.Fit())
+        {
+            return false;
+        }
+
+        mHeader.SetAnswerCount(static_cast<uint16_t>(mHeader.GetAnswerCount() + 1));
+        mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+        return true;
+    }
+
     bool Ok() const { return mQueryBuildOk; }
 
 private:
@@ -79,6 +79,9 @@ public:
 
     HeaderRef & Header() { return mHeader; }
 
+    /// The packet built so far. Only valid if HasPacketBuffer().
+    const chip::System::PacketBufferHandle & GetPacket() const { return mPacket; }
+
     /// Attempts to add a record to the currentsystem packet buffer.
     /// On success, the packet buffer data length is updated.
     /// On failure, the packet buffer data length is NOT updated and header is unchanged.
@@ -21,6 +21,8 @@
 
 #include <system/SystemClock.h>
 
+#include <string.h>
+
 namespace mdns {
 namespace Minimal {
 
@@ -50,10 +52,65 @@ bool ResponseSendingState::IncludeQuery() const
     return (mSource->SrcPort != kMdnsStandardPort);
 }
 
+bool CachedResponse::Set(const ResponseSendingState & state, const chip::System::PacketBufferHandle & packet)
+{
+    Clear();
+
+    const QueryData & query = *state.GetQuery();
+
+    // Keep the name uncompressed, as the query it is in goes away.
+    chip::Encoding::BigEndian::BufferWriter name(mName, sizeof(mName));
+    SerializedQNameIterator it = query.GetName();
+    while (it.Next())
+    {
+        name.Put8(static_cast<uint8_t>(strlen(it.Value()))).Put(it.Value());
+    }
+    name.Put8(0);
+    VerifyOrReturnValue(it.IsValid() && name.Fit(), false);
+
+    mPacket = chip::System::PacketBufferHandle::NewWithData(packet->Start(), packet->DataLength());
+    VerifyOrReturnValue(!mPacket.IsNull(), false);
+
+    mExpiryTime    = chip::System::SystemClock().GetMonotonicTimestamp() + kLifetime;
+    mInterfaceId   = state.GetSourceInterfaceId();
+    mType          = query.GetType();
+    mClass         = query.GetClass();
+    mUnicastAnswer = query.RequestedUnicastAnswer();
+    mIncludeQuery  = state.IncludeQuery();
+    mNameLength    = static_cast<uint8_t>(name.Needed());
+    return true;
+}
+
+bool CachedResponse::Matches(const ResponseSendingState & state) const
+{
+    VerifyOrReturnValue(IsInUse() && chip::System::SystemClock().GetMonotonicTimestamp() < mExpiryTime, false);
+
+    const QueryData & query = *state.GetQuery();
+    if ((query.GetType() != mType) || (query.GetClass() != mClass) || (query.RequestedUnicastAnswer() != mUnicastAnswer) ||
+        (state.IncludeQuery() != mIncludeQuery) || (state.GetSourceInterfaceId() != mInterfaceId))
+    {
+        return false;
+    }
+
+    return SerializedQNameIterator(BytesRange(mName, mName + mNameLength), mName) == query.GetName();
+}
+
+chip::System::PacketBufferHandle CachedResponse::CopyReply(uint16_t messageId) const
+{
+    chip::System::PacketBufferHandle reply = chip::System::PacketBufferHandle::NewWithData(mPacket->Start(), mPacket->DataLength());
+    if (!reply.IsNull())
+    {
+        HeaderRef(reply->Start()).SetMessageId(messageId);
+    }
+    return reply;
+}
+
 } // namespace Internal
 
 CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder)
 {
+    ClearResponseCache();
+
     // If already existing or we find a free slot, just use it
     // Note that dynamic memory implementations are never expected to be nullptr
     //
@@ -76,6 +133,8 @@ CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder
 
 CHIP_ERROR ResponseSender::RemoveQueryResponder(QueryResponderBase * queryResponder)
 {
+    ClearResponseCache();
+
     for (auto it = mResponders.begin(); it != mResponders.end(); it++)
     {
         if (*it == queryResponder)
@@ -107,6 +166,15 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
 {
     mSendState.Reset(messageId, query, querySource);
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    const bool cacheableReply = IsCacheableReply(configuration);
+    if (cacheableReply)
+    {
+        CHIP_ERROR err = SendCachedReply();
+        VerifyOrReturnError(err == CHIP_ERROR_NOT_FOUND, err);
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
     if (query.IsAnnounceBroadcast())
     {
         // Deny listing large amount of data
@@ -195,9 +263,66 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         }
     }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    if (cacheableReply)
+    {
+        CacheReply();
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
     return FlushReply();
 }
 
+void ResponseSender::ClearResponseCache()
+{
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    for (auto & cachedResponse : mCachedResponses)
+    {
+        cachedResponse.Clear();
+    }
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+}
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+bool ResponseSender::IsCacheableReply(const ResponseConfiguration & configuration) const
+{
+    // Multicast replies leave out the records multicast within the last second, so they are
+    // not the same from one query to the next. Announcements and TTL overrides are one-offs.
+    return mSendState.SendUnicast() && !mSendState.GetQuery()->IsAnnounceBroadcast() &&
+        !configuration.GetTtlSecondsOverride().HasValue();
+}
+
+CHIP_ERROR ResponseSender::SendCachedReply()
+{
+    for (const auto & cachedResponse : mCachedResponses)
+    {
+        if (!cachedResponse.Matches(mSendState))
+        {
+            continue;
+        }
+
+        chip::System::PacketBufferHandle reply = cachedResponse.CopyReply(mSendState.GetMessageId());
+        ReturnErrorCodeIf(reply.IsNull(), CHIP_ERROR_NO_MEMORY);
+        return mServer->DirectSend(std::move(reply), mSendState.GetSourceAddress(), mSendState.GetSourcePort(),
+                                   mSendState.GetSourceInterfaceId());
+    }
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+void ResponseSender::CacheReply()
+{
+    // Only replies that fit a single packet are kept.
+    VerifyOrReturn(!mSendState.IsSplitReply() && mResponseBuilder.HasPacketBuffer() && mResponseBuilder.HasResponseRecords());
+
+    if (mCachedResponses[mNextCachedResponse].Set(mSendState, mResponseBuilder.GetPacket()))
+    {
+        mNextCachedResponse = (mNextCachedResponse + 1) % CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE;
+    }
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 CHIP_ERROR ResponseSender::FlushReply()
 {
     ReturnErrorCodeIf(!mResponseBuilder.HasPacketBuffer(), CHIP_NO_ERROR); // nothing to flush
@@ -308,6 +433,7 @@ void ResponseSender::AddResponse(const ResourceRecord & record)
     if (!mResponseBuilder.Ok())
     {
         mResponseBuilder.Header().SetFlags(mResponseBuilder.Header().GetFlags().SetTruncated(true));
+        mSendState.MarkSplitReply();
 
         ReturnOnFailure(mSendState.SetError(FlushReply()));
         ReturnOnFailure(mSendState.SetError(PrepareNewReplyPacket()));
@@ -23,6 +23,7 @@
 
 #include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
 
+#include <system/SystemClock.h>
 #include <system/SystemPacketBuffer.h>
 
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
@@ -78,6 +79,7 @@ public:
         mSource       = packet;
         mSendError    = CHIP_NO_ERROR;
         mResourceType = ResourceType::kAnswer;
+        mSplitReply   = false;
         mSentItems.ClearAll();
     }
 
@@ -110,15 +112,66 @@ public:
     bool GetWasSent(ResponseItemsSent item) const { return mSentItems.Has(item); }
     void MarkWasSent(ResponseItemsSent item) { mSentItems.Set(item); }
 
+    /// Check if the reply was split over several packets
+    bool IsSplitReply() const { return mSplitReply; }
+    void MarkSplitReply() { mSplitReply = true; }
+
 private:
     const QueryData * mQuery                 = nullptr;               // query being replied to
     const chip::Inet::IPPacketInfo * mSource = nullptr;               // Where to send the reply (if unicast)
     uint16_t mMessageId                      = 0;                     // message id for the reply
     ResourceType mResourceType               = ResourceType::kAnswer; // what is being sent right now
     CHIP_ERROR mSendError                    = CHIP_NO_ERROR;
+    bool mSplitReply                         = false;                 // a truncated packet was already sent
     chip::BitFlags<ResponseItemsSent> mSentItems;
 };
 
+/// A unicast reply as it was sent, kept to be sent again for the same query.
+///
+/// Replies only depend on the query, on the interface it was received on (for
+/// the IP addresses) and on the configured responders, so a reply can be
+/// reused until the responders change. The IP addresses of the interface may
+/// change without notice though, so a reply is only reused for kLifetime.
+class CachedResponse
+{
+public:
+    /// Long enough for the retries of a query and the queries of controllers
+    /// reconnecting at once, short enough for address changes to be seen soon.
+    static constexpr chip::System::Clock::Seconds16 kLifetime = chip::System::Clock::Seconds16(5);
+
+    bool IsInUse() const { return !mPacket.IsNull(); }
+    void Clear() { mPacket = nullptr; }
+
+    /// Keep a copy of [packet], the reply to the query being replied to in [state].
+    ///
+    /// Returns false (and keeps nothing) if the query name is too long to be
+    /// kept or the packet cannot be copied.
+    bool Set(const ResponseSendingState & state, const chip::System::PacketBufferHandle & packet);
+
+    /// Check if this is the reply to the query being replied to in [state],
+    /// kept less than kLifetime ago.
+    bool Matches(const ResponseSendingState & state) const;
+
+    /// Make a copy of the reply to send, for the query with the given message id.
+    ///
+    /// Returns a null handle on allocation failure.
+    chip::System::PacketBufferHandle CopyReply(uint16_t messageId) const;
+
+private:
+    // Operational instance names, the longest Matter names, take 54 bytes.
+    static constexpr size_t kMaxNameLength = 64;
+
+    chip::System::PacketBufferHandle mPacket; // null if unused
+    chip::System::Clock::Timestamp mExpiryTime;
+    chip::Inet::InterfaceId mInterfaceId;
+    QType mType         = QType::ANY;
+    QClass mClass       = QClass::ANY;
+    bool mUnicastAnswer = false;
+    bool mIncludeQuery  = false;
+    uint8_t mNameLength = 0;
+    uint8_t mName[kMaxNameLength]; // uncompressed query name
+};
+
 } // namespace Internal
 
 /// Sends responses to mDNS queries.
@@ -138,6 +191,12 @@ public:
     CHIP_ERROR Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                        const ResponseConfiguration & configuration);
 
+    /// Drop all replies kept for repeated queries.
+    ///
+    /// Must be called whenever the data of a registered query responder
+    /// changes. Adding or removing query responders does this already.
+    void ClearResponseCache();
+
     // Implementation of ResponderDelegate
     void AddResponse(const ResourceRecord & record) override;
     bool ShouldSend(const Responder &) const override;
@@ -149,12 +208,31 @@ private:
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    /// Check if the reply being sent can be kept for repeated queries.
+    bool IsCacheableReply(const ResponseConfiguration & configuration) const;
+
+    /// Send a kept reply to the current query, if there is one.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND if no reply was kept for the query.
+    CHIP_ERROR SendCachedReply();
+
+    /// Keep a copy of the reply being built before it is flushed.
+    void CacheReply();
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
     ServerBase * mServer;
     QueryResponderPtrPool mResponders = {};
 
     /// Current send state
     ResponseBuilder mResponseBuilder;          // packet being built
     Internal::ResponseSendingState mSendState; // sending state
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    /// Unicast replies kept for repeated queries, replaced in a round-robin fashion
+    Internal::CachedResponse mCachedResponses[CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE];
+    size_t mNextCachedResponse = 0;
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
 };
 
 } // namespace Minimal
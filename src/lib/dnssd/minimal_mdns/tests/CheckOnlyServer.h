@@ -90,6 +90,7 @@ public:
     {
         NL_TEST_ASSERT(mInSuite, header.GetFlags().IsResponse());
         NL_TEST_ASSERT(mInSuite, header.GetFlags().IsValidMdns());
+        mMessageId = header.GetMessageId();
         mTotalRecords += header.GetAnswerCount() + header.GetAdditionalCount();
 
         if (!header.GetFlags().IsTruncated())
@@ -272,6 +273,7 @@ public:
     }
     bool GetSendCalled() { return mSendCalled; }
     bool GetHeaderFound() { return mHeaderFound; }
+    uint16_t GetMessageId() { return mMessageId; }
     void SetTestSuite(nlTestSuite * suite) { mInSuite = suite; }
     void Reset()
     {
@@ -317,6 +319,7 @@ private:
     size_t mNumReceivedTxtRecords = 0;
     bool mHeaderFound             = false;
     bool mSendCalled              = false;
+    uint16_t mMessageId           = 0;
     int mTotalRecords             = 0;
     FullQName kIgnoreQname        = FullQName(kIgnoreQNameParts);
     BytesRange mPacketData;
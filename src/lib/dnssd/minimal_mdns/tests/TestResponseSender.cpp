@@ -344,6 +344,90 @@ void PtrSrvTxtMultipleRespondersToServiceListing(nlTestSuite * inSuite, void * i
     NL_TEST_ASSERT(inSuite, common1->server.GetHeaderFound());
 }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+void SrvTxtAnyResponseToRepeatedQuery(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+
+    // Build a query for the instance name, asking for a unicast reply
+    common.recordWriter.WriteQName(common.instance);
+    common.packetInfo.Clear();
+    common.packetInfo.SrcPort = 5353;
+
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+    NL_TEST_ASSERT(inSuite, common.server.GetMessageId() == 1);
+
+    // The reply is kept, so changes to the responders are only seen once the kept replies are cleared.
+    common.queryResponder.AddResponder(&common.txtResponder);
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+    NL_TEST_ASSERT(inSuite, common.server.GetMessageId() == 2);
+
+    responseSender.ClearResponseCache();
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(3, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+
+    // Another query for the same name gets its own reply.
+    QueryData srvQueryData = QueryData(QType::SRV, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(4, srvQueryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+}
+
+void SrvTxtAnyResponseToRepeatedQueryAfterLifetime(nlTestSuite * inSuite, void * inContext)
+{
+    chip::System::Clock::Internal::MockClock mockClock;
+    chip::System::Clock::ClockBase * realClock = &chip::System::SystemClock();
+    chip::System::Clock::Internal::SetSystemClockForTesting(&mockClock);
+
+    CommonTestElements common(inSuite, "test");
+    ResponseSender responseSender(&common.server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    common.packetInfo.Clear();
+    common.packetInfo.SrcPort = 5353;
+
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, true, common.requestNameStart, common.requestBytesRange);
+
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+
+    // The reply is kept for a little while...
+    common.queryResponder.AddResponder(&common.txtResponder);
+    mockClock.AdvanceMonotonic(mdns::Minimal::Internal::CachedResponse::kLifetime - chip::System::Clock::Milliseconds64(1));
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+
+    // ...and then built again, e.g. with the current IP addresses of the interface.
+    mockClock.AdvanceMonotonic(chip::System::Clock::Milliseconds64(1));
+    common.server.Reset();
+    common.server.AddExpectedRecord(&common.srvRecord);
+    common.server.AddExpectedRecord(&common.txtRecord);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(3, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, common.server.GetHeaderFound());
+
+    chip::System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 const nlTest sTests[] = {
     NL_TEST_DEF("SrvAnyResponseToInstance", SrvAnyResponseToInstance),                                       //
     NL_TEST_DEF("SrvTxtAnyResponseToInstance", SrvTxtAnyResponseToInstance),                                 //
@@ -355,6 +439,10 @@ const nlTest sTests[] = {
     NL_TEST_DEF("AddManyQueryResponders", AddManyQueryResponders),                                           //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToInstance", PtrSrvTxtMultipleRespondersToInstance),             //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToServiceListing", PtrSrvTxtMultipleRespondersToServiceListing), //
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    NL_TEST_DEF("SrvTxtAnyResponseToRepeatedQuery", SrvTxtAnyResponseToRepeatedQuery),                           //
+    NL_TEST_DEF("SrvTxtAnyResponseToRepeatedQueryAfterLifetime", SrvTxtAnyResponseToRepeatedQueryAfterLifetime), //
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
 
     NL_TEST_SENTINEL() //
 };
@@ -58,6 +58,8 @@ void TestSinglePeerAddRemove(nlTestSuite * inSuite, void * inContext)
 
     attempts.MarkPending(MakePeerId(1));
 
+    NL_TEST_ASSERT(inSuite, attempts.IsPending(ScheduledPeer(1, true).Value()));
+    NL_TEST_ASSERT(inSuite, !attempts.IsPending(ScheduledPeer(2, true).Value()));
     NL_TEST_ASSERT(inSuite, attempts.GetTimeUntilNextExpectedResponse() == Optional<Timeout>(0_ms32));
     NL_TEST_ASSERT(inSuite, attempts.NextScheduled() == ScheduledPeer(1, true));
     NL_TEST_ASSERT(inSuite, !attempts.NextScheduled().HasValue());
@@ -82,6 +84,7 @@ void TestSinglePeerAddRemove(nlTestSuite * inSuite, void * inContext)
 
     // once complete, nothing to schedule
     attempts.Complete(MakePeerId(1));
+    NL_TEST_ASSERT(inSuite, !attempts.IsPending(ScheduledPeer(1, false).Value()));
     NL_TEST_ASSERT(inSuite, !attempts.GetTimeUntilNextExpectedResponse().HasValue());
     NL_TEST_ASSERT(inSuite, !attempts.NextScheduled().HasValue());
 }
@@ -0,0 +1,390 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/RecordCache.h>
+
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/core/tests/QNameStrings.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+const auto kServiceName  = testing::TestQName<3>({ "_matter", "_tcp", "local" });
+const auto kInstanceName = testing::TestQName<4>({ "1234567898765432-ABCDEFEDCBAABCDE", "_matter", "_tcp", "local" });
+const auto kHostName     = testing::TestQName<2>({ "abcd", "local" });
+const auto kOtherHost    = testing::TestQName<2>({ "efgh", "local" });
+
+/// Packet parser delegate that caches every resource of a packet.
+class CachingDelegate : public ParserDelegate
+{
+public:
+    CachingDelegate(RecordCache & cache, const BytesRange & packet) : mCache(cache), mPacket(packet) {}
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        mCachedCount += mCache.Add(Inet::InterfaceId::Null(), data, mPacket) ? 1 : 0;
+    }
+
+    size_t CachedCount() const { return mCachedCount; }
+
+private:
+    RecordCache & mCache;
+    BytesRange mPacket;
+    size_t mCachedCount = 0;
+};
+
+/// Writes the given records into a single packet, so that the names within it
+/// are compressed, and caches all of them.
+template <typename... Records>
+void AddRecords(nlTestSuite * inSuite, RecordCache & cache, const Records &... records)
+{
+    uint8_t packetBuffer[512] = {};
+    HeaderRef header(packetBuffer);
+    header.SetFlags(header.GetFlags().SetResponse());
+
+    // Compression pointers are offsets from the start of the packet, so the writer covers the header too.
+    Encoding::BigEndian::BufferWriter output(packetBuffer, sizeof(packetBuffer));
+    output.Skip(HeaderRef::kSizeBytes);
+    RecordWriter writer(&output);
+    for (const ResourceRecord * record : { static_cast<const ResourceRecord *>(&records)... })
+    {
+        NL_TEST_ASSERT(inSuite, record->Append(header, ResourceType::kAnswer, writer));
+    }
+
+    BytesRange packet(packetBuffer, packetBuffer + output.Needed());
+    CachingDelegate delegate(cache, packet);
+    NL_TEST_ASSERT(inSuite, ParsePacket(packet, &delegate));
+    NL_TEST_ASSERT(inSuite, delegate.CachedCount() == sizeof...(records));
+}
+
+size_t CountRecords(RecordCache & cache, const FullQName & name, QType type)
+{
+    size_t count = 0;
+    cache.ForEach(name, type, [&count](const RecordCache::Record &) { count++; });
+    return count;
+}
+
+Inet::IPAddress MakeAddress(const char * text)
+{
+    Inet::IPAddress address;
+    Inet::IPAddress::FromString(text, address);
+    return address;
+}
+
+void TestAddAndFind(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    const char * txtEntries[] = { "SII=5000", "SAI=300" };
+    AddRecords(inSuite, cache, PtrResourceRecord(kServiceName.Full(), kInstanceName.Full()),
+               SrvResourceRecord(kInstanceName.Full(), kHostName.Full(), 5540),
+               TxtResourceRecord(kInstanceName.Full(), txtEntries),
+               IPResourceRecord(kHostName.Full(), MakeAddress("fe80::1")));
+
+    // Names within the data were compressed in the packet, but can be read from the cache on their own.
+    size_t found = 0;
+    cache.ForEach(kServiceName.Full(), QType::PTR, [&](const RecordCache::Record & record) {
+        SerializedQNameIterator target;
+        NL_TEST_ASSERT(inSuite, ParsePtrRecord(record.data.GetData(), record.range, &target));
+        NL_TEST_ASSERT(inSuite, target == kInstanceName.Full());
+        found++;
+    });
+    NL_TEST_ASSERT(inSuite, found == 1);
+
+    found = 0;
+    cache.ForEach(kInstanceName.Full(), QType::SRV, [&](const RecordCache::Record & record) {
+        SrvRecord srv;
+        NL_TEST_ASSERT(inSuite, srv.Parse(record.data.GetData(), record.range));
+        NL_TEST_ASSERT(inSuite, srv.GetName() == kHostName.Full());
+        NL_TEST_ASSERT(inSuite, srv.GetPort() == 5540);
+        NL_TEST_ASSERT(inSuite, record.remainingTtlSeconds == ResourceRecord::kDefaultTtl);
+        found++;
+    });
+    NL_TEST_ASSERT(inSuite, found == 1);
+
+    found = 0;
+    cache.ForEach(kHostName.Serialized(), QType::AAAA, [&](const RecordCache::Record & record) {
+        Inet::IPAddress address;
+        NL_TEST_ASSERT(inSuite, ParseAAAARecord(record.data.GetData(), &address));
+        NL_TEST_ASSERT(inSuite, address == MakeAddress("fe80::1"));
+        found++;
+    });
+    NL_TEST_ASSERT(inSuite, found == 1);
+
+    NL_TEST_ASSERT(inSuite, cache.Contains(kInstanceName.Full(), QType::TXT));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(kInstanceName.Full(), QType::AAAA));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(kOtherHost.Full(), QType::AAAA));
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, !cache.Contains(kInstanceName.Full(), QType::SRV));
+}
+
+void TestExpiry(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    mockClock.AdvanceMonotonic(1234_ms32);
+    AddRecords(inSuite, cache, SrvResourceRecord(kInstanceName.Full(), kHostName.Full(), 5540).SetTtl(120));
+
+    mockClock.AdvanceMonotonic(60_s);
+    cache.ForEach(kInstanceName.Full(), QType::SRV, [&](const RecordCache::Record & record) {
+        NL_TEST_ASSERT(inSuite, record.remainingTtlSeconds == 60);
+        NL_TEST_ASSERT(inSuite, record.data.GetTtlSeconds() == 120);
+    });
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kInstanceName.Full(), QType::SRV) == 1);
+
+    mockClock.AdvanceMonotonic(60_s);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kInstanceName.Full(), QType::SRV) == 0);
+}
+
+void TestReplaceAndRemove(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    // A service has a single SRV record, so a new one replaces the cached one.
+    AddRecords(inSuite, cache, SrvResourceRecord(kInstanceName.Full(), kHostName.Full(), 5540));
+    AddRecords(inSuite, cache, SrvResourceRecord(kInstanceName.Full(), kOtherHost.Full(), 5541));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kInstanceName.Full(), QType::SRV) == 1);
+    cache.ForEach(kInstanceName.Full(), QType::SRV, [&](const RecordCache::Record & record) {
+        SrvRecord srv;
+        NL_TEST_ASSERT(inSuite, srv.Parse(record.data.GetData(), record.range));
+        NL_TEST_ASSERT(inSuite, srv.GetName() == kOtherHost.Full());
+        NL_TEST_ASSERT(inSuite, srv.GetPort() == 5541);
+    });
+
+    // A host may have several addresses, and the same one is only cached once.
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fe80::1")),
+               IPResourceRecord(kHostName.Full(), MakeAddress("fd00::1")));
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fe80::1")));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 2);
+
+    // A TTL of 0 removes a record.
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fe80::1")).SetTtl(0));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 1);
+    AddRecords(inSuite, cache, SrvResourceRecord(kInstanceName.Full(), kOtherHost.Full(), 5541).SetTtl(0));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kInstanceName.Full(), QType::SRV) == 0);
+
+    // Remove() drops all the records of a name and type.
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fd00::2")),
+               IPResourceRecord(kOtherHost.Full(), MakeAddress("fd00::3")));
+    cache.Remove(kHostName.Full(), QType::AAAA);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 0);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kOtherHost.Full(), QType::AAAA) == 1);
+}
+
+void TestCacheFlush(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fd00::1")),
+               IPResourceRecord(kHostName.Full(), MakeAddress("fd00::2")),
+               IPResourceRecord(kOtherHost.Full(), MakeAddress("fd00::3")));
+    mockClock.AdvanceMonotonic(10_s);
+
+    // The host moved: its new addresses flush the old ones a second later, but not each other or those of other hosts.
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fd00::4")).SetCacheFlush(true),
+               IPResourceRecord(kHostName.Full(), MakeAddress("fd00::5")).SetCacheFlush(true));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 4);
+
+    mockClock.AdvanceMonotonic(500_ms32);
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fd00::6")).SetCacheFlush(true));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 5);
+
+    mockClock.AdvanceMonotonic(500_ms32);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 3);
+    cache.ForEach(kHostName.Full(), QType::AAAA, [&](const RecordCache::Record & record) {
+        Inet::IPAddress address;
+        NL_TEST_ASSERT(inSuite, ParseAAAARecord(record.data.GetData(), &address));
+        NL_TEST_ASSERT(inSuite, address != MakeAddress("fd00::1") && address != MakeAddress("fd00::2"));
+    });
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kOtherHost.Full(), QType::AAAA) == 1);
+
+    // A record sent again with the cache-flush bit keeps its full TTL.
+    mockClock.AdvanceMonotonic(10_s);
+    AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), MakeAddress("fd00::4")).SetCacheFlush(true));
+    mockClock.AdvanceMonotonic(1_s);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == 1);
+    cache.ForEach(kHostName.Full(), QType::AAAA, [&](const RecordCache::Record & record) {
+        NL_TEST_ASSERT(inSuite, record.remainingTtlSeconds == ResourceRecord::kDefaultTtl - 1);
+    });
+}
+
+void TestFullCache(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    // Fill the cache with addresses, the first one closest to expiring.
+    for (size_t i = 0; i < RecordCache::kCacheSize; i++)
+    {
+        uint8_t bytes[16] = { 0xfd };
+        bytes[14]         = static_cast<uint8_t>(i >> 8);
+        bytes[15]         = static_cast<uint8_t>(i);
+        Inet::IPAddress address;
+        memcpy(address.Addr, bytes, sizeof(bytes));
+        AddRecords(inSuite, cache, IPResourceRecord(kHostName.Full(), address).SetTtl(static_cast<uint32_t>(100 + i)));
+    }
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == RecordCache::kCacheSize);
+
+    AddRecords(inSuite, cache, SrvResourceRecord(kInstanceName.Full(), kHostName.Full(), 5540));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kInstanceName.Full(), QType::SRV) == 1);
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, kHostName.Full(), QType::AAAA) == RecordCache::kCacheSize - 1);
+    cache.ForEach(kHostName.Full(), QType::AAAA, [&](const RecordCache::Record & record) {
+        NL_TEST_ASSERT(inSuite, record.data.GetTtlSeconds() != 100);
+    });
+}
+
+void TestManyNames(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    // More names than buckets in use, so that some share a bucket, each found by its own name in any case.
+    char hostNames[RecordCache::kCacheSize][16];
+    for (size_t i = 0; i < RecordCache::kCacheSize; i++)
+    {
+        snprintf(hostNames[i], sizeof(hostNames[i]), "Host%u", static_cast<unsigned>(i));
+        const char * hostQName[] = { hostNames[i], "local" };
+        AddRecords(inSuite, cache, IPResourceRecord(FullQName(hostQName), MakeAddress("fd00::1")));
+    }
+
+    for (size_t i = 0; i < RecordCache::kCacheSize; i++)
+    {
+        // Names are compared case-insensitively, so they hash that way too.
+        char lowerCaseName[sizeof(hostNames[i])];
+        snprintf(lowerCaseName, sizeof(lowerCaseName), "host%u", static_cast<unsigned>(i));
+        const char * hostQName[] = { lowerCaseName, "local" };
+        NL_TEST_ASSERT(inSuite, CountRecords(cache, FullQName(hostQName), QType::AAAA) == 1);
+    }
+
+    // Removing a record of a shared bucket leaves the others.
+    const char * firstQName[] = { hostNames[0], "local" };
+    AddRecords(inSuite, cache, IPResourceRecord(FullQName(firstQName), MakeAddress("fd00::1")).SetTtl(0));
+    NL_TEST_ASSERT(inSuite, CountRecords(cache, FullQName(firstQName), QType::AAAA) == 0);
+    for (size_t i = 1; i < RecordCache::kCacheSize; i++)
+    {
+        const char * hostQName[] = { hostNames[i], "local" };
+        NL_TEST_ASSERT(inSuite, CountRecords(cache, FullQName(hostQName), QType::AAAA) == 1);
+    }
+
+    // Once expired, the records are replaced by new ones rather than kept along with them.
+    mockClock.AdvanceMonotonic(System::Clock::Seconds32(ResourceRecord::kDefaultTtl + 1));
+    for (size_t i = 0; i < RecordCache::kCacheSize; i++)
+    {
+        const char * hostQName[] = { hostNames[i], "local" };
+        AddRecords(inSuite, cache, IPResourceRecord(FullQName(hostQName), MakeAddress("fd00::2")));
+    }
+    for (size_t i = 0; i < RecordCache::kCacheSize; i++)
+    {
+        const char * hostQName[] = { hostNames[i], "local" };
+        NL_TEST_ASSERT(inSuite, CountRecords(cache, FullQName(hostQName), QType::AAAA) == 1);
+    }
+}
+
+void TestKnownAnswers(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    AddRecords(inSuite, cache, PtrResourceRecord(kServiceName.Full(), kInstanceName.Full()).SetTtl(4500));
+    mockClock.AdvanceMonotonic(500_s);
+
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(512);
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+    QueryBuilder builder(std::move(buffer));
+    builder.AddQuery(Query(kServiceName.Full()).SetType(QType::PTR));
+    cache.ForEach(kServiceName.Full(), QType::PTR, [&](const RecordCache::Record & record) {
+        NL_TEST_ASSERT(inSuite, builder.AddAnswer(record.data, record.remainingTtlSeconds));
+    });
+    NL_TEST_ASSERT(inSuite, builder.Ok());
+
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+    BytesRange range(packet->Start(), packet->Start() + packet->DataLength());
+    ConstHeaderRef header(packet->Start());
+    NL_TEST_ASSERT(inSuite, header.GetQueryCount() == 1);
+    NL_TEST_ASSERT(inSuite, header.GetAnswerCount() == 1);
+
+    // The answer follows the query, with the remaining TTL.
+    QueryData query;
+    ResourceData answer;
+    const uint8_t * position = packet->Start() + HeaderRef::kSizeBytes;
+    NL_TEST_ASSERT(inSuite, query.Parse(range, &position));
+    NL_TEST_ASSERT(inSuite, answer.Parse(range, &position));
+    NL_TEST_ASSERT(inSuite, answer.GetName() == kServiceName.Full());
+    NL_TEST_ASSERT(inSuite, answer.GetTtlSeconds() == 4000);
+
+    SerializedQNameIterator target;
+    NL_TEST_ASSERT(inSuite, ParsePtrRecord(answer.GetData(), range, &target));
+    NL_TEST_ASSERT(inSuite, target == kInstanceName.Full());
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
+const nlTest sTests[] = {
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    NL_TEST_DEF("TestAddAndFind", TestAddAndFind),             //
+    NL_TEST_DEF("TestExpiry", TestExpiry),                     //
+    NL_TEST_DEF("TestReplaceAndRemove", TestReplaceAndRemove), //
+    NL_TEST_DEF("TestCacheFlush", TestCacheFlush),             //
+    NL_TEST_DEF("TestFullCache", TestFullCache),               //
+    NL_TEST_DEF("TestManyNames", TestManyNames),               //
+    NL_TEST_DEF("TestKnownAnswers", TestKnownAnswers),         //
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    NL_TEST_SENTINEL()                                         //
+};
+
+int TestSetup(void * inContext)
+{
+    return Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestRecordCache()
+{
+    nlTestSuite theSuite = { "RecordCache", sTests, TestSetup, TestTeardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRecordCache)
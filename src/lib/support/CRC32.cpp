@@ -0,0 +1,64 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the CRC-32 checksum, one table lookup per byte.
+ *
+ */
+
+#include <lib/support/CRC32.h>
+
+#include <array>
+
+namespace chip {
+
+namespace {
+
+// Reflected form of the CRC-32 polynomial 0x04C11DB7.
+constexpr uint32_t kPolynomial = 0xEDB88320;
+
+constexpr std::array<uint32_t, 256> MakeCrc32Table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kCrc32Table = MakeCrc32Table();
+
+} // namespace
+
+uint32_t Crc32(const uint8_t * data, size_t length, uint32_t crc)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = (crc >> 8) ^ kCrc32Table[(crc ^ data[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+} // namespace chip
@@ -0,0 +1,47 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a function computing the CRC-32 checksum of a
+ *      buffer, for detecting torn or corrupted records in persisted data.
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+
+/**
+ *  Computes the CRC-32 (as used by Ethernet, zlib and PNG) of a buffer.
+ *
+ *  A CRC over several buffers is computed by passing the CRC of the
+ *  preceding ones as @a crc.
+ *
+ *  @param[in] data    The bytes to checksum.
+ *  @param[in] length  The number of bytes at @a data.
+ *  @param[in] crc     The CRC of the data preceding @a data, 0 if none.
+ *
+ *  @return The CRC-32 of the data preceding @a data followed by @a data.
+ *
+ */
+uint32_t Crc32(const uint8_t * data, size_t length, uint32_t crc = 0);
+
+} // namespace chip
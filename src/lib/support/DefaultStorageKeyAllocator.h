@@ -121,6 +121,10 @@ public:
     {
         return StorageKeyName::Formatted("g/s/%s", resumptionIdBase64);
     }
+    static StorageKeyName SessionResumptionPage(size_t page)
+    {
+        return StorageKeyName::Formatted("g/srp/%x", static_cast<unsigned>(page));
+    }
 
     // Access Control
     static StorageKeyName AccessControlAclEntry(FabricIndex fabric, size_t index)
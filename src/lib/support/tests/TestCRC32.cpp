@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <string.h>
+
+#include <lib/support/CRC32.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+
+const uint8_t * Bytes(const char * string)
+{
+    return reinterpret_cast<const uint8_t *>(string);
+}
+
+void TestCrc32KnownValues(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, Crc32(nullptr, 0) == 0);
+    NL_TEST_ASSERT(inSuite, Crc32(Bytes("a"), 1) == 0xE8B7BE43);
+    NL_TEST_ASSERT(inSuite, Crc32(Bytes("123456789"), 9) == 0xCBF43926);
+
+    const char * fox = "The quick brown fox jumps over the lazy dog";
+    NL_TEST_ASSERT(inSuite, Crc32(Bytes(fox), strlen(fox)) == 0x414FA339);
+}
+
+void TestCrc32Incremental(nlTestSuite * inSuite, void * inContext)
+{
+    const char * fox = "The quick brown fox jumps over the lazy dog";
+    size_t length    = strlen(fox);
+
+    for (size_t split = 0; split <= length; split++)
+    {
+        uint32_t crc = Crc32(Bytes(fox), split);
+        crc          = Crc32(Bytes(fox) + split, length - split, crc);
+        NL_TEST_ASSERT(inSuite, crc == 0x414FA339);
+    }
+}
+
+void TestCrc32DetectsChanges(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t data[64];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    const uint32_t crc = Crc32(data, sizeof(data));
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        for (int bit = 0; bit < 8; bit++)
+        {
+            data[i] = static_cast<uint8_t>(data[i] ^ (1 << bit));
+            NL_TEST_ASSERT(inSuite, Crc32(data, sizeof(data)) != crc);
+            data[i] = static_cast<uint8_t>(data[i] ^ (1 << bit));
+        }
+    }
+    NL_TEST_ASSERT(inSuite, Crc32(data, sizeof(data) - 1) != crc);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestCrc32KnownValues", TestCrc32KnownValues),       //
+    NL_TEST_DEF("TestCrc32Incremental", TestCrc32Incremental),       //
+    NL_TEST_DEF("TestCrc32DetectsChanges", TestCrc32DetectsChanges), //
+    NL_TEST_SENTINEL()                                               //
+};
+
+} // namespace
+
+int TestCRC32()
+{
+    nlTestSuite theSuite = { "CRC32", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCRC32)
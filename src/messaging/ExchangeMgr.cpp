@@ -59,7 +59,7 @@ namespace Messaging {
  *    prior to use.
  *
  */
-ExchangeManager::ExchangeManager() : mReliableMessageMgr(mContextPool)
+ExchangeManager::ExchangeManager()
 {
     mState = State::kState_NotInitialized;
 }
@@ -75,13 +75,10 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
     mNextExchangeId = chip::Crypto::GetRandU16();
     mNextKeyId      = 0;
 
-    for (auto & handler : UMHandlerPool)
-    {
-        // Mark all handlers as unallocated.  This handles both initial
-        // initialization and the case when the consumer shuts us down and
-        // then re-initializes without removing registered handlers.
-        handler.Reset();
-    }
+    // Mark all handlers as unallocated.  This handles both initial
+    // initialization and the case when the consumer shuts us down and
+    // then re-initializes without removing registered handlers.
+    mUMHandlerCount = 0;
 
     sessionManager->SetMessageDelegate(this);
 
@@ -115,7 +112,54 @@ ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, Exc
         ChipLogError(ExchangeManager, "NewContext failed: session inactive");
         return nullptr;
     }
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, isInitiator, delegate);
+    return CreateContext(mNextExchangeId++, session, isInitiator, delegate);
+}
+
+ExchangeContext * ExchangeManager::CreateContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                                 ExchangeDelegate * delegate, bool isEphemeralExchange)
+{
+    ExchangeContext * ec = mContextPool.CreateObject(this, exchangeId, session, isInitiator, delegate, isEphemeralExchange);
+    if (ec != nullptr)
+    {
+        ExchangeContext *& head = mExchangeIndex[ExchangeIndexBucket(exchangeId, isInitiator)];
+        ec->mNextInExchangeIndex = head;
+        head                     = ec;
+    }
+    return ec;
+}
+
+void ExchangeManager::ReleaseContext(ExchangeContext * ec)
+{
+    ExchangeContext ** link = &mExchangeIndex[ExchangeIndexBucket(ec->GetExchangeId(), ec->IsInitiator())];
+    while (*link != ec)
+    {
+        VerifyOrDie(*link != nullptr);
+        link = &(*link)->mNextInExchangeIndex;
+    }
+    *link = ec->mNextInExchangeIndex;
+
+    mContextPool.ReleaseObject(ec);
+}
+
+size_t ExchangeManager::ExchangeIndexBucket(uint16_t exchangeId, bool isInitiator)
+{
+    // Exchange IDs are allocated sequentially by each node, so their low bits spread exchanges over the buckets.
+    return ((static_cast<size_t>(exchangeId) << 1) | (isInitiator ? 1u : 0u)) % CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS;
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    // A message sent by the initiator of an exchange belongs to the responder's context, and vice versa.
+    for (ExchangeContext * ec = mExchangeIndex[ExchangeIndexBucket(payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator())];
+         ec != nullptr; ec = ec->mNextInExchangeIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+    return nullptr;
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId,
@@ -140,30 +184,49 @@ CHIP_ERROR ExchangeManager::UnregisterUnsolicitedMessageHandlerForType(Protocols
     return UnregisterUMH(protocolId, static_cast<int16_t>(msgType));
 }
 
-CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
+size_t ExchangeManager::LowerBoundUMH(uint64_t key) const
 {
-    UnsolicitedMessageHandlerSlot * selected = nullptr;
-
-    for (auto & umh : UMHandlerPool)
+    size_t low  = 0;
+    size_t high = mUMHandlerCount;
+    while (low < high)
     {
-        if (!umh.IsInUse())
+        size_t mid = low + (high - low) / 2;
+        if (UMHandlerPool[mid].Key() < key)
         {
-            if (selected == nullptr)
-                selected = &umh;
+            low = mid + 1;
         }
-        else if (umh.Matches(protocolId, msgType))
+        else
         {
-            umh.Handler = handler;
-            return CHIP_NO_ERROR;
+            high = mid;
         }
     }
+    return low;
+}
 
-    if (selected == nullptr)
+CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler)
+{
+    const uint64_t key = UnsolicitedMessageHandlerSlot::Key(protocolId, msgType);
+    const size_t index = LowerBoundUMH(key);
+
+    if (index < mUMHandlerCount && UMHandlerPool[index].Matches(protocolId, msgType))
+    {
+        UMHandlerPool[index].Handler = handler;
+        return CHIP_NO_ERROR;
+    }
+
+    if (mUMHandlerCount == ArraySize(UMHandlerPool))
         return CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
 
-    selected->Handler     = handler;
-    selected->ProtocolId  = protocolId;
-    selected->MessageType = msgType;
+    for (size_t i = mUMHandlerCount; i > index; i--)
+    {
+        UMHandlerPool[i] = UMHandlerPool[i - 1];
+    }
+    mUMHandlerCount++;
+
+    UnsolicitedMessageHandlerSlot & selected = UMHandlerPool[index];
+    selected.Handler                         = handler;
+    selected.ProtocolId                      = protocolId;
+    selected.MessageType                     = msgType;
 
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -172,24 +235,49 @@ CHIP_ERROR ExchangeManager::RegisterUMH(Protocols::Id protocolId, int16_t msgTyp
 
 CHIP_ERROR ExchangeManager::UnregisterUMH(Protocols::Id protocolId, int16_t msgType)
 {
-    for (auto & umh : UMHandlerPool)
+    const size_t index = LowerBoundUMH(UnsolicitedMessageHandlerSlot::Key(protocolId, msgType));
+
+    if (index == mUMHandlerCount || !UMHandlerPool[index].Matches(protocolId, msgType))
+        return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+
+    mUMHandlerCount--;
+    for (size_t i = index; i < mUMHandlerCount; i++)
     {
-        if (umh.IsInUse() && umh.Matches(protocolId, msgType))
-        {
-            umh.Reset();
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
-            return CHIP_NO_ERROR;
-        }
+        UMHandlerPool[i] = UMHandlerPool[i + 1];
     }
 
-    return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+
+    return CHIP_NO_ERROR;
+}
+
+ExchangeManager::UnsolicitedMessageHandlerSlot * ExchangeManager::FindUMH(const PayloadHeader & payloadHeader)
+{
+    // Prefer handlers that can explicitly handle the message type over handlers that handle all messages for a protocol.
+    // The wildcard handler of a protocol sorts right before its handlers for specific message types.
+    const Protocols::Id protocolId = payloadHeader.GetProtocolID();
+    const int16_t msgType          = static_cast<int16_t>(payloadHeader.GetMessageType());
+
+    size_t index = LowerBoundUMH(UnsolicitedMessageHandlerSlot::Key(protocolId, msgType));
+    if (index < mUMHandlerCount && UMHandlerPool[index].Matches(protocolId, msgType))
+    {
+        return &UMHandlerPool[index];
+    }
+
+    index = LowerBoundUMH(UnsolicitedMessageHandlerSlot::Key(protocolId, kAnyMessageType));
+    if (index < mUMHandlerCount && UMHandlerPool[index].Matches(protocolId, kAnyMessageType))
+    {
+        return &UMHandlerPool[index];
+    }
+
+    return nullptr;
 }
 
 void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
                                         const SessionHandle & session, DuplicateMessage isDuplicate,
                                         System::PacketBufferHandle && msgBuf)
 {
-    UnsolicitedMessageHandlerSlot * matchingUMH = nullptr;
+    UnsolicitedMessageHandler * matchingHandler = nullptr;
 
 #if CHIP_PROGRESS_LOGGING
     auto * protocolName = Protocols::GetProtocolName(payloadHeader.GetProtocolID());
@@ -238,23 +326,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -277,23 +356,12 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     // unsolicited messages must be marked as being from an initiator.
     if (!msgFlags.Has(MessageFlagValues::kDuplicateMessage) && payloadHeader.IsInitiator())
     {
-        // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
-        // handle the message type over handlers that handle all messages for a profile.
-        matchingUMH = nullptr;
-
-        for (auto & umh : UMHandlerPool)
+        // Search for an unsolicited message handler that can handle the message. Keep the handler rather than its slot:
+        // the handler callbacks may register or unregister handlers, which moves the slots around.
+        UnsolicitedMessageHandlerSlot * matchingUMH = FindUMH(payloadHeader);
+        if (matchingUMH != nullptr)
         {
-            if (umh.IsInUse() && payloadHeader.HasProtocol(umh.ProtocolId))
-            {
-                if (umh.MessageType == payloadHeader.GetMessageType())
-                {
-                    matchingUMH = &umh;
-                    break;
-                }
-
-                if (umh.MessageType == kAnyMessageType)
-                    matchingUMH = &umh;
-            }
+            matchingHandler = matchingUMH->Handler;
         }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message does not need to send
@@ -315,12 +383,12 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     }
 
     // If we found a handler, create an exchange to handle the message.
-    if (matchingUMH != nullptr)
+    if (matchingHandler != nullptr)
     {
         ExchangeDelegate * delegate = nullptr;
 
         // Fetch delegate from the handler
-        CHIP_ERROR err = matchingUMH->Handler->OnUnsolicitedMessageReceived(payloadHeader, delegate);
+        CHIP_ERROR err = matchingHandler->OnUnsolicitedMessageReceived(payloadHeader, delegate);
         if (err != CHIP_NO_ERROR)
         {
             // Using same error message for all errors to reduce code size.
@@ -329,13 +397,13 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
             return;
         }
 
-        ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, false, delegate);
+        ExchangeContext * ec = CreateContext(payloadHeader.GetExchangeID(), session, false, delegate);
 
         if (ec == nullptr)
         {
             if (delegate != nullptr)
             {
-                matchingUMH->Handler->OnExchangeCreationFailed(delegate);
+                matchingHandler->OnExchangeCreationFailed(delegate);
             }
 
             // Using same error message for all errors to reduce code size.
@@ -381,8 +449,8 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // If rcvd msg is from initiator then this exchange is created as not Initiator.
     // If rcvd msg is not from initiator then this exchange is created as Initiator.
     // Create a EphemeralExchange to generate a StandaloneAck
-    ExchangeContext * ec = mContextPool.CreateObject(this, payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(),
-                                                     nullptr, true /* IsEphemeralExchange */);
+    ExchangeContext * ec = CreateContext(payloadHeader.GetExchangeID(), session, !payloadHeader.IsInitiator(), nullptr,
+                                         true /* IsEphemeralExchange */);
 
     if (ec == nullptr)
     {
@@ -100,7 +100,7 @@ public:
      */
     ExchangeContext * NewContext(const SessionHandle & session, ExchangeDelegate * delegate, bool isInitiator = true);
 
-    void ReleaseContext(ExchangeContext * ec) { mContextPool.ReleaseObject(ec); }
+    void ReleaseContext(ExchangeContext * ec);
 
     /**
      *  Register an unsolicited message handler for a given protocol identifier. This handler would be
@@ -204,14 +204,20 @@ private:
     {
         UnsolicitedMessageHandlerSlot() : ProtocolId(Protocols::NotSpecified) {}
 
-        constexpr void Reset() { Handler = nullptr; }
-        constexpr bool IsInUse() const { return Handler != nullptr; }
-        // Matches() only returns a sensible value if IsInUse() is true.
         constexpr bool Matches(Protocols::Id aProtocolId, int16_t aMessageType) const
         {
             return ProtocolId == aProtocolId && MessageType == aMessageType;
         }
 
+        // The order of the handler table. A protocol's wildcard handler sorts before its handlers for specific
+        // message types.
+        static constexpr uint64_t Key(Protocols::Id aProtocolId, int16_t aMessageType)
+        {
+            return (static_cast<uint64_t>(aProtocolId.ToFullyQualifiedSpecForm()) << 16) |
+                static_cast<uint16_t>(aMessageType - kAnyMessageType);
+        }
+        constexpr uint64_t Key() const { return Key(ProtocolId, MessageType); }
+
         Protocols::Id ProtocolId;
         // Message types are normally 8-bit unsigned ints, but we use
         // kAnyMessageType, which is negative, to represent a wildcard handler,
@@ -233,10 +239,26 @@ private:
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
+    // Registered handlers, sorted by UnsolicitedMessageHandlerSlot::Key() so that a received message finds its
+    // handler with a binary search. Only the first mUMHandlerCount slots are in use.
     UnsolicitedMessageHandlerSlot UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    size_t mUMHandlerCount = 0;
+
+    // Open exchanges hashed by exchange ID and role. Each bucket is a list linked through
+    // ExchangeContext::mNextInExchangeIndex. The session is not part of the hash, since the session an exchange holds
+    // can change or be released while it is open; MatchExchange() checks it.
+    ExchangeContext * mExchangeIndex[CHIP_CONFIG_EXCHANGE_INDEX_BUCKETS] = {};
 
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
+    size_t LowerBoundUMH(uint64_t key) const;
+    UnsolicitedMessageHandlerSlot * FindUMH(const PayloadHeader & payloadHeader);
+
+    ExchangeContext * CreateContext(uint16_t exchangeId, const SessionHandle & session, bool isInitiator,
+                                    ExchangeDelegate * delegate, bool isEphemeralExchange = false);
+    static size_t ExchangeIndexBucket(uint16_t exchangeId, bool isInitiator);
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
 
     void OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader, const SessionHandle & session,
                            DuplicateMessage isDuplicate, System::PacketBufferHandle && msgBuf) override;
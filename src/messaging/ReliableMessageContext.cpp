@@ -168,10 +168,10 @@ CHIP_ERROR ReliableMessageContext::HandleNeedsAckInner(uint32_t messageCounter,
         ReturnErrorOnFailure(SendStandaloneAckMessage());
     }
 
-    // Replace the Pending ack message counter.
-    SetPendingPeerAckMessageCounter(messageCounter);
+    // Replace the Pending ack message counter.  The ack deadline is queued along with it, so set it first.
     using namespace System::Clock::Literals;
     mNextAckTime = System::SystemClock().GetMonotonicTimestamp() + CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT;
+    SetPendingPeerAckMessageCounter(messageCounter);
     return CHIP_NO_ERROR;
 }
 
@@ -210,6 +210,7 @@ void ReliableMessageContext::SetPendingPeerAckMessageCounter(uint32_t aPeerAckMe
     mPendingPeerAckMessageCounter = aPeerAckMessageCounter;
     SetAckPending(true);
     mFlags.Set(Flags::kFlagAckMessageCounterIsValid);
+    GetReliableMessageMgr()->ScheduleAck(*this);
 }
 
 } // namespace Messaging
@@ -31,6 +31,7 @@
 #include <lib/core/CHIPError.h>
 #include <lib/core/ReferenceCounted.h>
 #include <lib/support/DLLUtil.h>
+#include <lib/support/IntrusiveList.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <system/SystemLayer.h>
 #include <transport/raw/MessageHeader.h>
@@ -48,7 +49,10 @@ class ExchangeContext;
 enum class MessageFlagValues : uint32_t;
 class ReliableMessageMgr;
 
-class ReliableMessageContext
+/**
+ *  While an acknowledgment is pending, the context is linked into the ack deadline queue of its ReliableMessageMgr.
+ */
+class ReliableMessageContext : public IntrusiveListNodeBase<IntrusiveMode::AutoUnlink>
 {
 public:
     ReliableMessageContext();
@@ -246,6 +250,11 @@ inline void ReliableMessageContext::SetAutoRequestAck(bool autoReqAck)
 inline void ReliableMessageContext::SetAckPending(bool inAckPending)
 {
     mFlags.Set(Flags::kFlagAckPending, inAckPending);
+    if (!inAckPending)
+    {
+        // Leave the ack deadline queue.
+        Unlink();
+    }
 }
 
 inline bool ReliableMessageContext::IsEphemeralExchange() const
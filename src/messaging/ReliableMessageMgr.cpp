@@ -26,6 +26,7 @@
 
 #include <lib/support/BitFlags.h>
 #include <lib/support/CHIPFaultInjection.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <messaging/ErrorCategory.h>
@@ -47,7 +48,7 @@ namespace chip {
 namespace Messaging {
 
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
-    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
+    ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0), queueIndex(kNotQueued)
 {
     ec->SetWaitingForAck(true);
 }
@@ -57,9 +58,7 @@ ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
     ec->SetWaitingForAck(false);
 }
 
-ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
-    mContextPool(contextPool), mSystemLayer(nullptr)
-{}
+ReliableMessageMgr::ReliableMessageMgr() : mSystemLayer(nullptr) {}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
@@ -74,10 +73,19 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseRetransEntry(*entry);
         return Loop::Continue;
     });
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    Platform::MemoryFree(mRetransQueue);
+    mRetransQueue         = nullptr;
+    mRetransQueueCapacity = 0;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    // Acks that are still pending will not be sent.
+    mAckQueue.Clear();
+
     mSystemLayer = nullptr;
 }
 
@@ -105,23 +113,36 @@ void ReliableMessageMgr::ExecuteActions()
     ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions at 0x" ChipLogFormatX64 "ms", ChipLogValueX64(now.count()));
 #endif
 
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending())
-        {
-            if (rc->mNextAckTime <= now)
-            {
+    // Send the acks that are due.  An ack that could not be sent stays pending, and is retried at the next timer.
+    IntrusiveList<ReliableMessageContext, IntrusiveMode::AutoUnlink> unsentAcks;
+    while (!mAckQueue.Empty() && mAckQueue.begin()->mNextAckTime <= now)
+    {
+        ReliableMessageContext * rc = &*mAckQueue.begin();
+        mAckQueue.Remove(rc);
+
+        // Make sure the exchange stays alive until we are done working with it.
+        ExchangeHandle ec(*rc->GetExchangeContext());
 #if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
+        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions sending ACK %p", rc);
 #endif
-                rc->SendStandaloneAckMessage();
-            }
+        rc->SendStandaloneAckMessage();
+        if (rc->IsAckPending() && !rc->IsInList())
+        {
+            unsentAcks.PushBack(rc);
         }
-    });
+    }
+    while (!unsentAcks.Empty())
+    {
+        ScheduleAck(*unsentAcks.begin());
+    }
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired.  Each entry that was queued
+    // when the timer fired is handled at most once, even if its next retransmission time is due already.
+    for (size_t remaining = mRetransQueueSize; remaining > 0 && mRetransQueueSize > 0; remaining--)
+    {
+        RetransTableEntry * entry = mRetransQueue[0];
         if (entry->nextRetransTime > now)
-            return Loop::Continue;
+            break;
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -130,6 +151,8 @@ void ReliableMessageMgr::ExecuteActions()
         uint32_t messageCounter = entry->retainedBuf.GetMessageCounter();
 #endif // CHIP_ERROR_LOGGING || CHIP_DETAIL_LOGGING
 
+        PeerStats * peerStats = GetPeerStatsForUpdate(*entry);
+
         if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
         {
             // Make sure our exchange stays alive until we are done working with it.
@@ -140,6 +163,11 @@ void ReliableMessageMgr::ExecuteActions()
                          " sendCount: %u max retries: %d",
                          messageCounter, ChipLogValueExchange(&ec.Get()), sendCount, CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
 
+            if (peerStats != nullptr)
+            {
+                peerStats->messagesFailed++;
+            }
+
             // Don't check whether the session in the exchange is valid, because when the session is released, the retrans entry is
             // cleared inside ExchangeContext::OnSessionReleased, so the session must be valid if the entry exists.
             SessionHandle session = ec->GetSessionHandle();
@@ -157,9 +185,9 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseRetransEntry(*entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -168,11 +196,15 @@ void ReliableMessageMgr::ExecuteActions()
                         " Send Cnt %d",
                         messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
 
+        if (peerStats != nullptr)
+        {
+            peerStats->retransmissions++;
+        }
+
         CalculateNextRetransTime(*entry);
+        QueueRetransmission(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -198,6 +230,9 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
 {
     VerifyOrDie(!rc->IsWaitingForAck());
 
+    // Make sure the entry can be queued once it has been transmitted.
+    ReturnErrorOnFailure(ReserveRetransQueue());
+
     *rEntry = mRetransTable.CreateObject(rc);
     if (*rEntry == nullptr)
     {
@@ -208,6 +243,126 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ReliableMessageMgr::ReserveRetransQueue()
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mRetransTable.Allocated() < mRetransQueueCapacity)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    size_t capacity = (mRetransQueueCapacity == 0) ? CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE : mRetransQueueCapacity * 2;
+    auto * queue    = static_cast<RetransTableEntry **>(Platform::MemoryRealloc(mRetransQueue, capacity * sizeof(*mRetransQueue)));
+    VerifyOrReturnError(queue != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    mRetransQueue         = queue;
+    mRetransQueueCapacity = capacity;
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    return CHIP_NO_ERROR;
+}
+
+void ReliableMessageMgr::SetRetransQueueSlot(size_t index, RetransTableEntry * entry)
+{
+    mRetransQueue[index] = entry;
+    entry->queueIndex    = index;
+}
+
+void ReliableMessageMgr::SiftUpRetransQueue(size_t index)
+{
+    RetransTableEntry * entry = mRetransQueue[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (mRetransQueue[parent]->nextRetransTime <= entry->nextRetransTime)
+        {
+            break;
+        }
+        SetRetransQueueSlot(index, mRetransQueue[parent]);
+        index = parent;
+    }
+    SetRetransQueueSlot(index, entry);
+}
+
+void ReliableMessageMgr::SiftDownRetransQueue(size_t index)
+{
+    RetransTableEntry * entry = mRetransQueue[index];
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= mRetransQueueSize)
+        {
+            break;
+        }
+        if (child + 1 < mRetransQueueSize && mRetransQueue[child + 1]->nextRetransTime < mRetransQueue[child]->nextRetransTime)
+        {
+            child++;
+        }
+        if (entry->nextRetransTime <= mRetransQueue[child]->nextRetransTime)
+        {
+            break;
+        }
+        SetRetransQueueSlot(index, mRetransQueue[child]);
+        index = child;
+    }
+    SetRetransQueueSlot(index, entry);
+}
+
+void ReliableMessageMgr::QueueRetransmission(RetransTableEntry & entry)
+{
+    if (entry.queueIndex == kNotQueued)
+    {
+        // ReserveRetransQueue() made room for every entry of the table.
+        SetRetransQueueSlot(mRetransQueueSize++, &entry);
+        SiftUpRetransQueue(entry.queueIndex);
+        return;
+    }
+
+    SiftUpRetransQueue(entry.queueIndex);
+    SiftDownRetransQueue(entry.queueIndex);
+}
+
+void ReliableMessageMgr::DequeueRetransmission(RetransTableEntry & entry)
+{
+    VerifyOrReturn(entry.queueIndex != kNotQueued);
+
+    size_t index     = entry.queueIndex;
+    entry.queueIndex = kNotQueued;
+    if (index == --mRetransQueueSize)
+    {
+        return;
+    }
+
+    // Move the last entry into the hole, and restore the heap order around it.
+    SetRetransQueueSlot(index, mRetransQueue[mRetransQueueSize]);
+    SiftUpRetransQueue(index);
+    SiftDownRetransQueue(index);
+}
+
+void ReliableMessageMgr::ReleaseRetransEntry(RetransTableEntry & entry)
+{
+    DequeueRetransmission(entry);
+    mRetransTable.ReleaseObject(&entry);
+}
+
+void ReliableMessageMgr::ScheduleAck(ReliableMessageContext & rc)
+{
+    rc.Unlink();
+
+    // Search from the back, where an ack with the default timeout belongs.
+    auto position = mAckQueue.end();
+    while (position != mAckQueue.begin())
+    {
+        auto previous = position;
+        --previous;
+        if (previous->mNextAckTime <= rc.mNextAckTime)
+        {
+            break;
+        }
+        position = previous;
+    }
+    mAckQueue.InsertBefore(position, &rc);
+}
+
 System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp baseInterval, uint8_t sendCount,
                                                         bool computeMaxPossible)
 {
@@ -269,7 +424,18 @@ System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp
 
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    entry->firstSendTime = System::SystemClock().GetMonotonicTimestamp();
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     CalculateNextRetransTime(*entry);
+    QueueRetransmission(*entry);
+
+    PeerStats * peerStats = GetPeerStatsForUpdate(*entry);
+    if (peerStats != nullptr)
+    {
+        peerStats->messagesSent++;
+    }
+
     StartTimer();
 }
 
@@ -279,6 +445,21 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+            PeerStats * peerStats = GetPeerStatsForUpdate(*entry);
+            if (peerStats != nullptr)
+            {
+                peerStats->messagesAcked++;
+            }
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+            // Only the acknowledgment of a message that was never retransmitted is an unambiguous sample (Karn's algorithm).
+            if (entry->sendCount == 0 && entry->ec->HasSessionHandle())
+            {
+                entry->ec->GetSessionHandle()->GetRttEstimator().AddSample(System::SystemClock().GetMonotonicTimestamp() -
+                                                                           entry->firstSendTime);
+            }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -363,7 +544,7 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -373,21 +554,16 @@ void ReliableMessageMgr::StartTimer()
     // When do we need to next wake up to send an ACK?
     System::Clock::Timestamp nextWakeTime = System::Clock::Timestamp::max();
 
-    ExecuteForAllContext([&](ReliableMessageContext * rc) {
-        if (rc->IsAckPending() && rc->mNextAckTime < nextWakeTime)
-        {
-            nextWakeTime = rc->mNextAckTime;
-        }
-    });
+    if (!mAckQueue.Empty())
+    {
+        nextWakeTime = mAckQueue.begin()->mNextAckTime;
+    }
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mRetransQueueSize > 0 && mRetransQueue[0]->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mRetransQueue[0]->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -469,10 +645,91 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
         baseTimeout = entry.ec->GetSessionHandle()->GetMRPBaseTimeout();
     }
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    const Messaging::RttEstimator & rttEstimator = entry.ec->GetSessionHandle()->GetRttEstimator();
+    if (rttEstimator.HasSample())
+    {
+        // The measured round-trip time replaces the advertised active interval, but a peer that is perceived as idle may be
+        // asleep, so its idle interval is only ever lengthened.
+        const System::Clock::Timestamp rttTimeout = rttEstimator.GetRetransTimeout();
+        if (entry.ec->HasReceivedAtLeastOneMessage() ||
+            baseTimeout == entry.ec->GetSessionHandle()->GetRemoteMRPConfig().mActiveRetransTimeout)
+        {
+            baseTimeout = rttTimeout;
+        }
+        else
+        {
+            baseTimeout = std::max(baseTimeout, rttTimeout);
+        }
+    }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     System::Clock::Timestamp backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime            = System::SystemClock().GetMonotonicTimestamp() + backoff;
 }
 
+CHIP_ERROR ReliableMessageMgr::GetPeerStats(const ScopedNodeId & peer, PeerStats & stats) const
+{
+#if CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+    for (size_t i = 0; i < mPeerStatsCount; i++)
+    {
+        if (mPeerStats[i].peer == peer)
+        {
+            stats = mPeerStats[i];
+            return CHIP_NO_ERROR;
+        }
+    }
+#endif // CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+    return CHIP_ERROR_NOT_FOUND;
+}
+
+void ReliableMessageMgr::ClearPeerStats()
+{
+#if CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+    mPeerStatsCount = 0;
+#endif // CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+}
+
+ReliableMessageMgr::PeerStats * ReliableMessageMgr::GetPeerStatsForUpdate(const RetransTableEntry & entry)
+{
+#if CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+    VerifyOrReturnValue(entry.ec->HasSessionHandle(), nullptr);
+    const ScopedNodeId peer = entry.ec->GetSessionHandle()->GetPeer();
+    VerifyOrReturnValue(peer.IsOperational(), nullptr);
+
+    // Keep the most recently active peer first, so that the least recently active one is evicted when the table is full.
+    size_t index = 0;
+    while (index < mPeerStatsCount && !(mPeerStats[index].peer == peer))
+    {
+        index++;
+    }
+
+    PeerStats stats;
+    if (index < mPeerStatsCount)
+    {
+        stats = mPeerStats[index];
+    }
+    else
+    {
+        stats.peer = peer;
+        if (mPeerStatsCount < CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE)
+        {
+            mPeerStatsCount++;
+        }
+        index = mPeerStatsCount - 1;
+    }
+
+    for (; index > 0; index--)
+    {
+        mPeerStats[index] = mPeerStats[index - 1];
+    }
+    mPeerStats[0] = stats;
+    return &mPeerStats[0];
+#else
+    return nullptr;
+#endif // CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+}
+
 #if CHIP_CONFIG_TEST
 int ReliableMessageMgr::TestGetCountRetransTable()
 {
@@ -27,7 +27,9 @@
 #include <stdint.h>
 
 #include <lib/core/CHIPError.h>
+#include <lib/core/ScopedNodeId.h>
 #include <lib/support/BitFlags.h>
+#include <lib/support/IntrusiveList.h>
 #include <lib/support/Pool.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
@@ -65,16 +67,38 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+        size_t queueIndex;                        /**< The position of the entry in the retransmission deadline queue,
+                                                       or kNotQueued before its first transmission. */
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+        System::Clock::Timestamp firstSendTime; /**< When the message was first transmitted, to measure the round-trip time. */
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     };
 
-    ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
+    /**
+     *  @struct PeerStats
+     *
+     *  @brief
+     *    Reliable messaging statistics for an operational peer, for diagnostics.
+     */
+    struct PeerStats
+    {
+        ScopedNodeId peer;
+        uint32_t messagesSent    = 0; /**< Messages sent to the peer that requested an acknowledgment. */
+        uint32_t messagesAcked   = 0; /**< Messages the peer acknowledged. */
+        uint32_t retransmissions = 0; /**< Retransmissions of messages to the peer. */
+        uint32_t messagesFailed  = 0; /**< Messages that were never acknowledged after all retransmissions. */
+    };
+
+    static constexpr size_t kNotQueued = SIZE_MAX;
+
+    ReliableMessageMgr();
     ~ReliableMessageMgr();
 
     void Init(chip::System::Layer * systemLayer);
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
+     * Send the pending acks and the retransmissions that are due.  If an
      * action needs to be triggered by ReliableMessageProtocol time facilities,
      * execute that action.
      */
@@ -160,10 +184,10 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
-     * Determine how many ReliableMessageProtocol ticks we need to sleep before we
-     * need to physically wake the CPU to perform an action.  Set a timer to go off
-     * when we next need to wake the system.
+     * Determine, from the earliest pending ack and retransmission deadlines, how
+     * many ReliableMessageProtocol ticks we need to sleep before we need to
+     * physically wake the CPU to perform an action.  Set a timer to go off when we
+     * next need to wake the system.
      *
      */
     void StartTimer();
@@ -184,6 +208,23 @@ public:
      */
     void RegisterSessionUpdateDelegate(SessionUpdateDelegate * sessionUpdateDelegate);
 
+    /**
+     *  Get the reliable messaging statistics for a peer.  Statistics are kept for the
+     *  CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE most recently active operational peers.
+     *
+     *  @param[in]    peer    The operational identity of the peer.
+     *  @param[out]   stats   The statistics of the peer.
+     *
+     *  @retval  #CHIP_ERROR_NOT_FOUND If no statistics are kept for the peer.
+     *  @retval  #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR GetPeerStats(const ScopedNodeId & peer, PeerStats & stats) const;
+
+    /**
+     *  Discard the reliable messaging statistics of all peers.
+     */
+    void ClearPeerStats();
+
     /**
      * Map a send error code to the error code we should actually use for
      * success checks.  This maps some error codes to CHIP_NO_ERROR as
@@ -206,6 +247,32 @@ public:
 #endif // CHIP_CONFIG_TEST
 
 private:
+    friend class ReliableMessageContext;
+
+    /**
+     * Queue the pending ack of a context by its mNextAckTime, replacing any previous deadline.
+     */
+    void ScheduleAck(ReliableMessageContext & rc);
+
+    /**
+     * Queue a retransmission table entry by its nextRetransTime, or restore the queue order after its
+     * nextRetransTime changed.
+     */
+    void QueueRetransmission(RetransTableEntry & entry);
+
+    /**
+     * Remove an entry from the retransmission table and from the retransmission deadline queue.
+     */
+    void ReleaseRetransEntry(RetransTableEntry & entry);
+
+    CHIP_ERROR ReserveRetransQueue();
+    void DequeueRetransmission(RetransTableEntry & entry);
+    void SetRetransQueueSlot(size_t index, RetransTableEntry * entry);
+    void SiftUpRetransQueue(size_t index);
+    void SiftDownRetransQueue(size_t index);
+
+    PeerStats * GetPeerStatsForUpdate(const RetransTableEntry & entry);
+
     /**
      * Calculates the next retransmission time for the entry
      * Function sets the nextRetransTime of the entry
@@ -214,24 +281,34 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
-    ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
 
-    /* Placeholder function to run a function for all exchanges */
-    template <typename Function>
-    void ExecuteForAllContext(Function function)
-    {
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            function(ec->GetReliableMessageContext());
-            return Loop::Continue;
-        });
-    }
-
     void TicklessDebugDumpRetransTable(const char * log);
 
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+    // The contexts with a pending ack, in order of mNextAckTime.  Every ack uses the same timeout, so contexts are
+    // almost always queued at the back.
+    IntrusiveList<ReliableMessageContext, IntrusiveMode::AutoUnlink> mAckQueue;
+
+    // A binary min-heap of the transmitted retransmission table entries, ordered by nextRetransTime, so that the
+    // timer only touches the entries that are due.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // The retransmission table is not bounded, so the queue grows with it.
+    RetransTableEntry ** mRetransQueue = nullptr;
+    size_t mRetransQueueCapacity       = 0;
+#else
+    RetransTableEntry * mRetransQueue[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    size_t mRetransQueueSize = 0;
+
+#if CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+    // Most recently active peer first.
+    PeerStats mPeerStats[CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE];
+    size_t mPeerStatsCount = 0;
+#endif // CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE > 0
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 };
 
@@ -157,6 +157,23 @@ namespace chip {
 #define CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS (4)
 #endif // CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS
 
+/**
+ *  @def CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE
+ *
+ *  @brief
+ *    The number of operational peers for which ReliableMessageMgr keeps
+ *    retransmission statistics for diagnostics.  The least recently active
+ *    peer is evicted when the table is full.  0 disables the statistics.
+ *
+ */
+#ifndef CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE 32
+#else
+#define CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE 4
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_RMP_PEER_STATS_TABLE_SIZE
+
 /**
  *  @def CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST
  *
@@ -180,6 +197,40 @@ namespace chip {
 #endif
 #endif // CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST
 
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    Should the retransmission timeout of a session adapt to the measured
+ *    round-trip time of its peer.
+ *
+ *  When enabled, every session estimates its round-trip time from the
+ *  acknowledgments of messages that were not retransmitted, and the
+ *  estimated retransmission timeout (SRTT + 4 * RTTVAR) replaces the active
+ *  interval advertised by the peer.  The idle interval of a peer that may be
+ *  asleep is never shortened.  The backoff, margin and jitter of section
+ *  4.11.2.1 are applied on top of the estimate as usual.
+ *
+ *  Set by the chip_config_mrp_adaptive_retrans_timeout GN argument.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+#define CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT 0
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+ *
+ *  @brief
+ *    The lower bound of an adaptive retransmission timeout.
+ *
+ *  A peer may delay the acknowledgment of a message it has no response to
+ *  by up to the standalone acknowledgment timeout, so a shorter timeout
+ *  would cause spurious retransmissions even on a fast link.
+ */
+#ifndef CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+#define CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL CHIP_CONFIG_RMP_DEFAULT_ACK_TIMEOUT
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL
+
 inline constexpr System::Clock::Milliseconds32 kDefaultActiveTime = System::Clock::Milliseconds16(4000);
 
 /**
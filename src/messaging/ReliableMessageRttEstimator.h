@@ -0,0 +1,108 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the round-trip time estimator that the Reliable
+ *      Messaging Protocol uses to adapt its retransmission timeouts.
+ */
+
+#pragma once
+
+#include <messaging/ReliableMessageProtocolConfig.h>
+#include <system/SystemClock.h>
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace chip {
+namespace Messaging {
+
+/**
+ *  @class RttEstimator
+ *
+ *  @brief
+ *    Estimates the round-trip time of a session from the acknowledgments of
+ *    its messages, and derives a retransmission timeout from the smoothed
+ *    round-trip time and its variation, as TCP does (RFC 6298).
+ *
+ *    The caller is responsible for only adding unambiguous samples, i.e. for
+ *    messages that were acknowledged without being retransmitted.
+ */
+class RttEstimator
+{
+public:
+    /// The largest retransmission timeout, which is the largest interval a peer may advertise (SAI and SII are at most
+    /// one hour, see section 4.12.8 "Parameters and Constants").
+    static constexpr System::Clock::Milliseconds32 kMaxRetransTimeout = System::Clock::Milliseconds32(3600000);
+
+    bool HasSample() const { return mSampleCount > 0; }
+    uint32_t GetSampleCount() const { return mSampleCount; }
+
+    /**
+     *  Adds the time between sending a message and receiving its acknowledgment.
+     */
+    void AddSample(System::Clock::Milliseconds64 rtt)
+    {
+        const uint32_t sample = static_cast<uint32_t>(std::min<uint64_t>(rtt.count(), kMaxRetransTimeout.count()));
+        if (mSampleCount == 0)
+        {
+            mSmoothedRtt8 = sample * 8;
+            mRttVariance4 = sample * 2;
+        }
+        else
+        {
+            // SRTT += (R - SRTT) / 8 and RTTVAR += (|R - SRTT| - RTTVAR) / 4, in fixed point.
+            const int64_t error = static_cast<int64_t>(sample) - static_cast<int64_t>(mSmoothedRtt8 / 8);
+            mSmoothedRtt8       = static_cast<uint32_t>(mSmoothedRtt8 + error);
+            mRttVariance4       = static_cast<uint32_t>(mRttVariance4 + (error < 0 ? -error : error) - mRttVariance4 / 4);
+        }
+        if (mSampleCount < UINT32_MAX)
+        {
+            mSampleCount++;
+        }
+    }
+
+    System::Clock::Milliseconds32 GetSmoothedRtt() const { return System::Clock::Milliseconds32(mSmoothedRtt8 / 8); }
+    System::Clock::Milliseconds32 GetRttVariance() const { return System::Clock::Milliseconds32(mRttVariance4 / 4); }
+
+    /**
+     *  Returns SRTT + 4 * RTTVAR, bounded by CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL and kMaxRetransTimeout.
+     *  Only meaningful once HasSample() is true.
+     */
+    System::Clock::Milliseconds32 GetRetransTimeout() const
+    {
+        using namespace System::Clock::Literals;
+        const uint64_t timeout = mSmoothedRtt8 / 8 + std::max<uint64_t>(mRttVariance4, kClockGranularityMs);
+        const System::Clock::Milliseconds32 minTimeout(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL);
+        return std::clamp(System::Clock::Milliseconds32(static_cast<uint32_t>(std::min<uint64_t>(timeout, UINT32_MAX))),
+                          minTimeout, kMaxRetransTimeout);
+    }
+
+    void Reset() { *this = RttEstimator(); }
+
+private:
+    static constexpr uint32_t kClockGranularityMs = 1;
+
+    uint32_t mSmoothedRtt8 = 0; // Smoothed round-trip time, in 1/8 ms.
+    uint32_t mRttVariance4 = 0; // Round-trip time variation, in 1/4 ms.
+    uint32_t mSampleCount  = 0;
+};
+
+} // namespace Messaging
+} // namespace chip
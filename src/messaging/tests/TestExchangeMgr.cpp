@@ -76,6 +76,30 @@ public:
     bool IsOnMessageReceivedCalled = false;
 };
 
+class EchoTypeDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    // Reply on the exchange with the message type that was received.
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ReceivedCount++;
+        return ec->SendMessage(Protocols::BDX::Id, payloadHeader.GetMessageType(),
+                               System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int ReceivedCount = 0;
+};
+
 class WaitForTimeoutDelegate : public ExchangeDelegate
 {
 public:
@@ -225,6 +249,127 @@ void CheckUmhRegistrationTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
 }
 
+void CheckUmhCapacityTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate mockAppDelegate;
+    ExchangeManager & exchangeMgr = ctx.GetExchangeManager();
+
+    // Fill the slots the messaging context leaves free, registering in descending order so that every registration
+    // inserts before the handlers registered so far.
+    uint8_t registered = 0;
+    for (uint8_t msgType = CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; msgType > 0; msgType--)
+    {
+        err = exchangeMgr.RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, msgType, &mockAppDelegate);
+        if (err == CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS)
+        {
+            break;
+        }
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        registered++;
+    }
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, registered > 0);
+
+    err = exchangeMgr.RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &mockAppDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS);
+
+    // Replacing the handler of a registered message type does not need a new slot.
+    err = exchangeMgr.RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS,
+                                                               &mockAppDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (uint8_t i = 0; i < registered; i++)
+    {
+        auto msgType = static_cast<uint8_t>(CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS - i);
+
+        err = exchangeMgr.UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, msgType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = exchangeMgr.UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, msgType);
+        NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+    }
+}
+
+void CheckUmhPrecedenceTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate typeDelegate;
+    MockAppDelegate protocolDelegate;
+    MockAppDelegate otherProtocolDelegate;
+
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &typeDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &protocolDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Echo::Id, &otherProtocolDelegate);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The handler for the message type is preferred over the handler for the protocol.
+    MockAppDelegate sendDelegate;
+    ExchangeContext * ec = ctx.NewExchangeToAlice(&sendDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, typeDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !protocolDelegate.IsOnMessageReceivedCalled);
+
+    // Other message types of the protocol go to the handler for the protocol.
+    ec = ctx.NewExchangeToAlice(&sendDelegate);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+    ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                    SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, protocolDelegate.IsOnMessageReceivedCalled);
+    NL_TEST_ASSERT(inSuite, !otherProtocolDelegate.IsOnMessageReceivedCalled);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::Echo::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+void CheckConcurrentExchangeResponses(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // Each request also opens an exchange on the responder.
+    constexpr size_t kExchangeCount = CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS / 2 - 1;
+
+    EchoTypeDelegate responder;
+    CHIP_ERROR err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id, &responder);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // All requests are in flight before any response arrives, so every response has to find its own exchange.
+    MockAppDelegate requesters[kExchangeCount];
+    for (auto & requester : requesters)
+    {
+        ExchangeContext * ec = ctx.NewExchangeToAlice(&requester);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ec != nullptr);
+        err = ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                              SendFlags(Messaging::SendMessageFlags::kExpectResponse)
+                                  .Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, responder.ReceivedCount == static_cast<int>(kExchangeCount));
+    for (auto & requester : requesters)
+    {
+        NL_TEST_ASSERT(inSuite, requester.IsOnMessageReceivedCalled);
+    }
+    NL_TEST_ASSERT(inSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+    err = ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForProtocol(Protocols::BDX::Id);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
 void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -271,7 +416,10 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
+    NL_TEST_DEF("Test ExchangeMgr::CheckUmhCapacityTest",     CheckUmhCapacityTest),
+    NL_TEST_DEF("Test ExchangeMgr::CheckUmhPrecedenceTest",   CheckUmhPrecedenceTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test concurrent exchange responses",         CheckConcurrentExchangeResponses),
     NL_TEST_DEF("Test OnConnectionExpired basics",            CheckSessionExpirationBasics),
     NL_TEST_DEF("Test OnConnectionExpired timeout handling",  CheckSessionExpirationTimeout),
     NL_TEST_DEF("Test session eviction in timeout handling",  CheckSessionExpirationDuringTimeout),
@@ -337,6 +337,11 @@ public:
     static void CheckGetBackoff(nlTestSuite * inSuite, void * inContext);
     static void CheckApplicationResponseDelayed(nlTestSuite * inSuite, void * inContext);
     static void CheckApplicationResponseNeverComes(nlTestSuite * inSuite, void * inContext);
+    static void CheckRetransmissionDeadlineOrder(nlTestSuite * inSuite, void * inContext);
+    static void CheckPeerStats(nlTestSuite * inSuite, void * inContext);
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    static void CheckAdaptiveRetransTimeout(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 };
 
 void TestReliableMessageProtocol::CheckAddClearRetrans(nlTestSuite * inSuite, void * inContext)
@@ -2144,6 +2149,201 @@ void TestReliableMessageProtocol::CheckApplicationResponseNeverComes(nlTestSuite
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 }
 
+/**
+ * Tests that an exchange with a short retransmission interval, which sent its message after an exchange with a long
+ * one, retransmits and gets acknowledged while the other exchange is still waiting for its first retransmission.
+ */
+void TestReliableMessageProtocol::CheckRetransmissionDeadlineOrder(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * slowExchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, slowExchange != nullptr);
+    ExchangeContext * fastExchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, fastExchange != nullptr);
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    // Both exchanges use the same session, so the retransmission interval of each message is set before sending it.
+    auto session = slowExchange->GetSessionHandle()->AsSecureSession();
+
+    // Drop both initial messages.
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 2;
+    loopback.mDroppedMessageCount = 0;
+
+    session->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(1000), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(1000), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+    CHIP_ERROR err = slowExchange->SendMessage(Echo::MsgType::EchoRequest,
+                                               MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)),
+                                               SendMessageFlags::kExpectResponse);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    session->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(64), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(64), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+    err = fastExchange->SendMessage(Echo::MsgType::EchoRequest, MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)),
+                                    SendMessageFlags::kExpectResponse);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 2);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 2);
+
+    // The message of the fast exchange is retransmitted first, and acknowledged.
+    ctx.GetIOContext().DriveIOUntil(500_ms32 + retryBoosterTimeout, [&] { return loopback.mSentMessageCount >= 3; });
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount >= 3);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+    NL_TEST_ASSERT(inSuite, !fastExchange->IsWaitingForAck());
+    NL_TEST_ASSERT(inSuite, slowExchange->IsWaitingForAck());
+
+    // Then the message of the slow exchange.
+    ctx.GetIOContext().DriveIOUntil(2000_ms32 + retryBoosterTimeout, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, !slowExchange->IsWaitingForAck());
+
+    slowExchange->Close();
+    fastExchange->Close();
+}
+
+/**
+ * Tests that the statistics of a peer count the messages sent to it, their retransmissions, and their acknowledgments.
+ */
+void TestReliableMessageProtocol::CheckPeerStats(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockSender(ctx);
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    rm->ClearPeerStats();
+
+    const ScopedNodeId peer = exchange->GetSessionHandle()->GetPeer();
+    ReliableMessageMgr::PeerStats stats;
+    NL_TEST_ASSERT(inSuite, rm->GetPeerStats(peer, stats) == CHIP_ERROR_NOT_FOUND);
+
+    exchange->GetSessionHandle()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(64), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(64), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+
+    // Drop the initial message, so that it is retransmitted once before it is acknowledged.
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 1;
+    loopback.mDroppedMessageCount = 0;
+
+    CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest, MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)),
+                                           SendMessageFlags::kExpectResponse);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(inSuite, rm->GetPeerStats(peer, stats) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stats.peer == peer);
+    NL_TEST_ASSERT(inSuite, stats.messagesSent == 1);
+    NL_TEST_ASSERT(inSuite, stats.retransmissions == 0);
+    NL_TEST_ASSERT(inSuite, stats.messagesAcked == 0);
+
+    ctx.GetIOContext().DriveIOUntil(1000_ms32 + retryBoosterTimeout, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    NL_TEST_ASSERT(inSuite, rm->GetPeerStats(peer, stats) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stats.messagesSent == 1);
+    NL_TEST_ASSERT(inSuite, stats.retransmissions == 1);
+    NL_TEST_ASSERT(inSuite, stats.messagesAcked == 1);
+    NL_TEST_ASSERT(inSuite, stats.messagesFailed == 0);
+
+    rm->ClearPeerStats();
+    NL_TEST_ASSERT(inSuite, rm->GetPeerStats(peer, stats) == CHIP_ERROR_NOT_FOUND);
+
+    exchange->Close();
+}
+
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+/**
+ * Tests that once the round-trip time of a session has been measured over a link with some latency, a lost message is
+ * retransmitted long before the (much longer) interval the peer advertised would have expired.
+ */
+void TestReliableMessageProtocol::CheckAdaptiveRetransTimeout(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockSender(ctx);
+    ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    SessionHandle session = ctx.GetSessionBobToAlice();
+    session->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        System::Clock::Timestamp(3000), // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        System::Clock::Timestamp(3000), // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+    NL_TEST_ASSERT(inSuite, !session->GetRttEstimator().HasSample());
+
+    auto & loopback               = ctx.GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+    loopback.mMessageDelay        = 20_ms32;
+
+    // Measure the round-trip time with messages that are acknowledged without loss.
+    constexpr int kSamples = 4;
+    for (int i = 0; i < kSamples; i++)
+    {
+        ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockSender);
+        NL_TEST_ASSERT(inSuite, exchange != nullptr);
+        CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest,
+                                               MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        ctx.GetIOContext().DriveIOUntil(1000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+        ctx.DrainAndServiceIO();
+        NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    }
+
+    const Messaging::RttEstimator & rttEstimator = session->GetRttEstimator();
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetSampleCount() == kSamples);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetSmoothedRtt() >= 40_ms32);
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetRetransTimeout() < 1000_ms32);
+
+    // Lose a message: it is retransmitted after the estimated timeout, not after the advertised 3 seconds.
+    loopback.mNumMessagesToDrop = 1;
+    ExchangeContext * exchange  = ctx.NewExchangeToAlice(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    const uint32_t sentMessageCount          = loopback.mSentMessageCount;
+    const System::Clock::Timestamp startTime = System::SystemClock().GetMonotonicTimestamp();
+    CHIP_ERROR err = exchange->SendMessage(Echo::MsgType::EchoRequest, MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.GetIOContext().DriveIOUntil(2000_ms32 + retryBoosterTimeout,
+                                    [&] { return loopback.mSentMessageCount >= sentMessageCount + 2; });
+    const System::Clock::Timestamp retransmitTime = System::SystemClock().GetMonotonicTimestamp() - startTime;
+    ChipLogProgress(Test, "Retransmitted after %" PRIu32 "ms", static_cast<uint32_t>(retransmitTime.count()));
+    NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount >= sentMessageCount + 2);
+    NL_TEST_ASSERT(inSuite, retransmitTime < 2000_ms + retryBoosterTimeout);
+
+    ctx.GetIOContext().DriveIOUntil(1000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    // The acknowledgment of a retransmitted message is ambiguous, so it is not a sample.
+    NL_TEST_ASSERT(inSuite, rttEstimator.GetSampleCount() == kSamples);
+
+    loopback.mMessageDelay = System::Clock::kZero;
+}
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
 /**
  * TODO: A test that we should have but can't write with the existing
  * infrastructure we have:
@@ -2198,6 +2398,13 @@ const nlTest sTests[] = {
                 TestReliableMessageProtocol::CheckApplicationResponseDelayed),
     NL_TEST_DEF("Test an application response that never comes, so MRP retransmits run out and then exchange times out",
                 TestReliableMessageProtocol::CheckApplicationResponseNeverComes),
+    NL_TEST_DEF("Test that retransmissions are sent in deadline order, not in the order they were queued",
+                TestReliableMessageProtocol::CheckRetransmissionDeadlineOrder),
+    NL_TEST_DEF("Test ReliableMessageMgr::GetPeerStats", TestReliableMessageProtocol::CheckPeerStats),
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    NL_TEST_DEF("Test that the retransmission timeout adapts to the measured round-trip time",
+                TestReliableMessageProtocol::CheckAdaptiveRetransTimeout),
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
     NL_TEST_SENTINEL(),
 };
 
@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the RttEstimator, which adapts
+ *      MRP retransmission timeouts to the measured round-trip time.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <messaging/ReliableMessageRttEstimator.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::System::Clock::Literals;
+
+const System::Clock::Milliseconds32 kMinTimeout(CHIP_CONFIG_MRP_ADAPTIVE_MIN_RETRY_INTERVAL);
+
+void TestFirstSample(nlTestSuite * inSuite, void * inContext)
+{
+    RttEstimator estimator;
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+
+    // SRTT = R and RTTVAR = R / 2, so the timeout is three times the first sample.
+    estimator.AddSample(400_ms);
+    NL_TEST_ASSERT(inSuite, estimator.HasSample());
+    NL_TEST_ASSERT(inSuite, estimator.GetSampleCount() == 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 400_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariance() == 200_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() == 1200_ms32);
+
+    estimator.Reset();
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+}
+
+void TestSteadyFastPeer(nlTestSuite * inSuite, void * inContext)
+{
+    RttEstimator estimator;
+    for (int i = 0; i < 64; i++)
+    {
+        estimator.AddSample(20_ms);
+    }
+
+    // The variation decays, but the timeout never drops below the time a peer may delay its acknowledgment.
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 20_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRttVariance() < 1_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() <= std::max(kMinTimeout, 24_ms32));
+}
+
+void TestSlowPeer(nlTestSuite * inSuite, void * inContext)
+{
+    RttEstimator estimator;
+    estimator.AddSample(100_ms);
+    const System::Clock::Milliseconds32 fastTimeout = estimator.GetRetransTimeout();
+
+    // The peer slows down: the estimate follows, and the timeout stays above the round-trip time.
+    for (int i = 0; i < 32; i++)
+    {
+        estimator.AddSample(900_ms);
+    }
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() > 850_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() <= 900_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() > 900_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() > fastTimeout);
+}
+
+void TestJitteryPeer(nlTestSuite * inSuite, void * inContext)
+{
+    RttEstimator estimator;
+    for (int i = 0; i < 64; i++)
+    {
+        estimator.AddSample((i % 2) ? 600_ms : 200_ms);
+    }
+
+    // The variation keeps the timeout above the slowest round trips.
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() > 300_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() < 500_ms32);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() > 600_ms32);
+}
+
+void TestBounds(nlTestSuite * inSuite, void * inContext)
+{
+    RttEstimator estimator;
+    estimator.AddSample(0_ms);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() == kMinTimeout);
+
+    estimator.Reset();
+    estimator.AddSample(System::Clock::Milliseconds64(UINT64_MAX));
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == RttEstimator::kMaxRetransTimeout);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout() == RttEstimator::kMaxRetransTimeout);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("FirstSample", TestFirstSample),
+    NL_TEST_DEF("SteadyFastPeer", TestSteadyFastPeer),
+    NL_TEST_DEF("SlowPeer", TestSlowPeer),
+    NL_TEST_DEF("JitteryPeer", TestJitteryPeer),
+    NL_TEST_DEF("Bounds", TestBounds),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestReliableMessageRttEstimator()
+{
+    nlTestSuite theSuite = { "Test-CHIP-ReliableMessageRttEstimator", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestReliableMessageRttEstimator)
@@ -0,0 +1,180 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a pool of worker threads that process CHIP device events off the CHIP task, which
+ *      platforms with threads use to run background work (e.g. CASE certificate validation and signatures)
+ *      in parallel.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <pthread.h>
+#include <queue>
+#include <vector>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/CHIPDeviceEvent.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ *  @class DeviceWorkerPool
+ *
+ *  @brief
+ *      A FIFO queue of device events, bounded to a maximum number of pending events, and the threads that dispatch
+ *      them. Each event is dispatched by exactly one worker, and the workers dispatch events concurrently with each
+ *      other, so the dispatch function and the work it runs must be thread-safe.
+ */
+class DeviceWorkerPool
+{
+public:
+    using DispatchFunct = void (*)(const ChipDeviceEvent & event, void * context);
+
+    DeviceWorkerPool() = default;
+    ~DeviceWorkerPool() { Stop(); }
+
+    /**
+     * Start accepting events, and start @a threadCount workers that dispatch them with @a dispatch. With no workers,
+     * events are only dispatched by threads that call RunWorker().
+     */
+    CHIP_ERROR Start(size_t threadCount, size_t maxPendingEvents, DispatchFunct dispatch, void * context)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            VerifyOrReturnError(!mRunning && mThreads.empty(), CHIP_ERROR_INCORRECT_STATE);
+            VerifyOrReturnError(dispatch != nullptr && maxPendingEvents > 0, CHIP_ERROR_INVALID_ARGUMENT);
+            mDispatch         = dispatch;
+            mContext          = context;
+            mMaxPendingEvents = maxPendingEvents;
+            mRunning          = true;
+        }
+
+        int err = 0;
+        mThreads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount && err == 0; i++)
+        {
+            pthread_t thread;
+            err = pthread_create(&thread, nullptr, WorkerMain, this);
+            if (err == 0)
+            {
+                mThreads.push_back(thread);
+            }
+        }
+
+        if (err != 0)
+        {
+            Stop();
+        }
+        return CHIP_ERROR_POSIX(err);
+    }
+
+    /**
+     * Stop accepting events and wait for the workers to exit. Events that were accepted before are still dispatched,
+     * so that work that holds resources until it has run is not lost. Must not be called from a worker.
+     */
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mRunning = false;
+        }
+        mEventPosted.notify_all();
+
+        for (pthread_t thread : mThreads)
+        {
+            VerifyOrDie(pthread_equal(thread, pthread_self()) == 0);
+            pthread_join(thread, nullptr);
+        }
+        mThreads.clear();
+    }
+
+    bool IsRunning()
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mRunning;
+    }
+
+    /**
+     * Queue @a event for dispatch by the next idle worker. May be called from any thread, including a worker.
+     */
+    CHIP_ERROR Post(const ChipDeviceEvent & event)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+            VerifyOrReturnError(mEventQueue.size() < mMaxPendingEvents, CHIP_ERROR_NO_MEMORY);
+            mEventQueue.push(event);
+        }
+        mEventPosted.notify_one();
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Dispatch events on the calling thread until the pool is stopped and its queue is empty.
+     */
+    void RunWorker()
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+        for (;;)
+        {
+            mEventPosted.wait(lock, [this] { return !mEventQueue.empty() || !mRunning; });
+            if (mEventQueue.empty())
+            {
+                return;
+            }
+
+            const ChipDeviceEvent event = mEventQueue.front();
+            mEventQueue.pop();
+
+            lock.unlock();
+            mDispatch(event, mContext);
+            lock.lock();
+        }
+    }
+
+private:
+    static void * WorkerMain(void * arg)
+    {
+        static_cast<DeviceWorkerPool *>(arg)->RunWorker();
+        return nullptr;
+    }
+
+    std::mutex mLock;
+    std::condition_variable mEventPosted;
+    std::queue<ChipDeviceEvent> mEventQueue;
+    std::vector<pthread_t> mThreads;
+    DispatchFunct mDispatch  = nullptr;
+    void * mContext          = nullptr;
+    size_t mMaxPendingEvents = 0;
+    bool mRunning            = false;
+
+    DeviceWorkerPool(const DeviceWorkerPool &)             = delete;
+    DeviceWorkerPool & operator=(const DeviceWorkerPool &) = delete;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
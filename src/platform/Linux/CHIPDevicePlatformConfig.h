@@ -50,11 +50,52 @@
 #define CHIP_DEVICE_CONFIG_WITH_GLIB_MAIN_LOOP 0
 #endif
 
+// Run background work (CASE crypto) on a pool of worker threads, once the application has
+// called PlatformMgr().StartBackgroundEventLoopTask().
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+#define CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING 1
+#endif
+
+#ifndef CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT
+#define CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT 4
+#endif
+
+#ifndef CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
+#define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 32
+#endif
+
 // ========== Platform-specific Configuration =========
 
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+ *
+ * Store the KVS as an append-only log (see ChipLinuxStorageLog) rather than as an INI
+ * file that is rewritten on every write. An existing INI KVS file is imported on
+ * first use.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_COMMIT_WINDOW_MS
+ *
+ * When CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG is enabled, how long (in milliseconds)
+ * KVS writes are held back so that writes made in quick succession are synced to the
+ * log together. The default of 0 syncs every write before Put() or Delete() returns,
+ * as the stack expects of the KVS.
+ *
+ * A non-zero window makes Put() and Delete() return before the write is durable: it
+ * is visible to reads immediately, but is lost on a crash or power loss within the
+ * window. Pending writes are synced when the platform manager shuts down.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_COMMIT_WINDOW_MS
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_COMMIT_WINDOW_MS 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_COMMIT_WINDOW_MS
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
@@ -0,0 +1,529 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements an append-only log key-value store on Linux.
+ *
+ *         The log starts with an 8 byte magic, followed by records of:
+ *
+ *           - CRC-32 of the rest of the record (32 bits)
+ *           - record type (8 bits)
+ *           - key length (16 bits)
+ *           - value length (32 bits, 0 for deletes)
+ *           - key
+ *           - value
+ *
+ *         with all integers little-endian.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <libgen.h>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/Base64.h>
+#include <lib/support/CRC32.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kMagic[]         = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kRecordHeaderSize = 4 + 1 + 2 + 4;
+
+// Same limit as ChipLinuxStorage::WriteValueBin().
+constexpr size_t kMaxValueSize = 5 * 1024;
+
+// Once this much is pending, writes are committed right away rather than at the end of the commit window.
+constexpr size_t kMaxPendingSize = 16 * 1024;
+
+// Logs smaller than this are not compacted, whatever their share of stale records.
+constexpr size_t kMinCompactionSize = 16 * 1024;
+
+size_t RecordSize(size_t keySize, size_t valueSize)
+{
+    return kRecordHeaderSize + keySize + valueSize;
+}
+
+CHIP_ERROR ReadFile(int fd, std::vector<uint8_t> & data)
+{
+    struct stat st;
+    VerifyOrReturnError(fstat(fd, &st) == 0, CHIP_ERROR_POSIX(errno));
+    data.resize(static_cast<size_t>(st.st_size));
+
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        ssize_t result = pread(fd, data.data() + offset, data.size() - offset, static_cast<off_t>(offset));
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(result >= 0, CHIP_ERROR_POSIX(errno));
+        if (result == 0)
+        {
+            // The file shrank since fstat().
+            break;
+        }
+        offset += static_cast<size_t>(result);
+    }
+    data.resize(offset);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteFile(int fd, const uint8_t * data, size_t length, size_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t result = pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(result >= 0, CHIP_ERROR_POSIX(errno));
+        data += result;
+        length -= static_cast<size_t>(result);
+        offset += static_cast<size_t>(result);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Sync the directory holding path, so that a file created in or renamed into it is durable.
+CHIP_ERROR SyncDirectoryOf(const std::string & path)
+{
+    std::string pathCopy = path;
+    int fd               = open(dirname(&pathCopy[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    VerifyOrReturnError(fd != -1, CHIP_ERROR_POSIX(errno));
+    int result = fsync(fd);
+    int error  = errno;
+    close(fd);
+    return (result == 0) ? CHIP_NO_ERROR : CHIP_ERROR_POSIX(error);
+}
+
+} // namespace
+
+ChipLinuxStorageLog::~ChipLinuxStorageLog()
+{
+    Shutdown();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * file, System::Clock::Milliseconds32 commitWindow)
+{
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS log file: %s", file);
+    if (mFd != -1)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS log file: %s", file);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath.assign(file);
+    mCommitWindow = commitWindow;
+    mShutdown     = false;
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to load KVS log %s: %" CHIP_ERROR_FORMAT, file, err.Format());
+        if (mFd != -1)
+        {
+            close(mFd);
+            mFd = -1;
+        }
+        mValues.clear();
+        return err;
+    }
+
+    if (mCommitWindow.count() > 0)
+    {
+        mCommitter = std::thread(&ChipLinuxStorageLog::CommitterMain, this);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mShutdown = true;
+    }
+    mCommitRequested.notify_one();
+    if (mCommitter.joinable())
+    {
+        mCommitter.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturn(mFd != -1);
+    CommitLocked();
+    close(mFd);
+    mFd = -1;
+    mValues.clear();
+    mPending.clear();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    VerifyOrReturnError(key != nullptr && value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    const std::vector<uint8_t> & stored = it->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t totalSizeToRead = stored.size() - offset;
+    size_t copySize        = std::min(valueSize, totalSizeToRead);
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+    if (copySize > 0)
+    {
+        memcpy(value, stored.data() + offset, copySize);
+    }
+
+    return (valueSize < totalSizeToRead) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Put(const char * key, const void * value, size_t valueSize)
+{
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(valueSize <= kMaxValueSize, CHIP_ERROR_INVALID_ARGUMENT);
+    std::string keyString(key);
+    VerifyOrReturnError(keyString.size() <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+    bool wasPending       = !mPending.empty();
+    AppendRecord(mPending, RecordType::kPut, keyString, bytes, valueSize);
+
+    auto it = mValues.find(keyString);
+    if (it != mValues.end())
+    {
+        mLiveSize -= RecordSize(it->first.size(), it->second.size());
+        it->second.assign(bytes, bytes + valueSize);
+    }
+    else
+    {
+        mValues.emplace(keyString, std::vector<uint8_t>(bytes, bytes + valueSize));
+    }
+    mLiveSize += RecordSize(keyString.size(), valueSize);
+
+    return ScheduleCommitLocked(wasPending);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    bool wasPending = !mPending.empty();
+    AppendRecord(mPending, RecordType::kDelete, it->first, nullptr, 0);
+    mLiveSize -= RecordSize(it->first.size(), it->second.size());
+    mValues.erase(it);
+
+    return ScheduleCommitLocked(wasPending);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Commit()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_INCORRECT_STATE);
+    return CommitLocked();
+}
+
+void ChipLinuxStorageLog::AppendRecord(std::vector<uint8_t> & buffer, RecordType type, const std::string & key,
+                                       const uint8_t * value, size_t valueSize)
+{
+    size_t start = buffer.size();
+    buffer.resize(start + RecordSize(key.size(), valueSize));
+
+    uint8_t * record = buffer.data() + start;
+    record[4]        = to_underlying(type);
+    Encoding::LittleEndian::Put16(record + 5, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(record + 7, static_cast<uint32_t>(valueSize));
+    memcpy(record + kRecordHeaderSize, key.data(), key.size());
+    if (valueSize > 0)
+    {
+        memcpy(record + kRecordHeaderSize + key.size(), value, valueSize);
+    }
+    Encoding::LittleEndian::Put32(record, Crc32(record + 4, buffer.size() - start - 4));
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load()
+{
+    mValues.clear();
+    mPending.clear();
+    mLiveSize = sizeof(kMagic);
+
+    mFd = open(mPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(mFd != -1, CHIP_ERROR_POSIX(errno));
+
+    std::vector<uint8_t> data;
+    ReturnErrorOnFailure(ReadFile(mFd, data));
+
+    if (data.empty())
+    {
+        // New log.
+        ReturnErrorOnFailure(WriteFile(mFd, kMagic, sizeof(kMagic), 0));
+        VerifyOrReturnError(fsync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+        ReturnErrorOnFailure(SyncDirectoryOf(mPath));
+        mLogSize = sizeof(kMagic);
+        return CHIP_NO_ERROR;
+    }
+
+    if (data.size() < sizeof(kMagic) || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0)
+    {
+        return Import(data);
+    }
+
+    size_t offset = sizeof(kMagic);
+    while (data.size() - offset >= kRecordHeaderSize)
+    {
+        const uint8_t * record = data.data() + offset;
+        uint8_t type           = record[4];
+        size_t keySize         = Encoding::LittleEndian::Get16(record + 5);
+        size_t valueSize       = Encoding::LittleEndian::Get32(record + 7);
+        size_t recordSize      = RecordSize(keySize, valueSize);
+
+        if (recordSize > data.size() - offset ||
+            Encoding::LittleEndian::Get32(record) != Crc32(record + 4, recordSize - 4) ||
+            (type != to_underlying(RecordType::kPut) && type != to_underlying(RecordType::kDelete)))
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keySize);
+        auto it = mValues.find(key);
+        if (it != mValues.end())
+        {
+            mLiveSize -= RecordSize(keySize, it->second.size());
+            mValues.erase(it);
+        }
+
+        if (type == to_underlying(RecordType::kPut))
+        {
+            const uint8_t * value = record + kRecordHeaderSize + keySize;
+            mValues.emplace(std::move(key), std::vector<uint8_t>(value, value + valueSize));
+            mLiveSize += recordSize;
+        }
+
+        offset += recordSize;
+    }
+
+    if (offset < data.size())
+    {
+        // The tail was torn by a crash in the middle of a commit; drop it so that new records follow the last complete one.
+        ChipLogError(DeviceLayer, "Dropping %u bytes of incomplete records from KVS log %s",
+                     static_cast<unsigned>(data.size() - offset), mPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(offset)) == 0, CHIP_ERROR_POSIX(errno));
+        VerifyOrReturnError(fsync(mFd) == 0, CHIP_ERROR_POSIX(errno));
+    }
+    mLogSize      = offset;
+    mHasIniBackup = access(IniBackupPath().c_str(), F_OK) == 0;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Import(const std::vector<uint8_t> & iniData)
+{
+    ChipLogProgress(DeviceLayer, "Importing INI KVS file %s into a KVS log", mPath.c_str());
+
+    inipp::Ini<char> ini;
+    std::istringstream stream(std::string(iniData.begin(), iniData.end()));
+    ini.parse(stream);
+
+    for (const auto & entry : ini.sections["DEFAULT"])
+    {
+        std::string key = IniEscaping::UnescapeKey(entry.first);
+        VerifyOrReturnError(!key.empty() && key.size() <= UINT16_MAX, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+        // ChipLinuxStorage stores KVS values base64 encoded.
+        std::vector<uint8_t> value(BASE64_MAX_DECODED_LEN(entry.second.size()));
+        uint32_t valueSize = Base64Decode32(entry.second.data(), static_cast<uint32_t>(entry.second.size()), value.data());
+        VerifyOrReturnError(valueSize != UINT32_MAX, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+        value.resize(valueSize);
+
+        mLiveSize += RecordSize(key.size(), value.size());
+        mValues[key] = std::move(value);
+    }
+
+    // Keep the INI file under another name until the log has committed a write, so that its values are not lost if the
+    // log turns out to be unusable.
+    std::string backupPath = IniBackupPath();
+    unlink(backupPath.c_str());
+    VerifyOrReturnError(link(mPath.c_str(), backupPath.c_str()) == 0, CHIP_ERROR_POSIX(errno));
+    mHasIniBackup = true;
+
+    return Compact();
+}
+
+void ChipLinuxStorageLog::RemoveIniBackup()
+{
+    std::string backupPath = IniBackupPath();
+    if (unlink(backupPath.c_str()) != 0 && errno != ENOENT)
+    {
+        ChipLogError(DeviceLayer, "Failed to remove INI KVS backup %s: %" CHIP_ERROR_FORMAT, backupPath.c_str(),
+                     CHIP_ERROR_POSIX(errno).Format());
+        return;
+    }
+    mHasIniBackup = false;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::vector<uint8_t> data(kMagic, kMagic + sizeof(kMagic));
+    for (const auto & entry : mValues)
+    {
+        AppendRecord(data, RecordType::kPut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    std::string tmpPath = mPath + "-XXXXXX";
+    int fd              = mkostemp(&tmpPath[0], O_CLOEXEC);
+    VerifyOrReturnError(fd != -1, CHIP_ERROR_POSIX(errno));
+
+    CHIP_ERROR err = WriteFile(fd, data.data(), data.size(), 0);
+    if (err == CHIP_NO_ERROR && fsync(fd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mPath.c_str()) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    // The rename is done, so the new file is the log whether or not syncing the directory succeeds.
+    if (mFd != -1)
+    {
+        close(mFd);
+    }
+    mFd      = fd;
+    mLogSize = data.size();
+    return SyncDirectoryOf(mPath);
+}
+
+CHIP_ERROR ChipLinuxStorageLog::CommitLocked()
+{
+    VerifyOrReturnError(!mPending.empty(), CHIP_NO_ERROR);
+
+    CHIP_ERROR err = WriteFile(mFd, mPending.data(), mPending.size(), mLogSize);
+    if (err == CHIP_NO_ERROR && fdatasync(mFd) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        // Keep the writes pending, to be retried by the next commit. Whatever part of them made it to the file will be
+        // overwritten, or dropped as incomplete when the log is next loaded.
+        ChipLogError(DeviceLayer, "Failed to commit KVS log %s: %" CHIP_ERROR_FORMAT, mPath.c_str(), err.Format());
+        return err;
+    }
+
+    mLogSize += mPending.size();
+    mPending.clear();
+
+    if (mHasIniBackup)
+    {
+        RemoveIniBackup();
+    }
+
+    if (mLogSize >= kMinCompactionSize && mLogSize > 2 * mLiveSize)
+    {
+        // The log is still complete if compaction fails, it just stays large.
+        CHIP_ERROR compactErr = Compact();
+        if (compactErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "Failed to compact KVS log %s: %" CHIP_ERROR_FORMAT, mPath.c_str(), compactErr.Format());
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ScheduleCommitLocked(bool wasPending)
+{
+    if (mCommitWindow.count() == 0 || mPending.size() >= kMaxPendingSize)
+    {
+        return CommitLocked();
+    }
+
+    if (!wasPending)
+    {
+        mPendingSince = std::chrono::steady_clock::now();
+        mCommitRequested.notify_one();
+    }
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::CommitterMain()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (!mShutdown)
+    {
+        if (mPending.empty())
+        {
+            mCommitRequested.wait(lock);
+        }
+        else if (std::chrono::steady_clock::now() < mPendingSince + mCommitWindow)
+        {
+            mCommitRequested.wait_until(lock, mPendingSince + mCommitWindow);
+        }
+        else if (CommitLocked() != CHIP_NO_ERROR)
+        {
+            // Retry after another window.
+            mPendingSince = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a key-value store persisted as an append-only
+ *         log of put and delete records, used as the KVS backend on Linux
+ *         when CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG is enabled.
+ *
+ *         Unlike ChipLinuxStorage, which rewrites the whole INI file on
+ *         every commit, a write only appends a record. Writes made within
+ *         the commit window are appended and synced together, and the log
+ *         is rewritten (compacted) once it holds mostly stale records.
+ *
+ *         Every record carries a CRC, so a record torn by a crash or power
+ *         loss is detected and dropped, together with everything after it,
+ *         when the log is next loaded. Compaction writes a new file and
+ *         rename()s it over the log, so it is atomic as well.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog();
+
+    /**
+     * Load the log at @a file, creating it if it doesn't exist.
+     *
+     * A file in the INI format of ChipLinuxStorage is imported and replaced by a log holding the same values. The INI file
+     * is kept as @a file with an ".ini" suffix until the log has committed a write.
+     *
+     * @param file          path of the log
+     * @param commitWindow  how long writes are held back so they can be synced together, 0 to sync every write
+     */
+    CHIP_ERROR Init(const char * file, System::Clock::Milliseconds32 commitWindow);
+
+    /**
+     * Commit any pending writes and close the log.
+     */
+    void Shutdown();
+
+    /**
+     * Read the value of @a key with the semantics of KeyValueStoreManager::Get().
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset);
+
+    /**
+     * Set the value of @a key. The write is visible to Get() immediately, and durable once committed: before returning with a
+     * commit window of 0, otherwise at the latest after the commit window.
+     */
+    CHIP_ERROR Put(const char * key, const void * value, size_t valueSize);
+
+    /**
+     * Delete @a key, returning CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND if it has no value.
+     */
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Append and sync any pending writes now.
+     */
+    CHIP_ERROR Commit();
+
+private:
+    enum class RecordType : uint8_t
+    {
+        kPut    = 1,
+        kDelete = 2,
+    };
+
+    static void AppendRecord(std::vector<uint8_t> & buffer, RecordType type, const std::string & key, const uint8_t * value,
+                             size_t valueSize);
+
+    CHIP_ERROR Load();
+    CHIP_ERROR Import(const std::vector<uint8_t> & iniData);
+    std::string IniBackupPath() const { return mPath + ".ini"; }
+    void RemoveIniBackup();
+    CHIP_ERROR Compact();
+    CHIP_ERROR CommitLocked();
+    CHIP_ERROR ScheduleCommitLocked(bool wasPending);
+    void CommitterMain();
+
+    std::mutex mLock;
+    std::condition_variable mCommitRequested;
+    std::thread mCommitter;
+
+    std::string mPath;
+    int mFd = -1;
+    System::Clock::Milliseconds32 mCommitWindow{ 0 };
+
+    std::map<std::string, std::vector<uint8_t>> mValues;
+    // Records of writes not yet appended to the file.
+    std::vector<uint8_t> mPending;
+    std::chrono::steady_clock::time_point mPendingSince;
+    // Size of the file, and of the records it would hold if compacted.
+    size_t mLogSize    = 0;
+    size_t mLiveSize   = 0;
+    bool mShutdown     = false;
+    bool mHasIniBackup = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -44,5 +44,9 @@
 #define INET_CONFIG_NUM_UDP_ENDPOINTS 32
 #endif // INET_CONFIG_NUM_UDP_ENDPOINTS
 
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 16
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
 // On linux platform, we have sys/socket.h, so HAVE_SO_BINDTODEVICE should be set to 1
 #define HAVE_SO_BINDTODEVICE 1
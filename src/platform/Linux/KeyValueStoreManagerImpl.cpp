@@ -36,6 +36,26 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
+                                          size_t offset_bytes)
+{
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
+{
+    return mStorage.Put(key, value, value_size);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+{
+    return mStorage.Delete(key);
+}
+
+#else
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
@@ -110,6 +130,8 @@ exit:
     return err;
 }
 
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
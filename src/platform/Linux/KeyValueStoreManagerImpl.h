@@ -23,7 +23,12 @@
 
 #pragma once
 
+#include <platform/CHIPDeviceConfig.h>
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+#else
 #include <platform/Linux/CHIPLinuxStorage.h>
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
 
 namespace chip {
 namespace DeviceLayer {
@@ -36,14 +41,39 @@ public:
      * @brief
      * Initalize the KVS, must be called before using.
      */
-    CHIP_ERROR Init(const char * file) { return mStorage.Init(file); }
+    CHIP_ERROR Init(const char * file)
+    {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+        return mStorage.Init(file, System::Clock::Milliseconds32(CHIP_DEVICE_CONFIG_LINUX_KVS_COMMIT_WINDOW_MS));
+#else
+        return mStorage.Init(file);
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+    }
+
+    /**
+     * @brief
+     * Make every write durable, including writes still held back by the commit window of the KVS log.
+     */
+    CHIP_ERROR Commit()
+    {
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+        return mStorage.Commit();
+#else
+        // ChipLinuxStorage commits every write before returning.
+        return CHIP_NO_ERROR;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+    }
 
     CHIP_ERROR _Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size = nullptr, size_t offset = 0);
     CHIP_ERROR _Delete(const char * key);
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
 private:
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
+    DeviceLayer::Internal::ChipLinuxStorageLog mStorage;
+#else
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_APPEND_LOG
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
@@ -40,6 +40,7 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/DeviceControlServer.h>
 #include <platform/DeviceInstanceInfoProvider.h>
+#include <platform/KeyValueStoreManager.h>
 #include <platform/Linux/DeviceInstanceInfoProviderImpl.h>
 #include <platform/Linux/DiagnosticDataProviderImpl.h>
 #include <platform/PlatformManager.h>
@@ -274,6 +275,12 @@ void PlatformManagerImpl::_Shutdown()
 
     Internal::GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>::_Shutdown();
 
+    CHIP_ERROR err = PersistedStorage::KeyValueStoreMgrImpl().Commit();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to commit the KVS: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
 #if CHIP_DEVICE_CONFIG_WITH_GLIB_MAIN_LOOP
     g_main_loop_quit(mGLibMainLoop);
     g_thread_join(mGLibMainLoopThread);
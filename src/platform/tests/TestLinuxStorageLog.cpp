@@ -0,0 +1,309 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the append-only log
+ *      key-value store used on Linux.
+ *
+ */
+
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlunit-test.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr System::Clock::Milliseconds32 kNoCommitWindow(0);
+constexpr System::Clock::Milliseconds32 kLongCommitWindow(60 * 1000);
+
+std::string sLogPath;
+
+size_t GetFileSize(const std::string & path)
+{
+    struct stat st;
+    return (stat(path.c_str(), &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+}
+
+bool HasValue(ChipLinuxStorageLog & storage, const char * key, const char * expected)
+{
+    char value[64];
+    size_t readSize = 0;
+    return storage.Get(key, value, sizeof(value), &readSize, 0) == CHIP_NO_ERROR && readSize == strlen(expected) &&
+        memcmp(value, expected, readSize) == 0;
+}
+
+bool HasNoValue(ChipLinuxStorageLog & storage, const char * key)
+{
+    char value[64];
+    return storage.Get(key, value, sizeof(value), nullptr, 0) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+void TestPutGetDelete(nlTestSuite * inSuite, void * inContext)
+{
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, HasNoValue(storage, "a"));
+
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("empty", nullptr, 0) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "updated", 7) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("a") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("a") == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+        NL_TEST_ASSERT(inSuite, HasNoValue(storage, "a"));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "b", "updated"));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "empty", ""));
+
+        // Partial and offset reads.
+        char value[4];
+        size_t readSize = 0;
+        NL_TEST_ASSERT(inSuite, storage.Get("b", value, 3, &readSize, 0) == CHIP_ERROR_BUFFER_TOO_SMALL);
+        NL_TEST_ASSERT(inSuite, readSize == 3 && memcmp(value, "upd", 3) == 0);
+        NL_TEST_ASSERT(inSuite, storage.Get("b", value, sizeof(value), &readSize, 3) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readSize == 4 && memcmp(value, "ated", 4) == 0);
+        NL_TEST_ASSERT(inSuite, storage.Get("b", value, sizeof(value), &readSize, 8) == CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Everything is replayed from the log.
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasNoValue(storage, "a"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "b", "updated"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "empty", ""));
+}
+
+void TestTornRecord(nlTestSuite * inSuite, void * inContext)
+{
+    size_t sizeBeforeLastRecord = 0;
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        sizeBeforeLastRecord = GetFileSize(sLogPath);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+    }
+
+    // Simulate a crash in the middle of appending the last record.
+    NL_TEST_ASSERT(inSuite, truncate(sLogPath.c_str(), static_cast<off_t>(GetFileSize(sLogPath) - 2)) == 0);
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, GetFileSize(sLogPath) == sizeBeforeLastRecord);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+        NL_TEST_ASSERT(inSuite, HasNoValue(storage, "b"));
+        NL_TEST_ASSERT(inSuite, storage.Put("c", "third", 5) == CHIP_NO_ERROR);
+    }
+
+    // Corrupt the last record instead.
+    {
+        std::fstream file(sLogPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('X');
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+    NL_TEST_ASSERT(inSuite, HasNoValue(storage, "c"));
+}
+
+void TestCompaction(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t value[256];
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("kept", "value", 5) == CHIP_NO_ERROR);
+        for (int i = 0; i < 1000; i++)
+        {
+            memset(value, i, sizeof(value));
+            NL_TEST_ASSERT(inSuite, storage.Put("counter", value, sizeof(value)) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, storage.Put("deleted", "value", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("deleted") == CHIP_NO_ERROR);
+
+        // Without compaction the log would hold every one of the updates.
+        NL_TEST_ASSERT(inSuite, GetFileSize(sLogPath) < 100 * sizeof(value));
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "kept", "value"));
+    NL_TEST_ASSERT(inSuite, HasNoValue(storage, "deleted"));
+
+    uint8_t readValue[sizeof(value)];
+    size_t readSize = 0;
+    NL_TEST_ASSERT(inSuite, storage.Get("counter", readValue, sizeof(readValue), &readSize, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readSize == sizeof(value) && memcmp(readValue, value, sizeof(value)) == 0);
+}
+
+void TestCommitWindow(nlTestSuite * inSuite, void * inContext)
+{
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kLongCommitWindow) == CHIP_NO_ERROR);
+        size_t emptySize = GetFileSize(sLogPath);
+
+        // Writes within the window are visible, but not yet appended.
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+        NL_TEST_ASSERT(inSuite, GetFileSize(sLogPath) == emptySize);
+
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, GetFileSize(sLogPath) > emptySize);
+
+        // Shutting down commits what is pending.
+        NL_TEST_ASSERT(inSuite, storage.Put("c", "third", 5) == CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "b", "second"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "c", "third"));
+}
+
+void TestCommitWindowExpiry(nlTestSuite * inSuite, void * inContext)
+{
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), System::Clock::Milliseconds32(10)) == CHIP_NO_ERROR);
+    size_t emptySize = GetFileSize(sLogPath);
+
+    NL_TEST_ASSERT(inSuite, storage.Put("a", "first", 5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.Put("b", "second", 6) == CHIP_NO_ERROR);
+
+    // Both writes get committed, together, once the window has passed.
+    for (int i = 0; i < 500 && GetFileSize(sLogPath) == emptySize; i++)
+    {
+        usleep(10 * 1000);
+    }
+    NL_TEST_ASSERT(inSuite, GetFileSize(sLogPath) > emptySize);
+}
+
+void TestImportIni(nlTestSuite * inSuite, void * inContext)
+{
+    // As written by ChipLinuxStorage: escaped keys, base64 encoded values.
+    {
+        std::ofstream file(sLogPath);
+        file << "[DEFAULT]\n"
+             << "a=Zmlyc3Q=\n"
+             << "key\\x3dwith\\x20escapes=c2Vjb25k\n";
+    }
+
+    const size_t iniSize         = GetFileSize(sLogPath);
+    const std::string backupPath = sLogPath + ".ini";
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "first"));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "key=with escapes", "second"));
+    }
+
+    // The INI file is kept, also across restarts, until the log has committed a write.
+    NL_TEST_ASSERT(inSuite, GetFileSize(backupPath) == iniSize);
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, GetFileSize(backupPath) == iniSize);
+        NL_TEST_ASSERT(inSuite, storage.Put("a", "updated", 7) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, access(backupPath.c_str(), F_OK) != 0);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(sLogPath.c_str(), kNoCommitWindow) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "a", "updated"));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key=with escapes", "second"));
+}
+
+const nlTest sTests[] = { NL_TEST_DEF("Test PutGetDelete", TestPutGetDelete),
+                          NL_TEST_DEF("Test TornRecord", TestTornRecord),
+                          NL_TEST_DEF("Test Compaction", TestCompaction),
+                          NL_TEST_DEF("Test CommitWindow", TestCommitWindow),
+                          NL_TEST_DEF("Test CommitWindowExpiry", TestCommitWindowExpiry),
+                          NL_TEST_DEF("Test ImportIni", TestImportIni),
+                          NL_TEST_SENTINEL() };
+
+int TestLinuxStorageLog_Setup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestLinuxStorageLog_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+int TestLinuxStorageLog_Initialize(void * inContext)
+{
+    char path[] = "/tmp/chip_kvs_log_test-XXXXXX";
+    int fd      = mkstemp(path);
+    if (fd == -1)
+    {
+        return FAILURE;
+    }
+    close(fd);
+    // Start every test from a missing file.
+    unlink(path);
+    sLogPath = path;
+    return SUCCESS;
+}
+
+int TestLinuxStorageLog_Terminate(void * inContext)
+{
+    unlink(sLogPath.c_str());
+    unlink((sLogPath + ".ini").c_str());
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestLinuxStorageLog()
+{
+    nlTestSuite theSuite = {
+        .name       = "LinuxStorageLog tests",
+        .tests      = &sTests[0],
+        .setup      = TestLinuxStorageLog_Setup,
+        .tear_down  = TestLinuxStorageLog_Teardown,
+        .initialize = TestLinuxStorageLog_Initialize,
+        .terminate  = TestLinuxStorageLog_Terminate,
+    };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxStorageLog);
@@ -253,6 +253,64 @@ static void TestPlatformMgr_MockSystemLayer(nlTestSuite * inSuite, void * inCont
     DeviceLayer::SetSystemLayerForTesting(nullptr);
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+static std::atomic<int> sBackgroundWorkStarted;
+static std::atomic<int> sBackgroundWorkDone;
+static std::atomic<bool> sBackgroundWorkConcurrent;
+
+static void BackgroundWork(intptr_t)
+{
+    // Wait (bounded) for as many work items as there are workers to be running at the same time.
+    int started = ++sBackgroundWorkStarted;
+    for (size_t t = 0; started < CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT && t < 1000; t++)
+    {
+        chip::test_utils::SleepMillis(1);
+        started = sBackgroundWorkStarted;
+    }
+    if (started >= CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT)
+    {
+        sBackgroundWorkConcurrent = true;
+    }
+    sBackgroundWorkDone++;
+}
+
+static void TestPlatformMgr_BackgroundEventLoopTask(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kWorkItems = 2 * CHIP_DEVICE_CONFIG_BG_WORKER_THREAD_COUNT;
+
+    sBackgroundWorkStarted    = 0;
+    sBackgroundWorkDone       = 0;
+    sBackgroundWorkConcurrent = false;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = PlatformMgr().StartBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Only work functions are processed in the background.
+    ChipDeviceEvent event{ .Type = DeviceEventType::kChipLambdaEvent };
+    NL_TEST_ASSERT(inSuite, PlatformMgr().PostBackgroundEvent(&event) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The work runs without the CHIP event loop, on as many threads as are configured.
+    for (int i = 0; i < kWorkItems; i++)
+    {
+        err = PlatformMgr().ScheduleBackgroundWork(BackgroundWork);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    for (size_t t = 0; sBackgroundWorkDone != kWorkItems && t < 5000; t++)
+        chip::test_utils::SleepMillis(1);
+
+    err = PlatformMgr().StopBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkDone == kWorkItems);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkConcurrent);
+
+    PlatformMgr().Shutdown();
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -266,6 +324,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
     NL_TEST_DEF("Test mock System::Layer", TestPlatformMgr_MockSystemLayer),
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    NL_TEST_DEF("Test PlatformMgr::StartBackgroundEventLoopTask", TestPlatformMgr_BackgroundEventLoopTask),
+#endif
 
     NL_TEST_SENTINEL()
 };
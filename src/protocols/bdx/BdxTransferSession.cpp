@@ -1,7 +1,6 @@
 /**
  *    @file
  *      Implementation for the TransferSession class.
- *      // TODO: Support Asynchronous mode. Currently, only Synchronous mode is supported.
  */
 
 #include <protocols/bdx/BdxTransferSession.h>
@@ -206,6 +205,7 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     VerifyOrReturnError(proposedControlOpts.Has(acceptData.ControlMode), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(acceptData.MaxBlockSize <= mTransferRequestData.MaxBlockSize, CHIP_ERROR_INVALID_ARGUMENT);
 
+    mControlMode          = acceptData.ControlMode;
     mTransferMaxBlockSize = acceptData.MaxBlockSize;
 
     if (mRole == TransferRole::kSender)
@@ -251,6 +251,7 @@ CHIP_ERROR TransferSession::AcceptTransfer(const TransferAcceptData & acceptData
     mState = TransferState::kTransferInProgress;
 
     if ((mRole == TransferRole::kReceiver && mControlMode == TransferControlFlags::kSenderDrive) ||
+        (mRole == TransferRole::kReceiver && mControlMode == TransferControlFlags::kAsync) ||
         (mRole == TransferRole::kSender && mControlMode == TransferControlFlags::kReceiverDrive))
     {
         mAwaitingResponse = true;
@@ -318,10 +319,7 @@ CHIP_ERROR TransferSession::PrepareBlockQueryWithSkip(const uint64_t & bytesToSk
 
 CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
 {
-    VerifyOrReturnError(mState == TransferState::kTransferInProgress, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mRole == TransferRole::kSender, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mPendingOutput == OutputEventType::kNone, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(!mAwaitingResponse, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanPrepareBlock(), CHIP_ERROR_INCORRECT_STATE);
 
     // Verify non-zero data is provided and is no longer than MaxBlockSize (BlockEOF may contain 0 length data)
     VerifyOrReturnError((inData.Data != nullptr) && (inData.Length <= mTransferMaxBlockSize), CHIP_ERROR_INVALID_ARGUMENT);
@@ -345,6 +343,11 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
         mState = TransferState::kAwaitingEOFAck;
     }
 
+    if (mControlMode == TransferControlFlags::kAsync)
+    {
+        mNumBlocksInFlight++;
+    }
+
     mAwaitingResponse = true;
     mLastBlockNum     = mNextBlockNum++;
 
@@ -353,6 +356,20 @@ CHIP_ERROR TransferSession::PrepareBlock(const BlockData & inData)
     return CHIP_NO_ERROR;
 }
 
+bool TransferSession::CanPrepareBlock() const
+{
+    VerifyOrReturnValue(mState == TransferState::kTransferInProgress, false);
+    VerifyOrReturnValue(mRole == TransferRole::kSender, false);
+    VerifyOrReturnValue(mPendingOutput == OutputEventType::kNone, false);
+
+    if (mControlMode == TransferControlFlags::kAsync)
+    {
+        return mNumBlocksInFlight < kMaxBlocksInFlight;
+    }
+
+    return !mAwaitingResponse;
+}
+
 CHIP_ERROR TransferSession::PrepareBlockAck()
 {
     VerifyOrReturnError(mRole == TransferRole::kReceiver, CHIP_ERROR_INCORRECT_STATE);
@@ -421,6 +438,7 @@ void TransferSession::Reset()
     mNextBlockNum      = 0;
     mLastQueryNum      = 0;
     mNextQueryNum      = 0;
+    mNumBlocksInFlight = 0;
 
     mTimeout                = System::Clock::kZero;
     mTimeoutStartTime       = System::Clock::kZero;
@@ -598,7 +616,7 @@ void TransferSession::HandleReceiveAccept(System::PacketBufferHandle msgData)
     mPendingMsgHandle = std::move(msgData);
     mPendingOutput    = OutputEventType::kAcceptReceived;
 
-    mAwaitingResponse = (mControlMode == TransferControlFlags::kSenderDrive);
+    mAwaitingResponse = (mControlMode == TransferControlFlags::kSenderDrive) || (mControlMode == TransferControlFlags::kAsync);
     mState            = TransferState::kTransferInProgress;
 
 #if CHIP_AUTOMATION_LOGGING
@@ -645,6 +663,7 @@ void TransferSession::HandleBlockQuery(System::PacketBufferHandle msgData)
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mControlMode != TransferControlFlags::kAsync, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQuery query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
@@ -667,6 +686,7 @@ void TransferSession::HandleBlockQueryWithSkip(System::PacketBufferHandle msgDat
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+    VerifyOrReturn(mControlMode != TransferControlFlags::kAsync, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
     BlockQueryWithSkip query;
     const CHIP_ERROR err = query.Parse(std::move(msgData));
@@ -716,7 +736,15 @@ void TransferSession::HandleBlock(System::PacketBufferHandle msgData)
     mNumBytesProcessed += blockMsg.DataLength;
     mLastBlockNum = blockMsg.BlockCounter;
 
-    mAwaitingResponse = false;
+    if (mControlMode == TransferControlFlags::kAsync)
+    {
+        // In Asynchronous mode, the Sender sends the next Block without waiting for a query, so keep expecting it.
+        mLastQueryNum = blockMsg.BlockCounter + 1;
+    }
+    else
+    {
+        mAwaitingResponse = false;
+    }
 
 #if CHIP_AUTOMATION_LOGGING
     blockMsg.LogMessage(MessageType::Block);
@@ -758,9 +786,16 @@ void TransferSession::HandleBlockEOF(System::PacketBufferHandle msgData)
 void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
-    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
     VerifyOrReturn(mAwaitingResponse, PrepareStatusReport(StatusCode::kUnexpectedMessage));
 
+    if (mControlMode == TransferControlFlags::kAsync)
+    {
+        HandleAsyncBlockAck(std::move(msgData));
+        return;
+    }
+
+    VerifyOrReturn(mState == TransferState::kTransferInProgress, PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
     BlockAck ackMsg;
     const CHIP_ERROR err = ackMsg.Parse(std::move(msgData));
     VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
@@ -777,6 +812,37 @@ void TransferSession::HandleBlockAck(System::PacketBufferHandle msgData)
 #endif // CHIP_AUTOMATION_LOGGING
 }
 
+void TransferSession::HandleAsyncBlockAck(System::PacketBufferHandle msgData)
+{
+    // Blocks that are still in flight after the BlockEOF was sent may be acknowledged before the BlockEOF itself.
+    VerifyOrReturn((mState == TransferState::kTransferInProgress) || (mState == TransferState::kAwaitingEOFAck),
+                   PrepareStatusReport(StatusCode::kUnexpectedMessage));
+
+    BlockAck ackMsg;
+    const CHIP_ERROR err = ackMsg.Parse(std::move(msgData));
+    VerifyOrReturn(err == CHIP_NO_ERROR, PrepareStatusReport(StatusCode::kBadMessageContents));
+
+    // A BlockAck acknowledges its Block and all the ones before it, so it may release several of the Blocks in flight, which
+    // are the ones up to mLastBlockNum. The BlockEOF is only acknowledged by a BlockAckEOF.
+    const uint32_t numStillInFlight = mLastBlockNum - ackMsg.BlockCounter;
+    VerifyOrReturn(numStillInFlight < mNumBlocksInFlight, PrepareStatusReport(StatusCode::kBadBlockCounter));
+    VerifyOrReturn((mState == TransferState::kTransferInProgress) || (numStillInFlight > 0),
+                   PrepareStatusReport(StatusCode::kBadBlockCounter));
+
+    mNumBlocksInFlight = static_cast<uint16_t>(numStillInFlight);
+    mAwaitingResponse  = (mNumBlocksInFlight > 0);
+
+    // Once the BlockEOF is sent there is nothing left for the application to do with a BlockAck.
+    if (mState == TransferState::kTransferInProgress)
+    {
+        mPendingOutput = OutputEventType::kAckReceived;
+    }
+
+#if CHIP_AUTOMATION_LOGGING
+    ackMsg.LogMessage(MessageType::BlockAck);
+#endif // CHIP_AUTOMATION_LOGGING
+}
+
 void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
 {
     VerifyOrReturn(mRole == TransferRole::kSender, PrepareStatusReport(StatusCode::kUnexpectedMessage));
@@ -790,7 +856,8 @@ void TransferSession::HandleBlockAckEOF(System::PacketBufferHandle msgData)
 
     mPendingOutput = OutputEventType::kAckEOFReceived;
 
-    mAwaitingResponse = false;
+    mAwaitingResponse  = false;
+    mNumBlocksInFlight = 0;
 
     mState = TransferState::kTransferDone;
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <protocols/bdx/BdxMessages.h>
 #include <system/SystemClock.h>
@@ -24,6 +25,14 @@ enum class TransferRole : uint8_t
     kSender   = 1,
 };
 
+/**
+ * The largest Block data that fits in a single message over a session that allows large payloads (see
+ * Session::AllowsLargePayload()), such as a session over TCP. Such messages are not bound by the IPv6 MTU, only by the capacity
+ * of a packet buffer, which has to hold the Block counter and the MIC as well.
+ */
+inline constexpr uint16_t kMaxLargePayloadBlockSize =
+    static_cast<uint16_t>(System::PacketBuffer::kMaxSize - kMaxTagLen - sizeof(uint32_t));
+
 class DLL_EXPORT TransferSession
 {
 public:
@@ -244,6 +253,12 @@ public:
      * @brief
      *   Prepare a Block message. The Block counter will be populated automatically.
      *
+     *   In Asynchronous mode, the Sender does not wait for a BlockAck before it prepares the next Block, as long as fewer than
+     *   kMaxBlocksInFlight Blocks are unacknowledged (see CanPrepareBlock()). This relies on the transport to deliver the Blocks
+     *   reliably and in order, so Asynchronous mode should only be used over sessions that do not use MRP, such as sessions over
+     *   TCP. A Block must only be sent with kExpectResponse when the exchange does not expect a response yet, since an exchange
+     *   expects one response at a time.
+     *
      * @param inData Contains data for filling out the Block message
      *
      * @return CHIP_ERROR The result of the preparation of a Block message. May also indicate if the TransferSession object
@@ -251,6 +266,13 @@ public:
      */
     CHIP_ERROR PrepareBlock(const BlockData & inData);
 
+    /**
+     * @brief
+     *   Check whether the Sender can prepare a Block now: in a synchronous mode, when a Block was queried or acknowledged, and in
+     *   Asynchronous mode, when fewer than kMaxBlocksInFlight Blocks are unacknowledged.
+     */
+    bool CanPrepareBlock() const;
+
     /**
      * @brief
      *   Prepare a BlockAck message. The Block counter will be populated automatically.
@@ -300,6 +322,7 @@ public:
     uint32_t GetNextBlockNum() const { return mNextBlockNum; }
     uint32_t GetNextQueryNum() const { return mNextQueryNum; }
     size_t GetNumBytesProcessed() const { return mNumBytesProcessed; }
+    uint16_t GetNumBlocksInFlight() const { return mNumBlocksInFlight; }
     const uint8_t * GetFileDesignator(uint16_t & fileDesignatorLen) const
     {
         fileDesignatorLen = mTransferRequestData.FileDesLength;
@@ -308,6 +331,10 @@ public:
 
     TransferSession();
 
+    /// The number of Blocks that a Sender in Asynchronous mode sends before it waits for a BlockAck.
+    static constexpr uint16_t kMaxBlocksInFlight = CHIP_CONFIG_BDX_MAX_BLOCKS_IN_FLIGHT;
+    static_assert(kMaxBlocksInFlight > 0, "An asynchronous BDX transfer needs to send at least one Block at a time");
+
 private:
     enum class TransferState : uint8_t
     {
@@ -333,6 +360,7 @@ private:
     void HandleBlock(System::PacketBufferHandle msgData);
     void HandleBlockEOF(System::PacketBufferHandle msgData);
     void HandleBlockAck(System::PacketBufferHandle msgData);
+    void HandleAsyncBlockAck(System::PacketBufferHandle msgData);
     void HandleBlockAckEOF(System::PacketBufferHandle msgData);
 
     /**
@@ -382,6 +410,9 @@ private:
     uint32_t mLastQueryNum = 0;
     uint32_t mNextQueryNum = 0;
 
+    // Blocks sent in Asynchronous mode that are not acknowledged yet. They are the ones up to mLastBlockNum.
+    uint16_t mNumBlocksInFlight = 0;
+
     System::Clock::Timeout mTimeout            = System::Clock::kZero;
     System::Clock::Timestamp mTimeoutStartTime = System::Clock::kZero;
     bool mShouldInitTimeoutStart               = true;
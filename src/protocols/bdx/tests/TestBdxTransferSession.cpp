@@ -534,6 +534,116 @@ void TestInitiatingSenderSenderDrive(nlTestSuite * inSuite, void * inContext)
     SendAndVerifyBlockAck(inSuite, inContext, initiatingSender, respondingReceiver, outEvent, true);
 }
 
+// Full transfer test using Asynchronous mode, where the Sender keeps several Blocks in flight and the Receiver acknowledges them
+void TestInitiatingReceiverAsync(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TransferSession::OutputEvent outEvent;
+    TransferSession initiatingReceiver;
+    TransferSession respondingSender;
+    uint32_t numBlocksSent = 0;
+
+    // Chosen arbitrarily for this test
+    uint16_t transferBlockSize     = 64;
+    System::Clock::Timeout timeout = System::Clock::Seconds16(24);
+
+    // The Receiver proposes Asynchronous mode along with a synchronous one to fall back to, and the Sender supports both.
+    BitFlags<TransferControlFlags> proposedOpts(TransferControlFlags::kAsync, TransferControlFlags::kReceiverDrive);
+
+    TransferSession::TransferInitData initOptions;
+    initOptions.TransferCtlFlags = proposedOpts;
+    initOptions.MaxBlockSize     = transferBlockSize;
+    char testFileDes[9]          = { "test.txt" };
+    initOptions.FileDesLength    = static_cast<uint16_t>(strlen(testFileDes));
+    initOptions.FileDesignator   = reinterpret_cast<uint8_t *>(testFileDes);
+
+    SendAndVerifyTransferInit(inSuite, inContext, outEvent, timeout, initiatingReceiver, TransferRole::kReceiver, initOptions,
+                              respondingSender, proposedOpts, transferBlockSize);
+
+    TransferSession::TransferAcceptData acceptData;
+    acceptData.ControlMode  = TransferControlFlags::kAsync;
+    acceptData.MaxBlockSize = transferBlockSize;
+    acceptData.StartOffset  = 0;
+    acceptData.Length       = 0;
+
+    SendAndVerifyAcceptMsg(inSuite, inContext, outEvent, respondingSender, TransferRole::kSender, acceptData, initiatingReceiver,
+                           initOptions);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetControlMode() == TransferControlFlags::kAsync);
+    NL_TEST_ASSERT(inSuite, initiatingReceiver.GetControlMode() == TransferControlFlags::kAsync);
+
+    // The Receiver does not query Blocks in Asynchronous mode
+    err = initiatingReceiver.PrepareBlockQuery();
+    NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, initiatingReceiver);
+
+    // Fill the window without waiting for a BlockAck
+    while (numBlocksSent < TransferSession::kMaxBlocksInFlight)
+    {
+        NL_TEST_ASSERT(inSuite, respondingSender.CanPrepareBlock());
+        SendAndVerifyArbitraryBlock(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, false, numBlocksSent);
+        numBlocksSent++;
+    }
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == TransferSession::kMaxBlocksInFlight);
+
+    // Test that no more Blocks can be prepared until one is acknowledged
+    System::PacketBufferHandle fakeBuf = System::PacketBufferHandle::New(transferBlockSize);
+    if (fakeBuf.IsNull())
+    {
+        NL_TEST_ASSERT(inSuite, false);
+        return;
+    }
+    TransferSession::BlockData prematureBlock;
+    prematureBlock.Data   = fakeBuf->Start();
+    prematureBlock.Length = transferBlockSize;
+    prematureBlock.IsEof  = false;
+    NL_TEST_ASSERT(inSuite, !respondingSender.CanPrepareBlock());
+    err = respondingSender.PrepareBlock(prematureBlock);
+    NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, respondingSender);
+
+    // One BlockAck for the last Block acknowledges the whole window
+    SendAndVerifyBlockAck(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, false);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 0);
+
+    // A BlockAck that arrives after more Blocks were sent only releases the Blocks up to its counter
+    SendAndVerifyArbitraryBlock(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, false, numBlocksSent++);
+    err = initiatingReceiver.PrepareBlockAck();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(inSuite, inContext, outEvent, MessageType::BlockAck);
+    TransferSession::MessageTypeData ackMsgTypeData = outEvent.msgTypeData;
+    System::PacketBufferHandle ackMsg               = std::move(outEvent.MsgData);
+
+    SendAndVerifyArbitraryBlock(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, false, numBlocksSent++);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 2);
+
+    err = AttachHeaderAndSend(ackMsgTypeData, std::move(ackMsg), respondingSender);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    respondingSender.PollOutput(outEvent, kNoAdvanceTime);
+    NL_TEST_ASSERT(inSuite, outEvent.EventType == TransferSession::OutputEventType::kAckReceived);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 1);
+
+    // A BlockAck for a Block that is still in flight when the BlockEOF is sent is accepted without any output, and the BlockAckEOF
+    // completes the transfer
+    err = initiatingReceiver.PrepareBlockAck();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    initiatingReceiver.PollOutput(outEvent, kNoAdvanceTime);
+    VerifyBdxMessageToSend(inSuite, inContext, outEvent, MessageType::BlockAck);
+    ackMsgTypeData = outEvent.msgTypeData;
+    ackMsg         = std::move(outEvent.MsgData);
+
+    SendAndVerifyArbitraryBlock(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, true, numBlocksSent++);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 2);
+
+    err = AttachHeaderAndSend(ackMsgTypeData, std::move(ackMsg), respondingSender);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    VerifyNoMoreOutput(inSuite, inContext, respondingSender);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 1);
+
+    SendAndVerifyBlockAck(inSuite, inContext, respondingSender, initiatingReceiver, outEvent, true);
+    NL_TEST_ASSERT(inSuite, respondingSender.GetNumBlocksInFlight() == 0);
+}
+
 // Test that calls to AcceptTransfer() with bad parameters result in an error.
 void TestBadAcceptMessageFields(nlTestSuite * inSuite, void * inContext)
 {
@@ -745,6 +855,7 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("TestInitiatingReceiverReceiverDrive", TestInitiatingReceiverReceiverDrive),
     NL_TEST_DEF("TestInitiatingSenderSenderDrive", TestInitiatingSenderSenderDrive),
+    NL_TEST_DEF("TestInitiatingReceiverAsync", TestInitiatingReceiverAsync),
     NL_TEST_DEF("TestBadAcceptMessageFields", TestBadAcceptMessageFields),
     NL_TEST_DEF("TestTimeout", TestTimeout),
     NL_TEST_DEF("TestDuplicateBlockError", TestDuplicateBlockError),
@@ -329,13 +329,36 @@ public:
     DATA mData;
 };
 
+struct CASESession::HandleSigma2Data
+{
+    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R2_Signed;
+    size_t msg_r2_signed_len;
+
+    ByteSpan responderNOC;
+    ByteSpan responderICAC;
+
+    uint8_t rootCertBuf[kMaxCHIPCertLength];
+    ByteSpan fabricRCAC;
+
+    P256ECDSASignature tbsData2Signature;
+
+    FabricId fabricId;
+    NodeId peerNodeId;
+
+    ValidationContext validContext;
+};
+
 struct CASESession::SendSigma3Data
 {
     FabricIndex fabricIndex;
 
-    // Use one or the other
+    // Use one of these
     const FabricTable * fabricTable;
     const Crypto::OperationalKeystore * keystore;
+    Platform::UniquePtr<Crypto::P256Keypair> opKeypair;
+
+    // Whether the signature is generated in the background.
+    bool SignsInBackground() const { return keystore != nullptr || opKeypair != nullptr; }
 
     chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R3_Signed;
     size_t msg_r3_signed_len;
@@ -388,6 +411,11 @@ void CASESession::Clear()
 {
     MATTER_TRACE_SCOPE("Clear", "CASESession");
     // Cancel any outstanding work.
+    if (mHandleSigma2Helper)
+    {
+        mHandleSigma2Helper->CancelWork();
+        mHandleSigma2Helper.reset();
+    }
     if (mSendSigma3Helper)
     {
         mSendSigma3Helper->CancelWork();
@@ -1177,13 +1205,11 @@ exit:
 CHIP_ERROR CASESession::HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg)
 {
     MATTER_TRACE_SCOPE("HandleSigma2_and_SendSigma3", "CASESession");
-    ReturnErrorOnFailure(HandleSigma2(std::move(msg)));
-    ReturnErrorOnFailure(SendSigma3a());
-
-    return CHIP_NO_ERROR;
+    // Sigma3 is sent by HandleSigma2c, once the responder's credentials and signature are verified in the background.
+    return HandleSigma2a(std::move(msg));
 }
 
-CHIP_ERROR CASESession::HandleSigma2(System::PacketBufferHandle && msg)
+CHIP_ERROR CASESession::HandleSigma2a(System::PacketBufferHandle && msg)
 {
     MATTER_TRACE_SCOPE("HandleSigma2", "CASESession");
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -1200,155 +1226,231 @@ CHIP_ERROR CASESession::HandleSigma2(System::PacketBufferHandle && msg)
     size_t msg_r2_encrypted_len          = 0;
     size_t msg_r2_encrypted_len_with_tag = 0;
 
-    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R2_Signed;
-    size_t msg_r2_signed_len;
     size_t max_msg_r2_signed_enc_len;
     constexpr size_t kCaseOverheadForFutureTbeData = 128;
 
     AutoReleaseSessionKey sr2k(*mSessionManager->GetSessionKeystore());
 
-    P256ECDSASignature tbsData2Signature;
-
-    NodeId responderNodeId;
-    P256PublicKey responderPublicKey;
-
     uint8_t responderRandom[kSigmaParamRandomNumberSize];
-    ByteSpan responderNOC;
-    ByteSpan responderICAC;
 
     uint16_t responderSessionId;
 
     ChipLogProgress(SecureChannel, "Received Sigma2 msg");
 
-    FabricId fabricId = kUndefinedFabricId;
+    auto helper = WorkHelper<HandleSigma2Data>::Create(*this, &HandleSigma2b, &CASESession::HandleSigma2c);
+    VerifyOrExit(helper, err = CHIP_ERROR_NO_MEMORY);
     {
-        VerifyOrExit(mFabricsTable != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-        const auto * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
-        VerifyOrExit(fabricInfo != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-        fabricId = fabricInfo->GetFabricId();
-    }
+        auto & data = helper->mData;
 
-    VerifyOrExit(mEphemeralKey != nullptr, err = CHIP_ERROR_INTERNAL);
-    VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+        {
+            VerifyOrExit(mFabricsTable != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+            const auto * fabricInfo = mFabricsTable->FindFabricWithIndex(mFabricIndex);
+            VerifyOrExit(fabricInfo != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+            data.fabricId = fabricInfo->GetFabricId();
+        }
+        data.peerNodeId = mPeerNodeId;
 
-    tlvReader.Init(std::move(msg));
-    SuccessOrExit(err = tlvReader.Next(containerType, TLV::AnonymousTag()));
-    SuccessOrExit(err = tlvReader.EnterContainer(containerType));
+        VerifyOrExit(mEphemeralKey != nullptr, err = CHIP_ERROR_INTERNAL);
+        VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
 
-    // Retrieve Responder's Random value
-    SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_ResponderRandom)));
-    SuccessOrExit(err = tlvReader.GetBytes(responderRandom, sizeof(responderRandom)));
+        tlvReader.Init(std::move(msg));
+        SuccessOrExit(err = tlvReader.Next(containerType, TLV::AnonymousTag()));
+        SuccessOrExit(err = tlvReader.EnterContainer(containerType));
 
-    // Assign Session ID
-    SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_UnsignedInteger, TLV::ContextTag(kTag_Sigma2_ResponderSessionId)));
-    SuccessOrExit(err = tlvReader.Get(responderSessionId));
+        // Retrieve Responder's Random value
+        SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_ResponderRandom)));
+        SuccessOrExit(err = tlvReader.GetBytes(responderRandom, sizeof(responderRandom)));
 
-    ChipLogDetail(SecureChannel, "Peer assigned session session ID %d", responderSessionId);
-    SetPeerSessionId(responderSessionId);
+        // Assign Session ID
+        SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_UnsignedInteger, TLV::ContextTag(kTag_Sigma2_ResponderSessionId)));
+        SuccessOrExit(err = tlvReader.Get(responderSessionId));
 
-    // Retrieve Responder's Ephemeral Pubkey
-    SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_ResponderEphPubKey)));
-    SuccessOrExit(err = tlvReader.GetBytes(mRemotePubKey, static_cast<uint32_t>(mRemotePubKey.Length())));
+        ChipLogDetail(SecureChannel, "Peer assigned session session ID %d", responderSessionId);
+        SetPeerSessionId(responderSessionId);
 
-    // Generate a Shared Secret
-    SuccessOrExit(err = mEphemeralKey->ECDH_derive_secret(mRemotePubKey, mSharedSecret));
+        // Retrieve Responder's Ephemeral Pubkey
+        SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_ResponderEphPubKey)));
+        SuccessOrExit(err = tlvReader.GetBytes(mRemotePubKey, static_cast<uint32_t>(mRemotePubKey.Length())));
 
-    // Generate the S2K key
-    {
-        MutableByteSpan saltSpan(msg_salt);
-        SuccessOrExit(err = ConstructSaltSigma2(ByteSpan(responderRandom), mRemotePubKey, ByteSpan(mIPK), saltSpan));
-        SuccessOrExit(err = DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR2Info), sr2k));
-    }
+        // Generate a Shared Secret
+        SuccessOrExit(err = mEphemeralKey->ECDH_derive_secret(mRemotePubKey, mSharedSecret));
 
-    SuccessOrExit(err = mCommissioningHash.AddData(ByteSpan{ buf, buflen }));
+        // Generate the S2K key
+        {
+            MutableByteSpan saltSpan(msg_salt);
+            SuccessOrExit(err = ConstructSaltSigma2(ByteSpan(responderRandom), mRemotePubKey, ByteSpan(mIPK), saltSpan));
+            SuccessOrExit(err = DeriveSigmaKey(saltSpan, ByteSpan(kKDFSR2Info), sr2k));
+        }
 
-    // Generate decrypted data
-    SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_Encrypted2)));
+        SuccessOrExit(err = mCommissioningHash.AddData(ByteSpan{ buf, buflen }));
 
-    max_msg_r2_signed_enc_len =
-        TLV::EstimateStructOverhead(Credentials::kMaxCHIPCertLength, Credentials::kMaxCHIPCertLength, tbsData2Signature.Length(),
-                                    SessionResumptionStorage::kResumptionIdSize, kCaseOverheadForFutureTbeData);
-    msg_r2_encrypted_len_with_tag = tlvReader.GetLength();
+        // Generate decrypted data
+        SuccessOrExit(err = tlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_Sigma2_Encrypted2)));
 
-    // Validate we did not receive a buffer larger than legal
-    VerifyOrExit(msg_r2_encrypted_len_with_tag <= max_msg_r2_signed_enc_len, err = CHIP_ERROR_INVALID_TLV_ELEMENT);
-    VerifyOrExit(msg_r2_encrypted_len_with_tag > CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, err = CHIP_ERROR_INVALID_TLV_ELEMENT);
-    VerifyOrExit(msg_R2_Encrypted.Alloc(msg_r2_encrypted_len_with_tag), err = CHIP_ERROR_NO_MEMORY);
+        max_msg_r2_signed_enc_len = TLV::EstimateStructOverhead(Credentials::kMaxCHIPCertLength, Credentials::kMaxCHIPCertLength,
+                                                                data.tbsData2Signature.Length(),
+                                                                SessionResumptionStorage::kResumptionIdSize,
+                                                                kCaseOverheadForFutureTbeData);
+        msg_r2_encrypted_len_with_tag = tlvReader.GetLength();
 
-    SuccessOrExit(err = tlvReader.GetBytes(msg_R2_Encrypted.Get(), static_cast<uint32_t>(msg_r2_encrypted_len_with_tag)));
-    msg_r2_encrypted_len = msg_r2_encrypted_len_with_tag - CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+        // Validate we did not receive a buffer larger than legal
+        VerifyOrExit(msg_r2_encrypted_len_with_tag <= max_msg_r2_signed_enc_len, err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+        VerifyOrExit(msg_r2_encrypted_len_with_tag > CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES, err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+        VerifyOrExit(msg_R2_Encrypted.Alloc(msg_r2_encrypted_len_with_tag), err = CHIP_ERROR_NO_MEMORY);
 
-    SuccessOrExit(err = AES_CCM_decrypt(msg_R2_Encrypted.Get(), msg_r2_encrypted_len, nullptr, 0,
-                                        msg_R2_Encrypted.Get() + msg_r2_encrypted_len, CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
-                                        sr2k.KeyHandle(), kTBEData2_Nonce, kTBEDataNonceLength, msg_R2_Encrypted.Get()));
+        SuccessOrExit(err = tlvReader.GetBytes(msg_R2_Encrypted.Get(), static_cast<uint32_t>(msg_r2_encrypted_len_with_tag)));
+        msg_r2_encrypted_len = msg_r2_encrypted_len_with_tag - CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
 
-    decryptedDataTlvReader.Init(msg_R2_Encrypted.Get(), msg_r2_encrypted_len);
-    containerType = TLV::kTLVType_Structure;
-    SuccessOrExit(err = decryptedDataTlvReader.Next(containerType, TLV::AnonymousTag()));
-    SuccessOrExit(err = decryptedDataTlvReader.EnterContainer(containerType));
+        SuccessOrExit(err = AES_CCM_decrypt(msg_R2_Encrypted.Get(), msg_r2_encrypted_len, nullptr, 0,
+                                            msg_R2_Encrypted.Get() + msg_r2_encrypted_len, CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
+                                            sr2k.KeyHandle(), kTBEData2_Nonce, kTBEDataNonceLength, msg_R2_Encrypted.Get()));
 
-    SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_SenderNOC)));
-    SuccessOrExit(err = decryptedDataTlvReader.Get(responderNOC));
+        decryptedDataTlvReader.Init(msg_R2_Encrypted.Get(), msg_r2_encrypted_len);
+        containerType = TLV::kTLVType_Structure;
+        SuccessOrExit(err = decryptedDataTlvReader.Next(containerType, TLV::AnonymousTag()));
+        SuccessOrExit(err = decryptedDataTlvReader.EnterContainer(containerType));
 
-    SuccessOrExit(err = decryptedDataTlvReader.Next());
-    if (TLV::TagNumFromTag(decryptedDataTlvReader.GetTag()) == kTag_TBEData_SenderICAC)
-    {
-        VerifyOrExit(decryptedDataTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
-        SuccessOrExit(err = decryptedDataTlvReader.Get(responderICAC));
-        SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_Signature)));
+        SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_SenderNOC)));
+        SuccessOrExit(err = decryptedDataTlvReader.Get(data.responderNOC));
+
+        SuccessOrExit(err = decryptedDataTlvReader.Next());
+        if (TLV::TagNumFromTag(decryptedDataTlvReader.GetTag()) == kTag_TBEData_SenderICAC)
+        {
+            VerifyOrExit(decryptedDataTlvReader.GetType() == TLV::kTLVType_ByteString, err = CHIP_ERROR_WRONG_TLV_TYPE);
+            SuccessOrExit(err = decryptedDataTlvReader.Get(data.responderICAC));
+            SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_Signature)));
+        }
+
+        // Construct msg_R2_Signed, whose signature in msg_r2_encrypted is validated in the background
+        data.msg_r2_signed_len = TLV::EstimateStructOverhead(sizeof(uint16_t), data.responderNOC.size(), data.responderICAC.size(),
+                                                             kP256_PublicKey_Length, kP256_PublicKey_Length);
+
+        VerifyOrExit(data.msg_R2_Signed.Alloc(data.msg_r2_signed_len), err = CHIP_ERROR_NO_MEMORY);
+
+        SuccessOrExit(err = ConstructTBSData(data.responderNOC, data.responderICAC, ByteSpan(mRemotePubKey, mRemotePubKey.Length()),
+                                             ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
+                                             data.msg_R2_Signed.Get(), data.msg_r2_signed_len));
+
+        VerifyOrExit(TLV::TagNumFromTag(decryptedDataTlvReader.GetTag()) == kTag_TBEData_Signature,
+                     err = CHIP_ERROR_INVALID_TLV_TAG);
+        VerifyOrExit(data.tbsData2Signature.Capacity() >= decryptedDataTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
+        data.tbsData2Signature.SetLength(decryptedDataTlvReader.GetLength());
+        SuccessOrExit(err = decryptedDataTlvReader.GetBytes(data.tbsData2Signature.Bytes(), data.tbsData2Signature.Length()));
+
+        // Retrieve session resumption ID
+        SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_ResumptionID)));
+        SuccessOrExit(err = decryptedDataTlvReader.GetBytes(mNewResumptionId.data(), mNewResumptionId.size()));
+
+        // Retrieve responderMRPParams if present
+        if (tlvReader.Next() != CHIP_END_OF_TLV)
+        {
+            SuccessOrExit(err = DecodeMRPParametersIfPresent(TLV::ContextTag(kTag_Sigma2_ResponderMRPParams), tlvReader));
+            mExchangeCtxt->GetSessionHandle()->AsUnauthenticatedSession()->SetRemoteSessionParameters(
+                GetRemoteSessionParameters());
+        }
+
+        // Prepare for validating the responder identity
+        {
+            MutableByteSpan fabricRCAC{ data.rootCertBuf };
+            SuccessOrExit(err = mFabricsTable->FetchRootCert(mFabricIndex, fabricRCAC));
+            data.fabricRCAC = fabricRCAC;
+            SuccessOrExit(err = SetEffectiveTime());
+        }
+
+        // Copy remaining needed data into work structure
+        {
+            data.validContext = mValidContext;
+            if (data.validContext.mVerifiedCertCache == nullptr)
+            {
+                data.validContext.mVerifiedCertCache = &mFabricsTable->GetVerifiedCertificateCache();
+            }
+
+            // responderNOC and responderICAC are spans into msg_R2_Encrypted
+            // which is going away, so redirect them to their copies in
+            // msg_R2_Signed, which is staying around
+            TLV::TLVReader signedDataTlvReader;
+            signedDataTlvReader.Init(data.msg_R2_Signed.Get(), data.msg_r2_signed_len);
+            SuccessOrExit(err = signedDataTlvReader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+            SuccessOrExit(err = signedDataTlvReader.EnterContainer(containerType));
+
+            SuccessOrExit(err = signedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBSData_SenderNOC)));
+            SuccessOrExit(err = signedDataTlvReader.Get(data.responderNOC));
+
+            if (!data.responderICAC.empty())
+            {
+                SuccessOrExit(err = signedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBSData_SenderICAC)));
+                SuccessOrExit(err = signedDataTlvReader.Get(data.responderICAC));
+            }
+        }
+
+        SuccessOrExit(err = helper->ScheduleWork());
+        mHandleSigma2Helper = helper;
+        mExchangeCtxt->WillSendMessage();
+        mState = State::kHandleSigma2Pending;
     }
 
-    // Validate responder identity located in msg_r2_encrypted
-    // Constructing responder identity
+exit:
+    if (err != CHIP_NO_ERROR)
     {
-        CompressedFabricId unused;
-        FabricId responderFabricId;
-        SuccessOrExit(err = SetEffectiveTime());
-        SuccessOrExit(err = mFabricsTable->VerifyCredentials(mFabricIndex, responderNOC, responderICAC, mValidContext, unused,
-                                                             responderFabricId, responderNodeId, responderPublicKey));
-        VerifyOrExit(fabricId == responderFabricId, err = CHIP_ERROR_INVALID_CASE_PARAMETER);
-        // Verify that responderNodeId (from responderNOC) matches one that was included
-        // in the computation of the Destination Identifier when generating Sigma1.
-        VerifyOrExit(mPeerNodeId == responderNodeId, err = CHIP_ERROR_INVALID_CASE_PARAMETER);
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
     }
+    return err;
+}
 
-    // Construct msg_R2_Signed and validate the signature in msg_r2_encrypted
-    msg_r2_signed_len = TLV::EstimateStructOverhead(sizeof(uint16_t), responderNOC.size(), responderICAC.size(),
-                                                    kP256_PublicKey_Length, kP256_PublicKey_Length);
+CHIP_ERROR CASESession::HandleSigma2b(HandleSigma2Data & data, bool & cancel)
+{
+    // Validate responder identity located in msg_r2_encrypted
+    // Constructing responder identity
+    CompressedFabricId unused;
+    FabricId responderFabricId;
+    NodeId responderNodeId;
+    P256PublicKey responderPublicKey;
+    ReturnErrorOnFailure(FabricTable::VerifyCredentials(data.responderNOC, data.responderICAC, data.fabricRCAC, data.validContext,
+                                                        unused, responderFabricId, responderNodeId, responderPublicKey));
+    VerifyOrReturnError(data.fabricId == responderFabricId, CHIP_ERROR_INVALID_CASE_PARAMETER);
+    // Verify that responderNodeId (from responderNOC) matches one that was included
+    // in the computation of the Destination Identifier when generating Sigma1.
+    VerifyOrReturnError(data.peerNodeId == responderNodeId, CHIP_ERROR_INVALID_CASE_PARAMETER);
 
-    VerifyOrExit(msg_R2_Signed.Alloc(msg_r2_signed_len), err = CHIP_ERROR_NO_MEMORY);
+    // Validate signature
+    ReturnErrorOnFailure(
+        responderPublicKey.ECDSA_validate_msg_signature(data.msg_R2_Signed.Get(), data.msg_r2_signed_len, data.tbsData2Signature));
 
-    SuccessOrExit(err = ConstructTBSData(responderNOC, responderICAC, ByteSpan(mRemotePubKey, mRemotePubKey.Length()),
-                                         ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()), msg_R2_Signed.Get(),
-                                         msg_r2_signed_len));
+    return CHIP_NO_ERROR;
+}
 
-    VerifyOrExit(TLV::TagNumFromTag(decryptedDataTlvReader.GetTag()) == kTag_TBEData_Signature, err = CHIP_ERROR_INVALID_TLV_TAG);
-    VerifyOrExit(tbsData2Signature.Capacity() >= decryptedDataTlvReader.GetLength(), err = CHIP_ERROR_INVALID_TLV_ELEMENT);
-    tbsData2Signature.SetLength(decryptedDataTlvReader.GetLength());
-    SuccessOrExit(err = decryptedDataTlvReader.GetBytes(tbsData2Signature.Bytes(), tbsData2Signature.Length()));
+CHIP_ERROR CASESession::HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
-    // Validate signature
-    SuccessOrExit(err = responderPublicKey.ECDSA_validate_msg_signature(msg_R2_Signed.Get(), msg_r2_signed_len, tbsData2Signature));
+    VerifyOrExit(mState == State::kHandleSigma2Pending, err = CHIP_ERROR_INCORRECT_STATE);
 
-    // Retrieve session resumption ID
-    SuccessOrExit(err = decryptedDataTlvReader.Next(TLV::kTLVType_ByteString, TLV::ContextTag(kTag_TBEData_ResumptionID)));
-    SuccessOrExit(err = decryptedDataTlvReader.GetBytes(mNewResumptionId.data(), mNewResumptionId.size()));
+    SuccessOrExit(err = status);
 
     // Retrieve peer CASE Authenticated Tags (CATs) from peer's NOC.
-    SuccessOrExit(err = ExtractCATsFromOpCert(responderNOC, mPeerCATs));
+    SuccessOrExit(err = ExtractCATsFromOpCert(data.responderNOC, mPeerCATs));
 
-    // Retrieve responderMRPParams if present
-    if (tlvReader.Next() != CHIP_END_OF_TLV)
+exit:
+    mHandleSigma2Helper.reset();
+
+    if (err != CHIP_NO_ERROR)
     {
-        SuccessOrExit(err = DecodeMRPParametersIfPresent(TLV::ContextTag(kTag_Sigma2_ResponderMRPParams), tlvReader));
-        mExchangeCtxt->GetSessionHandle()->AsUnauthenticatedSession()->SetRemoteSessionParameters(GetRemoteSessionParameters());
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+    }
+    else
+    {
+        // SendSigma3a sends its own status report on failure.
+        err = SendSigma3a();
     }
 
-exit:
     if (err != CHIP_NO_ERROR)
     {
-        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        // Abort the pending establish, which is normally done by CASESession::OnMessageReceived,
+        // but in the background processing case must be done here.
+        DiscardExchange();
+        AbortPendingEstablish(err);
     }
+
     return err;
 }
 
@@ -1378,7 +1480,22 @@ CHIP_ERROR CASESession::SendSigma3a()
                 // NOTE: used to sign in background.
                 data.keystore = keystore;
             }
-            else
+            else if (fabricInfo->HasOperationalKey())
+            {
+                // NOTE: used to sign in background, with a copy of the injected key (e.g. a controller's), so that
+                // the fabric table is not used off the Matter thread.
+                P256SerializedKeypair serializedKeypair;
+                if (mFabricsTable->ExportInjectedOpKeypairForFabric(mFabricIndex, serializedKeypair) == CHIP_NO_ERROR)
+                {
+                    data.opKeypair = Platform::MakeUnique<P256Keypair>();
+                    if (data.opKeypair && data.opKeypair->Deserialize(serializedKeypair) != CHIP_NO_ERROR)
+                    {
+                        data.opKeypair.reset();
+                    }
+                }
+            }
+
+            if (!data.SignsInBackground())
             {
                 // NOTE: used to sign in foreground.
                 data.fabricTable = mFabricsTable;
@@ -1406,7 +1523,7 @@ CHIP_ERROR CASESession::SendSigma3a()
                           data.nocCert, data.icaCert, ByteSpan(mEphemeralKey->Pubkey(), mEphemeralKey->Pubkey().Length()),
                           ByteSpan(mRemotePubKey, mRemotePubKey.Length()), data.msg_R3_Signed.Get(), data.msg_r3_signed_len));
 
-        if (data.keystore != nullptr)
+        if (data.SignsInBackground())
         {
             SuccessOrExit(err = helper->ScheduleWork());
             mSendSigma3Helper = helper;
@@ -1438,6 +1555,12 @@ CHIP_ERROR CASESession::SendSigma3b(SendSigma3Data & data, bool & cancel)
         ReturnErrorOnFailure(data.keystore->SignWithOpKeypair(
             data.fabricIndex, ByteSpan{ data.msg_R3_Signed.Get(), data.msg_r3_signed_len }, data.tbsData3Signature));
     }
+    else if (data.opKeypair != nullptr)
+    {
+        // Legacy case, in background: sign with the copy of the fabric's injected key
+        ReturnErrorOnFailure(
+            data.opKeypair->ECDSA_sign_msg(data.msg_R3_Signed.Get(), data.msg_r3_signed_len, data.tbsData3Signature));
+    }
     else
     {
         // Legacy case: delegate to fabric table fabric info
@@ -1494,7 +1617,7 @@ CHIP_ERROR CASESession::SendSigma3c(SendSigma3Data & data, CHIP_ERROR status)
 
     AutoReleaseSessionKey sr3k(*mSessionManager->GetSessionKeystore());
 
-    VerifyOrDieWithMsg(data.keystore == nullptr || mState == State::kSendSigma3Pending, SecureChannel, "Bad internal state.");
+    VerifyOrDieWithMsg(!data.SignsInBackground() || mState == State::kSendSigma3Pending, SecureChannel, "Bad internal state.");
 
     SuccessOrExit(err = status);
 
@@ -1553,10 +1676,10 @@ CHIP_ERROR CASESession::SendSigma3c(SendSigma3Data & data, CHIP_ERROR status)
 exit:
     mSendSigma3Helper.reset();
 
-    // If data.keystore is set, processing occurred in the background, so if an error occurred,
+    // If data.SignsInBackground(), processing occurred in the background, so if an error occurred,
     // need to send status report (normally occurs in SendSigma3a), and discard exchange and
     // abort pending establish (normally occurs in OnMessageReceived).
-    if (data.keystore != nullptr && err != CHIP_NO_ERROR)
+    if (data.SignsInBackground() && err != CHIP_NO_ERROR)
     {
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
         DiscardExchange();
@@ -1683,6 +1806,10 @@ CHIP_ERROR CASESession::HandleSigma3a(System::PacketBufferHandle && msg)
         // Copy remaining needed data into work structure
         {
             data.validContext = mValidContext;
+            if (data.validContext.mVerifiedCertCache == nullptr)
+            {
+                data.validContext.mVerifiedCertCache = &mFabricsTable->GetVerifiedCertificateCache();
+            }
 
             // initiatorNOC and initiatorICAC are spans into msg_R3_Encrypted
             // which is going away, so to save memory, redirect them to their
@@ -2253,6 +2380,13 @@ bool CASESession::InvokeBackgroundWorkWatchdog()
 {
     bool watchdogFired = false;
 
+    if (mHandleSigma2Helper && mHandleSigma2Helper->UnableToScheduleAfterWorkCallback())
+    {
+        ChipLogError(SecureChannel, "HandleSigma2Helper was unable to schedule the AfterWorkCallback");
+        mHandleSigma2Helper->DoAfterWork();
+        watchdogFired = true;
+    }
+
     if (mSendSigma3Helper && mSendSigma3Helper->UnableToScheduleAfterWorkCallback())
     {
         ChipLogError(SecureChannel, "SendSigma3Helper was unable to schedule the AfterWorkCallback");
@@ -2283,6 +2417,7 @@ SessionEstablishmentStage CASESession::MapCASEStateToSessionEstablishmentStage(S
     case State::kSentSigma2:
     case State::kSentSigma2Resume:
         return SessionEstablishmentStage::kSentSigma2;
+    case State::kHandleSigma2Pending:
     case State::kSendSigma3Pending:
         return SessionEstablishmentStage::kReceivedSigma2;
     case State::kSentSigma3:
@@ -203,6 +203,7 @@ public:
         kFinishedViaResume   = 7,
         kSendSigma3Pending   = 8,
         kHandleSigma3Pending = 9,
+        kHandleSigma2Pending = 10,
     };
 
     State GetState() { return mState; }
@@ -241,9 +242,13 @@ private:
                                 ByteSpan initiatorRandom);
     CHIP_ERROR SendSigma2();
     CHIP_ERROR HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg);
-    CHIP_ERROR HandleSigma2(System::PacketBufferHandle && msg);
     CHIP_ERROR HandleSigma2Resume(System::PacketBufferHandle && msg);
 
+    struct HandleSigma2Data;
+    CHIP_ERROR HandleSigma2a(System::PacketBufferHandle && msg);
+    static CHIP_ERROR HandleSigma2b(HandleSigma2Data & data, bool & cancel);
+    CHIP_ERROR HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status);
+
     struct SendSigma3Data;
     CHIP_ERROR SendSigma3a();
     static CHIP_ERROR SendSigma3b(SendSigma3Data & data, bool & cancel);
@@ -314,6 +319,7 @@ private:
 
     template <class DATA>
     class WorkHelper;
+    Platform::SharedPtr<WorkHelper<HandleSigma2Data>> mHandleSigma2Helper;
     Platform::SharedPtr<WorkHelper<SendSigma3Data>> mSendSigma3Helper;
     Platform::SharedPtr<WorkHelper<HandleSigma3Data>> mHandleSigma3Helper;
 
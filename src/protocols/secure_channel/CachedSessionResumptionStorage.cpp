@@ -0,0 +1,591 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
+
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+
+constexpr TLV::Tag CachedSessionResumptionStorage::kSlotTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kFabricIndexTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kPeerNodeIdTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kResumptionIdTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kSharedSecretTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kCATTag;
+constexpr TLV::Tag CachedSessionResumptionStorage::kSaveCountTag;
+
+CachedSessionResumptionStorage::~CachedSessionResumptionStorage()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(OnWriteBackTimer, this);
+    }
+    ClearCache();
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Init(PersistentStorageDelegate * storage, System::Layer * systemLayer,
+                                                System::Clock::Timeout writeBackDelay)
+{
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mStorage        = storage;
+    mSystemLayer    = systemLayer;
+    mWriteBackDelay = writeBackDelay;
+
+    ClearCache();
+    LoadFromStorage();
+    MigrateLegacyStorage();
+
+    // Pages that loading or moving state changed are written right away, or else by the write-back timer.
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to write back session resumption state: %" CHIP_ERROR_FORMAT, err.Format());
+        LogErrorOnFailure(StartWriteBackTimer());
+    }
+    return CHIP_NO_ERROR;
+}
+
+void CachedSessionResumptionStorage::Shutdown()
+{
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to write back session resumption state: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(OnWriteBackTimer, this);
+        mSystemLayer = nullptr;
+    }
+}
+
+void CachedSessionResumptionStorage::EraseState(Entry & entry)
+{
+    entry.mNode = ScopedNodeId();
+    entry.mResumptionId.fill(0);
+    Crypto::ClearSecretData(entry.mSharedSecret.Bytes(), entry.mSharedSecret.Capacity());
+    entry.mSharedSecret.SetLength(0);
+    entry.mPeerCATs  = kUndefinedCATs;
+    entry.mSaveCount = 0;
+}
+
+void CachedSessionResumptionStorage::ClearCache()
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsInList())
+        {
+            mLruList.Remove(&entry);
+        }
+        EraseState(entry);
+    }
+    memset(mNodeBuckets, 0, sizeof(mNodeBuckets));
+    memset(mResumptionIdBuckets, 0, sizeof(mResumptionIdBuckets));
+    memset(mPendingPages, 0, sizeof(mPendingPages));
+    mCachedCount   = 0;
+    mPendingWrites = 0;
+    mNextSaveCount = 0;
+    RebuildFreeList();
+}
+
+void CachedSessionResumptionStorage::RebuildFreeList()
+{
+    // Lower slots first, which keeps the entries in as few pages as possible.
+    mFreeEntries = nullptr;
+    for (size_t i = kCacheSize; i > 0; i--)
+    {
+        Entry & entry = mEntries[i - 1];
+        if (!entry.IsInList())
+        {
+            entry.mNextById   = nullptr;
+            entry.mNextByNode = mFreeEntries;
+            mFreeEntries      = &entry;
+        }
+    }
+}
+
+void CachedSessionResumptionStorage::LoadFromStorage()
+{
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    if (!buffer.Alloc(MaxPageSize()))
+    {
+        ChipLogError(SecureChannel, "Unable to load session resumption state: %" CHIP_ERROR_FORMAT, CHIP_ERROR_NO_MEMORY.Format());
+        return;
+    }
+
+    for (size_t page = 0; page < kPageCount; page++)
+    {
+        CHIP_ERROR err = LoadPage(page, buffer.Get());
+        if (err != CHIP_NO_ERROR && err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            // Keep the entries that could be read, and write the page again without the rest.
+            ChipLogError(SecureChannel, "Unable to load session resumption page %u: %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(page), err.Format());
+            MarkPending(page);
+        }
+    }
+    Crypto::ClearSecretData(buffer.Get(), MaxPageSize());
+    RebuildFreeList();
+
+    ChipLogProgress(SecureChannel, "Loaded %u session resumption entries", static_cast<unsigned>(mCachedCount));
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::LoadPage(size_t page, uint8_t * buffer)
+{
+    uint16_t len = static_cast<uint16_t>(MaxPageSize());
+    ReturnErrorOnFailure(mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SessionResumptionPage(page).KeyName(), buffer, len));
+
+    TLV::ContiguousBufferTLVReader reader;
+    reader.Init(buffer, len);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(reader.EnterContainer(arrayType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(LoadEntry(reader, page));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(arrayType));
+    return reader.VerifyEndOfContainer();
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::LoadEntry(TLV::ContiguousBufferTLVReader & reader, size_t page)
+{
+    TLV::TLVType containerType;
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    uint8_t slot;
+    ReturnErrorOnFailure(reader.Next(kSlotTag));
+    ReturnErrorOnFailure(reader.Get(slot));
+
+    FabricIndex fabricIndex;
+    ReturnErrorOnFailure(reader.Next(kFabricIndexTag));
+    ReturnErrorOnFailure(reader.Get(fabricIndex));
+
+    NodeId peerNodeId;
+    ReturnErrorOnFailure(reader.Next(kPeerNodeIdTag));
+    ReturnErrorOnFailure(reader.Get(peerNodeId));
+
+    ByteSpan resumptionIdSpan;
+    ReturnErrorOnFailure(reader.Next(kResumptionIdTag));
+    ReturnErrorOnFailure(reader.Get(resumptionIdSpan));
+
+    ByteSpan sharedSecretSpan;
+    ReturnErrorOnFailure(reader.Next(kSharedSecretTag));
+    ReturnErrorOnFailure(reader.Get(sharedSecretSpan));
+
+    ByteSpan catSpan;
+    ReturnErrorOnFailure(reader.Next(kCATTag));
+    ReturnErrorOnFailure(reader.Get(catSpan));
+
+    uint32_t saveCount;
+    ReturnErrorOnFailure(reader.Next(kSaveCountTag));
+    ReturnErrorOnFailure(reader.Get(saveCount));
+
+    ReturnErrorOnFailure(reader.ExitContainer(containerType));
+
+    const size_t index = page * kEntriesPerPage + slot;
+    VerifyOrReturnError(slot < kEntriesPerPage && index < kCacheSize && !mEntries[index].IsInList(),
+                        CHIP_ERROR_INVALID_TLV_ELEMENT);
+    VerifyOrReturnError(resumptionIdSpan.size() == kResumptionIdSize, CHIP_ERROR_INVALID_TLV_ELEMENT);
+    VerifyOrReturnError(sharedSecretSpan.size() <= Crypto::P256ECDHDerivedSecret::Capacity(), CHIP_ERROR_INVALID_TLV_ELEMENT);
+    VerifyOrReturnError(catSpan.size() == CATValues::kSerializedLength, CHIP_ERROR_INVALID_TLV_ELEMENT);
+
+    // A node is only in two pages if a restart came between writing them, e.g. when its entry was deleted and a new
+    // one saved in another page. The newer state wins.
+    const ScopedNodeId node(peerNodeId, fabricIndex);
+    Entry * existing = FindEntry(node);
+    if (existing != nullptr)
+    {
+        if (existing->mSaveCount >= saveCount)
+        {
+            MarkPending(page);
+            return CHIP_NO_ERROR;
+        }
+        RemoveEntry(*existing);
+    }
+
+    Entry & entry = mEntries[index];
+    entry.mNode   = node;
+    memcpy(entry.mResumptionId.data(), resumptionIdSpan.data(), kResumptionIdSize);
+    memcpy(entry.mSharedSecret.Bytes(), sharedSecretSpan.data(), sharedSecretSpan.size());
+    entry.mSharedSecret.SetLength(sharedSecretSpan.size());
+    CATValues::Serialized cat;
+    memcpy(cat, catSpan.data(), catSpan.size());
+    ReturnErrorOnFailure(entry.mPeerCATs.Deserialize(cat));
+    entry.mSaveCount = saveCount;
+
+    LinkNode(entry);
+    LinkResumptionId(entry);
+    InsertByUse(entry);
+    mNextSaveCount = std::max(mNextSaveCount, saveCount + 1);
+    return CHIP_NO_ERROR;
+}
+
+void CachedSessionResumptionStorage::MigrateLegacyStorage()
+{
+    SimpleSessionResumptionStorage legacyStorage;
+    DefaultSessionResumptionStorage::SessionIndex index;
+    VerifyOrReturn(legacyStorage.Init(mStorage) == CHIP_NO_ERROR && legacyStorage.LoadIndex(index) == CHIP_NO_ERROR &&
+                   index.mSize > 0);
+
+    // The index lists nodes in the order they were first saved, which is the best guess at their order of use.
+    for (size_t i = 0; i < index.mSize; i++)
+    {
+        const ScopedNodeId & node = index.mNodes[i];
+        ResumptionIdStorage resumptionId;
+        Crypto::P256ECDHDerivedSecret sharedSecret;
+        CATValues peerCATs;
+        if (FindEntry(node) == nullptr && legacyStorage.LoadState(node, resumptionId, sharedSecret, peerCATs) == CHIP_NO_ERROR)
+        {
+            AddEntry(node, resumptionId, sharedSecret, peerCATs);
+        }
+    }
+
+    // The old state is only deleted once the pages hold it; otherwise the next Init() tries again.
+    CHIP_ERROR err = Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to move session resumption state to pages: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+    for (size_t i = 0; i < index.mSize; i++)
+    {
+        legacyStorage.Delete(index.mNodes[i]);
+    }
+    mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SessionResumptionIndex().KeyName());
+    ChipLogProgress(SecureChannel, "Moved %u session resumption entries to pages", static_cast<unsigned>(index.mSize));
+}
+
+size_t CachedSessionResumptionStorage::NodeBucket(const ScopedNodeId & node)
+{
+    const uint64_t hash = node.GetNodeId() ^ (static_cast<uint64_t>(node.GetFabricIndex()) * 0x9E3779B97F4A7C15ull);
+    return static_cast<size_t>((hash ^ (hash >> 32)) % kBucketCount);
+}
+
+size_t CachedSessionResumptionStorage::ResumptionIdBucket(ConstResumptionIdView resumptionId)
+{
+    // Resumption IDs are random, so their first bytes are a good enough hash.
+    uint32_t hash;
+    memcpy(&hash, resumptionId.data(), sizeof(hash));
+    return hash % kBucketCount;
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::FindEntry(const ScopedNodeId & node)
+{
+    for (Entry * entry = mNodeBuckets[NodeBucket(node)]; entry != nullptr; entry = entry->mNextByNode)
+    {
+        if (entry->mNode == node)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::FindEntry(ConstResumptionIdView resumptionId)
+{
+    for (Entry * entry = mResumptionIdBuckets[ResumptionIdBucket(resumptionId)]; entry != nullptr; entry = entry->mNextById)
+    {
+        if (memcmp(entry->mResumptionId.data(), resumptionId.data(), kResumptionIdSize) == 0)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+CachedSessionResumptionStorage::Entry * CachedSessionResumptionStorage::AddEntry(const ScopedNodeId & node,
+                                                                                 ConstResumptionIdView resumptionId,
+                                                                                 const Crypto::P256ECDHDerivedSecret & sharedSecret,
+                                                                                 const CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(node);
+    if (entry != nullptr)
+    {
+        UnlinkResumptionId(*entry);
+        Touch(*entry);
+    }
+    else
+    {
+        if (mFreeEntries == nullptr)
+        {
+            // Drop the least recently used node, whose slot the new one then takes.
+            RemoveEntry(*mLruList.begin());
+        }
+
+        entry        = mFreeEntries;
+        mFreeEntries = entry->mNextByNode;
+        entry->mNode = node;
+        LinkNode(*entry);
+        mLruList.PushBack(entry);
+    }
+
+    memcpy(entry->mResumptionId.data(), resumptionId.data(), kResumptionIdSize);
+    LinkResumptionId(*entry);
+    entry->mSharedSecret = sharedSecret;
+    entry->mPeerCATs     = peerCATs;
+    entry->mSaveCount    = mNextSaveCount++;
+    MarkPending(PageOf(*entry));
+    return entry;
+}
+
+void CachedSessionResumptionStorage::LinkNode(Entry & entry)
+{
+    const size_t bucket  = NodeBucket(entry.mNode);
+    entry.mNextByNode    = mNodeBuckets[bucket];
+    mNodeBuckets[bucket] = &entry;
+    mCachedCount++;
+}
+
+void CachedSessionResumptionStorage::LinkResumptionId(Entry & entry)
+{
+    const size_t bucket          = ResumptionIdBucket(entry.mResumptionId);
+    entry.mNextById              = mResumptionIdBuckets[bucket];
+    mResumptionIdBuckets[bucket] = &entry;
+}
+
+void CachedSessionResumptionStorage::UnlinkResumptionId(Entry & entry)
+{
+    Entry ** link = &mResumptionIdBuckets[ResumptionIdBucket(entry.mResumptionId)];
+    while (*link != &entry)
+    {
+        link = &(*link)->mNextById;
+    }
+    *link = entry.mNextById;
+}
+
+void CachedSessionResumptionStorage::InsertByUse(Entry & entry)
+{
+    auto position = mLruList.begin();
+    while (position != mLruList.end() && position->mSaveCount <= entry.mSaveCount)
+    {
+        ++position;
+    }
+    mLruList.InsertBefore(position, &entry);
+}
+
+void CachedSessionResumptionStorage::RemoveEntry(Entry & entry)
+{
+    Entry ** link = &mNodeBuckets[NodeBucket(entry.mNode)];
+    while (*link != &entry)
+    {
+        link = &(*link)->mNextByNode;
+    }
+    *link = entry.mNextByNode;
+    UnlinkResumptionId(entry);
+
+    mLruList.Remove(&entry);
+    mCachedCount--;
+    MarkPending(PageOf(entry));
+    EraseState(entry);
+
+    entry.mNextById   = nullptr;
+    entry.mNextByNode = mFreeEntries;
+    mFreeEntries      = &entry;
+}
+
+void CachedSessionResumptionStorage::Touch(Entry & entry)
+{
+    mLruList.Remove(&entry);
+    mLruList.PushBack(&entry);
+}
+
+void CachedSessionResumptionStorage::MarkPending(size_t page)
+{
+    if (!mPendingPages[page])
+    {
+        mPendingPages[page] = true;
+        mPendingWrites++;
+    }
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::EncodePage(size_t page, uint8_t * buffer, size_t & length) const
+{
+    TLV::TLVWriter writer;
+    writer.Init(buffer, MaxPageSize());
+
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, arrayType));
+
+    bool empty = true;
+    for (uint8_t slot = 0; slot < kEntriesPerPage; slot++)
+    {
+        const size_t index = page * kEntriesPerPage + slot;
+        if (index >= kCacheSize || !mEntries[index].IsInList())
+        {
+            continue;
+        }
+        const Entry & entry = mEntries[index];
+
+        TLV::TLVType innerType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, innerType));
+        ReturnErrorOnFailure(writer.Put(kSlotTag, slot));
+        ReturnErrorOnFailure(writer.Put(kFabricIndexTag, entry.mNode.GetFabricIndex()));
+        ReturnErrorOnFailure(writer.Put(kPeerNodeIdTag, entry.mNode.GetNodeId()));
+        ReturnErrorOnFailure(writer.Put(kResumptionIdTag, ByteSpan(entry.mResumptionId)));
+        ReturnErrorOnFailure(writer.Put(kSharedSecretTag, entry.mSharedSecret.Span()));
+        CATValues::Serialized cat;
+        ReturnErrorOnFailure(entry.mPeerCATs.Serialize(cat));
+        ReturnErrorOnFailure(writer.Put(kCATTag, ByteSpan(cat)));
+        ReturnErrorOnFailure(writer.Put(kSaveCountTag, entry.mSaveCount));
+        ReturnErrorOnFailure(writer.EndContainer(innerType));
+        empty = false;
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(arrayType));
+    length = empty ? 0 : writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::WritePage(size_t page)
+{
+    static_assert(MaxPageSize() <= UINT16_MAX, "A page does not fit in a storage value");
+
+    Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(MaxPageSize()), CHIP_ERROR_NO_MEMORY);
+
+    const StorageKeyName key = DefaultStorageKeyAllocator::SessionResumptionPage(page);
+    size_t length            = 0;
+    CHIP_ERROR err           = EncodePage(page, buffer.Get(), length);
+    if (err == CHIP_NO_ERROR && length == 0)
+    {
+        err = mStorage->SyncDeleteKeyValue(key.KeyName());
+        err = (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND) ? CHIP_NO_ERROR : err;
+    }
+    else if (err == CHIP_NO_ERROR)
+    {
+        err = mStorage->SyncSetKeyValue(key.KeyName(), buffer.Get(), static_cast<uint16_t>(length));
+    }
+    Crypto::ClearSecretData(buffer.Get(), MaxPageSize());
+    ReturnErrorOnFailure(err);
+
+    mPendingPages[page] = false;
+    mPendingWrites--;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Flush()
+{
+    CHIP_ERROR stickyErr = CHIP_NO_ERROR;
+    for (size_t page = 0; page < kPageCount && mPendingWrites > 0; page++)
+    {
+        if (!mPendingPages[page])
+        {
+            continue;
+        }
+        CHIP_ERROR err = WritePage(page);
+        stickyErr      = stickyErr == CHIP_NO_ERROR ? err : stickyErr;
+    }
+    return stickyErr;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::StartWriteBackTimer()
+{
+    VerifyOrReturnError(WritesBack() && HasPendingWrites(), CHIP_NO_ERROR);
+    VerifyOrReturnError(!mSystemLayer->IsTimerActive(OnWriteBackTimer, this), CHIP_NO_ERROR);
+    return mSystemLayer->StartTimer(mWriteBackDelay, OnWriteBackTimer, this);
+}
+
+void CachedSessionResumptionStorage::OnWriteBackTimer(System::Layer * systemLayer, void * appState)
+{
+    auto * self    = static_cast<CachedSessionResumptionStorage *>(appState);
+    CHIP_ERROR err = self->Flush();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Unable to write back session resumption state: %" CHIP_ERROR_FORMAT, err.Format());
+        // Try again later; the pages stay pending until then.
+        LogErrorOnFailure(self->StartWriteBackTimer());
+    }
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                                              Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(node);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    Touch(*entry);
+    resumptionId = entry->mResumptionId;
+    sharedSecret = entry->mSharedSecret;
+    peerCATs     = entry->mPeerCATs;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                                              Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs)
+{
+    Entry * entry = FindEntry(resumptionId);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    Touch(*entry);
+    node         = entry->mNode;
+    sharedSecret = entry->mSharedSecret;
+    peerCATs     = entry->mPeerCATs;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                                                const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs)
+{
+    AddEntry(node, resumptionId, sharedSecret, peerCATs);
+    if (!WritesBack())
+    {
+        return Flush();
+    }
+
+    // Pages may have been pending before without a timer, e.g. when a write in Init() failed.
+    if (StartWriteBackTimer() != CHIP_NO_ERROR)
+    {
+        return Flush();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::Delete(const ScopedNodeId & node)
+{
+    Entry * entry = FindEntry(node);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    RemoveEntry(*entry);
+    return Flush();
+}
+
+CHIP_ERROR CachedSessionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.IsInList() && entry.mNode.GetFabricIndex() == fabricIndex)
+        {
+            RemoveEntry(entry);
+        }
+    }
+    return Flush();
+}
+
+} // namespace chip
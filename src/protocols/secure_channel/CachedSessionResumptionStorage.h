@@ -0,0 +1,174 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a SessionResumptionStorage that keeps the resumption state of the sessions of a controller in
+ *      memory, and persists it in pages of several nodes through a PersistentStorageDelegate.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/TLV.h>
+#include <lib/support/IntrusiveList.h>
+#include <protocols/secure_channel/SessionResumptionStorage.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+
+/**
+ * A SessionResumptionStorage for controllers, that resume sessions with many more nodes than a device does, e.g. when
+ * they reconnect to all of them after a restart.
+ *
+ * The resumption state of up to CHIP_CONFIG_CASE_SESSION_RESUME_CONTROLLER_CACHE_SIZE nodes is kept in memory, where
+ * nodes and resumption IDs are looked up, and is persisted in pages of kEntriesPerPage nodes: Init() loads it with one
+ * storage read per page, and saving the state of a node writes its page. When the table is full, saving the state of
+ * a new node drops the least recently used one.
+ *
+ * By default, every Save() writes through to storage. With a write-back delay, Save() only updates memory, and the
+ * pages changed within the delay are written together (see Flush()); a restart before then loses the newest state,
+ * and the affected sessions fall back to a full CASE handshake. Deleting state always writes through.
+ *
+ * Init() moves the state that an earlier SimpleSessionResumptionStorage left in the same storage over to the pages.
+ */
+class CachedSessionResumptionStorage : public SessionResumptionStorage
+{
+public:
+    static constexpr size_t kCacheSize      = CHIP_CONFIG_CASE_SESSION_RESUME_CONTROLLER_CACHE_SIZE;
+    static constexpr size_t kEntriesPerPage = 16;
+
+    ~CachedSessionResumptionStorage() override;
+
+    /**
+     * @param storage        The storage that holds the resumption state.
+     * @param systemLayer    The layer to run the write-back timer on, or null to write every Save() through to storage.
+     * @param writeBackDelay How long Save() may hold an entry before it is written to storage.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Layer * systemLayer = nullptr,
+                    System::Clock::Timeout writeBackDelay =
+                        System::Clock::Milliseconds32(CHIP_CONFIG_CASE_SESSION_RESUME_WRITE_BACK_DELAY_MS));
+
+    /**
+     * Write back the pages that have not been written to storage yet, and stop using the system layer.
+     */
+    void Shutdown();
+
+    /**
+     * Write the pages that have not been written to storage yet. Pages that fail to be written stay pending.
+     */
+    CHIP_ERROR Flush();
+
+    bool HasPendingWrites() const { return mPendingWrites > 0; }
+    size_t GetCachedCount() const { return mCachedCount; }
+
+    CHIP_ERROR FindByScopedNodeId(const ScopedNodeId & node, ResumptionIdStorage & resumptionId,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR FindByResumptionId(ConstResumptionIdView resumptionId, ScopedNodeId & node,
+                                  Crypto::P256ECDHDerivedSecret & sharedSecret, CATValues & peerCATs) override;
+    CHIP_ERROR Save(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                    const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs) override;
+    CHIP_ERROR Delete(const ScopedNodeId & node);
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+private:
+    static constexpr size_t kPageCount   = (kCacheSize + kEntriesPerPage - 1) / kEntriesPerPage;
+    static constexpr size_t kBucketCount = kCacheSize;
+
+    struct Entry : public IntrusiveListNodeBase<>
+    {
+        ScopedNodeId mNode;
+        ResumptionIdStorage mResumptionId;
+        Crypto::P256ECDHDerivedSecret mSharedSecret;
+        CATValues mPeerCATs;
+        // Orders the entries by when they were last saved, which is what a restart keeps of their use.
+        uint32_t mSaveCount = 0;
+
+        // Chains of the node and resumption ID hash buckets; the free list is chained through mNextByNode.
+        Entry * mNextByNode = nullptr;
+        Entry * mNextById   = nullptr;
+    };
+
+    static constexpr size_t MaxEntrySize()
+    {
+        return TLV::EstimateStructOverhead(sizeof(uint8_t), sizeof(FabricIndex), sizeof(NodeId), kResumptionIdSize,
+                                           Crypto::P256ECDHDerivedSecret::Capacity(), CATValues::kSerializedLength,
+                                           sizeof(uint32_t));
+    }
+
+    static constexpr size_t MaxPageSize() { return TLV::EstimateStructOverhead(kEntriesPerPage * MaxEntrySize()); }
+
+    static constexpr TLV::Tag kSlotTag         = TLV::ContextTag(1);
+    static constexpr TLV::Tag kFabricIndexTag  = TLV::ContextTag(2);
+    static constexpr TLV::Tag kPeerNodeIdTag   = TLV::ContextTag(3);
+    static constexpr TLV::Tag kResumptionIdTag = TLV::ContextTag(4);
+    static constexpr TLV::Tag kSharedSecretTag = TLV::ContextTag(5);
+    static constexpr TLV::Tag kCATTag          = TLV::ContextTag(6);
+    static constexpr TLV::Tag kSaveCountTag    = TLV::ContextTag(7);
+
+    static size_t NodeBucket(const ScopedNodeId & node);
+    static size_t ResumptionIdBucket(ConstResumptionIdView resumptionId);
+
+    size_t PageOf(const Entry & entry) const { return static_cast<size_t>(&entry - mEntries) / kEntriesPerPage; }
+    bool WritesBack() const { return mSystemLayer != nullptr && mWriteBackDelay != System::Clock::kZero; }
+
+    Entry * FindEntry(const ScopedNodeId & node);
+    Entry * FindEntry(ConstResumptionIdView resumptionId);
+    Entry * AddEntry(const ScopedNodeId & node, ConstResumptionIdView resumptionId,
+                     const Crypto::P256ECDHDerivedSecret & sharedSecret, const CATValues & peerCATs);
+    void LinkNode(Entry & entry);
+    void LinkResumptionId(Entry & entry);
+    void UnlinkResumptionId(Entry & entry);
+    void InsertByUse(Entry & entry);
+    void RemoveEntry(Entry & entry);
+    void ClearCache();
+    void RebuildFreeList();
+    void Touch(Entry & entry);
+    void MarkPending(size_t page);
+    static void EraseState(Entry & entry);
+
+    CHIP_ERROR EncodePage(size_t page, uint8_t * buffer, size_t & length) const;
+    CHIP_ERROR WritePage(size_t page);
+    CHIP_ERROR LoadPage(size_t page, uint8_t * buffer);
+    CHIP_ERROR LoadEntry(TLV::ContiguousBufferTLVReader & reader, size_t page);
+    void LoadFromStorage();
+    void MigrateLegacyStorage();
+
+    /// Start the write-back timer if pages are pending and it is not running yet.
+    CHIP_ERROR StartWriteBackTimer();
+    static void OnWriteBackTimer(System::Layer * systemLayer, void * appState);
+
+    PersistentStorageDelegate * mStorage = nullptr;
+
+    Entry mEntries[kCacheSize];
+    Entry * mNodeBuckets[kBucketCount]         = {};
+    Entry * mResumptionIdBuckets[kBucketCount] = {};
+    Entry * mFreeEntries                       = nullptr;
+    bool mPendingPages[kPageCount]             = {};
+
+    // In use entries, least recently used first.
+    IntrusiveList<Entry> mLruList;
+    size_t mCachedCount     = 0;
+    size_t mPendingWrites   = 0;
+    uint32_t mNextSaveCount = 0;
+
+    System::Layer * mSystemLayer = nullptr;
+    System::Clock::Timeout mWriteBackDelay;
+};
+
+} // namespace chip
@@ -0,0 +1,413 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <protocols/secure_channel/CachedSessionResumptionStorage.h>
+#include <protocols/secure_channel/SimpleSessionResumptionStorage.h>
+#include <system/SystemLayerImpl.h>
+
+#include <vector>
+
+namespace {
+
+using namespace chip;
+
+constexpr FabricIndex fabric1 = 10;
+constexpr FabricIndex fabric2 = 14;
+constexpr NodeId node1        = 12344321;
+
+constexpr size_t kCacheSize = CachedSessionResumptionStorage::kCacheSize;
+
+struct State
+{
+    ScopedNodeId node;
+    SessionResumptionStorage::ResumptionIdStorage resumptionId;
+    Crypto::P256ECDHDerivedSecret sharedSecret;
+    CATValues peerCATs;
+
+    CHIP_ERROR Init(ScopedNodeId aNode)
+    {
+        node = aNode;
+        sharedSecret.SetLength(sharedSecret.Capacity());
+        ReturnErrorOnFailure(Crypto::DRBG_get_bytes(resumptionId.data(), resumptionId.size()));
+        return Crypto::DRBG_get_bytes(sharedSecret.Bytes(), sharedSecret.Length());
+    }
+
+    CHIP_ERROR SaveTo(SessionResumptionStorage & storage) const
+    {
+        return storage.Save(node, resumptionId, sharedSecret, peerCATs);
+    }
+
+    bool IsFoundByNodeIn(SessionResumptionStorage & storage) const
+    {
+        SessionResumptionStorage::ResumptionIdStorage foundResumptionId;
+        Crypto::P256ECDHDerivedSecret foundSharedSecret;
+        CATValues foundPeerCATs;
+        return storage.FindByScopedNodeId(node, foundResumptionId, foundSharedSecret, foundPeerCATs) == CHIP_NO_ERROR &&
+            foundResumptionId == resumptionId && foundSharedSecret.Length() == sharedSecret.Length() &&
+            memcmp(foundSharedSecret.ConstBytes(), sharedSecret.ConstBytes(), sharedSecret.Length()) == 0;
+    }
+
+    bool IsFoundByResumptionIdIn(SessionResumptionStorage & storage) const
+    {
+        ScopedNodeId foundNode;
+        Crypto::P256ECDHDerivedSecret foundSharedSecret;
+        CATValues foundPeerCATs;
+        return storage.FindByResumptionId(resumptionId, foundNode, foundSharedSecret, foundPeerCATs) == CHIP_NO_ERROR &&
+            foundNode == node && memcmp(foundSharedSecret.ConstBytes(), sharedSecret.ConstBytes(), sharedSecret.Length()) == 0;
+    }
+};
+
+// The storage holds the state of a whole controller, so it lives on the heap rather than on the test's stack.
+using StoragePtr = Platform::UniquePtr<CachedSessionResumptionStorage>;
+
+StoragePtr NewStorage(PersistentStorageDelegate & storage, System::Layer * systemLayer = nullptr,
+                      System::Clock::Timeout writeBackDelay = System::Clock::kZero)
+{
+    StoragePtr sessionStorage = Platform::MakeUnique<CachedSessionResumptionStorage>();
+    VerifyOrReturnValue(sessionStorage, nullptr);
+    VerifyOrReturnValue(sessionStorage->Init(&storage, systemLayer, writeBackDelay) == CHIP_NO_ERROR, nullptr);
+    return sessionStorage;
+}
+
+void TestMigration(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    SimpleSessionResumptionStorage simpleStorage;
+    NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    State states[3];
+    for (size_t i = 0; i < ArraySize(states); i++)
+    {
+        NL_TEST_ASSERT(inSuite, states[i].Init(ScopedNodeId(node1 + i, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, states[i].SaveTo(simpleStorage) == CHIP_NO_ERROR);
+    }
+
+    // Init() moves the state over to a single page, and deletes it from where SimpleSessionResumptionStorage keeps it.
+    StoragePtr sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == ArraySize(states));
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 1);
+    for (auto & state : states)
+    {
+        NL_TEST_ASSERT(inSuite, state.IsFoundByNodeIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, state.IsFoundByResumptionIdIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, !state.IsFoundByNodeIn(simpleStorage));
+    }
+
+    sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == ArraySize(states));
+    for (auto & state : states)
+    {
+        NL_TEST_ASSERT(inSuite, state.IsFoundByNodeIn(*sessionStorage));
+    }
+}
+
+void TestWriteThrough(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    StoragePtr sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+
+    State states[3];
+    for (size_t i = 0; i < ArraySize(states); i++)
+    {
+        NL_TEST_ASSERT(inSuite, states[i].Init(ScopedNodeId(node1 + i, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, states[i].SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !sessionStorage->HasPendingWrites());
+    }
+
+    // The nodes share a page, which a new storage loads with a single read.
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 1);
+    sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == ArraySize(states));
+    for (auto & state : states)
+    {
+        NL_TEST_ASSERT(inSuite, state.IsFoundByNodeIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, state.IsFoundByResumptionIdIn(*sessionStorage));
+    }
+}
+
+void TestWriteBack(nlTestSuite * inSuite, void * inContext)
+{
+    System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+
+    TestPersistentStorageDelegate storage;
+    {
+        StoragePtr sessionStorage = NewStorage(storage, &systemLayer, System::Clock::Seconds32(1));
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+
+        State states[3];
+        for (size_t i = 0; i < ArraySize(states); i++)
+        {
+            NL_TEST_ASSERT(inSuite, states[i].Init(ScopedNodeId(node1 + i, fabric1)) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, states[i].SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+        }
+
+        // Nothing is written until the write-back timer fires or the storage is flushed.
+        NL_TEST_ASSERT(inSuite, sessionStorage->HasPendingWrites());
+        NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+        for (auto & state : states)
+        {
+            NL_TEST_ASSERT(inSuite, state.IsFoundByNodeIn(*sessionStorage));
+            NL_TEST_ASSERT(inSuite, state.IsFoundByResumptionIdIn(*sessionStorage));
+        }
+
+        NL_TEST_ASSERT(inSuite, sessionStorage->Flush() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !sessionStorage->HasPendingWrites());
+        NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 1);
+
+        // Shutdown() writes back what is still pending.
+        State newer;
+        NL_TEST_ASSERT(inSuite, newer.Init(ScopedNodeId(node1, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, newer.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, sessionStorage->HasPendingWrites());
+        sessionStorage->Shutdown();
+        NL_TEST_ASSERT(inSuite, !sessionStorage->HasPendingWrites());
+
+        sessionStorage = NewStorage(storage);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+        NL_TEST_ASSERT(inSuite, newer.IsFoundByNodeIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, states[1].IsFoundByNodeIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, states[2].IsFoundByNodeIn(*sessionStorage));
+    }
+
+    systemLayer.Shutdown();
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+void OnTimeout(System::Layer * systemLayer, void * appState)
+{
+    *static_cast<bool *>(appState) = true;
+}
+
+void TestWriteBackAfterFailedInit(nlTestSuite * inSuite, void * inContext)
+{
+    System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+
+    TestPersistentStorageDelegate storage;
+    {
+        // State of an earlier SimpleSessionResumptionStorage, which Init() cannot write to the pages it moves it to.
+        SimpleSessionResumptionStorage simpleStorage;
+        NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+        State older;
+        NL_TEST_ASSERT(inSuite, older.Init(ScopedNodeId(node1, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, older.SaveTo(simpleStorage) == CHIP_NO_ERROR);
+
+        for (size_t page = 0; page < kCacheSize; page++)
+        {
+            storage.AddPoisonKey(DefaultStorageKeyAllocator::SessionResumptionPage(page).KeyName());
+        }
+        StoragePtr sessionStorage = NewStorage(storage, &systemLayer, System::Clock::Milliseconds32(10));
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+        NL_TEST_ASSERT(inSuite, sessionStorage->HasPendingWrites());
+        storage.ClearPoisonKeys();
+
+        // The write-back timer that Init() armed for the pending pages writes them along with the next save.
+        State newer;
+        NL_TEST_ASSERT(inSuite, newer.Init(ScopedNodeId(node1 + 1, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, newer.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+        // Run the event loop until the pages are written, or for at most a second.
+        bool timedOut = false;
+        NL_TEST_ASSERT(inSuite, systemLayer.StartTimer(System::Clock::Seconds32(1), OnTimeout, &timedOut) == CHIP_NO_ERROR);
+        while (sessionStorage->HasPendingWrites() && !timedOut)
+        {
+            systemLayer.PrepareEvents();
+            systemLayer.WaitForEvents();
+            systemLayer.HandleEvents();
+        }
+        systemLayer.CancelTimer(OnTimeout, &timedOut);
+        NL_TEST_ASSERT(inSuite, !sessionStorage->HasPendingWrites());
+
+        sessionStorage = NewStorage(storage);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+        NL_TEST_ASSERT(inSuite, older.IsFoundByNodeIn(*sessionStorage));
+        NL_TEST_ASSERT(inSuite, newer.IsFoundByNodeIn(*sessionStorage));
+    }
+
+    systemLayer.Shutdown();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+void TestStaleResumptionId(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    StoragePtr sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+
+    State older;
+    State newer;
+    NL_TEST_ASSERT(inSuite, older.Init(ScopedNodeId(node1, fabric1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, newer.Init(ScopedNodeId(node1, fabric1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, older.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, newer.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == 1);
+    NL_TEST_ASSERT(inSuite, !older.IsFoundByResumptionIdIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, newer.IsFoundByResumptionIdIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, newer.IsFoundByNodeIn(*sessionStorage));
+
+    sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, !older.IsFoundByResumptionIdIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, newer.IsFoundByResumptionIdIn(*sessionStorage));
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    StoragePtr sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+
+    std::vector<State> states(kCacheSize + 1);
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, states[i].Init(ScopedNodeId(node1 + i, fabric1)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, states[i].SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == kCacheSize);
+
+    // Using the first node makes the second one the least recently used, whose state the new node replaces.
+    NL_TEST_ASSERT(inSuite, states[0].IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, states[kCacheSize].Init(ScopedNodeId(node1 + kCacheSize, fabric1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, states[kCacheSize].SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == kCacheSize);
+    NL_TEST_ASSERT(inSuite, !states[1].IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, !states[1].IsFoundByResumptionIdIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, states[0].IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, states[kCacheSize].IsFoundByResumptionIdIn(*sessionStorage));
+
+    sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == kCacheSize);
+    NL_TEST_ASSERT(inSuite, !states[1].IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, states[0].IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, states[kCacheSize].IsFoundByNodeIn(*sessionStorage));
+}
+
+void TestDelete(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    StoragePtr sessionStorage = NewStorage(storage);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+
+    State first;
+    State second;
+    State other;
+    NL_TEST_ASSERT(inSuite, first.Init(ScopedNodeId(node1, fabric1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, second.Init(ScopedNodeId(node1 + 1, fabric1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, other.Init(ScopedNodeId(node1, fabric2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, first.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, second.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, other.SaveTo(*sessionStorage) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sessionStorage->Delete(first.node) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage->Delete(first.node) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, !first.IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, !first.IsFoundByResumptionIdIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, second.IsFoundByNodeIn(*sessionStorage));
+
+    NL_TEST_ASSERT(inSuite, sessionStorage->DeleteAll(fabric1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == 1);
+    NL_TEST_ASSERT(inSuite, !second.IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, other.IsFoundByNodeIn(*sessionStorage));
+
+    // Deletes are written through, even for a storage that writes saves back.
+    System::LayerImpl systemLayer;
+    NL_TEST_ASSERT(inSuite, systemLayer.Init() == CHIP_NO_ERROR);
+    sessionStorage = NewStorage(storage, &systemLayer, System::Clock::Seconds32(1));
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, sessionStorage != nullptr);
+    NL_TEST_ASSERT(inSuite, sessionStorage->GetCachedCount() == 1);
+    NL_TEST_ASSERT(inSuite, !second.IsFoundByNodeIn(*sessionStorage));
+    NL_TEST_ASSERT(inSuite, sessionStorage->DeleteAll(fabric2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !sessionStorage->HasPendingWrites());
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+
+    sessionStorage.reset();
+    systemLayer.Shutdown();
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestMigration", TestMigration),
+    NL_TEST_DEF("TestWriteThrough", TestWriteThrough),
+    NL_TEST_DEF("TestWriteBack", TestWriteBack),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    NL_TEST_DEF("TestWriteBackAfterFailedInit", TestWriteBackAfterFailedInit),
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    NL_TEST_DEF("TestStaleResumptionId", TestStaleResumptionId),
+    NL_TEST_DEF("TestEviction", TestEviction),
+    NL_TEST_DEF("TestDelete", TestDelete),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+int TestSetup(void * inContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+nlTestSuite sSuite =
+{
+    "Test-CHIP-CachedSessionResumptionStorage",
+    &sTests[0],
+    TestSetup,
+    TestTeardown,
+};
+// clang-format on
+
+} // namespace
+
+/**
+ *  Main
+ */
+int TestCachedSessionResumptionStorage()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCachedSessionResumptionStorage)
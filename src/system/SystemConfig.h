@@ -358,6 +358,41 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  @brief
+ *      When packet buffers are allocated with malloc (see CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE), round their memory up
+ *      to one of a few size classes, and keep freed buffers in per-thread caches for reuse instead of freeing them.
+ *
+ *      This requires thread-local storage and locking.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *      With CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES, the number of freed packet buffers of each size class that a
+ *      thread keeps for itself. Half of them move to a cache shared by all threads when it has more.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 16
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+ *
+ *  @brief
+ *      With CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES, the number of freed packet buffers of each size class that are
+ *      kept for all threads. Buffers beyond this are returned to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE 64
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -495,6 +530,59 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      This is the maximum number of ready sockets that the epoll based System::Layer implementation
+ *      collects in a single wait. Sockets that remain ready beyond this count are reported on the next
+ *      event loop turn.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif /* CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      Use a hierarchical timing wheel (chip::System::TimerWheel) instead of a sorted list for pending timers in the
+ *      socket based System::Layer implementations. This makes starting and cancelling a timer constant time, at the cost
+ *      of a fixed table of slot and hash bucket heads.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
+// With dispatch or libev, timers are fired by the dispatch queue or libev rather than by the event loop advancing
+// TimerQueue, which is what the timer wheel is built and tested for.
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL && (CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV)
+#error "FORBIDDEN: CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL && (CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV)"
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL && (CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV)
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS
+ *
+ *  @brief
+ *      This is the number of hash buckets the timer wheel uses to find timers by callback and application state.
+ *      Must be a power of 2.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS
+#define CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS 256
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS
+ *
+ *  @brief
+ *      This is the granularity, in milliseconds, to which the expiration time of timers started with a non-zero delay
+ *      is rounded up, so that timers expiring close together fire from a single wakeup. Such timers may fire up to
+ *      this much late. A value of 0 or 1 disables coalescing.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS
+#define CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS 0
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
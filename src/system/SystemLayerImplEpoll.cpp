@@ -0,0 +1,484 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using Linux epoll().
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+namespace {
+
+constexpr Clock::Seconds64 kDefaultMinSleepPeriod = Clock::Seconds64(60 * 60 * 24 * 30); // Month [sec]
+
+// The size the table of watches by descriptor starts at; it doubles as higher descriptors are watched.
+constexpr size_t kInitialSocketWatchTableSize = 64;
+
+} // anonymous namespace
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mWaitResult = 0;
+    mEpollFd    = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    mSocketWatchPool.ReleaseAll();
+    mSocketWatchesByFd.Free();
+
+    if (mEpollFd >= 0)
+    {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by writing a single byte to the wake pipe.
+     *
+     * If this is being called from within an I/O event callback, then writing to the wake pipe can be skipped,
+     * since the I/O thread is already awake.
+     *
+     * Furthermore, we don't care if this write fails as the only reasonably likely failure is that the pipe is full, in which
+     * case the epoll calling thread is going to wake up anyway.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleEventsThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Send notification to wake up the epoll call.
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    Clock::Timestamp awakenTime = SystemClock().GetMonotonicTimestamp() + delay;
+    if (delay > Clock::kZero)
+    {
+        awakenTime = CoalesceAwakenTime(awakenTime);
+    }
+
+    TimerList::Node * timer = mTimerPool.Create(*this, awakenTime, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // See LayerImplSelect::ScheduleWork() for why this is an expires-ASAP timer rather than a lambda.
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Duplicate registration is an error.
+    VerifyOrReturnError(WatchForFd(fd) == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (static_cast<size_t>(fd) >= mSocketWatchesByFd.AllocatedSize())
+    {
+        ReturnErrorOnFailure(GrowSocketWatchTable(fd));
+    }
+
+    // The socket is only added to the epoll set once read or write interest is requested; a registered
+    // socket always reports EPOLLHUP/EPOLLERR, which would otherwise wake the loop for sockets nobody
+    // is waiting on.
+    SocketWatch * watch = mSocketWatchPool.CreateObject(fd);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+    mSocketWatchesByFd[static_cast<size_t>(fd)] = watch;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::GrowSocketWatchTable(int fd)
+{
+    size_t size = std::max(mSocketWatchesByFd.AllocatedSize(), kInitialSocketWatchTableSize);
+    while (size <= static_cast<size_t>(fd))
+    {
+        size *= 2;
+    }
+
+    Platform::ScopedMemoryBufferWithSize<SocketWatch *> table;
+    table.Calloc(size);
+    VerifyOrReturnError(table.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+    std::copy_n(mSocketWatchesByFd.Get(), mSocketWatchesByFd.AllocatedSize(), table.Get());
+    // Moving into a buffer does not free what it held.
+    mSocketWatchesByFd.Free();
+    mSocketWatchesByFd = std::move(table);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateEpollRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch->mRegisteredEvents != 0)
+    {
+        // Failure here is harmless: if the descriptor has already been closed, the kernel has
+        // dropped it from the epoll set by itself.
+        (void) epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr);
+    }
+    mSocketWatchesByFd[static_cast<size_t>(watch->mFD)] = nullptr;
+    mSocketWatchPool.ReleaseObject(watch);
+
+    // Unlike select(), epoll does not need to be restarted for the removal to take effect,
+    // and any event already dequeued for this watch is discarded by HandleEvents().
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::UpdateEpollRegistration(SocketWatch & watch)
+{
+    VerifyOrReturnError(watch.mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    uint32_t events = 0;
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead))
+    {
+        events |= EPOLLIN;
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite))
+    {
+        events |= EPOLLOUT;
+    }
+    VerifyOrReturnError(events != watch.mRegisteredEvents, CHIP_NO_ERROR);
+
+    int op;
+    if (watch.mRegisteredEvents == 0)
+    {
+        op = EPOLL_CTL_ADD;
+    }
+    else if (events == 0)
+    {
+        op = EPOLL_CTL_DEL;
+    }
+    else
+    {
+        op = EPOLL_CTL_MOD;
+    }
+
+    struct epoll_event event = {};
+    event.events             = events;
+    event.data.fd            = watch.mFD;
+    if (epoll_ctl(mEpollFd, op, watch.mFD, &event) != 0)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    watch.mRegisteredEvents = events;
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Translate the events reported by epoll for a socket into SocketEvents.
+ *
+ *  Hang-up and error conditions are reported through whichever of read or write the socket is
+ *  being watched for, which matches how select() marks such a socket as ready, so that the
+ *  subsequent recv()/send() call observes the error.
+ *
+ *  @param[in]    epollEvents   The events reported by epoll_wait().
+ *
+ *  @param[in]    requested     The events that the socket is being watched for.
+ */
+SocketEvents LayerImplEpoll::SocketEventsFromEpollEvents(uint32_t epollEvents, SocketEvents requested)
+{
+    SocketEvents res;
+
+    const bool failed = (epollEvents & (EPOLLERR | EPOLLHUP)) != 0;
+    if (requested.Has(SocketEventFlags::kRead) && (failed || (epollEvents & EPOLLIN)))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (requested.Has(SocketEventFlags::kWrite) && (failed || (epollEvents & EPOLLOUT)))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+    if (epollEvents & EPOLLERR)
+    {
+        res.Set(SocketEventFlags::kExcept);
+    }
+
+    return res;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+    Clock::Timestamp awakenTime        = currentTime + kDefaultMinSleepPeriod;
+
+    TimerList::Node * timer = mTimerList.Earliest();
+    if (timer && timer->AwakenTime() < awakenTime)
+    {
+        awakenTime = timer->AwakenTime();
+    }
+
+    // Unlike select(), there is no per-turn interest set to rebuild: socket interest is kept up to date
+    // in the kernel as it changes, so all that is left to compute here is the timeout.
+    const Clock::Timestamp sleepTime = (awakenTime > currentTime) ? (awakenTime - currentTime) : Clock::kZero;
+    mNextTimeoutMs                   = static_cast<int>(std::min<Clock::Timestamp::rep>(sleepTime.count(), INT_MAX));
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mWaitResult = epoll_wait(mEpollFd, mReadyEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, mNextTimeoutMs);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsWaitResultValid())
+    {
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(timer);
+    }
+
+    // Only the sockets that are actually ready are visited. An event that was dequeued for a socket that an earlier
+    // callback of this pass stopped watching is dropped, as the descriptor no longer has a watch (or, if it was
+    // watched again, is reported to the new watch only for the events it asked for).
+    for (int i = 0; i < mWaitResult; i++)
+    {
+        SocketWatch * w = WatchForFd(mReadyEvents[i].data.fd);
+        if (w == nullptr)
+        {
+            continue;
+        }
+
+        SocketEvents events = SocketEventsFromEpollEvents(mReadyEvents[i].events, w->mPendingIO);
+        if (events.HasAny() && w->mCallback != nullptr)
+        {
+            w->mCallback(events, w->mCallbackData);
+        }
+    }
+    mWaitResult = 0;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+} // namespace System
+} // namespace chip
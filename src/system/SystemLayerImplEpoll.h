@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using Linux epoll().
+ *
+ *      Unlike LayerImplSelect, interest in a socket is registered with the kernel
+ *      once (and updated only when it changes), so that each event loop turn costs
+ *      O(ready sockets) rather than O(watched sockets), and file descriptors are
+ *      not limited to FD_SETSIZE.
+ */
+
+#pragma once
+
+#include "system/SystemConfig.h"
+
+#if CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "LayerImplEpoll can not be combined with CHIP_SYSTEM_CONFIG_USE_DISPATCH or CHIP_SYSTEM_CONFIG_USE_LIBEV"
+#endif
+
+#include <sys/epoll.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <lib/support/ObjectLifeCycle.h>
+#include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
+#include <system/WakeEvent.h>
+
+namespace chip {
+namespace System {
+
+class LayerImplEpoll : public LayerSocketsLoop
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override { VerifyOrDie(mLayerState.Destroy()); }
+
+    // Layer overrides.
+    CHIP_ERROR Init() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return mLayerState.IsInitialized(); }
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    bool IsTimerActive(TimerCompleteCallback onComplete, void * appState) override;
+    void CancelTimer(TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ScheduleWork(TimerCompleteCallback onComplete, void * appState) override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR StartWatchingSocket(int fd, SocketWatchToken * tokenOut) override;
+    CHIP_ERROR SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data) override;
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+    SocketWatchToken InvalidSocketWatchToken() override { return reinterpret_cast<SocketWatchToken>(nullptr); }
+
+    // LayerSocketLoop overrides.
+    void Signal() override;
+    void EventLoopBegins() override {}
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+    void EventLoopEnds() override {}
+
+    // Expose the result of WaitForEvents() for non-blocking socket implementations.
+    bool IsWaitResultValid() const { return mWaitResult >= 0; }
+
+protected:
+    static SocketEvents SocketEventsFromEpollEvents(uint32_t epollEvents, SocketEvents requested);
+
+    // The capacity of the watch pool when pools are inline. With heap pools, as on Linux, watches are allocated as sockets
+    // are watched and their number is not limited.
+    static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
+        (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+
+    struct SocketWatch
+    {
+        explicit SocketWatch(int fd) : mFD(fd) {}
+        int mFD;
+        SocketEvents mPendingIO;
+        // Events currently registered with the kernel for mFD; 0 when mFD is not in the epoll set.
+        uint32_t mRegisteredEvents    = 0;
+        SocketWatchCallback mCallback = nullptr;
+        intptr_t mCallbackData        = 0;
+    };
+    ObjectPool<SocketWatch, kSocketWatchMax> mSocketWatchPool;
+
+    // The watch of each watched descriptor, indexed by descriptor, so that starting a watch and dispatching an event do
+    // not depend on the number of watched sockets. The table grows to the highest watched descriptor.
+    Platform::ScopedMemoryBufferWithSize<SocketWatch *> mSocketWatchesByFd;
+
+    SocketWatch * WatchForFd(int fd) const
+    {
+        return (static_cast<size_t>(fd) < mSocketWatchesByFd.AllocatedSize()) ? mSocketWatchesByFd[static_cast<size_t>(fd)]
+                                                                               : nullptr;
+    }
+    CHIP_ERROR GrowSocketWatchTable(int fd);
+    CHIP_ERROR UpdateEpollRegistration(SocketWatch & watch);
+
+    TimerPool<TimerList::Node> mTimerPool;
+    TimerQueue mTimerList;
+    // List of expired timers being processed right now.  Stored in a member so
+    // we can cancel them.
+    TimerList mExpiredTimers;
+    int mNextTimeoutMs;
+
+    int mEpollFd = -1;
+    struct epoll_event mReadyEvents[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    // Return value from epoll_wait(), carried between WaitForEvents() and HandleEvents().
+    int mWaitResult;
+
+    ObjectLifeCycle mLayerState;
+    WakeEvent mWakeEvent;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    std::atomic<pthread_t> mHandleEventsThread;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+using LayerImpl = LayerImplEpoll;
+
+} // namespace System
+} // namespace chip
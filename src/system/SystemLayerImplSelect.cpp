@@ -163,7 +163,13 @@ CHIP_ERROR LayerImplSelect::StartTimer(Clock::Timeout delay, TimerCompleteCallba
 
     CancelTimer(onComplete, appState);
 
-    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    Clock::Timestamp awakenTime = SystemClock().GetMonotonicTimestamp() + delay;
+    if (delay > Clock::kZero)
+    {
+        awakenTime = CoalesceAwakenTime(awakenTime);
+    }
+
+    TimerList::Node * timer = mTimerPool.Create(*this, awakenTime, onComplete, appState);
     VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
 
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
@@ -43,6 +43,7 @@
 
 #include <limits.h>
 #include <limits>
+#include <mutex>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
@@ -126,6 +127,159 @@ void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 }
 #endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+//
+// Size classes for heap allocated PacketBuffer objects. Every block is allocated with the size of its class, so that a freed
+// block can be reused for any buffer of the class. Each thread keeps a few freed blocks of each class, which it uses without
+// locking, and exchanges them in batches with a cache shared by all threads.
+//
+
+namespace {
+
+constexpr size_t kNumSizeClasses  = Stats::kNumPacketBufferSizeClasses;
+constexpr size_t kThreadCacheSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE;
+constexpr size_t kSharedCacheSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE;
+constexpr size_t kCacheBatchSize  = (kThreadCacheSize + 1) / 2;
+static_assert(kThreadCacheSize > 0, "Packet buffer thread caches must hold at least one buffer");
+
+// Freed blocks are chained through their first bytes.
+struct CachedBlock
+{
+    CachedBlock * mNext;
+};
+
+struct CachedBlockList
+{
+    CachedBlock * mHead = nullptr;
+    size_t mCount       = 0;
+
+    void Push(void * block)
+    {
+        CachedBlock * cachedBlock = static_cast<CachedBlock *>(block);
+        cachedBlock->mNext        = mHead;
+        mHead                     = cachedBlock;
+        mCount++;
+    }
+
+    CachedBlock * Pop()
+    {
+        CachedBlock * block = mHead;
+        if (block != nullptr)
+        {
+            mHead = block->mNext;
+            mCount--;
+        }
+        return block;
+    }
+
+    void MoveTo(CachedBlockList & other, size_t count)
+    {
+        for (; count > 0 && mHead != nullptr; count--)
+        {
+            other.Push(Pop());
+        }
+    }
+};
+
+// Constant-initialized and trivially destructible, so that it is usable by threads that exit after static destruction began.
+struct SharedBlockCache
+{
+    std::mutex mLock;
+    CachedBlockList mBlocks[kNumSizeClasses];
+};
+
+SharedBlockCache sSharedBlockCache;
+
+class ThreadBlockCache
+{
+public:
+    ~ThreadBlockCache()
+    {
+        // The thread may exit after Platform::MemoryShutdown(), so hand the blocks over instead of freeing them.
+        std::lock_guard<std::mutex> lock(sSharedBlockCache.mLock);
+        for (size_t sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++)
+        {
+            mBlocks[sizeClass].MoveTo(sSharedBlockCache.mBlocks[sizeClass], mBlocks[sizeClass].mCount);
+        }
+    }
+
+    void * Allocate(size_t sizeClass)
+    {
+        CachedBlockList & blocks = mBlocks[sizeClass];
+        if (blocks.mCount == 0)
+        {
+            std::lock_guard<std::mutex> lock(sSharedBlockCache.mLock);
+            sSharedBlockCache.mBlocks[sizeClass].MoveTo(blocks, kCacheBatchSize);
+        }
+        return blocks.Pop();
+    }
+
+    void Free(void * block, size_t sizeClass)
+    {
+        CachedBlockList & blocks = mBlocks[sizeClass];
+        if (blocks.mCount == kThreadCacheSize)
+        {
+            CachedBlockList excess;
+            {
+                std::lock_guard<std::mutex> lock(sSharedBlockCache.mLock);
+                CachedBlockList & shared = sSharedBlockCache.mBlocks[sizeClass];
+                blocks.MoveTo(shared, kCacheBatchSize);
+                if (shared.mCount > kSharedCacheSize)
+                {
+                    shared.MoveTo(excess, shared.mCount - kSharedCacheSize);
+                }
+            }
+            while (CachedBlock * excessBlock = excess.Pop())
+            {
+                chip::Platform::MemoryFree(excessBlock);
+            }
+        }
+        blocks.Push(block);
+    }
+
+private:
+    CachedBlockList mBlocks[kNumSizeClasses];
+};
+
+thread_local ThreadBlockCache sThreadBlockCache;
+
+} // namespace
+
+size_t PacketBuffer::SizeClassOf(size_t aBlockSize)
+{
+    static_assert(PacketBuffer::kNumSizeClasses == Stats::kNumPacketBufferSizeClasses, "Packet buffer statistics do not match");
+
+    size_t sizeClass = 0;
+    while (sizeClass < kNumSizeClasses - 1 && kSizeClassBlockSizes[sizeClass] < aBlockSize)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+PacketBuffer * PacketBuffer::AllocateBlock(size_t aBlockSize)
+{
+    const size_t sizeClass = SizeClassOf(aBlockSize);
+    void * block           = sThreadBlockCache.Allocate(sizeClass);
+    if (block == nullptr)
+    {
+        block = chip::Platform::MemoryAlloc(kSizeClassBlockSizes[sizeClass]);
+        VerifyOrReturnValue(block != nullptr, nullptr);
+    }
+
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs256 + sizeClass);
+    SYSTEM_STATS_INCREMENT_PACKETBUFFER_ALLOCATIONS(sizeClass);
+    return static_cast<PacketBuffer *>(block);
+}
+
+void PacketBuffer::FreeBlock(PacketBuffer * aBlock, size_t aBlockSize)
+{
+    const size_t sizeClass = SizeClassOf(aBlockSize);
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs256 + sizeClass);
+    sThreadBlockCache.Free(aBlock, sizeClass);
+}
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+
 // Number of unused bytes below which \c RightSize() won't bother reallocating.
 constexpr uint16_t kRightSizingThreshold = 16;
 
@@ -146,8 +300,17 @@ void PacketBufferHandle::InternalRightSize()
         return;
     }
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
+    const size_t blockSize = usedSize + PacketBuffer::kStructureSize;
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    // A smaller buffer of the same size class would use the same memory.
+    if (PacketBuffer::SizeClassOf(blockSize) == PacketBuffer::SizeClassOf(mBuffer->alloc_size + PacketBuffer::kStructureSize))
+    {
+        return;
+    }
+    PacketBuffer * newBuffer = PacketBuffer::AllocateBlock(blockSize);
+#else
     PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+#endif
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -525,6 +688,11 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     UNLOCK_BUF_POOL();
 
+#elif CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+
+    lPacket = PacketBuffer::AllocateBlock(lBlockSize);
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
     lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
@@ -605,12 +773,15 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         {
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const size_t lBlockSize = aPacket->alloc_size + kStructureSize;
+            ::chip::Platform::MemoryDebugCheckPointer(aPacket, lBlockSize);
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
+#elif CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+            FreeBlock(aPacket, lBlockSize);
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
 #endif
@@ -369,6 +369,17 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES || defined(DOXYGEN)
+    // Memory block sizes that heap allocations are rounded up to, so that freed blocks can be reused for other buffers.
+    static constexpr uint16_t kSizeClassBlockSizes[] = { kBlockSize < 256 ? kBlockSize : 256, kBlockSize < 512 ? kBlockSize : 512,
+                                                         kBlockSize < 1024 ? kBlockSize : 1024, kBlockSize };
+    static constexpr size_t kNumSizeClasses           = sizeof(kSizeClassBlockSizes) / sizeof(kSizeClassBlockSizes[0]);
+
+    static size_t SizeClassOf(size_t aBlockSize);
+    static PacketBuffer * AllocateBlock(size_t aBlockSize);
+    static void FreeBlock(PacketBuffer * aBlock, size_t aBlockSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES || defined(DOXYGEN)
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -44,6 +44,12 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "Packet Buffers",
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    "Packet Buffers (256 B)",
+    "Packet Buffers (512 B)",
+    "Packet Buffers (1024 B)",
+    "Packet Buffers (max size)",
+#endif
 #endif
     "Timers",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -59,6 +65,9 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 
 count_t sResourcesInUse[kNumEntries];
 count_t sHighWatermarks[kNumEntries];
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+total_t sPacketBufferAllocations[kNumPacketBufferSizeClasses];
+#endif
 
 const Label * GetStrings()
 {
@@ -75,10 +84,20 @@ count_t * GetHighWatermarks()
     return sHighWatermarks;
 }
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+total_t * GetPacketBufferAllocations()
+{
+    return sPacketBufferAllocations;
+}
+#endif
+
 void UpdateSnapshot(Snapshot & aSnapshot)
 {
     memcpy(&aSnapshot.mResourcesInUse, &sResourcesInUse, sizeof(aSnapshot.mResourcesInUse));
     memcpy(&aSnapshot.mHighWatermarks, &sHighWatermarks, sizeof(aSnapshot.mHighWatermarks));
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    memcpy(&aSnapshot.mPacketBufferAllocations, &sPacketBufferAllocations, sizeof(aSnapshot.mPacketBufferAllocations));
+#endif
 
     SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS();
 }
@@ -100,6 +119,13 @@ bool Difference(Snapshot & result, Snapshot & after, Snapshot & before)
         }
     }
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    for (i = 0; i < kNumPacketBufferSizeClasses; i++)
+    {
+        result.mPacketBufferAllocations[i] = after.mPacketBufferAllocations[i] - before.mPacketBufferAllocations[i];
+    }
+#endif
+
     return leak;
 }
 
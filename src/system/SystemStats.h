@@ -35,6 +35,7 @@
 
 // Include dependent headers
 #include <lib/support/DLLUtil.h>
+#include <system/SystemPacketBufferInternal.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -58,6 +59,13 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    // Packet buffers of each size class, in the order of PacketBuffer::kSizeClassBlockSizes.
+    kSystemLayer_NumPacketBufs256,
+    kSystemLayer_NumPacketBufs512,
+    kSystemLayer_NumPacketBufs1024,
+    kSystemLayer_NumPacketBufsMax,
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -78,17 +86,30 @@ typedef int8_t count_t;
 extern count_t ResourcesInUse[kNumEntries];
 extern count_t HighWatermarks[kNumEntries];
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+constexpr int kNumPacketBufferSizeClasses = kSystemLayer_NumPacketBufsMax - kSystemLayer_NumPacketBufs256 + 1;
+
+// Running count of allocations, which the difference between two snapshots turns into an allocation rate.
+typedef uint32_t total_t;
+#endif
+
 class Snapshot
 {
 public:
     count_t mResourcesInUse[kNumEntries];
     count_t mHighWatermarks[kNumEntries];
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    total_t mPacketBufferAllocations[kNumPacketBufferSizeClasses];
+#endif
 };
 
 bool Difference(Snapshot & result, Snapshot & after, Snapshot & before);
 void UpdateSnapshot(Snapshot & aSnapshot);
 count_t * GetResourcesInUse();
 count_t * GetHighWatermarks();
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+total_t * GetPacketBufferAllocations();
+#endif
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 void UpdateLwipPbufCounts(void);
@@ -141,6 +162,12 @@ const Label * GetStrings();
         chip::System::Stats::GetResourcesInUse()[entry] = 0;                                                                       \
     } while (0)
 
+#define SYSTEM_STATS_INCREMENT_PACKETBUFFER_ALLOCATIONS(sizeClass)                                                                 \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        ++(chip::System::Stats::GetPacketBufferAllocations()[sizeClass]);                                                          \
+    } while (0)
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()                                                                                     \
     do                                                                                                                             \
@@ -170,6 +197,8 @@ const Label * GetStrings();
 
 #define SYSTEM_STATS_RESET(entry)
 
+#define SYSTEM_STATS_INCREMENT_PACKETBUFFER_ALLOCATIONS(sizeClass)
+
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 
 #define SYSTEM_STATS_TEST_IN_USE(entry, expected) (true)
@@ -178,5 +178,340 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+bool TimerWheel::IsBefore(const Node * a, const Node * b)
+{
+    if (a->AwakenTime() != b->AwakenTime())
+    {
+        return a->AwakenTime() < b->AwakenTime();
+    }
+    // Sequence numbers may wrap; compare them as a signed distance.
+    return static_cast<int32_t>(a->mSequence - b->mSequence) < 0;
+}
+
+size_t TimerWheel::BucketFor(TimerCompleteCallback onComplete, void * appState)
+{
+    constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete)) * kMultiplier;
+    hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState));
+    hash *= kMultiplier;
+    return static_cast<size_t>(hash >> 32) & (kBucketCount - 1);
+}
+
+TimerWheel::Node * TimerWheel::SortByExpiry(Node * chain)
+{
+    // Stable merge sort of a chain linked through mNextTimer.
+    if (chain == nullptr || chain->mNextTimer == nullptr)
+    {
+        return chain;
+    }
+
+    Node * slow = chain;
+    for (Node * fast = chain->mNextTimer; fast != nullptr && fast->mNextTimer != nullptr; fast = fast->mNextTimer->mNextTimer)
+    {
+        slow = slow->mNextTimer;
+    }
+    Node * second    = slow->mNextTimer;
+    slow->mNextTimer = nullptr;
+
+    Node * a = SortByExpiry(chain);
+    Node * b = SortByExpiry(second);
+
+    Node * head  = nullptr;
+    Node ** tail = &head;
+    while (a != nullptr && b != nullptr)
+    {
+        Node ** from = IsBefore(b, a) ? &b : &a;
+        *tail        = *from;
+        tail         = &(*from)->mNextTimer;
+        *from        = (*from)->mNextTimer;
+    }
+    *tail = (a != nullptr) ? a : b;
+    return head;
+}
+
+uint16_t TimerWheel::SlotFor(uint64_t tick) const
+{
+    if (tick <= mCurrentTick)
+    {
+        return static_cast<uint16_t>(mCurrentTick & (kSlotsPerLevel - 1));
+    }
+
+    // The level is the most significant group of kSlotBits in which the expiration tick differs from the current tick, so
+    // every timer in a level expires before every timer in the next level up.
+    uint64_t diff  = (tick ^ mCurrentTick) >> kSlotBits;
+    unsigned level = 0;
+    while (diff != 0)
+    {
+        diff >>= kSlotBits;
+        ++level;
+    }
+    if (level >= kLevels)
+    {
+        return kOverflowSlot;
+    }
+    return static_cast<uint16_t>(level * kSlotsPerLevel + ((tick >> (level * kSlotBits)) & (kSlotsPerLevel - 1)));
+}
+
+void TimerWheel::Link(Node * timer)
+{
+    uint16_t slot     = SlotFor(timer->AwakenTime().count());
+    timer->mWheelSlot = slot;
+    timer->mPrevTimer = nullptr;
+    timer->mNextTimer = mSlots[slot];
+    if (mSlots[slot] != nullptr)
+    {
+        mSlots[slot]->mPrevTimer = timer;
+    }
+    mSlots[slot] = timer;
+}
+
+void TimerWheel::Unlink(Node * timer)
+{
+    if (timer->mPrevTimer != nullptr)
+    {
+        timer->mPrevTimer->mNextTimer = timer->mNextTimer;
+    }
+    else
+    {
+        mSlots[timer->mWheelSlot] = timer->mNextTimer;
+    }
+    if (timer->mNextTimer != nullptr)
+    {
+        timer->mNextTimer->mPrevTimer = timer->mPrevTimer;
+    }
+    timer->mNextTimer = nullptr;
+    timer->mPrevTimer = nullptr;
+    timer->mWheelSlot = kNotInWheel;
+}
+
+void TimerWheel::AddToBucket(Node * timer)
+{
+    Node *& bucket       = mBuckets[BucketFor(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    timer->mNextInBucket = bucket;
+    bucket               = timer;
+}
+
+void TimerWheel::RemoveFromBucket(Node * timer)
+{
+    Node ** link = &mBuckets[BucketFor(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())];
+    while (*link != nullptr)
+    {
+        if (*link == timer)
+        {
+            *link = timer->mNextInBucket;
+            break;
+        }
+        link = &(*link)->mNextInBucket;
+    }
+    timer->mNextInBucket = nullptr;
+}
+
+TimerWheel::Node * TimerWheel::Detach(Node * timer)
+{
+    Unlink(timer);
+    RemoveFromBucket(timer);
+    if (timer == mEarliestTimer)
+    {
+        UpdateEarliest();
+    }
+    return timer;
+}
+
+TimerWheel::Node * TimerWheel::FindEarliest(TimerCompleteCallback onComplete, void * appState) const
+{
+    Node * found = nullptr;
+    for (Node * timer = mBuckets[BucketFor(onComplete, appState)]; timer != nullptr; timer = timer->mNextInBucket)
+    {
+        if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState &&
+            (found == nullptr || IsBefore(timer, found)))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+void TimerWheel::UpdateEarliest()
+{
+    mEarliestTimer = nullptr;
+
+    Node * slot = nullptr;
+    for (unsigned level = 0; level < kLevels && slot == nullptr; ++level)
+    {
+        // Timers in a level above 0 always fall after the current tick's index within that level.
+        unsigned index = static_cast<unsigned>((mCurrentTick >> (level * kSlotBits)) & (kSlotsPerLevel - 1)) + (level > 0 ? 1 : 0);
+        for (; index < kSlotsPerLevel && slot == nullptr; ++index)
+        {
+            slot = mSlots[level * kSlotsPerLevel + index];
+        }
+    }
+    if (slot == nullptr)
+    {
+        slot = mSlots[kOverflowSlot];
+    }
+
+    for (Node * timer = slot; timer != nullptr; timer = timer->mNextTimer)
+    {
+        if (mEarliestTimer == nullptr || IsBefore(timer, mEarliestTimer))
+        {
+            mEarliestTimer = timer;
+        }
+    }
+}
+
+void TimerWheel::AdvanceTo(uint64_t tick)
+{
+    if (tick <= mCurrentTick)
+    {
+        return;
+    }
+
+    // Collect every timer whose placement is no longer valid relative to the new tick; all others stay where they are.
+    Node * pending = nullptr;
+    auto drain     = [this, &pending](unsigned slot) {
+        Node * timer = mSlots[slot];
+        mSlots[slot] = nullptr;
+        while (timer != nullptr)
+        {
+            Node * next       = timer->mNextTimer;
+            timer->mNextTimer = pending;
+            pending           = timer;
+            timer             = next;
+        }
+    };
+
+    for (unsigned level = 0; level < kLevels; ++level)
+    {
+        unsigned shift = level * kSlotBits;
+        unsigned first = 0;
+        unsigned last  = kSlotsPerLevel - 1;
+        if ((mCurrentTick >> (shift + kSlotBits)) == (tick >> (shift + kSlotBits)))
+        {
+            first = static_cast<unsigned>((mCurrentTick >> shift) & (kSlotsPerLevel - 1));
+            last  = static_cast<unsigned>((tick >> shift) & (kSlotsPerLevel - 1));
+        }
+        for (unsigned index = first; index <= last; ++index)
+        {
+            drain(level * kSlotsPerLevel + index);
+        }
+    }
+    if ((mCurrentTick >> (kLevels * kSlotBits)) != (tick >> (kLevels * kSlotBits)))
+    {
+        drain(kOverflowSlot);
+    }
+
+    mCurrentTick = tick;
+    while (pending != nullptr)
+    {
+        Node * next = pending->mNextTimer;
+        Link(pending);
+        pending = next;
+    }
+}
+
+TimerWheel::Node * TimerWheel::Add(Node * add)
+{
+    VerifyOrDie(add->mWheelSlot == kNotInWheel);
+    add->mSequence = mNextSequence++;
+    Link(add);
+    AddToBucket(add);
+    if (mEarliestTimer == nullptr || IsBefore(add, mEarliestTimer))
+    {
+        mEarliestTimer = add;
+    }
+    return mEarliestTimer;
+}
+
+TimerWheel::Node * TimerWheel::Remove(Node * remove)
+{
+    if (remove != nullptr && remove->mWheelSlot != kNotInWheel)
+    {
+        Detach(remove);
+    }
+    return mEarliestTimer;
+}
+
+TimerWheel::Node * TimerWheel::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindEarliest(aOnComplete, aAppState);
+    return (timer == nullptr) ? nullptr : Detach(timer);
+}
+
+TimerWheel::Node * TimerWheel::PopIfEarlier(Clock::Timestamp t)
+{
+    if ((mEarliestTimer == nullptr) || !(mEarliestTimer->AwakenTime() < t))
+    {
+        return nullptr;
+    }
+    return Detach(mEarliestTimer);
+}
+
+TimerList TimerWheel::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+
+    if ((mEarliestTimer == nullptr) || !(mEarliestTimer->AwakenTime() < t))
+    {
+        return out;
+    }
+
+    // After advancing, every timer expiring before t is in the current tick's level 0 slot.
+    AdvanceTo(t.count() - 1);
+
+    Node * expired = nullptr;
+    Node * timer   = mSlots[mCurrentTick & (kSlotsPerLevel - 1)];
+    while (timer != nullptr)
+    {
+        Node * next = timer->mNextTimer;
+        if (timer->AwakenTime() < t)
+        {
+            Unlink(timer);
+            RemoveFromBucket(timer);
+            timer->mNextTimer = expired;
+            expired           = timer;
+        }
+        timer = next;
+    }
+
+    out.mEarliestTimer = SortByExpiry(expired);
+    UpdateEarliest();
+    return out;
+}
+
+void TimerWheel::Clear()
+{
+    for (auto & slot : mSlots)
+    {
+        slot = nullptr;
+    }
+    for (auto & bucket : mBuckets)
+    {
+        bucket = nullptr;
+    }
+    mEarliestTimer = nullptr;
+    mCurrentTick   = 0;
+    mNextSequence  = 0;
+}
+
+Clock::Timeout TimerWheel::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = FindEarliest(aOnComplete, aAppState);
+    if (timer == nullptr)
+    {
+        return Clock::kZero;
+    }
+
+    Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+    if (currentTime < timer->AwakenTime())
+    {
+        return Clock::Timeout(timer->AwakenTime() - currentTime);
+    }
+    return Clock::kZero;
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 } // namespace System
 } // namespace chip
@@ -45,6 +45,7 @@ namespace System {
 
 class Layer;
 class TestTimer;
+class TimerWheel;
 
 /**
  * Basic Timer information: time and callback.
@@ -117,6 +118,14 @@ public:
             TimerData(systemLayer, awakenTime, onComplete, appState), mNextTimer(nullptr)
         {}
         Node * mNextTimer;
+
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+        // Bookkeeping used only while the node is held by a TimerWheel.
+        Node * mPrevTimer    = nullptr;
+        Node * mNextInBucket = nullptr;
+        uint32_t mSequence   = 0;
+        uint16_t mWheelSlot  = UINT16_MAX;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
     };
 
     TimerList() : mEarliestTimer(nullptr) {}
@@ -187,9 +196,151 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    friend class TimerWheel;
     Node * mEarliestTimer;
 };
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ * Hierarchical timing wheel of `Timer`s, offering the same interface as TimerList.
+ *
+ * Timers are placed into one of several levels of 64 slots according to how far in the future they expire, and are
+ * additionally hashed by (callback, appState). Add() and both forms of Remove() therefore take constant time instead of
+ * walking every pending timer, which matters once a node holds thousands of timers (e.g. subscriptions on a controller).
+ * Timers expiring at the same time are returned in the order they were added, as with TimerList.
+ */
+class TimerWheel
+{
+public:
+    using Node = TimerList::Node;
+
+    TimerWheel() { Clear(); }
+
+    /**
+     * Add a timer to the wheel.
+     *
+     * @return  The new earliest timer in the wheel.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the wheel, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the wheel, or nullptr if the wheel is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the wheel contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if the wheel is empty.
+     */
+    Node * PopEarliest() { return (mEarliestTimer == nullptr) ? nullptr : Detach(mEarliestTimer); }
+
+    /**
+     * Remove and return the earliest timer in the wheel, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t);
+
+    /**
+     * Get the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest() const { return mEarliestTimer; }
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mEarliestTimer == nullptr; }
+
+    /**
+     * Remove and return, as an ordered list, all timers that expire before the given time @a t.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the earliest timer with the given properties, if present, and return its remaining time.
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    static constexpr unsigned kSlotBits      = 6;
+    static constexpr unsigned kSlotsPerLevel = 1u << kSlotBits;
+    static constexpr unsigned kLevels        = 6;
+
+    // Timers more than 2^36 ms (about two years) away from the current tick share one unordered overflow slot.
+    static constexpr uint16_t kOverflowSlot = kLevels * kSlotsPerLevel;
+    static constexpr uint16_t kNotInWheel   = UINT16_MAX;
+    static constexpr size_t kBucketCount    = CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS;
+
+    static_assert((kBucketCount & (kBucketCount - 1)) == 0, "CHIP_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS must be a power of 2");
+    static_assert(kOverflowSlot < kNotInWheel, "Timer wheel slot index does not fit");
+
+    static bool IsBefore(const Node * a, const Node * b);
+    static size_t BucketFor(TimerCompleteCallback onComplete, void * appState);
+    static Node * SortByExpiry(Node * chain);
+
+    uint16_t SlotFor(uint64_t tick) const;
+    void Link(Node * timer);
+    void Unlink(Node * timer);
+    void AddToBucket(Node * timer);
+    void RemoveFromBucket(Node * timer);
+    Node * Detach(Node * timer);
+    Node * FindEarliest(TimerCompleteCallback onComplete, void * appState) const;
+    void UpdateEarliest();
+    void AdvanceTo(uint64_t tick);
+
+    Node * mSlots[kOverflowSlot + 1];
+    Node * mBuckets[kBucketCount];
+    Node * mEarliestTimer;
+    // All timers expiring at or before this tick live in its level 0 slot.
+    uint64_t mCurrentTick;
+    uint32_t mNextSequence;
+};
+
+/**
+ * Container used by System::Layer implementations for pending timers.
+ */
+using TimerQueue = TimerWheel;
+
+#else // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+using TimerQueue = TimerList;
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ * Apply the configured timer slack (CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS) to the expiration time of a timer started
+ * with a non-zero delay, rounding it up so that nearby timers expire together and share a single wakeup.
+ */
+inline Clock::Timestamp CoalesceAwakenTime(Clock::Timestamp awakenTime)
+{
+#if CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS > 1
+    constexpr Clock::Timestamp::rep kSlack = CHIP_SYSTEM_CONFIG_TIMER_SLACK_MS;
+    return Clock::Timestamp(((awakenTime.count() + kSlack - 1) / kSlack) * kSlack);
+#else
+    return awakenTime;
+#endif
+}
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
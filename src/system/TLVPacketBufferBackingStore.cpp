@@ -37,16 +37,31 @@ CHIP_ERROR TLVPacketBufferBackingStore::OnInit(chip::TLV::TLVReader & reader, co
 
 CHIP_ERROR TLVPacketBufferBackingStore::GetNextBuffer(chip::TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
 {
+    // Readers initialized from a reader (copies, container readers, the helper of TLVWriter::CopyElement) share this
+    // backing store and advance independently, so the buffer to advance from is the one whose data the reader has
+    // consumed: on entry, bufStart points one byte beyond it. That is usually the buffer last handed out, which is
+    // kept in mCurrentBuffer; the chain is only scanned from its head for a reader that is elsewhere in it.
     if (mUseChainedBuffers)
     {
-        mCurrentBuffer.Advance();
-    }
-    else
-    {
-        mCurrentBuffer = nullptr;
+        if (mCurrentBuffer.IsNull() || mCurrentBuffer->Start() + mCurrentBuffer->DataLength() != bufStart)
+        {
+            mCurrentBuffer = mHeadBuffer.Retain();
+            while (!mCurrentBuffer.IsNull() && mCurrentBuffer->Start() + mCurrentBuffer->DataLength() != bufStart)
+            {
+                mCurrentBuffer.Advance();
+            }
+        }
+        if (!mCurrentBuffer.IsNull())
+        {
+            mCurrentBuffer.Advance();
+        }
+        while (!mCurrentBuffer.IsNull() && mCurrentBuffer->DataLength() == 0)
+        {
+            mCurrentBuffer.Advance();
+        }
     }
 
-    if (mCurrentBuffer.IsNull())
+    if (!mUseChainedBuffers || mCurrentBuffer.IsNull())
     {
         bufStart = nullptr;
         bufLen   = 0;
@@ -113,5 +128,18 @@ CHIP_ERROR TLVPacketBufferBackingStore::GetNewBuffer(chip::TLV::TLVWriter & writ
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR ChainedPacketBufferTLVReader::Init(chip::System::PacketBufferHandle && buffer)
+{
+    // The chain may hold more data than PacketBuffer::TotalLength() can count, so add up the lengths of its buffers.
+    uint32_t totalLength = 0;
+    for (PacketBufferHandle current = buffer.Retain(); !current.IsNull(); current.Advance())
+    {
+        totalLength += current->DataLength();
+    }
+
+    mBackingStore.Init(std::move(buffer), /* useChainedBuffers = */ true);
+    return TLV::TLVReader::Init(mBackingStore, totalLength);
+}
+
 } // namespace System
 } // namespace chip
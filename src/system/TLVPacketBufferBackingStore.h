@@ -113,6 +113,27 @@ private:
     PacketBufferHandle mBuffer;
 };
 
+/**
+ * A TLVReader over a chain of PacketBuffers, which decodes elements that span buffers in place instead of requiring the
+ * chain to be copied into one contiguous buffer first.
+ *
+ * Readers initialized from this reader may be used alongside it, but must not outlive it. A string element is only
+ * readable with Get(ByteSpan &) or GetDataPtr() if its data lies within one buffer of the chain.
+ */
+class DLL_EXPORT ChainedPacketBufferTLVReader : public TLV::TLVReader
+{
+public:
+    /**
+     * Initializes a TLVReader object to read from a chain of PacketBuffers.
+     *
+     * @param[in]    buffer  A handle to the head of the chain, to be used as backing store for a TLV class.
+     */
+    CHIP_ERROR Init(chip::System::PacketBufferHandle && buffer);
+
+private:
+    TLVPacketBufferBackingStore mBackingStore;
+};
+
 class DLL_EXPORT PacketBufferTLVWriter : public chip::TLV::TLVWriter
 {
 public:
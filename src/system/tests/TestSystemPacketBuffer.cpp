@@ -40,6 +40,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -133,6 +134,7 @@ public:
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
+    static void CheckSizeClasses(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
@@ -1937,6 +1939,62 @@ void PacketBufferTest::CheckHandleCloneData(nlTestSuite * inSuite, void * inCont
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 }
 
+void PacketBufferTest::CheckSizeClasses(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+    NL_TEST_ASSERT(inSuite, PacketBuffer::SizeClassOf(1) == 0);
+    NL_TEST_ASSERT(inSuite, PacketBuffer::SizeClassOf(PacketBuffer::kSizeClassBlockSizes[0]) == 0);
+    NL_TEST_ASSERT(inSuite, PacketBuffer::SizeClassOf(PacketBuffer::kSizeClassBlockSizes[0] + 1) == 1);
+    NL_TEST_ASSERT(inSuite, PacketBuffer::SizeClassOf(PacketBuffer::kBlockSize) == PacketBuffer::kNumSizeClasses - 1);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    chip::System::Stats::Snapshot before;
+    chip::System::Stats::UpdateSnapshot(before);
+#endif
+
+    // A freed buffer is reused for the next buffer of its size class, whatever its exact size.
+    PacketBufferHandle handle = PacketBufferHandle::New(10, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    PacketBuffer * const smallBuffer = handle.mBuffer;
+    NL_TEST_ASSERT(inSuite, handle->AvailableDataLength() == 10);
+    handle = nullptr;
+
+    handle = PacketBufferHandle::New(PacketBuffer::kSizeClassBlockSizes[0] - PacketBuffer::kStructureSize, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == smallBuffer);
+
+    // Buffers of other size classes do not reuse it.
+    PacketBufferHandle largeHandle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, !largeHandle.IsNull());
+    handle = nullptr;
+    largeHandle = nullptr;
+    largeHandle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, largeHandle.mBuffer != smallBuffer);
+
+    // Right-sizing a buffer within its size class would not save memory.
+    handle = PacketBufferHandle::New(100, 0);
+    PacketBuffer * const buffer = handle.mBuffer;
+    handle->SetDataLength(4);
+    handle.RightSize();
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == buffer);
+
+    handle      = nullptr;
+    largeHandle = nullptr;
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    chip::System::Stats::Snapshot after;
+    chip::System::Stats::Snapshot difference;
+    chip::System::Stats::UpdateSnapshot(after);
+    NL_TEST_ASSERT(inSuite, !chip::System::Stats::Difference(difference, after, before));
+    NL_TEST_ASSERT(inSuite, difference.mPacketBufferAllocations[0] == 3);
+    NL_TEST_ASSERT(inSuite, difference.mPacketBufferAllocations[PacketBuffer::kNumSizeClasses - 1] == 2);
+#endif
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_SIZE_CLASSES
+}
+
 void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext)
 {
     struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
@@ -2006,6 +2064,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::SizeClasses",            PacketBufferTest::CheckSizeClasses),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,406 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the socket watch interface (<tt>chip::System::LayerSockets</tt>)
+ *      of the configured event-loop based System::Layer implementation.
+ *
+ */
+
+#include <system/SystemConfig.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <system/SystemError.h>
+#include <system/SystemLayerImpl.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_LIBEV && !CHIP_SYSTEM_CONFIG_USE_DISPATCH &&                        \
+    CHIP_SYSTEM_CONFIG_USE_POSIX_PIPE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace chip;
+using namespace chip::System;
+
+namespace {
+
+// Enough to exercise a watch table with many idle entries, while staying within the socket watch
+// capacity of every event loop implementation (one of which is taken by the wake event).
+constexpr size_t kNumPipes = 48;
+
+struct WatchedPipe
+{
+    int mReadFd                 = -1;
+    int mWriteFd                = -1;
+    SocketWatchToken mToken     = 0;
+    unsigned mCallbackCount     = 0;
+    SocketWatchToken * mToStop  = nullptr;
+    LayerSockets * mSystemLayer = nullptr;
+
+    static void OnEvent(SocketEvents events, intptr_t data)
+    {
+        WatchedPipe * self = reinterpret_cast<WatchedPipe *>(data);
+        if (events.Has(SocketEventFlags::kRead))
+        {
+            self->mCallbackCount++;
+        }
+        if (self->mToStop != nullptr)
+        {
+            self->mSystemLayer->StopWatchingSocket(self->mToStop);
+            self->mToStop = nullptr;
+        }
+    }
+
+    void MakeReadable() { VerifyOrDie(write(mWriteFd, "x", 1) == 1); }
+
+    void Drain()
+    {
+        char buf[16];
+        while (read(mReadFd, buf, sizeof(buf)) > 0)
+        {
+        }
+    }
+};
+
+struct TestContext
+{
+    LayerImpl mSystemLayer;
+    WatchedPipe mPipes[kNumPipes];
+
+    TestContext()
+    {
+        VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+        VerifyOrDie(mSystemLayer.Init() == CHIP_NO_ERROR);
+    }
+    ~TestContext()
+    {
+        mSystemLayer.Shutdown();
+        Platform::MemoryShutdown();
+    }
+
+    CHIP_ERROR OpenAndWatch(WatchedPipe & pipe)
+    {
+        int fds[2];
+        VerifyOrReturnError(::pipe(fds) == 0, CHIP_ERROR_POSIX(errno));
+        pipe.mReadFd      = fds[0];
+        pipe.mWriteFd     = fds[1];
+        pipe.mSystemLayer = &mSystemLayer;
+        VerifyOrReturnError(fcntl(pipe.mReadFd, F_SETFL, O_NONBLOCK) == 0, CHIP_ERROR_POSIX(errno));
+
+        ReturnErrorOnFailure(mSystemLayer.StartWatchingSocket(pipe.mReadFd, &pipe.mToken));
+        ReturnErrorOnFailure(mSystemLayer.SetCallback(pipe.mToken, WatchedPipe::OnEvent, reinterpret_cast<intptr_t>(&pipe)));
+        return mSystemLayer.RequestCallbackOnPendingRead(pipe.mToken);
+    }
+
+    void Close(WatchedPipe & pipe)
+    {
+        if (pipe.mToken != mSystemLayer.InvalidSocketWatchToken())
+        {
+            mSystemLayer.StopWatchingSocket(&pipe.mToken);
+        }
+        close(pipe.mReadFd);
+        close(pipe.mWriteFd);
+        pipe = WatchedPipe();
+    }
+
+    // Run one turn of the event loop. Callers make sure some socket is ready, so this does not block.
+    void ServiceEvents()
+    {
+        mSystemLayer.PrepareEvents();
+        mSystemLayer.WaitForEvents();
+        mSystemLayer.HandleEvents();
+    }
+
+    void ResetCounts()
+    {
+        for (auto & pipe : mPipes)
+        {
+            pipe.Drain();
+            pipe.mCallbackCount = 0;
+        }
+    }
+};
+
+void TestOnlyReadySocketsDispatched(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    for (auto & pipe : ctx.mPipes)
+    {
+        CHIP_ERROR err = ctx.OpenAndWatch(pipe);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    for (size_t i = 0; i < kNumPipes; i += 5)
+    {
+        ctx.mPipes[i].MakeReadable();
+    }
+    ctx.ServiceEvents();
+
+    for (size_t i = 0; i < kNumPipes; i++)
+    {
+        NL_TEST_ASSERT(inSuite, ctx.mPipes[i].mCallbackCount == ((i % 5 == 0) ? 1u : 0u));
+    }
+
+    // Level triggered: a socket that was not drained is reported again.
+    ctx.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, ctx.mPipes[0].mCallbackCount == 2);
+    NL_TEST_ASSERT(inSuite, ctx.mPipes[1].mCallbackCount == 0);
+
+    ctx.ResetCounts();
+    for (auto & pipe : ctx.mPipes)
+    {
+        ctx.Close(pipe);
+    }
+}
+
+void TestDuplicateWatch(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+    WatchedPipe & pipe = ctx.mPipes[0];
+
+    CHIP_ERROR err = ctx.OpenAndWatch(pipe);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SocketWatchToken duplicate;
+    NL_TEST_ASSERT(inSuite, ctx.mSystemLayer.StartWatchingSocket(pipe.mReadFd, &duplicate) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    ctx.Close(pipe);
+}
+
+void TestClearInterest(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx  = *static_cast<TestContext *>(aContext);
+    WatchedPipe & idle = ctx.mPipes[0];
+    WatchedPipe & busy = ctx.mPipes[1];
+
+    CHIP_ERROR err = ctx.OpenAndWatch(idle);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.OpenAndWatch(busy);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, ctx.mSystemLayer.ClearCallbackOnPendingRead(idle.mToken) == CHIP_NO_ERROR);
+    idle.MakeReadable();
+    busy.MakeReadable();
+    ctx.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, idle.mCallbackCount == 0);
+    NL_TEST_ASSERT(inSuite, busy.mCallbackCount == 1);
+
+    // Re-arming interest reports the data that arrived in the meantime.
+    NL_TEST_ASSERT(inSuite, ctx.mSystemLayer.RequestCallbackOnPendingRead(idle.mToken) == CHIP_NO_ERROR);
+    ctx.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, idle.mCallbackCount == 1);
+
+    ctx.ResetCounts();
+    ctx.Close(idle);
+    ctx.Close(busy);
+}
+
+void TestStopWatchingFromCallback(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+    WatchedPipe & a   = ctx.mPipes[0];
+    WatchedPipe & b   = ctx.mPipes[1];
+
+    CHIP_ERROR err = ctx.OpenAndWatch(a);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = ctx.OpenAndWatch(b);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Whichever of the two ready sockets is dispatched first stops watching the other one;
+    // the other must then not be called back, even though it was reported ready.
+    a.mToStop = &b.mToken;
+    b.mToStop = &a.mToken;
+    a.MakeReadable();
+    b.MakeReadable();
+    ctx.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, a.mCallbackCount + b.mCallbackCount == 1);
+
+    ctx.ResetCounts();
+    ctx.Close(a);
+    ctx.Close(b);
+}
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+void TestDescriptorAboveFdSetSize(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+    WatchedPipe & pipe = ctx.mPipes[0];
+
+    CHIP_ERROR err = ctx.OpenAndWatch(pipe);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    ctx.mSystemLayer.StopWatchingSocket(&pipe.mToken);
+
+    // select() can not wait on descriptors at or above FD_SETSIZE; epoll can.
+    int highFd = fcntl(pipe.mReadFd, F_DUPFD, FD_SETSIZE + 1);
+    if (highFd < 0)
+    {
+        // RLIMIT_NOFILE does not allow it; nothing to test.
+        ctx.Close(pipe);
+        return;
+    }
+    close(pipe.mReadFd);
+    pipe.mReadFd = highFd;
+
+    NL_TEST_ASSERT(inSuite, ctx.mSystemLayer.StartWatchingSocket(pipe.mReadFd, &pipe.mToken) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   ctx.mSystemLayer.SetCallback(pipe.mToken, WatchedPipe::OnEvent, reinterpret_cast<intptr_t>(&pipe)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.mSystemLayer.RequestCallbackOnPendingRead(pipe.mToken) == CHIP_NO_ERROR);
+
+    pipe.MakeReadable();
+    ctx.ServiceEvents();
+    NL_TEST_ASSERT(inSuite, pipe.mCallbackCount == 1);
+
+    ctx.ResetCounts();
+    ctx.Close(pipe);
+}
+
+uint64_t NowNs(clockid_t clock)
+{
+    struct timespec ts;
+    VerifyOrDie(clock_gettime(clock, &ts) == 0);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Raise the soft limit on open descriptors to at least [count], if the hard limit allows it.
+bool EnsureDescriptorLimit(rlim_t count)
+{
+    struct rlimit limit;
+    VerifyOrReturnValue(getrlimit(RLIMIT_NOFILE, &limit) == 0, false);
+    VerifyOrReturnValue(limit.rlim_cur < count, true);
+    VerifyOrReturnValue(limit.rlim_max == RLIM_INFINITY || limit.rlim_max >= count, false);
+    limit.rlim_cur = count;
+    return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+}
+
+void TestManyWatchedSockets(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    // Watch 1k sockets, one of which becomes readable at a time, and check that each loop turn dispatches only that
+    // socket. The wakeup latency (from the socket becoming readable to its callback) and the CPU time per event are
+    // logged; with epoll neither depends on the number of idle watched sockets.
+    constexpr size_t kNumSockets = 1000;
+    constexpr size_t kNumEvents  = 10000;
+
+    if (!EnsureDescriptorLimit(2 * kNumSockets + 64))
+    {
+        // RLIMIT_NOFILE does not allow it; nothing to test.
+        return;
+    }
+
+    std::unique_ptr<WatchedPipe[]> pipes(new WatchedPipe[kNumSockets]);
+    for (size_t i = 0; i < kNumSockets; i++)
+    {
+        CHIP_ERROR err = ctx.OpenAndWatch(pipes[i]);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    uint64_t wakeupNs      = 0;
+    uint64_t maxWakeupNs   = 0;
+    const uint64_t cpuNs   = NowNs(CLOCK_PROCESS_CPUTIME_ID);
+    unsigned expectedCount = 0;
+    for (size_t i = 0; i < kNumEvents; i++)
+    {
+        // Stride through the sockets so that consecutive events are far apart in the watch table.
+        WatchedPipe & pipe = pipes[(i * 7919) % kNumSockets];
+        if (&pipe == &pipes[0])
+        {
+            expectedCount++;
+        }
+
+        const uint64_t start = NowNs(CLOCK_MONOTONIC);
+        pipe.MakeReadable();
+        ctx.ServiceEvents();
+        const uint64_t elapsed = NowNs(CLOCK_MONOTONIC) - start;
+        wakeupNs += elapsed;
+        maxWakeupNs = std::max(maxWakeupNs, elapsed);
+
+        NL_TEST_ASSERT(inSuite, pipe.mCallbackCount >= 1);
+        pipe.Drain();
+    }
+    const uint64_t cpuPerEventNs = (NowNs(CLOCK_PROCESS_CPUTIME_ID) - cpuNs) / kNumEvents;
+
+    // Every event was dispatched to its own socket only, once.
+    unsigned totalCount = 0;
+    for (size_t i = 0; i < kNumSockets; i++)
+    {
+        totalCount += pipes[i].mCallbackCount;
+    }
+    NL_TEST_ASSERT(inSuite, totalCount == kNumEvents);
+    NL_TEST_ASSERT(inSuite, pipes[0].mCallbackCount == expectedCount);
+
+    ChipLogProgress(chipSystemLayer, "%u watched sockets: wakeup latency %u ns mean, %u ns max; CPU %u ns per event",
+                    static_cast<unsigned>(kNumSockets), static_cast<unsigned>(wakeupNs / kNumEvents),
+                    static_cast<unsigned>(maxWakeupNs), static_cast<unsigned>(cpuPerEventNs));
+
+    for (size_t i = 0; i < kNumSockets; i++)
+    {
+        ctx.Close(pipes[i]);
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+} // namespace
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("SocketWatch::TestOnlyReadySocketsDispatched",    TestOnlyReadySocketsDispatched),
+    NL_TEST_DEF("SocketWatch::TestDuplicateWatch",                TestDuplicateWatch),
+    NL_TEST_DEF("SocketWatch::TestClearInterest",                 TestClearInterest),
+    NL_TEST_DEF("SocketWatch::TestStopWatchingFromCallback",      TestStopWatchingFromCallback),
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    NL_TEST_DEF("SocketWatch::TestDescriptorAboveFdSetSize",      TestDescriptorAboveFdSetSize),
+    NL_TEST_DEF("SocketWatch::TestManyWatchedSockets",            TestManyWatchedSockets),
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static nlTestSuite kTheSuite = { "chip-system-socket-watch", sTests };
+
+int TestSystemSocketWatch()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&kTheSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemSocketWatch)
+#else  // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_LIBEV && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && ...
+int TestSystemSocketWatch(void)
+{
+    return SUCCESS;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_LIBEV && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && ...
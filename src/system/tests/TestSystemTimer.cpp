@@ -30,6 +30,7 @@
 #include <system/SystemConfig.h>
 
 #include <lib/core/ErrorStr.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
@@ -439,6 +440,9 @@ class TestTimer
 {
 public:
     static void CheckTimerPool(nlTestSuite * inSuite, void * aContext);
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    static void CheckTimerWheel(nlTestSuite * inSuite, void * aContext);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
 };
 } // namespace System
 } // namespace chip
@@ -712,6 +716,138 @@ static void IsTimerActiveTest(nlTestSuite * inSuite, void * aContext)
 
 // Test Suite
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+// Run the same randomized sequence of operations against a TimerList and a TimerWheel, and check that they agree.
+void chip::System::TestTimer::CheckTimerWheel(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & testContext = *static_cast<TestContext *>(aContext);
+    Layer & systemLayer       = *testContext.mLayer;
+    nlTestSuite * const suite = testContext.mTestSuite;
+
+    using Timer = TimerList::Node;
+    using namespace Clock::Literals;
+
+    static constexpr size_t kNumTimers = 200;
+    static constexpr int kNumSteps     = 5000;
+
+    struct Slot
+    {
+        Timer * listTimer  = nullptr;
+        Timer * wheelTimer = nullptr;
+    } slots[kNumTimers];
+
+    auto onComplete = [](Layer *, void *) {};
+
+    TimerList list;
+    TimerWheel wheel;
+    NL_TEST_ASSERT(suite, wheel.Remove(nullptr) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.Remove(onComplete, nullptr) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopEarliest() == nullptr);
+    NL_TEST_ASSERT(suite, wheel.PopIfEarlier(500_ms) == nullptr);
+    NL_TEST_ASSERT(suite, wheel.Empty());
+
+    auto sameTimer = [](const Timer * a, const Timer * b) {
+        if (a == nullptr || b == nullptr)
+        {
+            return a == b;
+        }
+        return a->AwakenTime() == b->AwakenTime() && a->GetCallback().GetAppState() == b->GetCallback().GetAppState();
+    };
+
+    uint32_t seed = 12345;
+    auto random   = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    };
+
+    Clock::Timestamp now = 1000_ms;
+    for (int step = 0; step < kNumSteps; ++step)
+    {
+        uint32_t r   = random();
+        Slot & entry = slots[r % kNumTimers];
+        void * state = &entry;
+
+        switch ((r >> 12) % 4)
+        {
+        case 0:
+        case 1: {
+            // (Re)start a timer. Round most delays so that timers often expire together, and occasionally pick one far in the
+            // future to exercise the upper levels and the overflow slot.
+            uint32_t kind = random() % 16;
+            Clock::Timestamp delay = (kind == 0) ? Clock::Timestamp(uint64_t(1) << (36 + random() % 4))
+                                                 : Clock::Timestamp((random() % (1u << (kind + 4))) & ~3u);
+            if (entry.listTimer != nullptr)
+            {
+                NL_TEST_ASSERT(suite, list.Remove(onComplete, state) == entry.listTimer);
+                NL_TEST_ASSERT(suite, wheel.Remove(onComplete, state) == entry.wheelTimer);
+                chip::Platform::Delete(entry.listTimer);
+                chip::Platform::Delete(entry.wheelTimer);
+            }
+            entry.listTimer  = chip::Platform::New<Timer>(systemLayer, now + delay, onComplete, state);
+            entry.wheelTimer = chip::Platform::New<Timer>(systemLayer, now + delay, onComplete, state);
+            Timer * listEarliest  = list.Add(entry.listTimer);
+            Timer * wheelEarliest = wheel.Add(entry.wheelTimer);
+            NL_TEST_ASSERT(suite, sameTimer(listEarliest, wheelEarliest));
+            break;
+        }
+        case 2:
+            // Cancel a timer.
+            if (entry.listTimer != nullptr)
+            {
+                NL_TEST_ASSERT(suite, list.Remove(entry.listTimer) == list.Earliest());
+                NL_TEST_ASSERT(suite, sameTimer(list.Earliest(), wheel.Remove(entry.wheelTimer)));
+                chip::Platform::Delete(entry.listTimer);
+                chip::Platform::Delete(entry.wheelTimer);
+                entry = Slot();
+            }
+            break;
+        case 3: {
+            // Let time pass and expire timers.
+            now += Clock::Timestamp(random() % 2048);
+            TimerList listExpired  = list.ExtractEarlier(now);
+            TimerList wheelExpired = wheel.ExtractEarlier(now);
+            for (;;)
+            {
+                Timer * listTimer  = listExpired.PopEarliest();
+                Timer * wheelTimer = wheelExpired.PopEarliest();
+                NL_TEST_ASSERT(suite, sameTimer(listTimer, wheelTimer));
+                if (listTimer == nullptr || wheelTimer == nullptr)
+                {
+                    break;
+                }
+                Slot & expired = *static_cast<Slot *>(listTimer->GetCallback().GetAppState());
+                chip::Platform::Delete(expired.listTimer);
+                chip::Platform::Delete(expired.wheelTimer);
+                expired = Slot();
+            }
+            break;
+        }
+        }
+
+        NL_TEST_ASSERT(suite, sameTimer(list.Earliest(), wheel.Earliest()));
+        NL_TEST_ASSERT(suite, list.Empty() == wheel.Empty());
+        NL_TEST_ASSERT(suite, list.GetRemainingTime(onComplete, state) == wheel.GetRemainingTime(onComplete, state));
+    }
+
+    // Drain in order.
+    for (;;)
+    {
+        Timer * listTimer  = list.PopEarliest();
+        Timer * wheelTimer = wheel.PopEarliest();
+        NL_TEST_ASSERT(suite, sameTimer(listTimer, wheelTimer));
+        if (listTimer == nullptr || wheelTimer == nullptr)
+        {
+            break;
+        }
+        chip::Platform::Delete(listTimer);
+        chip::Platform::Delete(wheelTimer);
+    }
+    NL_TEST_ASSERT(suite, wheel.Empty());
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -723,6 +859,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Timer::TestTimerOrder",           CheckOrder),
     NL_TEST_DEF("Timer::TestTimerCancellation",    CheckCancellation),
     NL_TEST_DEF("Timer::TestTimerPool",            chip::System::TestTimer::CheckTimerPool),
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    NL_TEST_DEF("Timer::TestTimerWheel",           chip::System::TestTimer::CheckTimerWheel),
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
     NL_TEST_DEF("Timer::TestCancelTimer",          CancelTimerTest::Test),
     NL_TEST_DEF("Timer::ExtendTimerTo",            ExtendTimerToTest),
     NL_TEST_DEF("Timer::TestIsTimerActive",        IsTimerActiveTest),
@@ -27,6 +27,7 @@
 #include <nlunit-test.h>
 
 using ::chip::Platform::ScopedMemoryBuffer;
+using ::chip::System::ChainedPacketBufferTLVReader;
 using ::chip::System::PacketBuffer;
 using ::chip::System::PacketBufferHandle;
 using ::chip::System::PacketBufferTLVReader;
@@ -56,6 +57,7 @@ public:
     static void NonChainedBufferCanReserve(nlTestSuite * inSuite, void * inContext);
     static void TestWriterReserveUnreserveDoesNotOverflow(nlTestSuite * inSuite, void * inContext);
     static void TestWriterReserve(nlTestSuite * inSuite, void * inContext);
+    static void ChainedBufferDecode(nlTestSuite * inSuite, void * inContext);
 };
 
 int TLVPacketBufferBackingStoreTest::TestSetup(void * inContext)
@@ -345,6 +347,106 @@ void TLVPacketBufferBackingStoreTest::TestWriterReserve(nlTestSuite * inSuite, v
     NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
 }
 
+/**
+ * Test that readers of a chain of buffers, including readers initialized from them, decode elements that span buffers.
+ */
+void TLVPacketBufferBackingStoreTest::ChainedBufferDecode(nlTestSuite * inSuite, void * inContext)
+{
+    // Start with a too-small buffer, so that the byte string spans buffers.
+    auto buffer = PacketBufferHandle::New(4, 0);
+
+    PacketBufferTLVWriter writer;
+    writer.Init(std::move(buffer), /* useChainedBuffers = */ true);
+
+    TLV::TLVType outerContainerType;
+    CHIP_ERROR error = writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, outerContainerType);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = writer.Put(TLV::AnonymousTag(), static_cast<uint8_t>(7));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    uint8_t bytes[2000];
+    for (size_t i = 0; i < sizeof(bytes); i++)
+    {
+        bytes[i] = static_cast<uint8_t>(i);
+    }
+    error = writer.Put(TLV::AnonymousTag(), ByteSpan(bytes));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = writer.Put(TLV::AnonymousTag(), static_cast<uint8_t>(8));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = writer.Finalize(&buffer);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buffer->HasChainedBuffer());
+
+    ChainedPacketBufferTLVReader reader;
+    error = reader.Init(std::move(buffer));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = reader.EnterContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = reader.Next(TLV::kTLVType_UnsignedInteger, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    error = reader.Next(TLV::kTLVType_ByteString, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    // A reader initialized from this one shares its backing store, but must advance through the chain on its own.
+    TLV::TLVReader copy;
+    copy.Init(reader);
+
+    uint8_t readBytes[sizeof(bytes)];
+    error = reader.GetBytes(readBytes, sizeof(readBytes));
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(readBytes, bytes, sizeof(bytes)) == 0);
+
+    uint8_t value;
+    error = reader.Next(TLV::kTLVType_UnsignedInteger, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    error = reader.Get(value);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == 8);
+
+    // Copying the byte string out of the chain reads it through a helper reader as well.
+    uint8_t copiedElement[sizeof(bytes) + 8];
+    TLV::TLVWriter elementWriter;
+    elementWriter.Init(copiedElement);
+    error = elementWriter.CopyElement(TLV::AnonymousTag(), copy);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    error = elementWriter.Finalize();
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    TLV::TLVReader elementReader;
+    elementReader.Init(copiedElement, elementWriter.GetLengthWritten());
+    error = elementReader.Next(TLV::kTLVType_ByteString, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+
+    ByteSpan byteValue;
+    error = elementReader.Get(byteValue);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, byteValue.data_equal(ByteSpan(bytes)));
+
+    error = copy.Next(TLV::kTLVType_UnsignedInteger, TLV::AnonymousTag());
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    error = copy.Get(value);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, value == 8);
+
+    error = reader.Next();
+    NL_TEST_ASSERT(inSuite, error == CHIP_END_OF_TLV);
+
+    error = reader.ExitContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, error == CHIP_NO_ERROR);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -356,6 +458,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("NonChainedBufferCanReserve",                TLVPacketBufferBackingStoreTest::NonChainedBufferCanReserve),
     NL_TEST_DEF("TestWriterReserveUnreserveDoesNotOverflow", TLVPacketBufferBackingStoreTest::TestWriterReserveUnreserveDoesNotOverflow),
     NL_TEST_DEF("TestWriterReserve",                         TLVPacketBufferBackingStoreTest::TestWriterReserve),
+    NL_TEST_DEF("ChainedBufferDecode",                       TLVPacketBufferBackingStoreTest::ChainedBufferDecode),
 
     NL_TEST_SENTINEL()
 };
@@ -175,6 +175,10 @@ private:
     bool mKeyAvailable;
     Crypto::Aes128KeyHandle mEncryptionKey;
     Crypto::Aes128KeyHandle mDecryptionKey;
+    // Bound to mEncryptionKey and mDecryptionKey once they are available, so that the cipher setup for the keys is done
+    // once per session instead of once per message.
+    mutable Crypto::AesCcm128Cipher mEncryptionCipher;
+    mutable Crypto::AesCcm128Cipher mDecryptionCipher;
     Crypto::AttestationChallenge mAttestationChallenge;
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
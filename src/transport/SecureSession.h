@@ -297,6 +297,7 @@ private:
     void MoveToState(State targetState);
 
     friend class SecureSessionDeleter;
+    friend class SecureSessionTable;
     friend class TestSecureSessionTable;
 
     SecureSessionTable & mTable;
@@ -319,6 +320,9 @@ private:
     SessionParameters mRemoteSessionParams;
     CryptoContext mCryptoContext;
     SessionMessageCounter mSessionMessageCounter;
+
+    /// Next session in the same bucket of the SecureSessionTable local session ID index.
+    SecureSession * mNextInLocalSessionIdBucket = nullptr;
 };
 
 } // namespace Transport
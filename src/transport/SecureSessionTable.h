@@ -29,6 +29,13 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+namespace Internal {
+constexpr size_t NextPowerOfTwo(size_t value, size_t power = 1)
+{
+    return power >= value ? power : NextPowerOfTwo(value, power * 2);
+}
+} // namespace Internal
+
 /**
  * Handles a set of sessions.
  *
@@ -39,7 +46,14 @@ inline constexpr uint16_t kUnsecuredSessionId = 0;
 class SecureSessionTable
 {
 public:
-    ~SecureSessionTable() { mEntries.ReleaseAll(); }
+    ~SecureSessionTable()
+    {
+        mEntries.ReleaseAll();
+        for (auto & bucket : mSessionIdBuckets)
+        {
+            bucket = nullptr;
+        }
+    }
 
     void Init() { mNextSessionId = chip::Crypto::GetRandU16(); }
 
@@ -76,7 +90,11 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -243,21 +261,44 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
-     *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * Candidate IDs are tried in order from the starting mNextSessionId clue,
+     * each checked against the session ID index.  At most one candidate per
+     * session in the table (plus kUnsecuredSessionId) can be in use, so this
+     * takes O(CHIP_CONFIG_SECURE_SESSION_POOL_SIZE) index lookups.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    /**
+     * Allocate a session out of the pool and add it to the session ID index.
+     */
+    template <typename... Args>
+    SecureSession * CreateSession(Args &&... args)
+    {
+        SecureSession * session = mEntries.CreateObject(*this, std::forward<Args>(args)...);
+        if (session != nullptr)
+        {
+            AddToIndex(session);
+        }
+        return session;
+    }
+
+    SecureSession * FindSessionByLocalSessionId(uint16_t localSessionId) const;
+    void AddToIndex(SecureSession * session);
+    void RemoveFromIndex(SecureSession * session);
+
+    // Local session IDs are allocated sequentially, so indexing them by their low bits spreads the sessions of a full table
+    // evenly across the buckets.
+    static constexpr size_t kSessionIdBucketCount = Internal::NextPowerOfTwo(CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+
+    static size_t BucketFor(uint16_t localSessionId) { return localSessionId & (kSessionIdBucketCount - 1); }
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
+    // Index of the sessions in mEntries by local session ID, chained through SecureSession::mNextInLocalSessionIdBucket.
+    SecureSession * mSessionIdBuckets[kSessionIdBucketCount] = {};
 
     size_t GetMaxSessionTableSize() const
     {
@@ -25,6 +25,7 @@
 #include <lib/support/IntrusiveList.h>
 #include <lib/support/ReferenceCountedHandle.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
+#include <messaging/ReliableMessageRttEstimator.h>
 #include <messaging/SessionParameters.h>
 #include <platform/LockTracker.h>
 #include <transport/SessionDelegate.h>
@@ -209,6 +210,12 @@ public:
     // the target For group sessions, this function will always return 0.
     System::Clock::Timeout ComputeRoundTripTimeout(System::Clock::Timeout upperlayerProcessingTimeout);
 
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    // The round-trip time of the peer, as measured by the acknowledgments of our reliable messages.
+    Messaging::RttEstimator & GetRttEstimator() { return mRttEstimator; }
+    const Messaging::RttEstimator & GetRttEstimator() const { return mRttEstimator; }
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+
     FabricIndex GetFabricIndex() const { return mFabricIndex; }
 
     SecureSession * AsSecureSession();
@@ -264,6 +271,9 @@ protected:
 
 private:
     FabricIndex mFabricIndex = kUndefinedFabricIndex;
+#if CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
+    Messaging::RttEstimator mRttEstimator;
+#endif // CHIP_CONFIG_MRP_ADAPTIVE_RETRANS_TIMEOUT
 };
 
 //
@@ -372,6 +372,17 @@ void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, CHIP_ERROR inet
     endPoint->GetInterfaceId(&interfaceId);
     PeerAddress addr = PeerAddress::TCP(ipAddress, port, interfaceId);
 
+    // Every message is written whole, so waiting to coalesce it with the next one only delays it. Without this, a small
+    // message such as a BDX BlockAck sent while earlier data is unacknowledged waits for the peer's delayed ACK.
+    if (inetErr == CHIP_NO_ERROR)
+    {
+        CHIP_ERROR noDelayErr = endPoint->EnableNoDelay();
+        if (noDelayErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "Failed to disable TCP buffering: %" CHIP_ERROR_FORMAT, noDelayErr.Format());
+        }
+    }
+
     // Send any pending packets
     tcp->mPendingPackets.ForEachActiveObject([&](PendingPacket * pending) {
         if (pending->mPeerAddress == addr)
@@ -466,6 +477,13 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
         endPoint->OnConnectionReceived = OnConnectionReceived;
         endPoint->OnAcceptError        = OnAcceptError;
         endPoint->OnPeerClose          = OnPeerClosed;
+
+        // See OnConnectionComplete().
+        CHIP_ERROR err = endPoint->EnableNoDelay();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "Failed to disable TCP buffering: %" CHIP_ERROR_FORMAT, err.Format());
+        }
     }
     else
     {
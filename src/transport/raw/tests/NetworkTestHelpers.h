@@ -78,12 +78,13 @@ public:
         // Make sure no one left packets hanging out that they thought got
         // delivered but actually didn't.
         VerifyOrDie(mPendingMessageQueue.empty());
+        VerifyOrDie(mDelayedMessageQueue.empty());
     }
 
     /// Transports are required to have a constructor that takes exactly one argument
     CHIP_ERROR Init(const char *) { return CHIP_NO_ERROR; }
 
-    bool HasPendingMessages() { return !mPendingMessageQueue.empty(); }
+    bool HasPendingMessages() { return !mPendingMessageQueue.empty() || !mDelayedMessageQueue.empty(); }
 
     void SetLoopbackTransportDelegate(LoopbackTransportDelegate * delegate) { mDelegate = delegate; }
 
@@ -99,6 +100,20 @@ public:
         }
     }
 
+    static void OnDelayedMessageReceived(System::Layer * aSystemLayer, void * aAppState)
+    {
+        LoopbackTransport * _this = static_cast<LoopbackTransport *>(aAppState);
+
+        const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        while (!_this->mDelayedMessageQueue.empty() && _this->mDelayedMessageQueue.front().first <= now)
+        {
+            auto item = std::move(_this->mDelayedMessageQueue.front().second);
+            _this->mDelayedMessageQueue.pop();
+            _this->HandleMessageReceived(item.mDestinationAddress, std::move(item.mPendingMessage));
+        }
+        _this->StartDelayedMessageTimer();
+    }
+
     static constexpr uint32_t kUnlimitedMessageCount = std::numeric_limits<uint32_t>::max();
 
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
@@ -136,6 +151,13 @@ public:
         }
 
         System::PacketBufferHandle receivedMessage = msgBuf.CloneData();
+        if (mMessageDelay > System::Clock::kZero)
+        {
+            // Simulate the latency of a link: deliver the message once the delay has elapsed.
+            mDelayedMessageQueue.emplace(System::SystemClock().GetMonotonicTimestamp() + mMessageDelay,
+                                         PendingMessageItem(address, std::move(receivedMessage)));
+            return mDelayedMessageQueue.size() == 1 ? StartDelayedMessageTimer() : CHIP_NO_ERROR;
+        }
         mPendingMessageQueue.push(PendingMessageItem(address, std::move(receivedMessage)));
         return mSystemLayer->ScheduleWork(OnMessageReceived, this);
     }
@@ -145,6 +167,8 @@ public:
     void Reset()
     {
         mPendingMessageQueue              = std::queue<PendingMessageItem>();
+        mDelayedMessageQueue              = std::queue<std::pair<System::Clock::Timestamp, PendingMessageItem>>();
+        mMessageDelay                     = System::Clock::kZero;
         mNumMessagesToDrop                = 0;
         mDroppedMessageCount              = 0;
         mSentMessageCount                 = 0;
@@ -163,8 +187,20 @@ public:
         System::PacketBufferHandle mPendingMessage;
     };
 
+    CHIP_ERROR StartDelayedMessageTimer()
+    {
+        VerifyOrReturnError(!mDelayedMessageQueue.empty(), CHIP_NO_ERROR);
+        const System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+        const System::Clock::Timestamp due = mDelayedMessageQueue.front().first;
+        const System::Clock::Timestamp delay = (due > now) ? due - now : System::Clock::Timestamp(0);
+        return mSystemLayer->StartTimer(std::chrono::duration_cast<System::Clock::Timeout>(delay), OnDelayedMessageReceived, this);
+    }
+
     System::Layer * mSystemLayer = nullptr;
     std::queue<PendingMessageItem> mPendingMessageQueue;
+    // Messages that are delivered once their delivery time has come, when mMessageDelay is not zero.
+    std::queue<std::pair<System::Clock::Timestamp, PendingMessageItem>> mDelayedMessageQueue;
+    System::Clock::Milliseconds32 mMessageDelay = System::Clock::kZero;
     uint32_t mNumMessagesToDrop                = 0;
     uint32_t mDroppedMessageCount              = 0;
     uint32_t mSentMessageCount                 = 0;
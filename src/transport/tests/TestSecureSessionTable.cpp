@@ -47,6 +47,12 @@ public:
     //
     static void ValidateSessionSorting(nlTestSuite * inSuite, void * inContext);
 
+    //
+    // This test validates that sessions can be found by their local session ID as they are allocated and
+    // released, and that newly allocated sessions never reuse an ID that is still in use.
+    //
+    static void ValidateSessionIdIndex(nlTestSuite * inSuite, void * inContext);
+
 private:
     struct SessionParameters
     {
@@ -459,6 +465,52 @@ void TestSecureSessionTable::ValidateSessionSorting(nlTestSuite * inSuite, void
     }
 }
 
+void TestSecureSessionTable::ValidateSessionIdIndex(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSessionTable sessionTable;
+    sessionTable.Init();
+
+    auto sessionIdOf = [](const Optional<SessionHandle> & session) {
+        return session.Value()->AsSecureSession()->GetLocalSessionId();
+    };
+
+    // Allocation wraps around to 1, skipping kUnsecuredSessionId.
+    sessionTable.mNextSessionId = kMaxSessionID;
+    auto session1               = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    auto session2               = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    auto session3               = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    NL_TEST_ASSERT(inSuite, session1.HasValue() && session2.HasValue() && session3.HasValue());
+    NL_TEST_ASSERT(inSuite, sessionIdOf(session1) == kMaxSessionID);
+    NL_TEST_ASSERT(inSuite, sessionIdOf(session2) == 1);
+    NL_TEST_ASSERT(inSuite, sessionIdOf(session3) == 2);
+
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(kMaxSessionID) == session1);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(1) == session2);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(2) == session3);
+    NL_TEST_ASSERT(inSuite, !sessionTable.FindSecureSessionByLocalKey(kUnsecuredSessionId).HasValue());
+    NL_TEST_ASSERT(inSuite, !sessionTable.FindSecureSessionByLocalKey(3).HasValue());
+
+    // IDs still in use are skipped.
+    sessionTable.mNextSessionId = kMaxSessionID;
+    auto session4               = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    NL_TEST_ASSERT(inSuite, session4.HasValue());
+    NL_TEST_ASSERT(inSuite, sessionIdOf(session4) == 3);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(3) == session4);
+
+    // Dropping the last reference to a pending session releases it and frees its ID.
+    session2.ClearValue();
+    NL_TEST_ASSERT(inSuite, !sessionTable.FindSecureSessionByLocalKey(1).HasValue());
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(kMaxSessionID) == session1);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(2) == session3);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(3) == session4);
+
+    sessionTable.mNextSessionId = kMaxSessionID;
+    auto session5               = sessionTable.CreateNewSecureSession(SecureSession::Type::kPASE, ScopedNodeId());
+    NL_TEST_ASSERT(inSuite, session5.HasValue());
+    NL_TEST_ASSERT(inSuite, sessionIdOf(session5) == 1);
+    NL_TEST_ASSERT(inSuite, sessionTable.FindSecureSessionByLocalKey(1) == session5);
+}
+
 Platform::UniquePtr<TestSecureSessionTable> gTestSecureSessionTable;
 
 } // namespace Transport
@@ -475,6 +527,7 @@ namespace {
 const nlTest sTests[] =
 {
     NL_TEST_DEF("Validate Session Sorting (Over Minima)",               chip::Transport::TestSecureSessionTable::ValidateSessionSorting),
+    NL_TEST_DEF("Validate Session ID Index",                            chip::Transport::TestSecureSessionTable::ValidateSessionIdIndex),
     NL_TEST_SENTINEL()
 };
 // clang-format on